@@ -13,6 +13,139 @@
 /********************************************************************************************/
 #define LOCK_TIME_LIMIT 50U
 /********************************************************************************************/
+/*	every (Enable) or (Disable) option below can also be given to the compiler, like		*/
+/*	(-DUSART_CRC=Enable), so the host tests select their options without changing this file.	*/
+/********************************************************************************************/
+/*	The Transfer Statistics (bytes, interrupts, CPU cycles and drops) of each port,		*/
+/*	it uses the DWT cycle counter, the options are : (Enable) or (Disable).				*/
+/********************************************************************************************/
+#ifndef USART_STATISTICS
+#define USART_STATISTICS    Disable
+#endif
+/********************************************************************************************/
+/*	The Traffic Capture (elements with their inter-element timing) and the Replay load		*/
+/*	generator, it uses the DWT cycle counter, the options are : (Enable) or (Disable).		*/
+/********************************************************************************************/
+#ifndef USART_CAPTURE
+#define USART_CAPTURE       Disable
+#endif
+/*	the maximum number of the Transmitted frames that wait for their Reception at the Sink	*/
+#define REPLAY_PENDING_FRAMES   8U
+/*	the longest wait of the last frames at the Sink after the replay, in micro seconds		*/
+#define REPLAY_DRAIN_US         20000UL
+/********************************************************************************************/
+/*	The running CRC (CRC-16/MODBUS or CRC-32) that is updated by every Transmitted and		*/
+/*	Received element, the options are : (Enable) or (Disable).								*/
+/********************************************************************************************/
+#ifndef USART_CRC
+#define USART_CRC           Disable
+#endif
+/********************************************************************************************/
+/*	The Receive Timestamps (the first element and the frame end) and the delivery latency	*/
+/*	of every Received frame, it uses the DWT cycle counter, the options are : (Enable) or	*/
+/*	(Disable).																				*/
+/********************************************************************************************/
+#ifndef USART_TIMESTAMP
+#define USART_TIMESTAMP     Disable
+#endif
+/********************************************************************************************/
+/*	The Frame Pool : fixed-size frame blocks owned by the driver, they are allocated and	*/
+/*	freed without locks by the Interrupts and the application, so the frame RAM follows	*/
+/*	the frames in flight, the options are : (Enable) or (Disable).							*/
+/********************************************************************************************/
+#ifndef USART_POOL
+#define USART_POOL          Disable
+#endif
+/*	the number of the frame blocks (up to 32)												*/
+#define POOL_BLOCKS_NUM         16U
+/*	the size of one frame block															*/
+#define POOL_BLOCK_SIZE         64U
+/*	the maximum number of the Received blocks that wait for the application at each port	*/
+#define POOL_RX_QUEUE           4U
+/********************************************************************************************/
+/*	The Event Trace : a ring of binary records (the API calls and returns, the ISR entries	*/
+/*	with the SR, the lock changes and the errors) with their DWT cycle, so the sequence		*/
+/*	that leaves a port BUSY can be read later, the options are : (Enable) or (Disable).	*/
+/********************************************************************************************/
+#ifndef USART_TRACE
+#define USART_TRACE         Disable
+#endif
+/*	the number of the trace records (a power of 2), the oldest ones are overwritten		*/
+#define TRACE_RECORDS           256U
+/********************************************************************************************/
+/*	The Baud Rate Fallback : the port goes back to its MCAL_UART_Init_ Baud rate between	*/
+/*	frames when the Frame and Noise errors of a window of Received elements reach a limit,	*/
+/*	no notice is sent to the peer, it goes back only when it Receives elements at the old	*/
+/*	rate, the options are : (Enable) or (Disable).											*/
+/********************************************************************************************/
+#ifndef USART_BAUD_FALLBACK
+#define USART_BAUD_FALLBACK Disable
+#endif
+/*	the number of the Received elements of one error window								*/
+#define BAUD_ERROR_WINDOW       256U
+/*	the Frame and Noise errors in one window that start the fallback						*/
+#define BAUD_ERROR_LIMIT        8U
+/********************************************************************************************/
+/*	The Modbus RTU mode : the frames are ended by the line silence (the IDLE interrupt and	*/
+/*	the t1.5 / t3.5 times by the DWT cycle counter) and checked by the running CRC-16, it	*/
+/*	needs the (USART_CRC) option, the options are : (Enable) or (Disable).					*/
+/********************************************************************************************/
+#ifndef USART_MODBUS
+#define USART_MODBUS        Disable
+#endif
+/********************************************************************************************/
+/*	The Synchronous master mode : the (CK) pin clocks every Transmitted element and the		*/
+/*	Received elements are sampled by the same clock, like a {SPI} master, the options are :	*/
+/*	(Enable) or (Disable).																	*/
+/********************************************************************************************/
+#ifndef USART_SYNC
+#define USART_SYNC          Disable
+#endif
+/********************************************************************************************/
+/*	The buffered write mode : the small writes are copied into a ring and sent together in	*/
+/*	one Transmission, the elements written while it is in progress are added to it, the		*/
+/*	options are : (Enable) or (Disable).													*/
+/********************************************************************************************/
+#ifndef USART_WRITE
+#define USART_WRITE         Disable
+#endif
+/********************************************************************************************/
+/*	The Receive timeouts : a Reception also ends after a silence following its elements or	*/
+/*	after a total time (MCAL_UART_Set_RX_Timeouts), like the VTIME and VMIN rules of the		*/
+/*	termios, the options are : (Enable) or (Disable).										*/
+/********************************************************************************************/
+#ifndef USART_RX_TIMEOUT
+#define USART_RX_TIMEOUT    Disable
+#endif
+/********************************************************************************************/
+/*	The Receive ring : the Interrupt Receives a stream into a ring and the application reads	*/
+/*	the Received elements in place (two spans at most) then consumes them, the options are :	*/
+/*	(Enable) or (Disable).																	*/
+/********************************************************************************************/
+#ifndef USART_RX_RING
+#define USART_RX_RING       Disable
+#endif
+/********************************************************************************************/
+/*	The self-test support : the internal loopback (the half-duplex connection of the TX and	*/
+/*	RX lines) and the abort of a Reception, the options are : (Enable) or (Disable).		*/
+/********************************************************************************************/
+#ifndef USART_SELF_TEST
+#define USART_SELF_TEST     Disable
+#endif
+/********************************************************************************************/
+/*	The host model : (USART_posix.c) is built with (USART_program.c) on Linux, it models the	*/
+/*	registers of USART1, USART2 and USART6 and calls their Interrupt Handlers from a thread,	*/
+/*	the lines of the ports are termios serial ports or pseudo-terminals, the options are :	*/
+/*	(Enable) or (Disable).																	*/
+/********************************************************************************************/
+#ifndef USART_POSIX
+#define USART_POSIX         Disable
+#endif
+/*	the microseconds of one tick of the Time_Limit values (the STK timer tick)				*/
+#define POSIX_TICK_US           1U
+/*	the number of the elements that arrived on the line and wait for the (DR) register		*/
+#define POSIX_PENDING_SIZE      256U
+/********************************************************************************************/
 
 /********************************************************************************************/
-#endif
\ No newline at end of file
+#endif
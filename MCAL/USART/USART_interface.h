@@ -29,35 +29,360 @@ typedef enum
 /********************************************************************************************/
 
 /********************************************************************************************/
-/*							UART Peripheral information struct								*/
+/*          		   	The USART Peripheral Receive Error Policy.          	  		    */
 /********************************************************************************************/
+typedef enum
+{
+	RX_Strict_Mode    = 0x00U,		/*	Any Receive Error stops the Reception and unlocks the RX	  */
+	RX_Resilient_Mode = 0x01U		/*	Errors mark the frame and the RX resynchronise on the next one */
 
+}Uart_RX_Mode;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Receive Error Counters.          	  		    */
+/********************************************************************************************/
 typedef struct{
 
-    MUSART_peri     *USART_x ; 					/*	 		UART registers base address        					  */
+	u32				 PE_Counter;				/*	 		Number of the received Parity errors		  		  */
+	u32				 NE_Counter;				/*	 		Number of the received Noise errors		  		      */
+	u32				 FE_Counter;				/*	 		Number of the received Frame errors		  		      */
+	u32				 ORE_Counter;				/*	 		Number of the received Overrun errors		  		  */
+	u32				 Damaged_Frames;			/*	 		Number of the dropped (damaged) frames		  		  */
 
-	u32				 Time_Limit;				/*			UART time limit between each transaction		      */
+}USART_Error_Counters;
+/********************************************************************************************/
 
-    u8           	*TX_Buffer_Ptr;      		/*	 		Pointer to UART Tx transfer Buffer 					  */
-    u16              TX_Buffer_Size;        	/*	 		UART Tx Transfer Buffer size       					  */
-    s16              TX_Process_Count;      	/*	 		UART Tx Transfer process Counter   					  */
-	u8				 TX_Buffer_lastEL;			/*	 		UART TX last element should be in its buffer		  */
-	Uart_LOCK_ST	 TX_Lock_Flag;				/*   		UART Tx Flag that presents the current state		  */
-	u8				 TX_Lock_Counter;			/*	 UART Tx Lock counter that presents the unlock request number */
+/********************************************************************************************/
+/*          		   	The USART Peripheral Transfer Statistics.          	  		        */
+/********************************************************************************************/
+typedef struct{
+
+	u32				 TX_Bytes;					/*	 		Number of the Transmitted elements			  		  */
+	u32				 RX_Bytes;					/*	 		Number of the Received elements			  		      */
+	u32				 TX_Interrupts;				/*	 		Number of the TX interrupts (TC)			  		  */
+	u32				 RX_Interrupts;				/*	 		Number of the RX interrupts (RXNE)			  		  */
+	u32				 CPU_Cycles;				/*	 Cycles spent in the ISR and in the Blocking functions	 	  */
+	u32				 ISR_Max_Cycles;			/*	 		The longest ISR execution in cycles			  		  */
+	u32				 Dropped_Bytes;				/*	 		Number of the lost or dropped elements		  		  */
+	u32				 Start_Cycle;				/*	 		The DWT cycle of the last statistics reset	  		  */
+
+}USART_Statistics;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*	The fields' order of the statistics record produced by MCAL_UART_Stats_Report			*/
+/********************************************************************************************/
+#define USART_STATS_CSV_HEADER	"port,baud,frame_bits_x2,tx_bytes,rx_bytes,wire_util_permille,int_per_kbyte,cycles_per_byte,isr_max_cycles,drop_ppm\n"
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Running CRC types.          	  		        */
+/********************************************************************************************/
+typedef enum
+{
+	Uart_CRC_None = 0x00U,			/*	 		No running CRC										  */
+	Uart_CRC_16   = 0x01U,			/*	 		CRC-16/MODBUS										  */
+	Uart_CRC_32   = 0x02U			/*	 		CRC-32 (IEEE 802.3)									  */
+
+}Uart_CRC_Type;
+
+/*------------------------------------------------------------------------------------------*/
+/*	The CRC text wire format : only the frames of MCAL_UART_Transmit_CRC_INT carry it, the	*/
+/*	other frames of the port are sent as they are.											*/
+/*																							*/
+/*		| the frame elements | the CRC as hex text | the last element |						*/
+/*																							*/
+/*	the CRC is the one of the frame elements (the last element is not in it) after its		*/
+/*	final XOR, the text is upper-case ('0'..'9', 'A'..'F'), {MSB} digit first, 4 digits for	*/
+/*	(Uart_CRC_16) and 8 digits for (Uart_CRC_32), so the last element should not be a hex	*/
+/*	digit. the Receiver checks it when (Copy_RX_Check) of MCAL_UART_CRC_Config is (Enable).	*/
+/*------------------------------------------------------------------------------------------*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Traffic Capture record.          	  		    */
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Delta_Cycles;				/*	 DWT cycles since the previous captured element	  		  */
+	u8				 Element;					/*	 		The Received element						  		  */
+	u8				 Error_Flags;				/*	 		The (PE), (FE), (NE) and (ORE) flags of it	  		  */
+
+}USART_Capture_Record;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Received frame timestamps.          	  		*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 First_Cycle;				/*	 		The DWT cycle of the first element (RXNE)	  		  */
+	u32				 End_Cycle;					/*	 		The DWT cycle of the last element (RXNE)	  		  */
+	u32				 Delivery_Cycle;			/*	 The DWT cycle when the application took the frame		  */
+	u32				 Latency_Cycles;			/*	 		The cycles from the frame end to its delivery		  */
+	u32				 Max_Latency_Cycles;		/*	 		The longest delivery latency of the port	  		  */
+
+}USART_Frame_Time;
+
+/*	the DWT cycles in micro seconds	*/
+#define USART_CYCLES_TO_US(__CYCLES__)	((__CYCLES__) / (FCK / 1000000UL))
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Event Trace record.          	  		    	*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Cycle;						/*	 		The DWT cycle of the event					  		  */
+	u8				 Event;						/*	 		The event (USART_Trace_Event)				  		  */
+	u8				 Port;						/*	 The bits 8..15 of the Peripheral address (0x10, 0x44, 0x14) */
+	u16				 Data;						/*	 		The event data								  		  */
 
+}USART_Trace_Record;
+
+typedef enum
+{
+	Trace_TX_INT       = 0x01U,		/*	MCAL_UART_Transmit_INT is called, (Data) : the Size		*/
+	Trace_RX_INT       = 0x02U,		/*	MCAL_UART_Receive_INT is called, (Data) : the Size		*/
+	Trace_TX_Polling   = 0x03U,		/*	MCAL_UART_Transmit is called, (Data) : the Size			*/
+	Trace_RX_Polling   = 0x04U,		/*	MCAL_UART_Receive is called, (Data) : the Size			*/
+	Trace_Return       = 0x08U,		/*	the API returns, (Data) : the Uart_Fun_Status			*/
+	Trace_ISR          = 0x10U,		/*	the IRQ Handler starts, (Data) : the SR register		*/
+	Trace_TX_Lock      = 0x20U,		/*	the TX lock changes, (Data) : BUSY or IDLE				*/
+	Trace_RX_Lock      = 0x21U,		/*	the RX lock changes, (Data) : BUSY or IDLE				*/
+	Trace_TX_Unlock    = 0x22U,		/*	the TX lock is released by LOCK_TIME_LIMIT				*/
+	Trace_RX_Unlock    = 0x23U,		/*	the RX lock is released by LOCK_TIME_LIMIT				*/
+	Trace_RX_Error     = 0x30U,		/*	a Receive error, (Data) : the SR error flags			*/
+	Trace_TX_End       = 0x40U,		/*	the Transfer ends, (Data) : the Uart_Fun_Status			*/
+	Trace_RX_End       = 0x41U		/*	the Reception ends, (Data) : the Uart_Fun_Status		*/
+
+}USART_Trace_Event;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Modbus RTU statistics.          	  		    */
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Frames;					/*	 		Number of the Received valid frames			  		  */
+	u32				 CRC_Errors;				/*	 		Number of the frames with a wrong CRC		  		  */
+	u32				 Gap_Errors;				/*	 Number of the frames that started before t3.5 of silence	  */
+	u32				 Damaged;					/*	 Number of the frames with a Receive error or too long	  */
+	u32				 Overwritten;				/*	 Number of the valid frames that were not taken in time	  */
+
+}USART_Modbus_Stats;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral buffered write statistics.          	  	    */
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Messages;					/*	 		Number of the accepted writes				  		  */
+	u32				 Bytes;						/*	 		Number of the accepted elements				  		  */
+	u32				 Streams;					/*	 Number of the started Transmissions (one setup for each one) */
+	u32				 Extended;					/*	 Number of the times the elements were added to a Transmission */
+	u32				 Full;						/*	 		Number of the writes refused as the ring was full	  */
+	u32				 Max_Wait_Cycles;			/*	 The longest wait of a written element before its Transmission */
+
+}USART_Write_Stats;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Receive ring span.          	  		        */
+/********************************************************************************************/
+typedef struct{
+
+	const u8		*Data;						/*	 		The first element of the span in the ring	  		  */
+	u16				 Size;						/*	 		Number of the elements of the span, or (0)	  		  */
+
+}USART_RX_Span;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The host model noise model of a line.          	  		        	*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Bit_Error_ppm;				/*	 The chance of an inverted data bit, in parts per million	  */
+	u32				 Frame_Error_ppm;			/*	 The chance of an element with a frame error (FE), in ppm	  */
+	u32				 Overrun_ppm;				/*	 The chance of a lost element (ORE on the next one), in ppm	  */
+	u32				 Seed;						/*	 		The seed of the random numbers, not (0)	 		  */
+	u8				 Burst_Bits;				/*	 Number of the bits inverted together by a bit error, or (0 or 1) */
+
+}USART_Noise_Model;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*							UART Peripheral information struct								*/
+/********************************************************************************************/
+
+typedef struct USART_Struct_Tag{
+	/*------------------------------------------------------------------------------------------*/
+	/*	the fields of the Interrupt Handlers are the first ones (52 bytes together), and every	*/
+	/*	group is ordered from the words to the bytes, so only the group ends can have padding.	*/
+	/*------------------------------------------------------------------------------------------*/
+    MUSART_peri     *USART_x ; 					/*	 		UART registers base address        					  */
+	u32				 CR1_Shadow;				/*	 The last value written to CR1, the control bits are read from it */
+
+    u8           	*TX_Buffer_Ptr;      		/*	 		Pointer to UART Tx transfer Buffer 					  */
     u8           	*RX_Buffer_Ptr;      		/*	 		Pointer to UART RX transfer Buffer 					  */
-    u16              RX_Buffer_Size;        	/*	 		UART RX Transfer Buffer size       					  */
+	void			(*TX_CallBack)(struct USART_Struct_Tag *USARTx);	/*	 UART Tx function that is executed at the end of an INT Transfer */
+	void			(*RX_CallBack)(struct USART_Struct_Tag *USARTx);	/*	 UART Rx function that is executed at the end of an INT Reception */
+	Uart_LOCK_ST	 TX_Lock_Flag;				/*   		UART Tx Flag that presents the current state		  */
+	Uart_LOCK_ST	 RX_Lock_Flag;				/*   		UART Rx Flag that presents the current state	  	  */
+	Uart_RX_Mode	 RX_Mode;					/*	 		UART RX Error policy (Strict or Resilient)	 		  */
+    s16              TX_Process_Count;      	/*	 		UART Tx Transfer process Counter   					  */
     s16              RX_Process_Count;      	/*	 		UART RX Transfer process Counter   					  */
+    u16              TX_Buffer_Size;        	/*	 		UART Tx Transfer Buffer size       					  */
+    u16              RX_Buffer_Size;        	/*	 		UART RX Transfer Buffer size       					  */
+	u8				 TX_Buffer_lastEL;			/*	 		UART TX last element should be in its buffer		  */
 	u8				 RX_Buffer_lastEL;			/*	 		UART RX last element should be in its buffer   		  */
-	Uart_LOCK_ST	 RX_Lock_Flag;				/*   		UART Tx Flag that presents the current state	  	  */
-	u8				 RX_Lock_Counter;			/*	 UART Tx Lock counter that presents the unlock request number */
-
+	u8				 TX_Lock_Counter;			/*	 UART Tx Lock counter that presents the unlock request number */
+	u8				 RX_Lock_Counter;			/*	 UART Rx Lock counter that presents the unlock request number */
+	u8				 RX_Frame_Damaged;			/*	 UART RX flag that marks the current frame as a damaged one	  */
+	u8				 TX_By_Size;				/*	 UART Tx flag, the Transmission ends by its size only		  */
+	/*------------------------------------------------------------------------------------------*/
+	/*	the configuration and the counters, they are used out of the Interrupt Handlers.		*/
+	/*------------------------------------------------------------------------------------------*/
+	u32				 CR2_Shadow;				/*			The last value written to CR2						  */
+	u32				 CR3_Shadow;				/*			The last value written to CR3						  */
+	u32				 Time_Limit;				/*			UART time limit between each transaction		      */
+	u32				 Baud_Rate;					/*	 	UART Baud rate given to MCAL_UART_Init_ or Set_Baud	  */
+	USART_Error_Counters RX_Errors;			/*	 		UART RX Error counters						 		  */
 	u8              *Error_Code;        		/*	 					UART Error code                    		  */
+	/*------------------------------------------------------------------------------------------*/
+	/*									the driver options										*/
+	/*------------------------------------------------------------------------------------------*/
+#if USART_BAUD_FALLBACK == Enable
+	u32				 Base_Baud_Rate;			/*	 	UART Baud rate of MCAL_UART_Init_ (the fallback one)  */
+	u32				 Fallback_Counter;			/*	 		Number of the done fallbacks				 		  */
+	u16				 Window_Elements;			/*	 		Number of the Received elements of the window		  */
+	u16				 Window_Errors;				/*	 		Number of the Frame and Noise errors of the window	  */
+	u8				 Fallback_Pending;			/*	 	the fallback waits for the end of the current frame	  */
+#endif
+#if USART_STATISTICS == Enable
+	USART_Statistics Stats;					/*	 		UART Transfer statistics					 		  */
+#endif
+#if USART_CRC == Enable
+	u32				 TX_CRC;					/*	 		UART TX running CRC value					 		  */
+	u32				 RX_CRC;					/*	 		UART RX running CRC value					 		  */
+	Uart_CRC_Type	 CRC_Type;					/*	 		UART running CRC type						 		  */
+	u8				 RX_CRC_Check;				/*	 UART RX frames end by the CRC text (Enable), see the wire format */
+	u8				 TX_CRC_Pending;			/*	 		Number of the CRC digits to be inserted	 		  */
+	u8				 RX_CRC_Valid;				/*	 		The CRC result of the last Received frame	 		  */
+#endif
+#if USART_CAPTURE == Enable
+	USART_Capture_Record *Capture_Buffer;		/*	 		Pointer to UART Capture records buffer		 		  */
+	u32				 Capture_Last_Cycle;		/*	 		The DWT cycle of the last captured element	 		  */
+	u32				 Frame_End_Cycle;			/*	 		The DWT cycle of the last Received frame end 		  */
+	u32				 Frame_End_Counter;			/*	 		Number of the Received frames				 		  */
+	u16				 Capture_Size;				/*	 		UART Capture records buffer size			 		  */
+	u16				 Capture_Count;				/*	 		Number of the captured records				 		  */
+#endif
+#if USART_TIMESTAMP == Enable
+	USART_Frame_Time RX_Time;					/*	 		UART RX timestamps of the last frame		 		  */
+	u8				 RX_Time_Delivered;			/*	 	the last frame timestamps are taken by the application	  */
+#endif
+#if USART_POOL == Enable
+	u32				 RX_Pool_Drops;				/*	 Number of the frames dropped (an error, the block end, no free block or queue place) */
+	u16				 RX_Pool_Size[POOL_RX_QUEUE + 1];	/*	 		The frame sizes of the waiting blocks		  */
+	u8				 RX_Pool_Queue[POOL_RX_QUEUE + 1];	/*	 The Received blocks waiting for the application  */
+	volatile u8		 RX_Pool_In;				/*	 	The queue index that is written by the Interrupt	  */
+	volatile u8		 RX_Pool_Out;				/*	 	The queue index that is written by the application	  */
+	u8				 RX_Pool_Block;				/*	 	The pool block of the Reception or (POOL_NO_BLOCK)	  */
+	u8				 TX_Pool_Block;				/*	 	The pool block of the Transmission or (POOL_NO_BLOCK) */
+#endif
+#if USART_SYNC == Enable
+	u8				*Sync_TX_Ptr;				/*	 		The elements to Transmit, or NULL			 		  */
+	u8				*Sync_RX_Ptr;				/*	 		The buffer of the Received elements, or NULL	 	  */
+	u16				 Sync_Size;					/*	 		The size of the Transfer					 		  */
+	u16				 Sync_TX_Count;				/*	 		Number of the loaded elements				 		  */
+	u16				 Sync_RX_Count;				/*	 		Number of the Received elements				 		  */
+	u8				 Sync_Active;				/*	 		A Synchronous Transfer is in progress		 		  */
+#endif
+#if USART_MODBUS == Enable
+	u8				*Modbus_Buffer;				/*	 The two frame buffers of the Modbus mode, or NULL		  */
+	u32				 Modbus_CRC;				/*	 		The running CRC of the current frame		 		  */
+	u32				 Modbus_Last_Cycle;			/*	 		The DWT cycle of the last line activity		 		  */
+	u32				 Modbus_T15;				/*	 		The t1.5 time in DWT cycles					 		  */
+	u32				 Modbus_T35;				/*	 		The t3.5 time in DWT cycles					 		  */
+	Uart_CRC_Type	 Modbus_Saved_CRC_Type;		/*	 	The CRC type of the port before the Modbus mode		  */
+	USART_Modbus_Stats Modbus_Stats;			/*	 		The Modbus RTU statistics					 		  */
+	u16				 Modbus_Size;				/*	 		The size of one frame buffer				 		  */
+	u16				 Modbus_Length;				/*	 		Number of the elements of the current frame		  */
+	u16				 Modbus_Ready_Length;		/*	 		The size of the waiting frame (with its CRC)	 	  */
+	u8				 Modbus_Half;				/*	 		The buffer of the current frame (0 or 1)	 		  */
+	u8				 Modbus_Open;				/*	 the current frame had an IDLE with a wrong CRC (t1.5 check) */
+	u8				 Modbus_Damaged;			/*	 		The current frame has an error				 		  */
+	u8				 Modbus_Ready;				/*	 		A valid frame waits for the application		 		  */
+	u8				 Modbus_Saved_CRC_Check;	/*	 	The RX CRC check of the port before the Modbus mode	  */
+#endif
+#if USART_WRITE == Enable
+	u8				*Write_Buffer;				/*	 		The ring of the buffered write mode, or NULL		  */
+	u32				 Write_Deadline;			/*	 	The longest wait of a written element in DWT cycles	  */
+	u32				 Write_First_Cycle;			/*	 The DWT cycle of the oldest waiting element (the deadline)	  */
+	USART_Write_Stats Write_Stats;				/*	 		The buffered write statistics				 		  */
+	u16				 Write_Size;				/*	 		The size of the ring						 		  */
+	u16				 Write_Threshold;			/*	 The waiting elements that start a Transmission at once		  */
+	volatile u16	 Write_In;					/*	 	The ring index that is written by the application	  */
+	volatile u16	 Write_Out;					/*	 	The ring index that is written by the Interrupt		  */
+	u16				 Write_Span;				/*	 	The elements of the ring in the current Transmission	  */
+	volatile u8		 Write_Streaming;			/*	 	The Transmission in progress is sent from the ring	  */
+#endif
+#if USART_RX_TIMEOUT == Enable
+	u32				 RX_Gap_Cycles;				/*	 The silence after an element that ends the Reception, or (0) */
+	u32				 RX_Total_Cycles;			/*	 		The longest time of a Reception, or (0)		 		  */
+	u32				 RX_Start_Cycle;			/*	 		The DWT cycle of the Reception start		 		  */
+	u32				 RX_Last_Cycle;				/*	 		The DWT cycle of the last Received element	 		  */
+	u8				 RX_Gap_Idle;				/*	 	The IDLE line (one element time) ends the Reception	  */
+#endif
+#if USART_RX_RING == Enable
+	u8				*Ring_Buffer;				/*	 		The Receive ring, or NULL					 		  */
+	u32				 Ring_Drops;				/*	 Number of the elements dropped as the ring was full or with an error */
+	u16				 Ring_Size;					/*	 		The size of the ring						 		  */
+	volatile u16	 Ring_In;					/*	 	The ring index that is written by the Interrupt		  */
+	volatile u16	 Ring_Out;					/*	 	The ring index that is written by the application	  */
+#endif
 
 }USART_Struct;
 
 /********************************************************************************************/
 
+/********************************************************************************************/
+/*          		   	The USART Peripheral Traffic Replay configuration.          	    */
+/********************************************************************************************/
+typedef struct{
+
+	USART_Capture_Record *Records;				/*	 		The captured records that will be replayed	  		  */
+	u16				 Records_Count;				/*	 		Number of the records						  		  */
+	u16				 Scale_Percent;				/*	 (100) the original timing, (50) twice faster, (0) wire speed */
+	USART_Struct	*Sink;						/*	 	The port that receives the replayed traffic or NULL	  */
+	u8				*Sink_Buffer;				/*	 		The frame buffer of the Sink				  		  */
+	u16				 Sink_Size;					/*	 		The frame buffer size of the Sink			  		  */
+	u8				 Last_element;				/*	 		The frame boundary element					  		  */
+
+}USART_Replay_Config;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The USART Peripheral Traffic Replay report.          	  		    */
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Sent_Elements;				/*	 		Number of the replayed elements				  		  */
+	u32				 Sent_Frames;				/*	 		Number of the replayed frames				  		  */
+	u32				 Received_Frames;			/*	 		Number of the frames delivered at the Sink	  		  */
+	u32				 Overruns;					/*	 		Number of the Overrun errors at the Sink	  		  */
+	u32				 Dropped_Frames;			/*	 		Number of the damaged frames at the Sink	  		  */
+	u32				 Max_Latency_Cycles;		/*	 The longest time from the frame end Transmission to its delivery */
+	u32				 Total_Latency_Cycles;		/*	 		The sum of all the measured latencies		  		  */
+	u32				 Sink_Failures;				/*	 Number of the Sink Receptions that could not be started again	  */
+
+}USART_Replay_Report;
+/********************************************************************************************/
+
 
 /********************************************************************************************/
 /*									Error Codes												*/
@@ -68,6 +393,13 @@ typedef struct{
 #define Error_4			"UART_ERROR_FE"          /*		   Frame error         */
 #define Error_5			"UART_ERROR_ORE"         /*		   Overrun error       */
 #define Error_6			"UART_ERROR_TIMEOUT"     /*		   Timeout error       */
+#define Error_7			"UART_ERROR_OVERSIZE"    /*		   Frame overflow      */
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*				The Receive gap of one element time (MCAL_UART_Set_RX_Timeouts)				*/
+/********************************************************************************************/
+#define UART_RX_GAP_IDLE		0xFFFFFFFFUL
 /********************************************************************************************/
 
 /********************************************************************************************/
@@ -157,6 +489,33 @@ typedef struct{
 
 }MUSART_Receiving_Config ;
 /*------------------------------------------------------------------------------------------*/
+//------------------------------ Synchronous Clock Polarity : ---------
+typedef enum{
+
+	CK_Idle_Low ,
+	CK_Idle_High
+}Sync_Clock_Polarity ;
+//-------------------------------- Synchronous Clock Phase : ----------
+typedef enum{
+
+	CK_First_Edge ,
+	CK_Second_Edge
+}Sync_Clock_Phase ;
+//------------------------------ Synchronous Last Bit Clock : ---------
+typedef enum{
+
+	Last_Bit_No_Clock ,
+	Last_Bit_Clock
+}Sync_Last_Bit ;
+//-------------------------------------------------------------------------------------------
+typedef struct{
+
+	volatile	Sync_Clock_Polarity		Clock_Polarity	;
+	volatile	Sync_Clock_Phase		Clock_Phase		;
+	volatile	Sync_Last_Bit			Last_Bit		;
+
+}MUSART_Sync_Config ;
+/*------------------------------------------------------------------------------------------*/
 /********************************************************************************************/
 
 
@@ -219,10 +578,20 @@ Uart_Fun_Status 	MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_
 /// @param USARTx                   : the Struct of Peripheral's Registers.
 /// @param ptData                   : pointer of data we want to Transmit.
 /// @param Size                     : the size of the data that will be Transmitted.
-/// @param Time_Limit               : the maximum time for this function. 
-///@retval Functions Status.
+/// @param Last_element             : the last element that should be Transmitted.
+///@retval Functions Status, (Uart_OK) when the Transmission is started, its end (even at the first element) calls the
+///        TX callback.
 Uart_Fun_Status	    MCAL_UART_Transmit_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size ,u8 Last_element);
 /*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief MCAL_UART_Transmit_Size_INT : this function Transmits (Size) elements by the Interrupt mode like
+///                                      MCAL_UART_Transmit_INT, no element ends it earlier, so it sends the binary
+///                                      frames and the parts of a frame (no CRC text is inserted).
+/// @param USARTx                      : the Struct of Peripheral's Registers.
+/// @param ptData                      : pointer of data we want to Transmit.
+/// @param Size                        : the number of the elements that will be Transmitted.
+///@retval Functions Status, its end calls the TX callback with (TX_Buffer_Size) equal to (Size).
+Uart_Fun_Status	    MCAL_UART_Transmit_Size_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
 /// @brief MCAL_USART_Transmit_INT  : this function Receive an amount of data by the Asynchronous mode "Interrupt".
 /// @param USARTx                   : the Struct of Peripheral's Registers.
 /// @param ptData                   : pointer of data we want to Transmit.
@@ -238,4 +607,410 @@ Uart_Fun_Status	    MCAL_UART_Receive_INT(USART_Struct *USARTx , u8 *ptData ,u16
 /// @retval Functions Status.
 Uart_Fun_Status	    MCAL_UART_INTT_CALLBACK(USART_Struct *USARTx , USART_INT_TYPE INTT_TYPE, void (*Copy_ptr)(void));
 /*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_TX_CALLBACK : this function is Used to add a function that will be executed at the Handler when
+///                                 the Transfer of MCAL_UART_Transmit_INT ends, so the next Transfer can be started from it.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_ptr              : pointer to the function that will be executed with the Struct, or NULL to remove it.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_TX_CALLBACK(USART_Struct *USARTx , void (*Copy_ptr)(USART_Struct *USARTx));
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_RX_CALLBACK : this function is Used to add a function that will be executed at the Handler when
+///                                 the Reception of MCAL_UART_Receive_INT ends (by the last element, the buffer end or an
+///                                 error), so the next Reception can be started from it.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_ptr              : pointer to the function that will be executed with the Struct, or NULL to remove it.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_RX_CALLBACK(USART_Struct *USARTx , void (*Copy_ptr)(USART_Struct *USARTx));
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Claim_CALLBACKS : this function sets the TX and RX callbacks of a service that owns the port, a
+///                                     callback is set only if it is free or it is the same function, so two services
+///                                     can share a port when they use different callbacks.
+/// @param  USARTx                    : the Struct of Peripheral's Registers.
+/// @param  Copy_TX                   : the TX callback, or NULL if the service does not use it.
+/// @param  Copy_RX                   : the RX callback, or NULL if the service does not use it.
+/// @retval Functions Status, (Uart_BUSY) if a callback is owned by another function, then no callback is set.
+Uart_Fun_Status	    MCAL_UART_Claim_CALLBACKS(USART_Struct *USARTx , void (*Copy_TX)(USART_Struct *USARTx) ,
+                                              void (*Copy_RX)(USART_Struct *USARTx));
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Set_RX_Mode  : this function selects the Receive Error policy of the Peripheral.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Mode              : the Receive Error policy:
+///         @arg RX_Strict_Mode    : any error stops the Reception (the default after MCAL_UART_Init_).
+///         @arg RX_Resilient_Mode : the error is counted, the frame is dropped and the Reception continues from the next frame.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Set_RX_Mode(USART_Struct *USARTx , Uart_RX_Mode Copy_Mode);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Get_RX_Errors : this function copies the Receive Error counters of the Peripheral.
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @param  Copy_Counters           : pointer to the struct that will hold the counters.
+/// @param  Copy_Clear              : (Enable) to clear the counters after reading them, (Disable) to keep them.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Get_RX_Errors(USART_Struct *USARTx , USART_Error_Counters *Copy_Counters, u8 Copy_Clear);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#if USART_STATISTICS == Enable
+/// @brief  MCAL_UART_Stats_Reset : this function clears the Transfer statistics and starts a new measurement window.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Stats_Reset(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Get_Stats : this function copies the raw Transfer statistics of the Peripheral.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @param  Copy_Stats          : pointer to the struct that will hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Get_Stats(USART_Struct *USARTx , USART_Statistics *Copy_Stats);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Stats_Report : this function writes one CSV record (see USART_STATS_CSV_HEADER) of the derived figures:
+///                                  wire utilisation, interrupts per byte, cycles per byte, max ISR time and drop rate.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Buffer            : the buffer that will hold the record.
+/// @param  Copy_Size              : the size of the buffer (at least 120 elements).
+/// @param  Copy_Length            : pointer to hold the length of the record.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Stats_Report(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size , u16 *Copy_Length);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_CAPTURE == Enable
+/// @brief  MCAL_UART_Capture_Start : this function starts recording the Received elements with their inter-element timing.
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @param  Copy_Records            : the buffer of the records.
+/// @param  Copy_Size               : the number of the records in the buffer, the capture stops when it is full.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Capture_Start(USART_Struct *USARTx , USART_Capture_Record *Copy_Records , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Capture_Stop : this function stops the capture.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Count             : pointer to hold the number of the captured records.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Capture_Stop(USART_Struct *USARTx , u16 *Copy_Count);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Replay : this function Transmits captured records by the Blocking mode with their original
+///                            (or scaled) inter-element timing, while the Sink port receives them by its Interrupt path,
+///                            the Sink RX pin is wired to the TX pin of the Transmitting port (or the two ports are a
+///                            pseudo-terminal pair of the host model), the frames that are not Received at the end are
+///                            waited for (REPLAY_DRAIN_US) at most.
+/// @param  USARTx           : the Struct of the Transmitting Peripheral.
+/// @param  Copy_Config      : the replay configuration.
+/// @param  Copy_Report      : pointer to hold the drops, overruns and frame latencies measured at the Sink.
+/// @retval Functions Status, the status of the Sink Reception when it can not be started.
+Uart_Fun_Status	    MCAL_UART_Replay(USART_Struct *USARTx , USART_Replay_Config *Copy_Config , USART_Replay_Report *Copy_Report);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_CRC == Enable
+/// @brief  MCAL_UART_CRC_Config : this function selects the running CRC of the Peripheral, it is updated by every
+///                                Transmitted and Received element, so the frame is not read again to check it.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @param  Copy_Type            : the CRC type (Uart_CRC_None), (Uart_CRC_16) or (Uart_CRC_32).
+/// @param  Copy_RX_Check        : (Enable) the Received frames end by the CRC text (the wire format above the
+///                                Uart_CRC_Type), it is checked by MCAL_UART_CRC_Check, the Transmitted frames are not
+///                                changed (MCAL_UART_Transmit_CRC_INT sends one with the text).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_CRC_Config(USART_Struct *USARTx , Uart_CRC_Type Copy_Type , u8 Copy_RX_Check);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief MCAL_UART_Transmit_CRC_INT : this function Transmits one frame by the Interrupt mode like MCAL_UART_Transmit_INT
+///                                     and inserts the CRC text of its elements before its last element (the wire format
+///                                     above the Uart_CRC_Type), the next frames are sent without it.
+/// @param USARTx                     : the Struct of Peripheral's Registers, with a CRC type.
+/// @param ptData                     : pointer of data we want to Transmit.
+/// @param Size                       : the size of the data that will be Transmitted.
+/// @param Last_element               : the last element that should be Transmitted (not a hex digit).
+///@retval Functions Status, (Uart_ERROR) if the port has no CRC type.
+Uart_Fun_Status	    MCAL_UART_Transmit_CRC_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size ,u8 Last_element);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_CRC_Get : this function gets the CRC of the last (or the current) frame.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @param  Copy_CommType     : (TX) the CRC of the Transmitted elements, (RX) the CRC of the Received elements.
+/// @param  Copy_CRC          : pointer to hold the CRC value.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_CRC_Get(USART_Struct *USARTx , COMM_TYPE Copy_CommType , u32 *Copy_CRC);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_CRC_Check : this function checks the last Received frame, its CRC (hex text, {MSB} digit first)
+///                               should be just before the last element, it needs the (Copy_RX_Check) of the CRC Config.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @retval (Uart_OK) if the frame is valid, or (Uart_ERROR) if not.
+Uart_Fun_Status	    MCAL_UART_CRC_Check(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_CRC_Block : this function calculates the CRC of a block by the same tables of the running CRC.
+/// @param  Copy_Type           : the CRC type (Uart_CRC_16) or (Uart_CRC_32).
+/// @param  Copy_Data           : pointer to the block.
+/// @param  Copy_Size           : the size of the block.
+/// @retval the CRC value.
+u32	                MCAL_UART_CRC_Block(Uart_CRC_Type Copy_Type , const u8 *Copy_Data , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_TIMESTAMP == Enable
+/// @brief  MCAL_UART_Get_RX_Time : this function gets the timestamps of the last Received frame, the first call for a
+///                                 frame marks its delivery, so the latency is the time the frame waited for the application.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_Time             : pointer to hold the timestamps.
+/// @retval Functions Status, (Uart_BUSY) if the Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Get_RX_Time(USART_Struct *USARTx , USART_Frame_Time *Copy_Time);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+/// @brief  MCAL_UART_Set_Baud : this function changes the Baud rate between frames, the last Transmitted element leaves
+///                              the shift register first, then (BRR) is written with the Peripheral disabled.
+/// @param  USARTx             : the Struct of Peripheral's Registers.
+/// @param  Copy_Baud          : the new Baud rate.
+/// @retval Functions Status, (Uart_BUSY) if a Transmission or the Reception of a frame is in progress.
+Uart_Fun_Status	    MCAL_UART_Set_Baud(USART_Struct *USARTx , u32 Copy_Baud);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#if USART_POSIX == Enable
+/// @brief  MCAL_UART_Posix_Open : this function gives a serial port (or the slave side of a pseudo-terminal) to the
+///                                line of the Peripheral of the host model, it is called before or after MCAL_UART_Init_,
+///                                the Interrupt Handlers (and the callbacks) run in the model thread.
+/// @param  USARTx               : the USART Struct, its USART_x is USART1_R, USART2_R or USART6_R.
+/// @param  Copy_Path            : the device path, like "/dev/ttyUSB0".
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Open(USART_Struct *USARTx , const char *Copy_Path);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Posix_Pty : this function gives a new pseudo-terminal to the line of the Peripheral, the other side
+///                               is opened by its name (by a host tool, or by MCAL_UART_Posix_Open of another Peripheral).
+/// @param  USARTx              : the USART Struct, its USART_x is USART1_R, USART2_R or USART6_R.
+/// @param  Copy_Name           : the buffer of the slave side name.
+/// @param  Copy_Size           : the size of the name buffer.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Pty(USART_Struct *USARTx , char *Copy_Name , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Posix_Close : this function closes the line of the Peripheral, the next Transmitted elements are lost.
+/// @param  USARTx                : the USART Struct.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Close(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Posix_Noise : this function sets the noise model of the Received elements of the line, the errors
+///                                 are added when an element is given to (DR), so a test sees them as on a noisy line.
+/// @param  USARTx                : the USART Struct.
+/// @param  Copy_Model            : the noise model, or NULL to stop the noise.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Noise(USART_Struct *USARTx , const USART_Noise_Model *Copy_Model);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_SYNC == Enable
+/// @brief  MCAL_UART_Sync_Config : this function selects the Synchronous master mode, the (CK) pin gives the clock of
+///                                 the Transmitted elements, the Baud rate can be up to (FCK / 8) with (Sampling_By_8).
+/// @param  USARTx                : the Struct of the initialized Peripheral.
+/// @param  Copy_Config           : the clock polarity, phase and last bit clock, or NULL to go back to the Asynchronous
+///                                 mode.
+/// @retval Functions Status, (Uart_BUSY) if a Transmission or a Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Sync_Config(USART_Struct *USARTx , MUSART_Sync_Config *Copy_Config);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Sync_Transfer_INT : this function Transmits and Receives a number of elements at the same time by the
+///                                       Interrupt, like a {SPI} transaction, the elements end by the size only.
+/// @param  USARTx                      : the Struct of the Peripheral in the Synchronous mode.
+/// @param  Copy_TX_Data                : the elements to Transmit, or NULL to Transmit (0xFF).
+/// @param  Copy_RX_Data                : the buffer of the Received elements, or NULL to drop them.
+/// @param  Copy_Size                   : the number of the elements.
+/// @retval Functions Status, the RX callback is called at the end of the Transfer.
+Uart_Fun_Status	    MCAL_UART_Sync_Transfer_INT(USART_Struct *USARTx , u8 *Copy_TX_Data , u8 *Copy_RX_Data , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_MODBUS == Enable
+/// @brief  MCAL_UART_Modbus_Start : this function starts the Modbus RTU mode of the port, the Receive elements are stored
+///                                  in one half of the buffer while the last valid frame waits in the other half, a frame
+///                                  ends by the IDLE line with a valid CRC and it is given by the RX callback.
+/// @param  USARTx                 : the Struct of the initialized Peripheral (8 data bits, its Baud rate is used for t1.5
+///                                  and t3.5).
+/// @param  Copy_Buffer            : the buffer of two frames.
+/// @param  Copy_Size              : the size of one frame (up to 256).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Modbus_Start(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Modbus_Stop : this function stops the Modbus RTU mode of the port, the CRC type and the RX CRC
+///                                 check of the port before MCAL_UART_Modbus_Start are given back.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Modbus_Stop(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Modbus_Get_Frame : this function takes the last valid frame, it stays valid till the next frame ends.
+/// @param  USARTx                     : the Struct of Peripheral's Registers.
+/// @param  Copy_Frame                 : pointer to hold the frame (address, function, data).
+/// @param  Copy_Size                  : pointer to hold the frame size without its CRC.
+/// @retval Functions Status, (Uart_BUSY) if there is no new frame.
+Uart_Fun_Status	    MCAL_UART_Modbus_Get_Frame(USART_Struct *USARTx , u8 **Copy_Frame , u16 *Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Modbus_Send : this function adds the CRC to a frame and sends it by the Interrupt after t3.5 of
+///                                 silence, the elements are not checked for a last element.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_Frame            : the frame, it should have two more elements for the CRC.
+/// @param  Copy_Size             : the frame size without its CRC.
+/// @retval Functions Status, (Uart_BUSY) if the line was active in the last t3.5 or a Transmission is in progress.
+Uart_Fun_Status	    MCAL_UART_Modbus_Send(USART_Struct *USARTx , u8 *Copy_Frame , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Modbus_Get_Stats : this function gets the Modbus RTU statistics of the port.
+/// @param  USARTx                     : the Struct of Peripheral's Registers.
+/// @param  Copy_Stats                 : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Modbus_Get_Stats(USART_Struct *USARTx , USART_Modbus_Stats *Copy_Stats);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_WRITE == Enable
+/// @brief  MCAL_UART_Write_Start : this function starts the buffered write mode of the port, the written elements wait in
+///                                 a ring till they reach the threshold or the oldest one reaches the deadline.
+/// @param  USARTx                : the Struct of the initialized Peripheral.
+/// @param  Copy_Buffer           : the ring, it holds (Copy_Size - 1) elements.
+/// @param  Copy_Size             : the size of the ring.
+/// @param  Copy_Threshold        : the waiting elements that start the Transmission (1 to send every write at once).
+/// @param  Copy_Deadline_us      : the longest wait of an element in microseconds, it is checked by MCAL_UART_Write and
+///                                 MCAL_UART_Write_Tick.
+/// @retval Functions Status, (Uart_BUSY) if a Transmission is in progress.
+Uart_Fun_Status	    MCAL_UART_Write_Start(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size , u16 Copy_Threshold , u32 Copy_Deadline_us);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Write_Stop : this function stops the buffered write mode, the waiting elements are dropped.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @retval Functions Status, (Uart_BUSY) if the ring is being sent.
+Uart_Fun_Status	    MCAL_UART_Write_Stop(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Write : this function copies elements into the ring, they are added to the Transmission in progress
+///                           or they start one at the threshold or the deadline, it is called by the application only.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @param  ptData          : pointer of the elements.
+/// @param  Size            : the number of the elements.
+/// @retval Functions Status, (Uart_BUSY) if the ring has no place for all the elements (none is copied).
+Uart_Fun_Status	    MCAL_UART_Write(USART_Struct *USARTx , const u8 *ptData , u16 Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Write_Flush : this function starts the Transmission of the waiting elements without the threshold.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Write_Flush(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Write_Tick : this function checks the deadline of the waiting elements, it is called periodically
+///                                (by the main loop or the STK timer) when the application may stop writing.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Write_Tick(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Write_Get_Stats : this function gets the buffered write statistics, (Messages / Streams) is the
+///                                     number of the writes that share one Transmission setup.
+/// @param  USARTx                    : the Struct of Peripheral's Registers.
+/// @param  Copy_Stats                : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Write_Get_Stats(USART_Struct *USARTx , USART_Write_Stats *Copy_Stats);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_RX_TIMEOUT == Enable
+/// @brief  MCAL_UART_Set_RX_Timeouts : this function sets the end rules of the next Receptions (polling and Interrupt),
+///                                     a Reception ends by the first one of : its buffer size (the elements number), its
+///                                     last element, a silence after its elements, or its total time. The two timeouts end
+///                                     it with (Uart_TIMEOUT), (Error_6) and the Received elements number in RX_Buffer_Size.
+/// @param  USARTx                    : the Struct of Peripheral's Registers.
+/// @param  Copy_Gap_us               : the silence after a Received element in microseconds, (UART_RX_GAP_IDLE) for one
+///                                     element time (the IDLE line by the hardware), or (0) for no gap rule.
+/// @param  Copy_Total_us             : the longest time of a Reception in microseconds, or (0) for no total rule.
+/// @retval Functions Status, (Uart_BUSY) if a Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Set_RX_Timeouts(USART_Struct *USARTx , u32 Copy_Gap_us , u32 Copy_Total_us);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_RX_Tick : this function checks the gap (longer than one element time) and the total time of the
+///                             Interrupt Reception, it is called periodically by the STK timer, as the USART of the
+///                             STM32F4 has no Receive timeout; the IDLE gap and the polling Reception do not need it.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @retval Functions Status, (Uart_TIMEOUT) if the Reception is ended by this call.
+Uart_Fun_Status	    MCAL_UART_RX_Tick(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_RX_RING == Enable
+/// @brief  MCAL_UART_Receive_Ring : this function starts the continuous Reception of the port into a ring by the Interrupt,
+///                                  it goes on till MCAL_UART_Ring_Stop, the elements with an error are dropped.
+/// @param  USARTx                 : the Struct of the initialized Peripheral.
+/// @param  Copy_Buffer            : the ring, it holds (Copy_Size - 1) elements.
+/// @param  Copy_Size              : the size of the ring.
+/// @retval Functions Status, (Uart_BUSY) if a Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Receive_Ring(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Ring_Peek : this function gives the Received elements in their place, the oldest first, as two spans
+///                               (the second one is the part after the ring end), they stay valid till they are consumed.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @param  Copy_Spans          : pointer to two spans.
+/// @param  Copy_Count          : pointer to hold the number of all the Received elements (the sum of the spans).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Ring_Peek(USART_Struct *USARTx , USART_RX_Span Copy_Spans[2] , u16 *Copy_Count);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Ring_Consume : this function gives the place of the oldest elements back to the Reception.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Count             : the number of the read elements.
+/// @retval Functions Status, (Uart_ERROR) if it is more than the Received elements.
+Uart_Fun_Status	    MCAL_UART_Ring_Consume(USART_Struct *USARTx , u16 Copy_Count);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Ring_Stop : this function stops the ring Reception.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @param  Copy_Drops          : pointer to hold the number of the dropped elements, or NULL.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Ring_Stop(USART_Struct *USARTx , u32 *Copy_Drops);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_SELF_TEST == Enable
+/// @brief  MCAL_UART_Set_Loopback : this function connects the TX and the RX lines inside the Peripheral (the half-duplex
+///                                  mode), every Transmitted element is Received by the same port. The TX pin is the
+///                                  line (an open-drain pin with a pull-up), no wire is needed.
+/// @param  USARTx                 : the Struct of the initialized Peripheral.
+/// @param  Copy_State             : (Enable) or (Disable).
+/// @retval Functions Status, (Uart_BUSY) if a Transmission or the Reception of a frame is in progress.
+Uart_Fun_Status	    MCAL_UART_Set_Loopback(USART_Struct *USARTx , u8 Copy_State);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Receive_Abort : this function stops the Reception of MCAL_UART_Receive_INT without its callback, and
+///                                   drops the element that is not read (so its error flags are cleared).
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @retval Functions Status, (Uart_ERROR) for the ring, the Modbus and the pool Receptions, they have their own stop.
+Uart_Fun_Status	    MCAL_UART_Receive_Abort(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_POOL == Enable
+/// @brief  MCAL_UART_Pool_Alloc : this function takes a free frame block of (POOL_BLOCK_SIZE) elements, it can be
+///                                called by the application and by the Interrupts.
+/// @retval pointer to the block, or NULL if all the blocks are used.
+u8 *	            MCAL_UART_Pool_Alloc(void);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Pool_Free : this function gives a frame block back to the pool, it can be called by the
+///                               application and by the Interrupts.
+/// @param  Copy_Block          : pointer to the block.
+/// @retval Functions Status, (Uart_ERROR) if it is not a used block of the pool.
+Uart_Fun_Status	    MCAL_UART_Pool_Free(u8 *Copy_Block);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Pool_Free_Blocks : this function gets the number of the free blocks.
+/// @retval the number of the free blocks.
+u8	                MCAL_UART_Pool_Free_Blocks(void);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Receive_Pool : this function starts a continuous Interrupt Reception into the pool blocks, the
+///                                  block of every Received frame waits for the application and the Reception goes on
+///                                  in a new block, so the frames are not copied.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Last_element           : the last element of the frames.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Receive_Pool(USART_Struct *USARTx , u8 Last_element);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Pool_Get_Frame : this function takes the oldest Received block of the port, the application owns
+///                                    it and gives it back by MCAL_UART_Pool_Free or MCAL_UART_Transmit_Pool.
+/// @param  USARTx                   : the Struct of Peripheral's Registers.
+/// @param  Copy_Size                : pointer to hold the frame size with its last element.
+/// @retval pointer to the block, or NULL if no frame is waiting.
+u8 *	            MCAL_UART_Pool_Get_Frame(USART_Struct *USARTx , u16 *Copy_Size);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Transmit_Pool : this function Transmits a pool block by the Interrupt, the driver owns the block
+///                                   and frees it at the end of the Transmission.
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @param  Copy_Block              : pointer to the block.
+/// @param  Size                    : the size of the frame in the block.
+/// @param  Last_element            : the last element that should be Transmitted.
+/// @retval Functions Status, the block stays with the caller only for (Uart_BUSY) and (Uart_ERROR).
+Uart_Fun_Status	    MCAL_UART_Transmit_Pool(USART_Struct *USARTx , u8 *Copy_Block , u16 Size , u8 Last_element);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
+#if USART_TRACE == Enable
+/// @brief  MCAL_UART_Trace_Control : this function starts or stops the recording of the events, it is stopped to keep
+///                                   the records of a fault.
+/// @param  Copy_State              : (Enable) or (Disable).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Trace_Control(u8 Copy_State);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Trace_Read : this function copies the trace records, the oldest first.
+/// @param  Copy_Records         : the buffer of the records.
+/// @param  Copy_Max             : the number of the records in the buffer.
+/// @retval the number of the copied records.
+u16	                MCAL_UART_Trace_Read(USART_Trace_Record *Copy_Records , u16 Copy_Max);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+/// @brief  MCAL_UART_Trace_Dump : this function stops the recording and sends the records, the oldest first, as hex text
+///                                lines (16 digits each) by writing the DR register directly, so it works from a fault
+///                                handler or with a wedged port, the host decoder is (trace_decode.py).
+/// @param  USARTx               : the Struct of the initialized Peripheral.
+/// @retval Functions Status, (Uart_TIMEOUT) if the (TXE) flag is not set in two element times (the dump stops).
+Uart_Fun_Status	    MCAL_UART_Trace_Dump(USART_Struct *USARTx);
+/*---------------------------------------------------------------------------------------------------------------------------------------------------*/
+#endif
 #endif
\ No newline at end of file
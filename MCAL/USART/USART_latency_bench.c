@@ -0,0 +1,174 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the end-to-end latency bench of the host model (USART_POSIX)	*/
+/********************************************************************************************/
+/*	USART1 Transmits frames by MCAL_UART_Transmit_INT to USART2 over a pseudo-terminal pair,	*/
+/*	USART2 Receives them by MCAL_UART_Receive_INT, the latency is the time from the start of	*/
+/*	the Transmission to the RX callback, it is given with the wire time of the frame, so the	*/
+/*	overhead is the model and the handlers. the rows are CSV :								*/
+/*	baud,frame_size,frames,wire_us,mean_us,p50_us,p99_us,max_us,overhead_us,lost			*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -O2 -DUSART_POSIX=Enable -I. -IMCAL/USART MCAL/USART/USART_program.c		*/
+/*	    MCAL/USART/USART_posix.c MCAL/USART/USART_latency_bench.c -lpthread					*/
+/*	run : ./a.out [frames]																	*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     BENCH_MAX_FRAMES        1000U
+#define     BENCH_MAX_SIZE          256U
+/*	the wait of one frame, a longer one is a lost frame	*/
+#define     BENCH_TIMEOUT_NS        2000000000ULL
+/********************************************************************************************/
+static USART_Struct     Bench_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Bench_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Bench_TX_Frame[BENCH_MAX_SIZE];
+static u8               Bench_RX_Frame[BENCH_MAX_SIZE];
+static u64              Bench_Latency[BENCH_MAX_FRAMES];
+static volatile u64     Bench_RX_Ns;
+static volatile u8      Bench_TX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Bench_Now_Ns : it gives the monotonic time.
+/// @return the time in nanoseconds.
+static u64 Bench_Now_Ns(void)
+{
+    struct timespec Local_Time;
+    clock_gettime(CLOCK_MONOTONIC, &Local_Time);
+    return ((u64)Local_Time.tv_sec * 1000000000ULL) + (u64)Local_Time.tv_nsec;
+}
+
+
+/// @brief  Bench_RX_End : the RX callback, it keeps the end time of the Reception.
+/// @return None.
+static void Bench_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Bench_RX_Ns, Bench_Now_Ns(), __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Bench_TX_End : the TX callback.
+/// @return None.
+static void Bench_TX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Bench_TX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Bench_Compare : it orders two latencies.
+static int Bench_Compare(const void *Copy_A , const void *Copy_B)
+{
+    u64 Local_A = *(const u64 *)Copy_A;
+    u64 Local_B = *(const u64 *)Copy_B;
+    return (Local_A > Local_B) - (Local_A < Local_B);
+}
+
+
+/// @brief  Bench_Run    : it sends the frames of one size and prints their row.
+/// @param  Copy_Baud    : the Baud rate.
+/// @param  Copy_Size    : the frame size, with its last element.
+/// @param  Copy_Frames  : the number of the frames.
+/// @return None.
+static void Bench_Run(u32 Copy_Baud , u16 Copy_Size , u16 Copy_Frames)
+{
+    u16 Local_Index, Local_Done = 0, Local_Lost = 0;
+    u64 Local_Start, Local_Sum = 0;
+    struct timespec Local_Pause = { 0, 20000L };
+
+    memset(Bench_TX_Frame, 'A', Copy_Size);
+    Bench_TX_Frame[Copy_Size - 1U] = '\n';
+    for (Local_Index = 0; Local_Index < Copy_Frames; Local_Index++)
+    {
+        Bench_RX_Ns   = 0;
+        Bench_TX_Done = 0;
+        (void)MCAL_UART_Receive_INT(&Bench_RX, Bench_RX_Frame, BENCH_MAX_SIZE, '\n');
+        Local_Start = Bench_Now_Ns();
+        if (MCAL_UART_Transmit_INT(&Bench_TX, Bench_TX_Frame, Copy_Size, '\n') != Uart_OK)
+        {
+            Local_Lost++;
+            continue;
+        }
+        while (((__atomic_load_n(&Bench_RX_Ns, __ATOMIC_ACQUIRE) == 0) || (Bench_TX_Done == 0)) &&
+               ((Bench_Now_Ns() - Local_Start) < BENCH_TIMEOUT_NS))
+        {
+            nanosleep(&Local_Pause, NULL);
+        }
+        if ((Bench_RX_Ns == 0) || (Bench_TX_Done == 0) || (memcmp(Bench_RX_Frame, Bench_TX_Frame, Copy_Size) != 0))
+        {
+#if USART_SELF_TEST == Enable
+            // the Reception is stopped, so the next frame starts from its first element.
+            (void)MCAL_UART_Receive_Abort(&Bench_RX);
+#endif
+            Local_Lost++;
+            continue;
+        }
+        Bench_Latency[Local_Done] = Bench_RX_Ns - Local_Start;
+        Local_Sum += Bench_Latency[Local_Done];
+        Local_Done++;
+    }
+    // 10 bits of an (8N1) element.
+    u64 Local_Wire_Ns = ((u64)Copy_Size * 10ULL * 1000000000ULL) / Copy_Baud;
+    if (Local_Done == 0)
+    {
+        printf("%lu,%u,%u,%.1f,,,,,,%u\n", (unsigned long)Copy_Baud, Copy_Size, Copy_Frames, Local_Wire_Ns / 1000.0, Local_Lost);
+        return;
+    }
+    qsort(Bench_Latency, Local_Done, sizeof(u64), Bench_Compare);
+    u64 Local_Mean = Local_Sum / Local_Done;
+    printf("%lu,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%u\n", (unsigned long)Copy_Baud, Copy_Size, Copy_Frames,
+           Local_Wire_Ns / 1000.0, Local_Mean / 1000.0, Bench_Latency[Local_Done / 2U] / 1000.0,
+           Bench_Latency[(Local_Done * 99U) / 100U] / 1000.0, Bench_Latency[Local_Done - 1U] / 1000.0,
+           ((double)Local_Mean - (double)Local_Wire_Ns) / 1000.0, Local_Lost);
+}
+
+
+int main(int argc , char *argv[])
+{
+    static const u32 Local_Bauds[] = { 115200UL, 460800UL, 921600UL };
+    static const u16 Local_Sizes[] = { 1U, 16U, 64U, 256U };
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    char Local_Name[64];
+    u16  Local_Frames = (argc > 1) ? (u16)atoi(argv[1]) : 100U;
+    u8   Local_Baud, Local_Size;
+
+    if ((Local_Frames == 0) || (Local_Frames > BENCH_MAX_FRAMES)){ Local_Frames = 100U; }
+    if ((MCAL_UART_Posix_Pty(&Bench_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Bench_RX, Local_Name) != Uart_OK))
+    {
+        fprintf(stderr, "no pseudo-terminal\n");
+        return 1;
+    }
+    printf("baud,frame_size,frames,wire_us,mean_us,p50_us,p99_us,max_us,overhead_us,lost\n");
+    for (Local_Baud = 0; Local_Baud < (sizeof(Local_Bauds) / sizeof(Local_Bauds[0])); Local_Baud++)
+    {
+        (void)MCAL_UART_Init_(&Bench_TX, &Local_Frame, &Local_Receiving, Local_Bauds[Local_Baud]);
+        (void)MCAL_UART_Init_(&Bench_RX, &Local_Frame, &Local_Receiving, Local_Bauds[Local_Baud]);
+        (void)MCAL_UART_Enable(&Bench_TX);
+        (void)MCAL_UART_Enable(&Bench_RX);
+        // MCAL_UART_Init_ clears the callbacks.
+        (void)MCAL_UART_TX_CALLBACK(&Bench_TX, Bench_TX_End);
+        (void)MCAL_UART_RX_CALLBACK(&Bench_RX, Bench_RX_End);
+        for (Local_Size = 0; Local_Size < (sizeof(Local_Sizes) / sizeof(Local_Sizes[0])); Local_Size++)
+        {
+            Bench_Run(Local_Bauds[Local_Baud], Local_Sizes[Local_Size], Local_Frames);
+        }
+    }
+    (void)MCAL_UART_Posix_Close(&Bench_RX);
+    (void)MCAL_UART_Posix_Close(&Bench_TX);
+    return 0;
+}
+#endif
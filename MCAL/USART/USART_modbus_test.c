@@ -0,0 +1,224 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Modbus RTU mode, it runs on the		*/
+/*					   host model of the USART driver (USART_POSIX)							*/
+/********************************************************************************************/
+/*	both ports have a CRC-32 configuration before the Modbus mode, USART2 checks the CRC	*/
+/*	text of its frames. in the Modbus mode USART1 sends a request, USART2 answers it, then	*/
+/*	USART1 sends a frame with a wrong CRC and a second request. the test checks the frames,	*/
+/*	the Modbus statistics and the CRC type of the mode. after MCAL_UART_Modbus_Stop, the	*/
+/*	test checks that the CRC configuration is given back and that a frame with the CRC text	*/
+/*	is checked by it.																		*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_CRC=Enable -DUSART_MODBUS=Enable -I.		*/
+/*	    -IMCAL/USART MCAL/USART/USART_program.c MCAL/USART/USART_posix.c					*/
+/*	    MCAL/USART/USART_modbus_test.c -lpthread											*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if (USART_MODBUS == Disable) || (USART_CRC == Disable)
+#error "the test runs the Modbus mode and the CRC text frames, so it is built with USART_MODBUS and USART_CRC"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_BAUD               115200UL
+#define     TEST_FRAME_SIZE         32U
+/*	the longest wait of a frame, in pauses (100 us)	*/
+#define     TEST_WAITS              1000U
+/*	the silence after the frame with a wrong CRC, longer than t1.5	*/
+#define     TEST_SILENCE_MS         10L
+/********************************************************************************************/
+static USART_Struct     Test_Master = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_Slave  = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Test_Master_Buffer[2U * TEST_FRAME_SIZE];
+static u8               Test_Slave_Buffer[2U * TEST_FRAME_SIZE];
+static u8               Test_Text_Frame[TEST_FRAME_SIZE];
+static volatile u8      Test_RX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Test_RX_End  : the RX callback of USART2.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_Pause   : it waits one pause (100 us).
+/// @return None.
+static void Test_Pause(void)
+{
+    struct timespec Local_Pause = { 0, 100000L };
+
+    nanosleep(&Local_Pause, NULL);
+}
+
+
+/// @brief  Test_Send    : it sends a Modbus frame, it waits for the t3.5 silence and the end of the last Transmission.
+/// @param  USARTx       : the Struct of the sender.
+/// @param  Copy_Frame   : the frame, with two more elements for the CRC.
+/// @param  Copy_Size    : the frame size without its CRC.
+/// @return (1) if the frame is sent, (0) if not.
+static u8 Test_Send(USART_Struct *USARTx , u8 *Copy_Frame , u16 Copy_Size)
+{
+    u16 Local_Wait;
+
+    for (Local_Wait = 0; Local_Wait < TEST_WAITS; Local_Wait++)
+    {
+        if (MCAL_UART_Modbus_Send(USARTx, Copy_Frame, Copy_Size) == Uart_OK){ return 1; }
+        Test_Pause();
+    }
+    return 0;
+}
+
+
+/// @brief  Test_Expect  : it waits for a Modbus frame and compares it.
+/// @param  USARTx       : the Struct of the Receiver.
+/// @param  Copy_Frame   : the expected frame.
+/// @param  Copy_Size    : the frame size without its CRC.
+/// @param  Copy_Name    : the frame name of the messages.
+/// @return (1) if the frame is received, (0) if not.
+static u8 Test_Expect(USART_Struct *USARTx , const u8 *Copy_Frame , u16 Copy_Size , const char *Copy_Name)
+{
+    u8  *Local_Frame;
+    u16  Local_Size = 0;
+    u16  Local_Wait;
+
+    for (Local_Wait = 0; Local_Wait < TEST_WAITS; Local_Wait++)
+    {
+        if (MCAL_UART_Modbus_Get_Frame(USARTx, &Local_Frame, &Local_Size) == Uart_OK)
+        {
+            if ((Local_Size == Copy_Size) && (memcmp(Local_Frame, Copy_Frame, Copy_Size) == 0)){ return 1; }
+            break;
+        }
+        Test_Pause();
+    }
+    printf("FAIL : the %s is not received (size %u)\n", Copy_Name, Local_Size);
+    return 0;
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    // read three holding registers of the slave 0x11 from 0x006B, and its answer.
+    u8   Local_Request[8]  = { 0x11, 0x03, 0x00, 0x6B, 0x00, 0x03 };
+    u8   Local_Answer[11]  = { 0x11, 0x03, 0x06, 0xAE, 0x41, 0x56, 0x52, 0x43, 0x40 };
+    u8   Local_Request2[8] = { 0x11, 0x06, 0x00, 0x01, 0x00, 0x03 };
+    u8   Local_Bad[8]      = { 0x11, 0x03, 0x00, 0x6B, 0x00, 0x03, 0x00, 0x00 };
+    u8   Local_Text[]      = "MODBUS OFF\n";
+    USART_Modbus_Stats Local_Stats;
+    struct timespec Local_Silence = { 0, TEST_SILENCE_MS * 1000000L };
+    char Local_Name[64];
+    u16  Local_Wait, Local_CRC;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_Master, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_Slave, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_Master, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_Slave, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_Master);
+    (void)MCAL_UART_Enable(&Test_Slave);
+    (void)MCAL_UART_CRC_Config(&Test_Master, Uart_CRC_32, Disable);
+    (void)MCAL_UART_CRC_Config(&Test_Slave, Uart_CRC_32, Enable);
+
+    // the Modbus mode has its own CRC-16 and no CRC text.
+    if ((MCAL_UART_Modbus_Start(&Test_Master, Test_Master_Buffer, TEST_FRAME_SIZE) != Uart_OK) ||
+        (MCAL_UART_Modbus_Start(&Test_Slave, Test_Slave_Buffer, TEST_FRAME_SIZE) != Uart_OK))
+    {
+        printf("FAIL : MCAL_UART_Modbus_Start\n");
+        return 1;
+    }
+    if ((Test_Slave.CRC_Type != Uart_CRC_16) || (Test_Slave.RX_CRC_Check != Disable))
+    {
+        printf("FAIL : the Modbus mode does not select its CRC\n");
+        Local_Pass = 0;
+    }
+    if ((Test_Send(&Test_Master, Local_Request, 6U) == 0) || (Test_Expect(&Test_Slave, Local_Request, 6U, "request") == 0))
+    {
+        Local_Pass = 0;
+    }
+    if ((Test_Send(&Test_Slave, Local_Answer, 9U) == 0) || (Test_Expect(&Test_Master, Local_Answer, 9U, "answer") == 0))
+    {
+        Local_Pass = 0;
+    }
+    // the frame with a wrong CRC stays open till the silence after it is longer than t1.5.
+    Local_CRC = (u16)MCAL_UART_CRC_Block(Uart_CRC_16, Local_Bad, 6U) ^ 0x0001U;
+    Local_Bad[6] = (u8)(Local_CRC & 0xFF);
+    Local_Bad[7] = (u8)(Local_CRC >> 8);
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (MCAL_UART_Transmit_INT(&Test_Master, Local_Bad, 8U, 0) != Uart_OK); Local_Wait++)
+    {
+        Test_Pause();
+    }
+    nanosleep(&Local_Silence, NULL);
+    if ((Test_Send(&Test_Master, Local_Request2, 6U) == 0) || (Test_Expect(&Test_Slave, Local_Request2, 6U, "second request") == 0))
+    {
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Modbus_Get_Stats(&Test_Slave, &Local_Stats);
+    printf("slave : %lu frames, %lu CRC errors, %lu gap errors, %lu damaged, %lu overwritten\n",
+           (unsigned long)Local_Stats.Frames, (unsigned long)Local_Stats.CRC_Errors, (unsigned long)Local_Stats.Gap_Errors,
+           (unsigned long)Local_Stats.Damaged, (unsigned long)Local_Stats.Overwritten);
+    if ((Local_Stats.Frames != 2U) || (Local_Stats.CRC_Errors != 1U) || (Local_Stats.Gap_Errors != 0) || (Local_Stats.Damaged != 0))
+    {
+        printf("FAIL : the Modbus statistics of the slave\n");
+        Local_Pass = 0;
+    }
+
+    // the CRC configuration of the ports before the Modbus mode is given back.
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (MCAL_UART_Modbus_Stop(&Test_Master) != Uart_OK); Local_Wait++)
+    {
+        Test_Pause();
+    }
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (MCAL_UART_Modbus_Stop(&Test_Slave) != Uart_OK); Local_Wait++)
+    {
+        Test_Pause();
+    }
+    if ((Test_Master.CRC_Type != Uart_CRC_32) || (Test_Master.RX_CRC_Check != Disable) ||
+        (Test_Slave.CRC_Type != Uart_CRC_32) || (Test_Slave.RX_CRC_Check != Enable))
+    {
+        printf("FAIL : MCAL_UART_Modbus_Stop does not give the CRC configuration back\n");
+        Local_Pass = 0;
+    }
+    // a frame with the CRC-32 text is checked by the configuration that is given back.
+    (void)MCAL_UART_RX_CALLBACK(&Test_Slave, Test_RX_End);
+    Test_RX_Done = 0;
+    if ((MCAL_UART_Receive_INT(&Test_Slave, Test_Text_Frame, TEST_FRAME_SIZE, '\n') != Uart_OK) ||
+        (MCAL_UART_Transmit_CRC_INT(&Test_Master, Local_Text, (u16)(sizeof(Local_Text) - 1U), '\n') != Uart_OK))
+    {
+        printf("FAIL : the CRC text frame does not start\n");
+        Local_Pass = 0;
+    }
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+    {
+        Test_Pause();
+    }
+    if ((Test_RX_Done == 0) || (MCAL_UART_CRC_Check(&Test_Slave) != Uart_OK))
+    {
+        printf("FAIL : the CRC text frame is not checked after the Modbus mode\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_Slave);
+    (void)MCAL_UART_Posix_Close(&Test_Master);
+    printf("%s : Modbus loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,179 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the frame block pool, it runs on the	*/
+/*					   host model of the USART driver (USART_POSIX)							*/
+/********************************************************************************************/
+/*	USART1 sends a good frame, a frame longer than a block, a good frame, a frame with a	*/
+/*	frame error on every element (the noise model of USART2) and a good frame to USART2,	*/
+/*	that Receives them into the pool blocks. in the strict and in the resilient modes, the	*/
+/*	test checks that only the three good frames are queued, in one piece and in order, and	*/
+/*	that the blocks go back to the pool.													*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_POOL=Enable -I. -IMCAL/USART				*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_pool_test.c		*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_POOL == Disable
+#error "the test Receives into the pool blocks, so it is built with USART_POOL"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_GOOD_SIZE          10U
+#define     TEST_LONG_SIZE          (POOL_BLOCK_SIZE + 8U)
+#define     TEST_BAUD               115200UL
+/*	the time limit of the Blocking Transmission, in STK ticks	*/
+#define     TEST_TX_LIMIT           100000UL
+/*	the time of a frame to go through the model, in milli seconds	*/
+#define     TEST_SETTLE_MS          10L
+/********************************************************************************************/
+static USART_Struct     Test_TX;
+static USART_Struct     Test_RX;
+static u8               Test_Good[3][TEST_GOOD_SIZE];
+static u8               Test_Long[TEST_LONG_SIZE];
+static u8               Test_Damaged[TEST_GOOD_SIZE];
+/********************************************************************************************/
+
+
+/// @brief  Test_Fill    : it fills a frame by its tag, the last element is the frame boundary.
+/// @param  Copy_Frame   : the frame.
+/// @param  Copy_Size    : the frame size.
+/// @param  Copy_Tag     : the first element.
+/// @return None.
+static void Test_Fill(u8 *Copy_Frame , u16 Copy_Size , u8 Copy_Tag)
+{
+    u16 Local_Index;
+
+    for (Local_Index = 0; Local_Index < (Copy_Size - 1U); Local_Index++)
+    {
+        Copy_Frame[Local_Index] = (u8)(Copy_Tag + (Local_Index % 32U));
+    }
+    Copy_Frame[Copy_Size - 1U] = '\n';
+}
+
+
+/// @brief  Test_Send    : it sends a frame by the Blocking mode and waits for it to go through the model.
+/// @param  Copy_Frame   : the frame.
+/// @param  Copy_Size    : the frame size.
+/// @return None.
+static void Test_Send(u8 *Copy_Frame , u16 Copy_Size)
+{
+    struct timespec Local_Settle = { 0, TEST_SETTLE_MS * 1000000L };
+
+    (void)MCAL_UART_Transmit(&Test_TX, Copy_Frame, Copy_Size, TEST_TX_LIMIT, '\n');
+    nanosleep(&Local_Settle, NULL);
+}
+
+
+/// @brief  Test_Run     : it sends the frames in one Receive mode and checks the queued ones.
+/// @param  Copy_Mode    : the Receive Error policy of USART2.
+/// @return (1) if the test passes, (0) if not.
+static u8 Test_Run(Uart_RX_Mode Copy_Mode)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    USART_Noise_Model       Local_Noise     = { 0, 1000000UL, 0, 0x1234U, 1 };
+    const char *Local_Name_Mode = (Copy_Mode == RX_Strict_Mode) ? "strict" : "resilient";
+    char Local_Name[64];
+    u8  *Local_Block;
+    u16  Local_Size;
+    u8   Local_Free, Local_Index, Local_Pass = 1;
+
+    // every run has a new line and idle ports.
+    memset(&Test_TX, 0, sizeof(Test_TX));
+    memset(&Test_RX, 0, sizeof(Test_RX));
+    Test_TX.USART_x    = USART1_R;
+    Test_TX.Time_Limit = 1000;
+    Test_RX.USART_x    = USART2_R;
+    Test_RX.Time_Limit = 1000;
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 0;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_Set_RX_Mode(&Test_RX, Copy_Mode);
+    Local_Free = MCAL_UART_Pool_Free_Blocks();
+    if (MCAL_UART_Receive_Pool(&Test_RX, '\n') != Uart_OK)
+    {
+        printf("FAIL : MCAL_UART_Receive_Pool\n");
+        return 0;
+    }
+
+    Test_Send(Test_Good[0], TEST_GOOD_SIZE);
+    Test_Send(Test_Long, TEST_LONG_SIZE);
+    Test_Send(Test_Good[1], TEST_GOOD_SIZE);
+    (void)MCAL_UART_Posix_Noise(&Test_RX, &Local_Noise);
+    Test_Send(Test_Damaged, TEST_GOOD_SIZE);
+    (void)MCAL_UART_Posix_Noise(&Test_RX, NULL);
+    Test_Send(Test_Good[2], TEST_GOOD_SIZE);
+
+    for (Local_Index = 0; Local_Index < 3U; Local_Index++)
+    {
+        Local_Block = MCAL_UART_Pool_Get_Frame(&Test_RX, &Local_Size);
+        if ((Local_Block == NULL) || (Local_Size != TEST_GOOD_SIZE) || (memcmp(Local_Block, Test_Good[Local_Index], TEST_GOOD_SIZE) != 0))
+        {
+            printf("FAIL : %s, the good frame %u is not the queued frame %u (size %u)\n", Local_Name_Mode, Local_Index,
+                   Local_Index, (Local_Block == NULL) ? 0U : Local_Size);
+            Local_Pass = 0;
+        }
+        if (Local_Block != NULL){ (void)MCAL_UART_Pool_Free(Local_Block); }
+    }
+    if (MCAL_UART_Pool_Get_Frame(&Test_RX, &Local_Size) != NULL)
+    {
+        printf("FAIL : %s, a damaged or a cut frame is queued (size %u)\n", Local_Name_Mode, Local_Size);
+        Local_Pass = 0;
+    }
+    // the strict mode ends the Receptions of the damaged frames, the resilient mode drops them in the Reception.
+    if (((Copy_Mode == RX_Strict_Mode) && (Test_RX.RX_Pool_Drops < 2U)) ||
+        ((Copy_Mode == RX_Resilient_Mode) && (Test_RX.RX_Errors.Damaged_Frames != 2U)))
+    {
+        printf("FAIL : %s, the damaged frames are not counted (%lu drops, %lu damaged)\n", Local_Name_Mode,
+               (unsigned long)Test_RX.RX_Pool_Drops, (unsigned long)Test_RX.RX_Errors.Damaged_Frames);
+        Local_Pass = 0;
+    }
+    // only the block of the Reception in progress is used.
+    if (MCAL_UART_Pool_Free_Blocks() != (u8)(Local_Free - 1U))
+    {
+        printf("FAIL : %s, %u blocks are lost\n", Local_Name_Mode, (u8)(Local_Free - 1U - MCAL_UART_Pool_Free_Blocks()));
+        Local_Pass = 0;
+    }
+    printf("%s : %lu pool drops, %lu damaged frames\n", Local_Name_Mode, (unsigned long)Test_RX.RX_Pool_Drops,
+           (unsigned long)Test_RX.RX_Errors.Damaged_Frames);
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    return Local_Pass;
+}
+
+
+int main(void)
+{
+    u8 Local_Pass = 1;
+
+    Test_Fill(Test_Good[0], TEST_GOOD_SIZE, 'A');
+    Test_Fill(Test_Good[1], TEST_GOOD_SIZE, 'a');
+    Test_Fill(Test_Good[2], TEST_GOOD_SIZE, '0');
+    Test_Fill(Test_Long,    TEST_LONG_SIZE, 'A');
+    Test_Fill(Test_Damaged, TEST_GOOD_SIZE, 'K');
+    Local_Pass &= Test_Run(RX_Strict_Mode);
+    Local_Pass &= Test_Run(RX_Resilient_Mode);
+    printf("%s : POOL loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,1040 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V2.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the host model of the USART Peripherals, it is built with the	*/
+/*					   Program file on Linux, the lines are termios ports or pseudo-terminals	*/
+/********************************************************************************************/
+/*	the recursive mutex initializer, (ptsname_r) and (epoll) are GNU extensions, so it is	*/
+/*	defined before the first system header (the LIB headers may include one).				*/
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#include "LMCAL/01_STK/STK_interface.h"
+
+#if USART_POSIX == Enable
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+/*	(termios.h) names the carriage return delays CR1, CR2 and CR3, here they are the registers.	*/
+#undef      CR1
+#undef      CR2
+#undef      CR3
+/********************************************************************************************/
+/*	the model thread is the hardware : it shifts the written elements out at the Baud rate	*/
+/*	of the (BRR) and (CR) registers, it gives the Received elements to (DR) one element time	*/
+/*	apart, it sets the (SR) flags, then it calls the USARTx_IRQHandler of a Peripheral while	*/
+/*	one of its enabled Interrupts is pending.												*/
+/*	two locks are used : the Interrupt lock is the PRIMASK (a recursive one, the handlers	*/
+/*	are called with it and the critical sections of the Program file take it), the model	*/
+/*	lock keeps the model state and the (SR) updates, it is taken briefly by the register		*/
+/*	hooks, the model thread does not wait for the Interrupt lock while it holds it.			*/
+/********************************************************************************************/
+typedef struct{
+
+	u8				 Element;					/*	 		The Received element						 		  */
+	u8				 Error;						/*	 		The parity error mark of the element		 		  */
+
+}POSIX_RX_Element;
+
+typedef struct{
+
+	int				 Fd;						/*	 		The file descriptor of the line, or (-1)	 		  */
+	int				 Pty_Slave;					/*	 The slave side of a pseudo-terminal, kept open (no hang-up) */
+	u8				 Is_Tty;					/*	 	The line is a termios port (its frame is set)		  */
+	u8				 Hang_Up;					/*	 		The line gave a hang-up event				 		  */
+	u8				 Hung;						/*	 		The line is closed by its other side		 		  */
+	u32				 Events;					/*	 		The (epoll) events of the line				 		  */
+	u32				 Applied_CR1;				/*	 		The (CR1) register of the termios frame		 		  */
+	u32				 Applied_CR2;				/*	 		The (CR2) register of the termios frame		 		  */
+	u32				 Applied_BRR;				/*	 		The (BRR) register of the termios frame		 		  */
+	u8				 TX_Shift_Full;				/*	 		An element is in the shift register			 		  */
+	u8				 TDR_Full;					/*	 		An element waits in the (TDR) register		 		  */
+	u8				 TX_Held;					/*	 	The shifted element waits for the line (EAGAIN)	  */
+	u16				 TX_Shift;					/*	 		The element of the shift register			 		  */
+	u16				 TDR;						/*	 		The element of the (TDR) register			 		  */
+	u64				 TX_Done_Ns;				/*	 		The end time of the shifted element			 		  */
+	POSIX_RX_Element RX_Queue[POSIX_PENDING_SIZE];
+	u16				 RX_In;						/*	 		The next free place of the queue			 		  */
+	u16				 RX_Out;					/*	 		The next element of the queue				 		  */
+	u16				 RX_Count;					/*	 		The number of the waiting elements			 		  */
+	u64				 RX_Last_End;				/*	 		The time of the last given element			 		  */
+	u8				 Idle_Armed;				/*	 	An element was given since the last (IDLE) flag		  */
+	u8				 Mark_State;				/*	 		The state of the parity error mark			 		  */
+	u8				 Overrun;					/*	 	An element was lost, the next one has the (ORE) bit	  */
+	u8				 Noise_On;					/*	 		The noise model is used						 		  */
+	u8				 Burst_Left;				/*	 	The bits left of the current error burst			  */
+	u32				 Noise_State;				/*	 		The state of the random numbers				 		  */
+	USART_Noise_Model Noise;					/*	 		The noise model of the Received elements	 		  */
+
+}POSIX_Port;
+/********************************************************************************************/
+#define     POSIX_WAKE_ID           0xFFFFFFFFUL
+#define     POSIX_TIMER_ID          0xFFFFFFFEUL
+/*	the PARMRK sequence of a parity error is (0xFF 0x00 element), a (0xFF) element is doubled	*/
+#define     POSIX_MARK_NONE         0U
+#define     POSIX_MARK_FF           1U
+#define     POSIX_MARK_ERROR        2U
+/*	the handler calls without a wait, then the pending Interrupts are checked again after a pause	*/
+#define     POSIX_IRQ_ROUNDS        8U
+#define     POSIX_IRQ_PAUSE_NS      50000ULL
+/*	the retry time of the Interrupt lock, it is held by a critical section of the application	*/
+#define     POSIX_IRQ_RETRY_NS      20000ULL
+/*	the longest wait that is a spin, not a sleep	*/
+#define     POSIX_SPIN_NS           200000ULL
+/*	the (IDLE) flag waits this time more than one element time, as the Handler of the sender on the host loads the	*/
+/*	next element of a burst later than the hardware (a silence of the host, not of the line)						*/
+#define     POSIX_IDLE_SLACK_NS     1000000ULL
+/*	the (SR) flags of a Received element, they are cleared by the (SR) then (DR) reads			*/
+#define     POSIX_RX_FLAGS          ((1UL << __RXNE__) | (1UL << __PE__) | (1UL << __FE__) | (1UL << __NE__) | \
+                                     (1UL << __ORE__)  | (1UL << __IDLE__))
+/********************************************************************************************/
+/*	the reset value of (SR) has the (TXE) and (TC) flags.	*/
+MUSART_peri UART_Posix_Peri[POSIX_PERI_NUM] = { { .SR = 0xC0U }, { .SR = 0xC0U }, { .SR = 0xC0U } };
+__thread u32 UART_Posix_Exclusive;
+
+extern void USART1_IRQHandler(void);
+extern void USART2_IRQHandler(void);
+extern void USART6_IRQHandler(void);
+static void (* const POSIX_Handlers[POSIX_PERI_NUM])(void) = { USART1_IRQHandler, USART2_IRQHandler, USART6_IRQHandler };
+
+static POSIX_Port       POSIX_Ports[POSIX_PERI_NUM] = { { .Fd = -1, .Pty_Slave = -1 }, { .Fd = -1, .Pty_Slave = -1 },
+                                                        { .Fd = -1, .Pty_Slave = -1 } };
+static pthread_mutex_t  POSIX_IRQ_Lock   = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+static pthread_mutex_t  POSIX_Lock       = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t   POSIX_Once       = PTHREAD_ONCE_INIT;
+static pthread_t        POSIX_Thread;
+static int              POSIX_Epoll      = -1;
+static int              POSIX_Wake       = -1;
+static int              POSIX_Timer      = -1;
+static __thread u8      POSIX_In_Model;
+/*	the STK timer of the thread, its ticks are (POSIX_TICK_US) long	*/
+static __thread u64     POSIX_STK_Start;
+static __thread u32     POSIX_STK_Ticks;
+/********************************************************************************************/
+static POSIX_Port      *POSIX_Find(USART_Struct *USARTx);
+static void             POSIX_Start(void);
+static void            *POSIX_Thread_Main(void *Copy_Arg);
+static u64              POSIX_Steps(void);
+static u64              POSIX_Step(u8 Copy_Index , u64 Copy_Now);
+static u8               POSIX_Interrupts(u8 *Copy_Busy);
+static void             POSIX_Sleep(u64 Copy_Deadline);
+static void             POSIX_Kick(void);
+static u64              POSIX_Now_Ns(void);
+static u64              POSIX_Element_Ns(const MUSART_peri *Copy_Peri);
+static void             POSIX_Apply_Frame(POSIX_Port *Copy_Port , const MUSART_peri *Copy_Peri);
+static speed_t          POSIX_Speed(u32 Copy_Baud);
+static void             POSIX_TX_Step(u8 Copy_Index , u64 Copy_Now , u64 Copy_Element_Ns);
+static u8               POSIX_TX_Line(u8 Copy_Index , u16 Copy_Element);
+static void             POSIX_RX_Read(POSIX_Port *Copy_Port , const MUSART_peri *Copy_Peri);
+static void             POSIX_RX_Add(POSIX_Port *Copy_Port , u8 Copy_Element , u8 Copy_Error);
+static u64              POSIX_RX_Step(u8 Copy_Index , u64 Copy_Now , u64 Copy_Element_Ns);
+static u8               POSIX_Add_Noise(POSIX_Port *Copy_Port , u8 Copy_Parity , u8 *Copy_Element , u32 *Copy_SR);
+static u8               POSIX_Chance(POSIX_Port *Copy_Port , u32 Copy_ppm);
+static void             POSIX_Set_Events(u8 Copy_Index);
+/********************************************************************************************/
+
+
+/// @brief  MCAL_UART_Posix_Open : this function gives a serial port (or the slave side of a pseudo-terminal) to the
+///                                line of the Peripheral, it is called before or after MCAL_UART_Init_.
+/// @param  USARTx               : the USART Struct, its USART_x is USART1_R, USART2_R or USART6_R.
+/// @param  Copy_Path            : the device path, like "/dev/ttyUSB0".
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Open(USART_Struct *USARTx , const char *Copy_Path)
+{
+    if ((POSIX_Find(USARTx) == NULL) || (Copy_Path == NULL)){ return  Uart_ERROR; }
+
+    int Local_Fd = open(Copy_Path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (Local_Fd < 0){ return Uart_ERROR; }
+    (void)pthread_once(&POSIX_Once, POSIX_Start);
+
+    pthread_mutex_lock(&POSIX_Lock);
+    POSIX_Port *Local_Port = POSIX_Find(USARTx);
+    if ((POSIX_Epoll < 0) || (Local_Port -> Fd >= 0))
+    {
+        pthread_mutex_unlock(&POSIX_Lock);
+        close(Local_Fd);
+        return Uart_ERROR;
+    }
+    Local_Port -> Fd          = Local_Fd;
+    Local_Port -> Is_Tty      = (u8)isatty(Local_Fd);
+    Local_Port -> Hung        = 0;
+    Local_Port -> Hang_Up     = 0;
+    Local_Port -> Events      = 0;
+    Local_Port -> Mark_State  = POSIX_MARK_NONE;
+    // the frame of the registers is given to the termios port by the next step.
+    Local_Port -> Applied_BRR = 0xFFFFFFFFUL;
+    (void)epoll_ctl(POSIX_Epoll, EPOLL_CTL_ADD, Local_Fd,
+                    &(struct epoll_event){ .events = 0, .data.u32 = (u32)(Local_Port - POSIX_Ports) });
+    pthread_mutex_unlock(&POSIX_Lock);
+    POSIX_Kick();
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Posix_Pty : this function gives a new pseudo-terminal to the line of the Peripheral, the other side
+///                               is opened by its name (by a host tool, or by MCAL_UART_Posix_Open of another Peripheral).
+/// @param  USARTx              : the USART Struct, its USART_x is USART1_R, USART2_R or USART6_R.
+/// @param  Copy_Name           : the buffer of the slave side name.
+/// @param  Copy_Size           : the size of the name buffer.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Pty(USART_Struct *USARTx , char *Copy_Name , u16 Copy_Size)
+{
+    if ((POSIX_Find(USARTx) == NULL) || (Copy_Name == NULL) || (Copy_Size == 0)){ return  Uart_ERROR; }
+
+    int Local_Fd = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (Local_Fd < 0){ return Uart_ERROR; }
+    if ((grantpt(Local_Fd) != 0) || (unlockpt(Local_Fd) != 0) || (ptsname_r(Local_Fd, Copy_Name, Copy_Size) != 0))
+    {
+        close(Local_Fd);
+        return Uart_ERROR;
+    }
+    // the slave side is kept open, so the master does not see a hang-up while the other side is closed.
+    int Local_Slave = open(Copy_Name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (Local_Slave >= 0)
+    {
+        // the slave side is a raw line, the elements are not changed by the line discipline.
+        struct termios Local_TIO;
+        if (tcgetattr(Local_Slave, &Local_TIO) == 0)
+        {
+            cfmakeraw(&Local_TIO);
+            (void)tcsetattr(Local_Slave, TCSANOW, &Local_TIO);
+        }
+    }
+    (void)pthread_once(&POSIX_Once, POSIX_Start);
+
+    pthread_mutex_lock(&POSIX_Lock);
+    POSIX_Port *Local_Port = POSIX_Find(USARTx);
+    if ((POSIX_Epoll < 0) || (Local_Port -> Fd >= 0))
+    {
+        pthread_mutex_unlock(&POSIX_Lock);
+        if (Local_Slave >= 0){ close(Local_Slave); }
+        close(Local_Fd);
+        return Uart_ERROR;
+    }
+    // the master side has no termios frame, the elements are given as they are.
+    Local_Port -> Fd          = Local_Fd;
+    Local_Port -> Pty_Slave   = Local_Slave;
+    Local_Port -> Is_Tty      = 0;
+    Local_Port -> Hung        = 0;
+    Local_Port -> Hang_Up     = 0;
+    Local_Port -> Events      = 0;
+    Local_Port -> Mark_State  = POSIX_MARK_NONE;
+    (void)epoll_ctl(POSIX_Epoll, EPOLL_CTL_ADD, Local_Fd,
+                    &(struct epoll_event){ .events = 0, .data.u32 = (u32)(Local_Port - POSIX_Ports) });
+    pthread_mutex_unlock(&POSIX_Lock);
+    POSIX_Kick();
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Posix_Close : this function closes the line of the Peripheral, the next Transmitted elements are
+///                                 lost as on a line without a Receiver.
+/// @param  USARTx                : the USART Struct.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Close(USART_Struct *USARTx)
+{
+    if (POSIX_Find(USARTx) == NULL){ return  Uart_ERROR; }
+
+    pthread_mutex_lock(&POSIX_Lock);
+    POSIX_Port *Local_Port = POSIX_Find(USARTx);
+    if (Local_Port -> Fd < 0)
+    {
+        pthread_mutex_unlock(&POSIX_Lock);
+        return Uart_ERROR;
+    }
+    (void)epoll_ctl(POSIX_Epoll, EPOLL_CTL_DEL, Local_Port -> Fd, NULL);
+    close(Local_Port -> Fd);
+    if (Local_Port -> Pty_Slave >= 0){ close(Local_Port -> Pty_Slave); }
+    Local_Port -> Fd        = -1;
+    Local_Port -> Pty_Slave = -1;
+    Local_Port -> TX_Held   = 0;
+    pthread_mutex_unlock(&POSIX_Lock);
+    POSIX_Kick();
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Posix_Noise : this function sets the noise model of the Received elements of the line, the errors
+///                                 are added when an element is given to (DR), so a test sees them as on a noisy line.
+/// @param  USARTx                : the USART Struct.
+/// @param  Copy_Model            : the noise model, or NULL to stop the noise.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Posix_Noise(USART_Struct *USARTx , const USART_Noise_Model *Copy_Model)
+{
+    if ((POSIX_Find(USARTx) == NULL) || ((Copy_Model != NULL) && ((Copy_Model -> Seed == 0) ||
+        (Copy_Model -> Bit_Error_ppm > 1000000UL) || (Copy_Model -> Frame_Error_ppm > 1000000UL) ||
+        (Copy_Model -> Overrun_ppm > 1000000UL)))){ return  Uart_ERROR; }
+
+    pthread_mutex_lock(&POSIX_Lock);
+    POSIX_Port *Local_Port = POSIX_Find(USARTx);
+    Local_Port -> Noise_On   = 0;
+    Local_Port -> Burst_Left = 0;
+    if (Copy_Model != NULL)
+    {
+        Local_Port -> Noise       = *Copy_Model;
+        Local_Port -> Noise_State = Copy_Model -> Seed;
+        Local_Port -> Noise_On    = 1;
+    }
+    pthread_mutex_unlock(&POSIX_Lock);
+    return Uart_OK;
+}
+
+
+/********************************************************************************************/
+/*                   			    The Register Hooks                      			    */
+/********************************************************************************************/
+
+/// @brief  UART_Posix_DR_Read : it reads (DR), the (RXNE) flag and (as the (SR) register was read before it) the error
+///                              and (IDLE) flags are cleared, a held element is given by the next step.
+/// @param  Copy_Peri          : the Peripheral.
+/// @return the (DR) register.
+u32 UART_Posix_DR_Read(MUSART_peri *Copy_Peri)
+{
+    u32 Local_Value;
+    u8  Local_Held;
+
+    pthread_mutex_lock(&POSIX_Lock);
+    Local_Value = Copy_Peri -> DR;
+    Copy_Peri -> SR &= ~POSIX_RX_FLAGS;
+    Local_Held = (POSIX_Ports[Copy_Peri - UART_Posix_Peri].RX_Count > 0) ? 1 : 0;
+    pthread_mutex_unlock(&POSIX_Lock);
+    if (Local_Held == 1){ POSIX_Kick(); }
+    return Local_Value;
+}
+
+
+/// @brief  UART_Posix_DR_Write : it writes (DR), the element goes to the shift register if it is empty, or it waits in
+///                               (TDR) with the (TXE) flag cleared, it is lost if the Transmitter is not enabled. the
+///                               written (TDR) and the read (RDR) are two registers, so the Received element is kept.
+/// @param  Copy_Peri           : the Peripheral.
+/// @param  Copy_Value          : the element.
+/// @return None.
+void UART_Posix_DR_Write(MUSART_peri *Copy_Peri , u32 Copy_Value)
+{
+    POSIX_Port *Local_Port = &POSIX_Ports[Copy_Peri - UART_Posix_Peri];
+
+    (void)pthread_once(&POSIX_Once, POSIX_Start);
+    pthread_mutex_lock(&POSIX_Lock);
+    if (GET_BIT(Copy_Peri -> CR1, CR1_UE) && GET_BIT(Copy_Peri -> CR1, CR1_TE))
+    {
+        if (Local_Port -> TX_Shift_Full == 0)
+        {
+            Local_Port -> TX_Shift_Full = 1;
+            Local_Port -> TX_Shift      = (u16)(Copy_Value & 0x1FFU);
+            Local_Port -> TX_Done_Ns    = POSIX_Now_Ns() + POSIX_Element_Ns(Copy_Peri);
+        }
+        else
+        {
+            Local_Port -> TDR_Full = 1;
+            Local_Port -> TDR      = (u16)(Copy_Value & 0x1FFU);
+            CLR_BIT(Copy_Peri -> SR, __TXE__);
+        }
+        CLR_BIT(Copy_Peri -> SR, __TC__);
+    }
+    pthread_mutex_unlock(&POSIX_Lock);
+    POSIX_Kick();
+}
+
+
+/// @brief  UART_Posix_SR_Clear : it clears (SR) flags by a write of zeros, as the firmware does for (TC) and (RXNE).
+/// @param  Copy_Peri           : the Peripheral.
+/// @param  Copy_Mask           : the flags to clear.
+/// @return None.
+void UART_Posix_SR_Clear(MUSART_peri *Copy_Peri , u32 Copy_Mask)
+{
+    pthread_mutex_lock(&POSIX_Lock);
+    Copy_Peri -> SR &= ~Copy_Mask;
+    pthread_mutex_unlock(&POSIX_Lock);
+}
+
+
+/// @brief  UART_Posix_Control : a control register (or BRR) is written, the model takes the new frame and checks the
+///                              enabled Interrupts again.
+/// @param  Copy_Peri          : the Peripheral.
+/// @return None.
+void UART_Posix_Control(MUSART_peri *Copy_Peri)
+{
+    (void)Copy_Peri;
+    (void)pthread_once(&POSIX_Once, POSIX_Start);
+    POSIX_Kick();
+}
+
+
+/// @brief  UART_Posix_Enter : it disables the Interrupts, the handlers wait for the end of the critical section.
+/// @return None.
+void UART_Posix_Enter(void)
+{
+    pthread_mutex_lock(&POSIX_IRQ_Lock);
+}
+
+
+/// @brief  UART_Posix_Exit : it enables the Interrupts again.
+/// @return None.
+void UART_Posix_Exit(void)
+{
+    pthread_mutex_unlock(&POSIX_IRQ_Lock);
+}
+
+
+/// @brief  UART_Posix_Cycles : it gives the cycle counter, the monotonic time at (FCK). the Blocking functions wait
+///                             by reading it, so an application thread gives the CPU to the model thread (on a single
+///                             core host a spin would stop the model till the end of its time slice).
+/// @return the cycles.
+u32 UART_Posix_Cycles(void)
+{
+    if (POSIX_In_Model == 0){ (void)sched_yield(); }
+    return (u32)((POSIX_Now_Ns() * (FCK / 1000000UL)) / 1000ULL);
+}
+
+
+/********************************************************************************************/
+/*                   			    The Host STK Timer                      			    */
+/********************************************************************************************/
+
+/// @brief  MSTK_voidStartTimer : it starts the timer of the calling thread.
+/// @return None.
+void MSTK_voidStartTimer(void)
+{
+    POSIX_STK_Start = POSIX_Now_Ns();
+    POSIX_STK_Ticks = 0;
+}
+
+
+/// @brief  MSTK_voidStopTimer : it stops the timer of the calling thread.
+/// @return None.
+void MSTK_voidStopTimer(void)
+{
+}
+
+
+/// @brief  MSTK_u32GetElapsedTime : it gives the elapsed ticks of the timer, they go up by one at most in each call, as
+///                                  the firmware reads every tick of its time limits (they are compared by (==)). the
+///                                  Blocking functions wait by reading it, so it gives the CPU as UART_Posix_Cycles.
+/// @return the elapsed ticks.
+u32 MSTK_u32GetElapsedTime(void)
+{
+    u64 Local_Ticks;
+
+    if (POSIX_In_Model == 0){ (void)sched_yield(); }
+    Local_Ticks = (POSIX_Now_Ns() - POSIX_STK_Start) / ((u64)POSIX_TICK_US * 1000ULL);
+
+    if (Local_Ticks > POSIX_STK_Ticks){ POSIX_STK_Ticks++; }
+    return POSIX_STK_Ticks;
+}
+
+
+/********************************************************************************************/
+/*                   			    The Model Thread                      			    */
+/********************************************************************************************/
+
+/// @brief  POSIX_Find : it finds the port of the Peripheral of the USART Struct.
+/// @param  USARTx     : the USART Struct.
+/// @return the port, or NULL if the USART_x is not a modelled Peripheral.
+static POSIX_Port *POSIX_Find(USART_Struct *USARTx)
+{
+    u8 Local_Index;
+
+    for (Local_Index = 0; (USARTx != NULL) && (Local_Index < POSIX_PERI_NUM); Local_Index++)
+    {
+        if (USARTx -> USART_x == &UART_Posix_Peri[Local_Index]){ return &POSIX_Ports[Local_Index]; }
+    }
+    return NULL;
+}
+
+
+/// @brief  POSIX_Start : it creates the (epoll) set, the wake-up event, the timer and the model thread, once.
+/// @return None.
+static void POSIX_Start(void)
+{
+    POSIX_Epoll = epoll_create1(EPOLL_CLOEXEC);
+    POSIX_Wake  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    POSIX_Timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ((POSIX_Epoll >= 0) && (POSIX_Wake >= 0) && (POSIX_Timer >= 0) &&
+        (epoll_ctl(POSIX_Epoll, EPOLL_CTL_ADD, POSIX_Wake,
+                   &(struct epoll_event){ .events = EPOLLIN, .data.u32 = POSIX_WAKE_ID }) == 0) &&
+        (epoll_ctl(POSIX_Epoll, EPOLL_CTL_ADD, POSIX_Timer,
+                   &(struct epoll_event){ .events = EPOLLIN, .data.u32 = POSIX_TIMER_ID }) == 0) &&
+        (pthread_create(&POSIX_Thread, NULL, POSIX_Thread_Main, NULL) == 0))
+    {
+        (void)pthread_detach(POSIX_Thread);
+        return;
+    }
+    // no model : the lines can not be opened, and the registers keep their values.
+    if (POSIX_Epoll >= 0){ close(POSIX_Epoll); }
+    if (POSIX_Wake  >= 0){ close(POSIX_Wake); }
+    if (POSIX_Timer >= 0){ close(POSIX_Timer); }
+    POSIX_Epoll = -1;
+    POSIX_Wake  = -1;
+    POSIX_Timer = -1;
+}
+
+
+/// @brief  POSIX_Thread_Main : it is the model thread, it steps the Peripherals then calls the handlers of their pending
+///                             Interrupts, and sleeps till the next event of the lines or of the model time.
+/// @param  Copy_Arg          : not used.
+/// @return NULL.
+static void *POSIX_Thread_Main(void *Copy_Arg)
+{
+    u8  Local_Rounds = 0;
+    u8  Local_Busy;
+    u64 Local_Next;
+
+    (void)Copy_Arg;
+    POSIX_In_Model = 1;
+    for (;;)
+    {
+        Local_Next = POSIX_Steps();
+        Local_Busy = 0;
+        if (POSIX_Interrupts(&Local_Busy) == 1)
+        {
+            // the handlers may have written the registers, so the model is stepped again at once.
+            if (++Local_Rounds < POSIX_IRQ_ROUNDS){ continue; }
+            // an Interrupt that stays pending is called again after a pause, as the firmware would lock up.
+            Local_Rounds = 0;
+            u64 Local_Pause = POSIX_Now_Ns() + POSIX_IRQ_PAUSE_NS;
+            Local_Next = ((Local_Next == 0) || (Local_Pause < Local_Next)) ? Local_Pause : Local_Next;
+        }
+        else
+        {
+            Local_Rounds = 0;
+        }
+        if (Local_Busy == 1)
+        {
+            u64 Local_Retry = POSIX_Now_Ns() + POSIX_IRQ_RETRY_NS;
+            Local_Next = ((Local_Next == 0) || (Local_Retry < Local_Next)) ? Local_Retry : Local_Next;
+        }
+        POSIX_Sleep(Local_Next);
+    }
+    return NULL;
+}
+
+
+/// @brief  POSIX_Steps : it steps the three Peripherals with the model lock.
+/// @return the time of the next event of the model, or (0) if none.
+static u64 POSIX_Steps(void)
+{
+    u64 Local_Now  = POSIX_Now_Ns();
+    u64 Local_Next = 0;
+    u64 Local_Time;
+    u8  Local_Index;
+
+    pthread_mutex_lock(&POSIX_Lock);
+    for (Local_Index = 0; Local_Index < POSIX_PERI_NUM; Local_Index++)
+    {
+        Local_Time = POSIX_Step(Local_Index, Local_Now);
+        if ((Local_Time != 0) && ((Local_Next == 0) || (Local_Time < Local_Next))){ Local_Next = Local_Time; }
+    }
+    pthread_mutex_unlock(&POSIX_Lock);
+    return Local_Next;
+}
+
+
+/// @brief  POSIX_Step  : it steps one Peripheral : the termios frame, the Transmitter, the line and the Receiver.
+/// @param  Copy_Index  : the index of the Peripheral.
+/// @param  Copy_Now    : the model time.
+/// @return the time of the next event of the Peripheral, or (0) if none.
+static u64 POSIX_Step(u8 Copy_Index , u64 Copy_Now)
+{
+    POSIX_Port  *Local_Port = &POSIX_Ports[Copy_Index];
+    MUSART_peri *Local_Peri = &UART_Posix_Peri[Copy_Index];
+    u64 Local_Element_Ns    = POSIX_Element_Ns(Local_Peri);
+    u64 Local_Next;
+
+    if ((Local_Port -> Fd >= 0) && (Local_Port -> Is_Tty == 1) &&
+        ((Local_Port -> Applied_CR1 != Local_Peri -> CR1) || (Local_Port -> Applied_CR2 != Local_Peri -> CR2) ||
+         (Local_Port -> Applied_BRR != Local_Peri -> BRR)))
+    {
+        POSIX_Apply_Frame(Local_Port, Local_Peri);
+    }
+    POSIX_TX_Step(Copy_Index, Copy_Now, Local_Element_Ns);
+    POSIX_RX_Read(Local_Port, Local_Peri);
+    Local_Next = POSIX_RX_Step(Copy_Index, Copy_Now, Local_Element_Ns);
+    if ((Local_Port -> TX_Shift_Full == 1) && (Local_Port -> TX_Held == 0) &&
+        ((Local_Next == 0) || (Local_Port -> TX_Done_Ns < Local_Next)))
+    {
+        Local_Next = Local_Port -> TX_Done_Ns;
+    }
+    POSIX_Set_Events(Copy_Index);
+    return Local_Next;
+}
+
+
+/// @brief  POSIX_Interrupts : it calls the handler of every Peripheral with a pending enabled Interrupt, the Interrupt
+///                            lock is not waited for, a critical section of the application delays the handlers.
+/// @param  Copy_Busy        : pointer set to (1) if an Interrupt is pending and the Interrupt lock is held.
+/// @return (1) if a handler is called, or (0) if not.
+static u8 POSIX_Interrupts(u8 *Copy_Busy)
+{
+    u8  Local_Called = 0;
+    u8  Local_Locked = 0;
+    u8  Local_Index;
+    u32 Local_SR, Local_CR1;
+
+    for (Local_Index = 0; Local_Index < POSIX_PERI_NUM; Local_Index++)
+    {
+        Local_SR  = UART_Posix_Peri[Local_Index].SR;
+        Local_CR1 = UART_Posix_Peri[Local_Index].CR1;
+        if ((GET_BIT(Local_CR1, CR1_UE) == 0) ||
+            (((GET_BIT(Local_CR1, CR1_TCIE)   & GET_BIT(Local_SR, __TC__))   |
+              (GET_BIT(Local_CR1, CR1_TXEIE)  & GET_BIT(Local_SR, __TXE__))  |
+              (GET_BIT(Local_CR1, CR1_RXNEIE) & (GET_BIT(Local_SR, __RXNE__) | GET_BIT(Local_SR, __ORE__))) |
+              (GET_BIT(Local_CR1, CR1_IDLEIE) & GET_BIT(Local_SR, __IDLE__)) |
+              (GET_BIT(Local_CR1, CR1_PEIE)   & GET_BIT(Local_SR, __PE__))) == 0))
+        {
+            continue;
+        }
+        if (Local_Locked == 0)
+        {
+            if (pthread_mutex_trylock(&POSIX_IRQ_Lock) != 0)
+            {
+                *Copy_Busy = 1;
+                return Local_Called;
+            }
+            Local_Locked = 1;
+        }
+        POSIX_Handlers[Local_Index]();
+        Local_Called = 1;
+    }
+    if (Local_Locked == 1){ pthread_mutex_unlock(&POSIX_IRQ_Lock); }
+    return Local_Called;
+}
+
+
+/// @brief  POSIX_Sleep   : it waits for a line, a register hook or the deadline.
+/// @param  Copy_Deadline : the time of the next event of the model, or (0) if none.
+/// @return None.
+static void POSIX_Sleep(u64 Copy_Deadline)
+{
+    struct epoll_event Local_Events[POSIX_PERI_NUM + 2U];
+    struct itimerspec  Local_Timer = { 0 };
+    u64 Local_Value;
+    int Local_Count, Local_Index;
+
+    if ((Copy_Deadline != 0) && (Copy_Deadline <= POSIX_Now_Ns())){ return; }
+    // a near event is waited for by a spin, the wake-up of the timer is longer than an element at the fast rates, the
+    // spin gives the CPU to the application threads (a single core host).
+    if ((Copy_Deadline != 0) && ((Copy_Deadline - POSIX_Now_Ns()) < POSIX_SPIN_NS))
+    {
+        while (POSIX_Now_Ns() < Copy_Deadline){ (void)sched_yield(); }
+        return;
+    }
+    // a zero time disarms the timer.
+    Local_Timer.it_value.tv_sec  = (time_t)(Copy_Deadline / 1000000000ULL);
+    Local_Timer.it_value.tv_nsec = (long)(Copy_Deadline % 1000000000ULL);
+    (void)timerfd_settime(POSIX_Timer, TFD_TIMER_ABSTIME, &Local_Timer, NULL);
+    Local_Count = epoll_wait(POSIX_Epoll, Local_Events, POSIX_PERI_NUM + 2U, -1);
+    (void)read(POSIX_Wake,  &Local_Value, sizeof(Local_Value));
+    (void)read(POSIX_Timer, &Local_Value, sizeof(Local_Value));
+    pthread_mutex_lock(&POSIX_Lock);
+    for (Local_Index = 0; Local_Index < Local_Count; Local_Index++)
+    {
+        if ((Local_Events[Local_Index].data.u32 < POSIX_PERI_NUM) && (Local_Events[Local_Index].events & (EPOLLHUP | EPOLLERR)))
+        {
+            POSIX_Ports[Local_Events[Local_Index].data.u32].Hang_Up = 1;
+        }
+    }
+    pthread_mutex_unlock(&POSIX_Lock);
+}
+
+
+/// @brief  POSIX_Kick : it wakes the model thread, it is not needed in the handlers (the model steps after them).
+/// @return None.
+static void POSIX_Kick(void)
+{
+    u64 Local_Value = 1;
+
+    if ((POSIX_In_Model == 0) && (POSIX_Wake >= 0))
+    {
+        (void)write(POSIX_Wake, &Local_Value, sizeof(Local_Value));
+    }
+}
+
+
+/// @brief  POSIX_Now_Ns : it gives the monotonic time.
+/// @return the time in nanoseconds.
+static u64 POSIX_Now_Ns(void)
+{
+    struct timespec Local_Time;
+    clock_gettime(CLOCK_MONOTONIC, &Local_Time);
+    return ((u64)Local_Time.tv_sec * 1000000000ULL) + (u64)Local_Time.tv_nsec;
+}
+
+
+/// @brief  POSIX_Element_Ns : it gives the time of one element on the line by (BRR), (OVER8), (M), (PCE) and (STOP).
+/// @param  Copy_Peri        : the Peripheral.
+/// @return the element time in nanoseconds.
+static u64 POSIX_Element_Ns(const MUSART_peri *Copy_Peri)
+{
+    u32 Local_BRR = Copy_Peri -> BRR;
+    u32 Local_CR1 = Copy_Peri -> CR1;
+    // the bit time is (DIV / FCK), with (OVER8) the fraction of (BRR) has three bits.
+    u32 Local_DIV = (GET_BIT(Local_CR1, CR1_OVER8) == 1) ? (((Local_BRR >> 4) << 3) | (Local_BRR & 0x07U)) : Local_BRR;
+    // the half bits of the element : start, data (with the parity) and stop (0.5, 1, 1.5 or 2 bits).
+    static const u8 Local_Stop_Half[4] = { 2U, 1U, 4U, 3U };
+    u32 Local_Half_Bits = 2U + (2U * ((GET_BIT(Local_CR1, CR1_M) == 1) ? 9U : 8U)) +
+                          Local_Stop_Half[(Copy_Peri -> CR2 >> CR2_STOP) & 0x03U];
+
+    if (Local_DIV == 0){ Local_DIV = 1; }
+    return ((u64)Local_Half_Bits * Local_DIV * 1000000000ULL) / (2ULL * (u64)FCK);
+}
+
+
+/// @brief  POSIX_Apply_Frame : it sets the termios port by the frame of the registers : the data bits, the parity (its
+///                             errors are marked by PARMRK), the stop bits and the nearest termios speed.
+/// @param  Copy_Port         : the port.
+/// @param  Copy_Peri         : the Peripheral.
+/// @return None.
+static void POSIX_Apply_Frame(POSIX_Port *Copy_Port , const MUSART_peri *Copy_Peri)
+{
+    struct termios Local_TIO;
+    u32 Local_CR1 = Copy_Peri -> CR1;
+    u32 Local_DIV = (GET_BIT(Local_CR1, CR1_OVER8) == 1) ?
+                    (((Copy_Peri -> BRR >> 4) << 3) | (Copy_Peri -> BRR & 0x07U)) : Copy_Peri -> BRR;
+
+    Copy_Port -> Applied_CR1 = Local_CR1;
+    Copy_Port -> Applied_CR2 = Copy_Peri -> CR2;
+    Copy_Port -> Applied_BRR = Copy_Peri -> BRR;
+    if (tcgetattr(Copy_Port -> Fd, &Local_TIO) != 0){ return; }
+    cfmakeraw(&Local_TIO);
+    Local_TIO.c_cflag |= CLOCAL | CREAD;
+    Local_TIO.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB);
+    // the parity bit is the last of the (M) data bits, a 9 bits element without a parity is sent by its 8 low bits.
+    Local_TIO.c_cflag |= ((GET_BIT(Local_CR1, CR1_M) == 0) && (GET_BIT(Local_CR1, CR1_PCE) == 1)) ? CS7 : CS8;
+    if (GET_BIT(Local_CR1, CR1_PCE) == 1)
+    {
+        Local_TIO.c_cflag |= PARENB | ((GET_BIT(Local_CR1, CR1_PS) == 1) ? PARODD : 0);
+        Local_TIO.c_iflag |= INPCK | PARMRK;
+    }
+    if (((Copy_Peri -> CR2 >> CR2_STOP) & 0x03U) >= 2U){ Local_TIO.c_cflag |= CSTOPB; }
+    Local_TIO.c_cc[VMIN]  = 0;
+    Local_TIO.c_cc[VTIME] = 0;
+    if (Local_DIV != 0)
+    {
+        speed_t Local_Speed = POSIX_Speed((u32)(FCK / Local_DIV));
+        if (Local_Speed != B0)
+        {
+            (void)cfsetispeed(&Local_TIO, Local_Speed);
+            (void)cfsetospeed(&Local_TIO, Local_Speed);
+        }
+    }
+    (void)tcsetattr(Copy_Port -> Fd, TCSANOW, &Local_TIO);
+}
+
+
+/// @brief  POSIX_Speed : it gives the nearest termios speed of a Baud rate.
+/// @param  Copy_Baud   : the Baud rate.
+/// @return the speed, or (B0) if the rate is (0).
+static speed_t POSIX_Speed(u32 Copy_Baud)
+{
+    static const u32     Local_Rates[]  = { 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200, 230400, 460800,
+                                            921600, 1000000, 2000000, 3000000, 4000000 };
+    static const speed_t Local_Speeds[] = { B1200, B2400, B4800, B9600, B19200, B38400, B57600, B115200, B230400,
+                                            B460800, B921600, B1000000, B2000000, B3000000, B4000000 };
+    u8  Local_Index, Local_Best = 0;
+    u32 Local_Error, Local_Best_Error = 0xFFFFFFFFUL;
+
+    if (Copy_Baud == 0){ return B0; }
+    for (Local_Index = 0; Local_Index < (sizeof(Local_Rates) / sizeof(Local_Rates[0])); Local_Index++)
+    {
+        Local_Error = (Copy_Baud > Local_Rates[Local_Index]) ? (Copy_Baud - Local_Rates[Local_Index]) :
+                                                               (Local_Rates[Local_Index] - Copy_Baud);
+        if (Local_Error < Local_Best_Error)
+        {
+            Local_Best_Error = Local_Error;
+            Local_Best       = Local_Index;
+        }
+    }
+    return Local_Speeds[Local_Best];
+}
+
+
+/// @brief  POSIX_TX_Step    : it ends the shifted elements of their time : they are written to the line (and to the
+///                            Receiver of the same Peripheral in the half-duplex mode), then (TDR) goes to the shift
+///                            register, or the (TC) flag is set.
+/// @param  Copy_Index       : the index of the Peripheral.
+/// @param  Copy_Now         : the model time.
+/// @param  Copy_Element_Ns  : the element time.
+/// @return None.
+static void POSIX_TX_Step(u8 Copy_Index , u64 Copy_Now , u64 Copy_Element_Ns)
+{
+    POSIX_Port  *Local_Port = &POSIX_Ports[Copy_Index];
+    MUSART_peri *Local_Peri = &UART_Posix_Peri[Copy_Index];
+
+    while ((Local_Port -> TX_Shift_Full == 1) && (Copy_Now >= Local_Port -> TX_Done_Ns))
+    {
+        // the line keeps the element while the other side does not read it.
+        if (POSIX_TX_Line(Copy_Index, Local_Port -> TX_Shift) == 0)
+        {
+            Local_Port -> TX_Held = 1;
+            return;
+        }
+        Local_Port -> TX_Held = 0;
+        if (Local_Port -> TDR_Full == 1)
+        {
+            Local_Port -> TX_Shift   = Local_Port -> TDR;
+            Local_Port -> TDR_Full   = 0;
+            // the elements are sent back to back, a late step does not stretch the line.
+            Local_Port -> TX_Done_Ns = ((Local_Port -> TX_Done_Ns + Copy_Element_Ns) > Copy_Now) ?
+                                       (Local_Port -> TX_Done_Ns + Copy_Element_Ns) : Copy_Now;
+            SET_BIT(Local_Peri -> SR, __TXE__);
+        }
+        else
+        {
+            Local_Port -> TX_Shift_Full = 0;
+            SET_BIT(Local_Peri -> SR, __TC__);
+        }
+    }
+}
+
+
+/// @brief  POSIX_TX_Line  : it writes one shifted element to the line.
+/// @param  Copy_Index     : the index of the Peripheral.
+/// @param  Copy_Element   : the element.
+/// @return (1) if the element left the Peripheral, or (0) if the line is full.
+static u8 POSIX_TX_Line(u8 Copy_Index , u16 Copy_Element)
+{
+    POSIX_Port  *Local_Port = &POSIX_Ports[Copy_Index];
+    MUSART_peri *Local_Peri = &UART_Posix_Peri[Copy_Index];
+    // with a parity the last data bit is the parity bit, it is made by the termios port.
+    u8 Local_Byte = (u8)(Copy_Element & (((GET_BIT(Local_Peri -> CR1, CR1_M) == 0) &&
+                                          (GET_BIT(Local_Peri -> CR1, CR1_PCE) == 1)) ? 0x7FU : 0xFFU));
+
+    if ((Local_Port -> Fd >= 0) && (Local_Port -> Hung == 0))
+    {
+        ssize_t Local_Count = write(Local_Port -> Fd, &Local_Byte, 1);
+        if ((Local_Count < 0) && ((errno == EAGAIN) || (errno == EINTR))){ return 0; }
+    }
+    if (GET_BIT(Local_Peri -> CR3, CR3_HDSEL) == 1)
+    {
+        // the half-duplex line is the TX pin, the Receiver gets every Transmitted element.
+        POSIX_RX_Add(Local_Port, Local_Byte, 0);
+    }
+    return 1;
+}
+
+
+/// @brief  POSIX_RX_Read : it reads the waiting elements of the line into the queue, the parity error marks of a
+///                         termios port with a parity are decoded.
+/// @param  Copy_Port     : the port.
+/// @param  Copy_Peri     : the Peripheral.
+/// @return None.
+static void POSIX_RX_Read(POSIX_Port *Copy_Port , const MUSART_peri *Copy_Peri)
+{
+    u8      Local_Buffer[POSIX_PENDING_SIZE];
+    ssize_t Local_Count, Local_Index;
+    u8      Local_Marks = ((Copy_Port -> Is_Tty == 1) && (GET_BIT(Copy_Peri -> CR1, CR1_PCE) == 1)) ? 1 : 0;
+
+    if ((Copy_Port -> Fd < 0) || (Copy_Port -> Hung == 1) || (Copy_Port -> RX_Count == POSIX_PENDING_SIZE)){ return; }
+    // one read element gives one element at most, so the queue does not overflow.
+    Local_Count = read(Copy_Port -> Fd, Local_Buffer, POSIX_PENDING_SIZE - Copy_Port -> RX_Count);
+    // a termios port without elements gives (0) (VMIN and VTIME are 0), so it is closed only after a hang-up event.
+    if (((Local_Count == 0) && ((Copy_Port -> Is_Tty == 0) || (Copy_Port -> Hang_Up == 1))) ||
+        ((Local_Count < 0) && (errno != EAGAIN) && (errno != EINTR)))
+    {
+        // (epoll) gives a hang-up even without events, so the line leaves the set.
+        Copy_Port -> Hung = 1;
+        (void)epoll_ctl(POSIX_Epoll, EPOLL_CTL_DEL, Copy_Port -> Fd, NULL);
+        return;
+    }
+    for (Local_Index = 0; Local_Index < Local_Count; Local_Index++)
+    {
+        u8 Local_Element = Local_Buffer[Local_Index];
+        if (Local_Marks == 0)
+        {
+            POSIX_RX_Add(Copy_Port, Local_Element, 0);
+            continue;
+        }
+        switch (Copy_Port -> Mark_State)
+        {
+        case POSIX_MARK_FF:
+            // (0xFF 0xFF) is a (0xFF) element, (0xFF 0x00) starts an error mark.
+            Copy_Port -> Mark_State = (Local_Element == 0xFFU) ? POSIX_MARK_NONE : POSIX_MARK_ERROR;
+            if (Local_Element == 0xFFU){ POSIX_RX_Add(Copy_Port, Local_Element, 0); }
+            break;
+        case POSIX_MARK_ERROR:
+            Copy_Port -> Mark_State = POSIX_MARK_NONE;
+            POSIX_RX_Add(Copy_Port, Local_Element, 1);
+            break;
+        default:
+            if (Local_Element == 0xFFU){ Copy_Port -> Mark_State = POSIX_MARK_FF; }
+            else                       { POSIX_RX_Add(Copy_Port, Local_Element, 0); }
+            break;
+        }
+    }
+}
+
+
+/// @brief  POSIX_RX_Add : it adds an element that arrived on the line to the queue, it is lost if the queue is full.
+/// @param  Copy_Port    : the port.
+/// @param  Copy_Element : the element.
+/// @param  Copy_Error   : (1) if the element has a parity error mark.
+/// @return None.
+static void POSIX_RX_Add(POSIX_Port *Copy_Port , u8 Copy_Element , u8 Copy_Error)
+{
+    if (Copy_Port -> RX_Count == POSIX_PENDING_SIZE)
+    {
+        Copy_Port -> Overrun = 1;
+        return;
+    }
+    Copy_Port -> RX_Queue[Copy_Port -> RX_In].Element = Copy_Element;
+    Copy_Port -> RX_Queue[Copy_Port -> RX_In].Error   = Copy_Error;
+    Copy_Port -> RX_In = (u16)((Copy_Port -> RX_In + 1U) % POSIX_PENDING_SIZE);
+    Copy_Port -> RX_Count++;
+}
+
+
+/// @brief  POSIX_RX_Step    : it gives the next element of the queue to (DR) one element time after the previous one, the
+///                            element is held while (RXNE) is set (the application did not read the previous one yet),
+///                            and it sets the (IDLE) flag one element time (and the host slack) after the last element.
+/// @param  Copy_Index       : the index of the Peripheral.
+/// @param  Copy_Now         : the model time.
+/// @param  Copy_Element_Ns  : the element time.
+/// @return the time of the next Receiver event, or (0) if none.
+static u64 POSIX_RX_Step(u8 Copy_Index , u64 Copy_Now , u64 Copy_Element_Ns)
+{
+    POSIX_Port  *Local_Port = &POSIX_Ports[Copy_Index];
+    MUSART_peri *Local_Peri = &UART_Posix_Peri[Copy_Index];
+    u64 Local_Earliest;
+    u8  Local_Element;
+    u32 Local_SR;
+
+    while (Local_Port -> RX_Count > 0)
+    {
+        Local_Earliest = Local_Port -> RX_Last_End + Copy_Element_Ns;
+        if (Copy_Now < Local_Earliest){ return Local_Earliest; }
+        // the model waits for the read of (DR), so no element is lost as an Overrun of the host.
+        if (GET_BIT(Local_Peri -> SR, __RXNE__) == 1){ return 0; }
+
+        Local_Element = Local_Port -> RX_Queue[Local_Port -> RX_Out].Element;
+        Local_SR      = (Local_Port -> RX_Queue[Local_Port -> RX_Out].Error == 1) ? (1UL << __PE__) : 0;
+        Local_Port -> RX_Out = (u16)((Local_Port -> RX_Out + 1U) % POSIX_PENDING_SIZE);
+        Local_Port -> RX_Count--;
+        // a late step keeps the element times of a burst.
+        Local_Port -> RX_Last_End = ((Local_Earliest + Copy_Element_Ns) > Copy_Now) ? Local_Earliest : Copy_Now;
+
+        if ((GET_BIT(Local_Peri -> CR1, CR1_UE) == 0) || (GET_BIT(Local_Peri -> CR1, CR1_RE) == 0)){ continue; }
+        if ((Local_Port -> Noise_On == 1) &&
+            (POSIX_Add_Noise(Local_Port, (u8)GET_BIT(Local_Peri -> CR1, CR1_PCE), &Local_Element, &Local_SR) == 0))
+        {
+            continue;
+        }
+        if (Local_Port -> Overrun == 1)
+        {
+            Local_Port -> Overrun = 0;
+            Local_SR |= (1UL << __ORE__);
+        }
+        Local_Peri -> DR  = Local_Element;
+        Local_Peri -> SR |= Local_SR | (1UL << __RXNE__);
+        Local_Port -> Idle_Armed = 1;
+    }
+    if (Local_Port -> Idle_Armed == 1)
+    {
+        Local_Earliest = Local_Port -> RX_Last_End + Copy_Element_Ns + POSIX_IDLE_SLACK_NS;
+        if (Copy_Now < Local_Earliest){ return Local_Earliest; }
+        Local_Port -> Idle_Armed = 0;
+        SET_BIT(Local_Peri -> SR, __IDLE__);
+    }
+    return 0;
+}
+
+
+/// @brief  POSIX_Add_Noise : it adds the errors of the noise model to a Received element.
+/// @param  Copy_Port       : the port.
+/// @param  Copy_Parity     : (1) if the parity is checked.
+/// @param  Copy_Element    : pointer of the element, its bits may be inverted.
+/// @param  Copy_SR         : pointer of the error bits of the element.
+/// @return (1) if the element is kept, or (0) if it is lost (an Overrun).
+static u8 POSIX_Add_Noise(POSIX_Port *Copy_Port , u8 Copy_Parity , u8 *Copy_Element , u32 *Copy_SR)
+{
+    u8 Local_Bit;
+    u8 Local_Inverted = 0;
+
+    if (POSIX_Chance(Copy_Port, Copy_Port -> Noise.Overrun_ppm) == 1)
+    {
+        Copy_Port -> Overrun = 1;
+        return 0;
+    }
+    if (POSIX_Chance(Copy_Port, Copy_Port -> Noise.Frame_Error_ppm) == 1)
+    {
+        *Copy_SR |= (1UL << __FE__);
+    }
+    // a burst goes on in the next bits, and in the next element.
+    for (Local_Bit = 0; Local_Bit < 8U; Local_Bit++)
+    {
+        if (Copy_Port -> Burst_Left > 0)
+        {
+            Copy_Port -> Burst_Left--;
+        }
+        else if (POSIX_Chance(Copy_Port, Copy_Port -> Noise.Bit_Error_ppm) == 1)
+        {
+            Copy_Port -> Burst_Left = (Copy_Port -> Noise.Burst_Bits > 1) ? (u8)(Copy_Port -> Noise.Burst_Bits - 1) : 0;
+        }
+        else
+        {
+            continue;
+        }
+        *Copy_Element ^= (u8)(1U << Local_Bit);
+        Local_Inverted++;
+    }
+    // an odd number of inverted bits is found by the parity check.
+    if ((Copy_Parity == 1) && ((Local_Inverted & 1U) == 1U))
+    {
+        *Copy_SR |= (1UL << __PE__);
+    }
+    return 1;
+}
+
+
+/// @brief  POSIX_Chance : it gives a random event (xorshift32) of a chance in parts per million.
+/// @param  Copy_Port    : the port.
+/// @param  Copy_ppm     : the chance in parts per million.
+/// @return (1) if the event happens, or (0) if not.
+static u8 POSIX_Chance(POSIX_Port *Copy_Port , u32 Copy_ppm)
+{
+    u32 Local_State = Copy_Port -> Noise_State;
+
+    if (Copy_ppm == 0){ return 0; }
+    Local_State ^= Local_State << 13;
+    Local_State ^= Local_State >> 17;
+    Local_State ^= Local_State << 5;
+    Copy_Port -> Noise_State = Local_State;
+    return ((Local_State % 1000000UL) < Copy_ppm) ? 1 : 0;
+}
+
+
+/// @brief  POSIX_Set_Events : it waits for the line to be readable while the queue has room, and to be writable while
+///                            a shifted element is held.
+/// @param  Copy_Index       : the index of the Peripheral.
+/// @return None.
+static void POSIX_Set_Events(u8 Copy_Index)
+{
+    POSIX_Port *Local_Port = &POSIX_Ports[Copy_Index];
+    u32 Local_Events;
+
+    if ((Local_Port -> Fd < 0) || (Local_Port -> Hung == 1)){ return; }
+    Local_Events = ((Local_Port -> RX_Count < POSIX_PENDING_SIZE) ? EPOLLIN : 0) | ((Local_Port -> TX_Held == 1) ? EPOLLOUT : 0);
+    if (Local_Events != Local_Port -> Events)
+    {
+        Local_Port -> Events = Local_Events;
+        (void)epoll_ctl(POSIX_Epoll, EPOLL_CTL_MOD, Local_Port -> Fd,
+                        &(struct epoll_event){ .events = Local_Events, .data.u32 = Copy_Index });
+    }
+}
+#endif
@@ -13,14 +13,24 @@
 #define     Disable     0
 #define     Enable      1
 /********************************************************************************************/
+/*	the options of the driver select the register access of the host model (USART_POSIX).	*/
+#include "USART_config.h"
+/********************************************************************************************/
 
 /********************************************************************************************/
 /*                   			    The USART Registers                      			    */
 /********************************************************************************************/
 
+#if USART_POSIX == Enable
+/*	the registers of the host model are in the host memory (USART_posix.c).	*/
+#define		USART1_BASE_ADD			(&UART_Posix_Peri[0])
+#define		USART2_BASE_ADD			(&UART_Posix_Peri[1])
+#define		USART6_BASE_ADD			(&UART_Posix_Peri[2])
+#else
 #define		USART1_BASE_ADD			(u32)(0x40011000)
 #define		USART2_BASE_ADD			(u32)(0x40004400)
 #define		USART6_BASE_ADD			(u32)(0x40011400)
+#endif
 typedef struct{
 
     volatile      u32           SR      ;
@@ -34,6 +44,145 @@ typedef struct{
 /********************************************************************************************/
 
 
+/********************************************************************************************/
+/*                   	The Host Model of the USART Peripherals (USART_POSIX)                */
+/********************************************************************************************/
+/*	(USART_posix.c) gives the registers of USART1, USART2 and USART6 their hardware behaviour	*/
+/*	on Linux, and its model thread calls the USARTx_IRQHandler functions, so the same Program	*/
+/*	file runs on the host. the model has no (CK) line, every other option runs on it.		*/
+#if USART_POSIX == Enable
+#if USART_SYNC == Enable
+#error "the host model (USART_POSIX) has no (CK) line, so the USART_SYNC option can not be used with it"
+#endif
+/*	the number of the modelled Peripherals (USART1, USART2 and USART6)	*/
+#define     POSIX_PERI_NUM          3U
+extern MUSART_peri UART_Posix_Peri[POSIX_PERI_NUM];
+/*	the value of the last LDREX of the thread	*/
+extern __thread u32 UART_Posix_Exclusive;
+
+u32     UART_Posix_DR_Read(MUSART_peri *Copy_Peri);
+void    UART_Posix_DR_Write(MUSART_peri *Copy_Peri , u32 Copy_Value);
+void    UART_Posix_SR_Clear(MUSART_peri *Copy_Peri , u32 Copy_Mask);
+void    UART_Posix_Control(MUSART_peri *Copy_Peri);
+void    UART_Posix_Enter(void);
+void    UART_Posix_Exit(void);
+u32     UART_Posix_Cycles(void);
+#endif
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*                   			    The Data Register Access                      			    */
+/********************************************************************************************/
+#if USART_POSIX == Enable
+///@brief  Read the (DR) register, it clears (RXNE) and, after the read of (SR), the error and (IDLE) flags.
+#define     __UART_DR_READ(__USARTX__)                  UART_Posix_DR_Read((__USARTX__)-> USART_x)
+///@brief  Write the (DR) register, it clears (TXE) and (TC) till the element is moved to the shift register.
+#define     __UART_DR_WRITE(__USARTX__,__VALUE__)       UART_Posix_DR_Write((__USARTX__)-> USART_x, (__VALUE__))
+///@brief  A control register is written, the model checks its Interrupts again.
+#define     __UART_CONTROL_WRITTEN(__PERI__)            UART_Posix_Control(__PERI__)
+#else
+#define     __UART_DR_READ(__USARTX__)                  ((__USARTX__)-> USART_x -> DR)
+#define     __UART_DR_WRITE(__USARTX__,__VALUE__)       ((__USARTX__)-> USART_x -> DR = (__VALUE__))
+#define     __UART_CONTROL_WRITTEN(__PERI__)            ((void)0)
+#endif
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*                   	The DWT Cycle Counter Registers (Statistics time base)               */
+/********************************************************************************************/
+#if USART_POSIX == Enable
+/*	the host cycles are the monotonic time at (FCK), the counter is always on.	*/
+#define     DWT_CYCCNT_R            (UART_Posix_Cycles())
+#else
+#define     DEMCR_R                 (*(volatile u32 *)0xE000EDFC)
+#define     DWT_CTRL_R              (*(volatile u32 *)0xE0001000)
+#define     DWT_CYCCNT_R            (*(volatile u32 *)0xE0001004)
+#endif
+
+/*	Trace enable bit in the DEMCR register		*/
+#define     DEMCR_TRCENA            24
+/*	Cycle counter enable bit in the DWT_CTRL	*/
+#define     DWT_CTRL_CYCCNTENA      0
+
+///@brief  Enable the DWT cycle counter.
+#if USART_POSIX == Enable
+#define     __UART_DWT_ENABLE()     ((void)0)
+#else
+#define     __UART_DWT_ENABLE()     do{ SET_BIT(DEMCR_R, DEMCR_TRCENA); SET_BIT(DWT_CTRL_R, DWT_CTRL_CYCCNTENA); }while(0)
+#endif
+///@brief  The DWT cycles of a time in micro seconds.
+#define     __UART_US_TO_CYCLES(__US__)     ((u32)((FCK / 1000000UL) * (__US__)))
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*                   			    The Running CRC Parameters                     			    */
+/********************************************************************************************/
+/*	CRC-16/MODBUS : reflected, initial value 0xFFFF, no final XOR.					*/
+#define     UART_CRC16_INIT         0x0000FFFFUL
+#define     UART_CRC16_XOROUT       0x00000000UL
+/*	CRC-32 (IEEE 802.3) : reflected, initial value 0xFFFFFFFF, final XOR 0xFFFFFFFF.	*/
+#define     UART_CRC32_INIT         0xFFFFFFFFUL
+#define     UART_CRC32_XOROUT       0xFFFFFFFFUL
+
+///@brief  The parameters of the given CRC type.
+#define     __UART_CRC_INIT(__TYPE__)       (((__TYPE__) == Uart_CRC_32) ? UART_CRC32_INIT    : UART_CRC16_INIT)
+#define     __UART_CRC_XOROUT(__TYPE__)     (((__TYPE__) == Uart_CRC_32) ? UART_CRC32_XOROUT  : UART_CRC16_XOROUT)
+#define     __UART_CRC_WIDTH(__TYPE__)      (((__TYPE__) == Uart_CRC_32) ? 4U : (((__TYPE__) == Uart_CRC_16) ? 2U : 0U))
+/*	the CRC is sent as hex text before the last element, two digits per element.	*/
+#define     __UART_CRC_DIGITS(__TYPE__)     (2U * __UART_CRC_WIDTH(__TYPE__))
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*                   	The Frame Pool Exclusive Access (LDREX / STREX)                     */
+/********************************************************************************************/
+/*	the index of no pool block	*/
+#define     POOL_NO_BLOCK           0xFFU
+
+#if USART_POSIX == Enable
+/*	on the host the store is a compare and swap with the value of the last LDREX of the thread.	*/
+#define     __UART_LDREX(__ADDR__,__VALUE__)            ((__VALUE__) = UART_Posix_Exclusive = __atomic_load_n((__ADDR__), __ATOMIC_SEQ_CST))
+#define     __UART_STREX(__ADDR__,__VALUE__,__RESULT__) ((__RESULT__) = __atomic_compare_exchange_n((__ADDR__), &UART_Posix_Exclusive, \
+                                                            (__VALUE__), 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? 0U : 1U)
+#define     __UART_CLREX()                              ((void)0)
+#else
+///@brief  Load a word and open the exclusive access to it.
+#define     __UART_LDREX(__ADDR__,__VALUE__)            __asm volatile ("LDREX %0, [%1]" : "=r" (__VALUE__) : "r" (__ADDR__) : "memory")
+///@brief  Store a word if it was not accessed (or an Interrupt did not happen) since its LDREX, (__RESULT__) is (0) on success.
+#define     __UART_STREX(__ADDR__,__VALUE__,__RESULT__) __asm volatile ("STREX %0, %2, [%1]" : "=&r" (__RESULT__) : "r" (__ADDR__), "r" (__VALUE__) : "memory")
+///@brief  Close the exclusive access without a store.
+#define     __UART_CLREX()                              __asm volatile ("CLREX" : : : "memory")
+#endif
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*                   			    The Critical Section Macros                  			    */
+/********************************************************************************************/
+#if USART_POSIX == Enable
+/*	on the host the Interrupts are the calls of the model thread, they wait for this recursive lock.	*/
+#define     __UART_ENTER_CRITICAL(__STATE__)            do{ (__STATE__) = 0U; UART_Posix_Enter(); }while(0)
+#define     __UART_EXIT_CRITICAL(__STATE__)             do{ (void)(__STATE__); UART_Posix_Exit(); }while(0)
+#else
+///@brief  Save the PRIMASK register and disable the Interrupts.
+#define     __UART_ENTER_CRITICAL(__STATE__)            __asm volatile ("MRS %0, PRIMASK\n\tCPSID i" : "=r" (__STATE__) :: "memory")
+///@brief  Restore the PRIMASK register.
+#define     __UART_EXIT_CRITICAL(__STATE__)             __asm volatile ("MSR PRIMASK, %0" :: "r" (__STATE__) : "memory")
+#endif
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*                   	The Write Ring Ordering                                              */
+/********************************************************************************************/
+///@brief  The elements copied into the write ring are stored before its index is moved (the Interrupt reads them).
+#define     __UART_COMPILER_BARRIER()                   __asm volatile ("" : : : "memory")
+/********************************************************************************************/
+
+
 /**********************************************/
 /* 				SR BITS Mapping 			  */
 /**********************************************/
@@ -57,6 +206,8 @@ typedef struct{
 #define __LBD__			8
 /*	CTS flag						*/
 #define __CTS__			9
+/*	The Receive Error flags (PE, FE, NE and ORE) mask	*/
+#define UART_RX_ERRORS_MASK		((1<<__PE__)|(1<<__FE__)|(1<<__NE__)|(1<<__ORE__))
 
 /**********************************************/
 /* 				CR1 BITS Mapping 			  */
@@ -182,12 +333,12 @@ typedef struct{
 ///@brief  Enable UART
 ///@param  __HANDLE__ specifies the UART Struct.
 ///@retval None
-#define     __UART_ENABLE(__USARTX__)	   ((__USARTX__)->CR1 |=  (1<<CR1_UE))
+#define     __UART_ENABLE(__USARTX__)	   __UART_SHADOW_SAFE_SET(__USARTX__, CR1, CR1_UE)
 /******************************************************************************************************************************************/
 ///@brief  Disable UART
 ///@param  __HANDLE__ specifies the UART Struct.
 ///@retval None
-#define     __UART_DISABLE(__USARTX__)	   ((__USARTX__)->CR1 &= ~(1<<CR1_UE))
+#define     __UART_DISABLE(__USARTX__)	   __UART_SHADOW_SAFE_CLR(__USARTX__, CR1, CR1_UE)
 /******************************************************************************************************************************************/
 /// @brief  Checks whether the specified UART flag is set or not.
 /// @param  __USARTX__ specifies the UART Struct.
@@ -223,7 +374,11 @@ typedef struct{
 ///          USART_SR register followed by a write operation to USART_DR register.
 /// @note   "TXE" flag is cleared only by a write to the USART_DR register.
 /// @retval None
+#if USART_POSIX == Enable
+#define     __UART_CLEAR_FLAG(__USARTX__, __FLAG__)     UART_Posix_SR_Clear((__USARTX__), (1UL << (__FLAG__)))
+#else
 #define     __UART_CLEAR_FLAG(__USARTX__, __FLAG__)     ((__USARTX__)->SR &= ~(1<<__FLAG__))
+#endif
 /******************************************************************************************************************************************/
 ///@brief  Lock the Communication of the Peripheral.
 ///@param  __HANDLE__     specifies the UART Struct.
@@ -247,8 +402,7 @@ typedef struct{
 ///            @arg  TX_Lock_Status :  The Tx lock Flag.
 ///            @arg  RX_Lock_Status :  The Rx lock Flag.
 ///@retval None
-#define     __COMM_ENABLE(__USARTX__,__COMM_TYPE__)	   (__COMM_TYPE__ == TX) ? (SET_BIT((__USARTX__-> USART_x -> CR1), CR1_TE ))  : \
-                                                                               (SET_BIT((__USARTX__-> USART_x -> CR1), CR1_RE ))
+#define     __COMM_ENABLE(__USARTX__,__COMM_TYPE__)	   __UART_SHADOW_SAFE_SET(__USARTX__, CR1, ((__COMM_TYPE__ == TX) ? CR1_TE : CR1_RE))
 /******************************************************************************************************************************************/
 ///@brief  Unlock the Communication of the Peripheral.
 ///@param  __HANDLE__ specifies the UART Struct.
@@ -256,7 +410,48 @@ typedef struct{
 ///            @arg  TX_Lock_Status :  The Tx lock Flag.
 ///            @arg  RX_Lock_Status :  The Rx lock Flag.
 ///@retval None
-#define     __COMM_DISABLE(__USARTX__,__COMM_TYPE__)	   (__COMM_TYPE__ == TX) ? (CLR_BIT((__USARTX__-> USART_x -> CR1), CR1_TE ))  : \
-                                                                                   (CLR_BIT((__USARTX__-> USART_x -> CR1), CR1_RE ))
+#define     __COMM_DISABLE(__USARTX__,__COMM_TYPE__)	   __UART_SHADOW_SAFE_CLR(__USARTX__, CR1, ((__COMM_TYPE__ == TX) ? CR1_TE : CR1_RE))
+/******************************************************************************************************************************************/
+///@brief  Set a bit of a control register by its shadow, the register is written once and it is not read.
+///@param  __USARTX__ specifies the UART Struct.
+///@param  __REG__    the control register : CR1, CR2 or CR3.
+///@param  __BIT__    the bit number.
+///@retval None
+#define     __UART_SHADOW_SET(__USARTX__,__REG__,__BIT__)   ((__USARTX__)-> USART_x -> __REG__ = ((__USARTX__)-> __REG__##_Shadow |=  (1UL << (__BIT__))), \
+                                                             __UART_CONTROL_WRITTEN((__USARTX__)-> USART_x))
+/******************************************************************************************************************************************/
+///@brief  Clear a bit of a control register by its shadow, the register is written once and it is not read.
+///@param  __USARTX__ specifies the UART Struct.
+///@param  __REG__    the control register : CR1, CR2 or CR3.
+///@param  __BIT__    the bit number.
+///@retval None
+#define     __UART_SHADOW_CLR(__USARTX__,__REG__,__BIT__)   ((__USARTX__)-> USART_x -> __REG__ = ((__USARTX__)-> __REG__##_Shadow &= ~(1UL << (__BIT__))), \
+                                                             __UART_CONTROL_WRITTEN((__USARTX__)-> USART_x))
+/******************************************************************************************************************************************/
+///@brief  Get a bit of a control register from its shadow.
+///@param  __USARTX__ specifies the UART Struct.
+///@param  __REG__    the control register : CR1, CR2 or CR3.
+///@param  __BIT__    the bit number.
+///@retval The bit value (1 or 0).
+#define     __UART_SHADOW_GET(__USARTX__,__REG__,__BIT__)   GET_BIT((__USARTX__)-> __REG__##_Shadow, __BIT__)
+/******************************************************************************************************************************************/
+///@brief  Set a bit of a control register by its shadow with the Interrupts disabled, it is used out of the Interrupt
+///        Handlers, as a Handler that changes the same shadow between its read and its write would be undone.
+///@param  __USARTX__ specifies the UART Struct.
+///@param  __REG__    the control register : CR1, CR2 or CR3.
+///@param  __BIT__    the bit number.
+///@retval None
+#define     __UART_SHADOW_SAFE_SET(__USARTX__,__REG__,__BIT__)  do{ u32 __UART_STATE__; __UART_ENTER_CRITICAL(__UART_STATE__); \
+                                                                    __UART_SHADOW_SET(__USARTX__, __REG__, __BIT__);       \
+                                                                    __UART_EXIT_CRITICAL(__UART_STATE__); }while(0)
+/******************************************************************************************************************************************/
+///@brief  Clear a bit of a control register by its shadow with the Interrupts disabled (out of the Interrupt Handlers).
+///@param  __USARTX__ specifies the UART Struct.
+///@param  __REG__    the control register : CR1, CR2 or CR3.
+///@param  __BIT__    the bit number.
+///@retval None
+#define     __UART_SHADOW_SAFE_CLR(__USARTX__,__REG__,__BIT__)  do{ u32 __UART_STATE__; __UART_ENTER_CRITICAL(__UART_STATE__); \
+                                                                    __UART_SHADOW_CLR(__USARTX__, __REG__, __BIT__);       \
+                                                                    __UART_EXIT_CRITICAL(__UART_STATE__); }while(0)
 /******************************************************************************************************************************************/
 #endif
@@ -5,6 +5,8 @@
 /*	Description  	:  This is the Program file For the USART Asynchronous Modes Peripheral */
 /*											at ARM-CORTEX m4								*/
 /********************************************************************************************/
+#include <stdint.h>
+
 #include "LIB/BIT_MATH.h"
 #include "LIB/STD_Types.h"
 
@@ -14,9 +16,130 @@
 
 #include "LMCAL/01_STK/STK_interface.h"
 /********************************************************************************************/
+/*                              The Transfer Statistics Macros                              */
+/********************************************************************************************/
+#if USART_STATISTICS == Enable
+#define     __UART_STATS_ADD(__USARTX__,__FIELD__,__VALUE__)    ((__USARTX__)->Stats.__FIELD__ += (__VALUE__))
+#define     __UART_STATS_START(__CYCLES__)                      u32 __CYCLES__ = DWT_CYCCNT_R
+#define     __UART_STATS_ISR_END(__USARTX__,__CYCLES__)         UART_Stats_ISR_End((__USARTX__),(__CYCLES__))
+#define     __UART_STATS_CPU_END(__USARTX__,__CYCLES__)         __UART_STATS_ADD(__USARTX__, CPU_Cycles, (DWT_CYCCNT_R - (__CYCLES__)))
+#else
+#define     __UART_STATS_ADD(__USARTX__,__FIELD__,__VALUE__)    ((void)0)
+#define     __UART_STATS_START(__CYCLES__)                      ((void)0)
+#define     __UART_STATS_ISR_END(__USARTX__,__CYCLES__)         ((void)0)
+#define     __UART_STATS_CPU_END(__USARTX__,__CYCLES__)         ((void)0)
+#endif
+/********************************************************************************************/
+/*                              The Event Trace Macro                                       */
+/********************************************************************************************/
+#if USART_TRACE == Enable
+#define     __UART_TRACE(__USARTX__,__EVENT__,__DATA__)         UART_Trace_Add((__USARTX__),(__EVENT__),(u16)(__DATA__))
+#else
+#define     __UART_TRACE(__USARTX__,__EVENT__,__DATA__)         ((void)0)
+#endif
+/********************************************************************************************/
+/*                              The Transmit Last Element Macro                             */
+/********************************************************************************************/
+/*	the Modbus frames are binary and the write ring has no frames, so the Transmission of a Modbus port or of the ring	*/
+/*	ends by its size only, as a Transmission of MCAL_UART_Transmit_Size_INT.											*/
+#if (USART_MODBUS == Enable) && (USART_WRITE == Enable)
+#define     __UART_TX_BY_SIZE(__USARTX__)                       (((__USARTX__)->TX_By_Size == 1) || ((__USARTX__)->Modbus_Buffer != NULL) || \
+                                                                 ((__USARTX__)->Write_Streaming == 1))
+#elif USART_MODBUS == Enable
+#define     __UART_TX_BY_SIZE(__USARTX__)                       (((__USARTX__)->TX_By_Size == 1) || ((__USARTX__)->Modbus_Buffer != NULL))
+#elif USART_WRITE == Enable
+#define     __UART_TX_BY_SIZE(__USARTX__)                       (((__USARTX__)->TX_By_Size == 1) || ((__USARTX__)->Write_Streaming == 1))
+#else
+#define     __UART_TX_BY_SIZE(__USARTX__)                       ((__USARTX__)->TX_By_Size == 1)
+#endif
+#define     __UART_TX_LAST_EL(__USARTX__,__ELEMENT__)           ((!__UART_TX_BY_SIZE(__USARTX__)) && ((__ELEMENT__) == (__USARTX__)->TX_Buffer_lastEL))
+/********************************************************************************************/
+/*	the options of one Interrupt Transmission (UART_Transmit_INT)								*/
+/*	the CRC text is inserted before the last element											*/
+#define     UART_TX_CRC_TEXT                                    0x01U
+/*	the Transmission ends by its size only														*/
+#define     UART_TX_SIZE_ONLY                                   0x02U
+/********************************************************************************************/
 static Uart_Fun_Status UART_Transmit_Handler(USART_Struct *USARTx);
 static Uart_Fun_Status UART_Receive_Handler(USART_Struct *USARTx);
+static Uart_Fun_Status UART_Receive_Element(USART_Struct *USARTx);
 static Uart_LOCK_ST    UART_Check_LockState(USART_Struct *USARTx ,COMM_TYPE _CommType_ );
+static u8              UART_Read_Element(USART_Struct *USARTx , u32 *Local_SR);
+static void            UART_Handle_RX_Errors(USART_Struct *USARTx , u32 Local_SR);
+static void            UART_Mark_Damaged(USART_Struct *USARTx);
+static Uart_Fun_Status UART_Transmit_Polling(USART_Struct *USARTx , u8 *ptData ,u16 Size, u32 Time_Limit ,u8 Last_element);
+static Uart_Fun_Status UART_Transmit_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size ,u8 Last_element , u8 Copy_Options);
+static void            UART_Start_TX(USART_Struct *USARTx , u8 *ptData , u16 Size , u8 Last_element , u8 Copy_Options);
+static Uart_Fun_Status UART_Load_TX_Element(USART_Struct *USARTx , u8 *Copy_Element);
+static Uart_Fun_Status UART_TX_Element_Done(USART_Struct *USARTx , u8 Copy_Element);
+static void            UART_TX_End(USART_Struct *USARTx);
+#if USART_CRC == Enable
+static u32             UART_CRC_Update(Uart_CRC_Type Copy_Type , u32 Copy_CRC , u8 Copy_Element);
+static void            UART_RX_CRC_Add(USART_Struct *USARTx , const u8 *Copy_Next , u16 Copy_Count);
+static u8              UART_RX_CRC_End(USART_Struct *USARTx , const u8 *Copy_End , u16 Copy_Count);
+#endif
+#if USART_POOL == Enable
+static u8              UART_Pool_Take(void);
+static Uart_Fun_Status UART_Pool_Give(u8 Copy_Block);
+static void            UART_Pool_RX_End(USART_Struct *USARTx , Uart_Fun_Status Copy_Status);
+#endif
+#if USART_TRACE == Enable
+static void            UART_Trace_Add(USART_Struct *USARTx , USART_Trace_Event Copy_Event , u16 Copy_Data);
+static Uart_Fun_Status UART_Trace_Put(USART_Struct *USARTx , u8 Copy_Element);
+#endif
+static Uart_Fun_Status UART_Receive_Polling( USART_Struct *USARTx , u8 *ptData ,u16 Size_Limit , u32 Wait_Time, u8 Last_element);
+static u32             UART_Compute_BRR(u32 Copy_Baud , u8 Copy_Over8);
+static u8              UART_Between_Frames(USART_Struct *USARTx);
+static void            UART_Write_Baud(USART_Struct *USARTx , u32 Copy_Baud);
+static void            UART_Wait_TC(USART_Struct *USARTx);
+#if USART_BAUD_FALLBACK == Enable
+static void            UART_Baud_Window(USART_Struct *USARTx , u32 Copy_SR);
+static void            UART_Baud_Fallback(USART_Struct *USARTx);
+#endif
+#if USART_SYNC == Enable
+static void            UART_Sync_Load(USART_Struct *USARTx);
+static void            UART_Sync_Element(USART_Struct *USARTx);
+#endif
+#if USART_MODBUS == Enable
+static void            UART_Modbus_Times(USART_Struct *USARTx);
+static void            UART_Modbus_Element(USART_Struct *USARTx);
+static void            UART_Modbus_Idle(USART_Struct *USARTx);
+static void            UART_Modbus_End(USART_Struct *USARTx);
+static void            UART_Modbus_Drop(USART_Struct *USARTx);
+#endif
+#if USART_WRITE == Enable
+static u16             UART_Write_Span(USART_Struct *USARTx);
+static Uart_Fun_Status UART_Write_Next(USART_Struct *USARTx);
+static Uart_Fun_Status UART_Write_Send(USART_Struct *USARTx , u8 Copy_Force);
+#endif
+#if USART_RX_TIMEOUT == Enable
+static u8              UART_RX_Timeout_Check(USART_Struct *USARTx , u32 Copy_SR);
+static Uart_Fun_Status UART_RX_Timeout_End(USART_Struct *USARTx);
+static void            UART_RX_Timeout_Finish(USART_Struct *USARTx);
+#endif
+#if (USART_MODBUS == Enable) || (USART_RX_TIMEOUT == Enable)
+static void            UART_Idle_Handler(USART_Struct *USARTx);
+#endif
+#if USART_RX_RING == Enable
+static void            UART_Ring_Element(USART_Struct *USARTx);
+#endif
+#if USART_STATISTICS == Enable
+static void            UART_Stats_ISR_End(USART_Struct *USARTx , u32 Copy_Start);
+static u8              UART_Append_Number(u8 *Copy_Buffer , u32 Copy_Number , u8 Copy_Separator);
+#endif
+#if USART_CAPTURE == Enable
+/*	the replayed frames that wait for their Reception at the Sink	*/
+typedef struct{
+
+	u32				 End_Cycle[REPLAY_PENDING_FRAMES];	/*	 The Transmission cycles of the frames' ends	  */
+	u32				 Sink_Frames;				/*	 		The frames of the Sink that are counted		 		  */
+	u8				 Head;						/*	 		The oldest waiting frame					 		  */
+	u8				 Count;						/*	 		Number of the waiting frames				 		  */
+
+}UART_Replay_Pending;
+static void            UART_Replay_Serve(USART_Replay_Config *Copy_Config , USART_Replay_Report *Copy_Report ,
+                                         UART_Replay_Pending *Copy_Pending , u8 Copy_Restart);
+#endif
 /********************************************************************************************/
 static void (* USART1_CallBack) (void) = NULL ;
 u8  __USART1__INTERRUPT_TYPE__ ;
@@ -29,6 +152,112 @@ USART_Struct *USART1_Struct;
 USART_Struct *USART2_Struct;
 USART_Struct *USART6_Struct;
 /********************************************************************************************/
+#if USART_POOL == Enable
+#if (POOL_BLOCKS_NUM == 0) || (POOL_BLOCKS_NUM > 32)
+#error "POOL_BLOCKS_NUM should be from 1 to 32, the used blocks are the bits of one word"
+#endif
+/*	the map of the used blocks, it is changed only by the exclusive access	*/
+#define     POOL_FULL_MAP       (0xFFFFFFFFUL >> (32U - POOL_BLOCKS_NUM))
+static volatile u32 UART_Pool_Map = 0;
+static u8           UART_Pool[POOL_BLOCKS_NUM][POOL_BLOCK_SIZE] __attribute__((aligned(4)));
+#endif
+#if USART_TRACE == Enable
+#if (TRACE_RECORDS & (TRACE_RECORDS - 1)) != 0
+#error "TRACE_RECORDS should be a power of 2"
+#endif
+/*	the records and the number of the recorded events, the next record is claimed by the	*/
+/*	exclusive access, so an Interrupt that records in the middle takes the next one.		*/
+static USART_Trace_Record UART_Trace[TRACE_RECORDS];
+static volatile u32 UART_Trace_Count = 0;
+static volatile u8  UART_Trace_State = Enable;
+#endif
+#if (USART_MODBUS == Enable) && (USART_CRC != Enable)
+#error "the Modbus RTU mode needs the USART_CRC option (the CRC-16 table)"
+#endif
+/********************************************************************************************/
+#if USART_CRC == Enable
+/********************************************************************************************/
+/*      The CRC-16/MODBUS table (reflected polynomial 0xA001) of the running CRC            */
+/********************************************************************************************/
+static const u16 UART_CRC16_Table[256] =
+{
+    0x0000U, 0xC0C1U, 0xC181U, 0x0140U, 0xC301U, 0x03C0U, 0x0280U, 0xC241U,
+    0xC601U, 0x06C0U, 0x0780U, 0xC741U, 0x0500U, 0xC5C1U, 0xC481U, 0x0440U,
+    0xCC01U, 0x0CC0U, 0x0D80U, 0xCD41U, 0x0F00U, 0xCFC1U, 0xCE81U, 0x0E40U,
+    0x0A00U, 0xCAC1U, 0xCB81U, 0x0B40U, 0xC901U, 0x09C0U, 0x0880U, 0xC841U,
+    0xD801U, 0x18C0U, 0x1980U, 0xD941U, 0x1B00U, 0xDBC1U, 0xDA81U, 0x1A40U,
+    0x1E00U, 0xDEC1U, 0xDF81U, 0x1F40U, 0xDD01U, 0x1DC0U, 0x1C80U, 0xDC41U,
+    0x1400U, 0xD4C1U, 0xD581U, 0x1540U, 0xD701U, 0x17C0U, 0x1680U, 0xD641U,
+    0xD201U, 0x12C0U, 0x1380U, 0xD341U, 0x1100U, 0xD1C1U, 0xD081U, 0x1040U,
+    0xF001U, 0x30C0U, 0x3180U, 0xF141U, 0x3300U, 0xF3C1U, 0xF281U, 0x3240U,
+    0x3600U, 0xF6C1U, 0xF781U, 0x3740U, 0xF501U, 0x35C0U, 0x3480U, 0xF441U,
+    0x3C00U, 0xFCC1U, 0xFD81U, 0x3D40U, 0xFF01U, 0x3FC0U, 0x3E80U, 0xFE41U,
+    0xFA01U, 0x3AC0U, 0x3B80U, 0xFB41U, 0x3900U, 0xF9C1U, 0xF881U, 0x3840U,
+    0x2800U, 0xE8C1U, 0xE981U, 0x2940U, 0xEB01U, 0x2BC0U, 0x2A80U, 0xEA41U,
+    0xEE01U, 0x2EC0U, 0x2F80U, 0xEF41U, 0x2D00U, 0xEDC1U, 0xEC81U, 0x2C40U,
+    0xE401U, 0x24C0U, 0x2580U, 0xE541U, 0x2700U, 0xE7C1U, 0xE681U, 0x2640U,
+    0x2200U, 0xE2C1U, 0xE381U, 0x2340U, 0xE101U, 0x21C0U, 0x2080U, 0xE041U,
+    0xA001U, 0x60C0U, 0x6180U, 0xA141U, 0x6300U, 0xA3C1U, 0xA281U, 0x6240U,
+    0x6600U, 0xA6C1U, 0xA781U, 0x6740U, 0xA501U, 0x65C0U, 0x6480U, 0xA441U,
+    0x6C00U, 0xACC1U, 0xAD81U, 0x6D40U, 0xAF01U, 0x6FC0U, 0x6E80U, 0xAE41U,
+    0xAA01U, 0x6AC0U, 0x6B80U, 0xAB41U, 0x6900U, 0xA9C1U, 0xA881U, 0x6840U,
+    0x7800U, 0xB8C1U, 0xB981U, 0x7940U, 0xBB01U, 0x7BC0U, 0x7A80U, 0xBA41U,
+    0xBE01U, 0x7EC0U, 0x7F80U, 0xBF41U, 0x7D00U, 0xBDC1U, 0xBC81U, 0x7C40U,
+    0xB401U, 0x74C0U, 0x7580U, 0xB541U, 0x7700U, 0xB7C1U, 0xB681U, 0x7640U,
+    0x7200U, 0xB2C1U, 0xB381U, 0x7340U, 0xB101U, 0x71C0U, 0x7080U, 0xB041U,
+    0x5000U, 0x90C1U, 0x9181U, 0x5140U, 0x9301U, 0x53C0U, 0x5280U, 0x9241U,
+    0x9601U, 0x56C0U, 0x5780U, 0x9741U, 0x5500U, 0x95C1U, 0x9481U, 0x5440U,
+    0x9C01U, 0x5CC0U, 0x5D80U, 0x9D41U, 0x5F00U, 0x9FC1U, 0x9E81U, 0x5E40U,
+    0x5A00U, 0x9AC1U, 0x9B81U, 0x5B40U, 0x9901U, 0x59C0U, 0x5880U, 0x9841U,
+    0x8801U, 0x48C0U, 0x4980U, 0x8941U, 0x4B00U, 0x8BC1U, 0x8A81U, 0x4A40U,
+    0x4E00U, 0x8EC1U, 0x8F81U, 0x4F40U, 0x8D01U, 0x4DC0U, 0x4C80U, 0x8C41U,
+    0x4400U, 0x84C1U, 0x8581U, 0x4540U, 0x8701U, 0x47C0U, 0x4680U, 0x8641U,
+    0x8201U, 0x42C0U, 0x4380U, 0x8341U, 0x4100U, 0x81C1U, 0x8081U, 0x4040U
+};
+/********************************************************************************************/
+/*      The CRC-32 table (reflected polynomial 0xEDB88320) of the running CRC               */
+/********************************************************************************************/
+static const u32 UART_CRC32_Table[256] =
+{
+    0x00000000U, 0x77073096U, 0xEE0E612CU, 0x990951BAU, 0x076DC419U, 0x706AF48FU, 0xE963A535U, 0x9E6495A3U,
+    0x0EDB8832U, 0x79DCB8A4U, 0xE0D5E91EU, 0x97D2D988U, 0x09B64C2BU, 0x7EB17CBDU, 0xE7B82D07U, 0x90BF1D91U,
+    0x1DB71064U, 0x6AB020F2U, 0xF3B97148U, 0x84BE41DEU, 0x1ADAD47DU, 0x6DDDE4EBU, 0xF4D4B551U, 0x83D385C7U,
+    0x136C9856U, 0x646BA8C0U, 0xFD62F97AU, 0x8A65C9ECU, 0x14015C4FU, 0x63066CD9U, 0xFA0F3D63U, 0x8D080DF5U,
+    0x3B6E20C8U, 0x4C69105EU, 0xD56041E4U, 0xA2677172U, 0x3C03E4D1U, 0x4B04D447U, 0xD20D85FDU, 0xA50AB56BU,
+    0x35B5A8FAU, 0x42B2986CU, 0xDBBBC9D6U, 0xACBCF940U, 0x32D86CE3U, 0x45DF5C75U, 0xDCD60DCFU, 0xABD13D59U,
+    0x26D930ACU, 0x51DE003AU, 0xC8D75180U, 0xBFD06116U, 0x21B4F4B5U, 0x56B3C423U, 0xCFBA9599U, 0xB8BDA50FU,
+    0x2802B89EU, 0x5F058808U, 0xC60CD9B2U, 0xB10BE924U, 0x2F6F7C87U, 0x58684C11U, 0xC1611DABU, 0xB6662D3DU,
+    0x76DC4190U, 0x01DB7106U, 0x98D220BCU, 0xEFD5102AU, 0x71B18589U, 0x06B6B51FU, 0x9FBFE4A5U, 0xE8B8D433U,
+    0x7807C9A2U, 0x0F00F934U, 0x9609A88EU, 0xE10E9818U, 0x7F6A0DBBU, 0x086D3D2DU, 0x91646C97U, 0xE6635C01U,
+    0x6B6B51F4U, 0x1C6C6162U, 0x856530D8U, 0xF262004EU, 0x6C0695EDU, 0x1B01A57BU, 0x8208F4C1U, 0xF50FC457U,
+    0x65B0D9C6U, 0x12B7E950U, 0x8BBEB8EAU, 0xFCB9887CU, 0x62DD1DDFU, 0x15DA2D49U, 0x8CD37CF3U, 0xFBD44C65U,
+    0x4DB26158U, 0x3AB551CEU, 0xA3BC0074U, 0xD4BB30E2U, 0x4ADFA541U, 0x3DD895D7U, 0xA4D1C46DU, 0xD3D6F4FBU,
+    0x4369E96AU, 0x346ED9FCU, 0xAD678846U, 0xDA60B8D0U, 0x44042D73U, 0x33031DE5U, 0xAA0A4C5FU, 0xDD0D7CC9U,
+    0x5005713CU, 0x270241AAU, 0xBE0B1010U, 0xC90C2086U, 0x5768B525U, 0x206F85B3U, 0xB966D409U, 0xCE61E49FU,
+    0x5EDEF90EU, 0x29D9C998U, 0xB0D09822U, 0xC7D7A8B4U, 0x59B33D17U, 0x2EB40D81U, 0xB7BD5C3BU, 0xC0BA6CADU,
+    0xEDB88320U, 0x9ABFB3B6U, 0x03B6E20CU, 0x74B1D29AU, 0xEAD54739U, 0x9DD277AFU, 0x04DB2615U, 0x73DC1683U,
+    0xE3630B12U, 0x94643B84U, 0x0D6D6A3EU, 0x7A6A5AA8U, 0xE40ECF0BU, 0x9309FF9DU, 0x0A00AE27U, 0x7D079EB1U,
+    0xF00F9344U, 0x8708A3D2U, 0x1E01F268U, 0x6906C2FEU, 0xF762575DU, 0x806567CBU, 0x196C3671U, 0x6E6B06E7U,
+    0xFED41B76U, 0x89D32BE0U, 0x10DA7A5AU, 0x67DD4ACCU, 0xF9B9DF6FU, 0x8EBEEFF9U, 0x17B7BE43U, 0x60B08ED5U,
+    0xD6D6A3E8U, 0xA1D1937EU, 0x38D8C2C4U, 0x4FDFF252U, 0xD1BB67F1U, 0xA6BC5767U, 0x3FB506DDU, 0x48B2364BU,
+    0xD80D2BDAU, 0xAF0A1B4CU, 0x36034AF6U, 0x41047A60U, 0xDF60EFC3U, 0xA867DF55U, 0x316E8EEFU, 0x4669BE79U,
+    0xCB61B38CU, 0xBC66831AU, 0x256FD2A0U, 0x5268E236U, 0xCC0C7795U, 0xBB0B4703U, 0x220216B9U, 0x5505262FU,
+    0xC5BA3BBEU, 0xB2BD0B28U, 0x2BB45A92U, 0x5CB36A04U, 0xC2D7FFA7U, 0xB5D0CF31U, 0x2CD99E8BU, 0x5BDEAE1DU,
+    0x9B64C2B0U, 0xEC63F226U, 0x756AA39CU, 0x026D930AU, 0x9C0906A9U, 0xEB0E363FU, 0x72076785U, 0x05005713U,
+    0x95BF4A82U, 0xE2B87A14U, 0x7BB12BAEU, 0x0CB61B38U, 0x92D28E9BU, 0xE5D5BE0DU, 0x7CDCEFB7U, 0x0BDBDF21U,
+    0x86D3D2D4U, 0xF1D4E242U, 0x68DDB3F8U, 0x1FDA836EU, 0x81BE16CDU, 0xF6B9265BU, 0x6FB077E1U, 0x18B74777U,
+    0x88085AE6U, 0xFF0F6A70U, 0x66063BCAU, 0x11010B5CU, 0x8F659EFFU, 0xF862AE69U, 0x616BFFD3U, 0x166CCF45U,
+    0xA00AE278U, 0xD70DD2EEU, 0x4E048354U, 0x3903B3C2U, 0xA7672661U, 0xD06016F7U, 0x4969474DU, 0x3E6E77DBU,
+    0xAED16A4AU, 0xD9D65ADCU, 0x40DF0B66U, 0x37D83BF0U, 0xA9BCAE53U, 0xDEBB9EC5U, 0x47B2CF7FU, 0x30B5FFE9U,
+    0xBDBDF21CU, 0xCABAC28AU, 0x53B39330U, 0x24B4A3A6U, 0xBAD03605U, 0xCDD70693U, 0x54DE5729U, 0x23D967BFU,
+    0xB3667A2EU, 0xC4614AB8U, 0x5D681B02U, 0x2A6F2B94U, 0xB40BBE37U, 0xC30C8EA1U, 0x5A05DF1BU, 0x2D02EF8DU
+};
+/********************************************************************************************/
+/*      The hex digits of the CRC text that is inserted before the TX last element          */
+/********************************************************************************************/
+static const u8 UART_Hex_Digits[16] = {'0','1','2','3','4','5','6','7','8','9','A','B','C','D','E','F'};
+/********************************************************************************************/
+#endif
 
 
 /// @brief  MCAL_USART_Init_      	: this function performs the Initialization process of The Peripheral .
@@ -51,79 +280,128 @@ Uart_Fun_Status	    MCAL_UART_Init_(USART_Struct *USARTx , MUSART_Frame_Config *
         else if (USARTx -> USART_x == USART2_R){ USART2_Struct = USARTx; }
         else if (USARTx -> USART_x == USART6_R){ USART6_Struct = USARTx; }
     }
+    // the configuration is composed in RAM, then every register is written once, the old bits are not kept.
+    u32 Local_CR2 = 0, Local_CR3 = 0;
+    // keep the Peripheral enabled if it is re-initialized while it works.
+    u32 Local_CR1 = (USARTx -> USART_x -> CR1) & (1UL << CR1_UE);
     /* First : define the Frame properties */  
     //  Word Size
-    USARTx->USART_x->CR1 |= ( USART_frame_struct -> M_VALUE << CR1_M ) ;
+    Local_CR1 |= ( USART_frame_struct -> M_VALUE << CR1_M ) ;
 
     // Parity Bit 
     switch (USART_frame_struct -> parity_op)
     {
     case Parity_Disable :
-        USARTx -> USART_x -> CR1 |= (Disable << CR1_PCE )  ; 
+        Local_CR1 |= (Disable << CR1_PCE )  ; 
         break;
 
     case Even_Parity :
-        USARTx -> USART_x -> CR1 |= (Enable << CR1_PCE ) | ( (Even_Parity -1)<< CR1_PS ) ;
+        Local_CR1 |= (Enable << CR1_PCE ) | ( (Even_Parity -1)<< CR1_PS ) ;
         break;
 
     case Odd_Parity :
-       USARTx -> USART_x -> CR1 |= (Enable << CR1_PCE ) | ( (Odd_Parity -1)<< CR1_PS ) ;
+        Local_CR1 |= (Enable << CR1_PCE ) | ( (Odd_Parity -1)<< CR1_PS ) ;
         break;
 
     default:   
         break;
     }
     // 3- Stop Bit Size
-    USARTx -> USART_x -> CR2 |= (USART_frame_struct -> Stop_Bit_NUM << CR2_STOP0 ) ;
+    Local_CR2 |= (USART_frame_struct -> Stop_Bit_NUM << CR2_STOP0 ) ;
 /*--------------------------------------------------------------------------------------------------*/
 // Second : define The Receiving data processes
 /*--------------------------------------------------------------------------------------------------*/
     // 1- Oversampling_Value type
-    USARTx -> USART_x -> CR1 |= (USART_receiving_struct -> Oversampling_type << CR1_OVER8) ;
+    Local_CR1 |= (USART_receiving_struct -> Oversampling_type << CR1_OVER8) ;
 
     // 2- OneBit_Sample method
-    USARTx -> USART_x -> CR3 |= (USART_receiving_struct -> OneBit_Sampling_method << CR3_ONEBIT) ;
+    Local_CR3 |= (USART_receiving_struct -> OneBit_Sampling_method << CR3_ONEBIT) ;
 /*--------------------------------------------------------------------------------------------------*/
 // third : define The Operation Mode
 /*--------------------------------------------------------------------------------------------------*/
-    // 1- Disable all Other Modes (LIN), (Synchronous), (Smartcard) and (IrDA)
-    USARTx -> USART_x -> CR2 |= (Disable << CR2_CLKEN) | (Disable << CR2_LINEN) ;
-    USARTx -> USART_x -> CR3 |= (Disable << CR3_IREN_) | (Disable << CR3_SCEN) ;
+    // 1- all Other Modes (LIN), (Synchronous), (Smartcard) and (IrDA) are Disabled, as their bits are not set.
+    USARTx -> CR1_Shadow = Local_CR1;
+    USARTx -> CR2_Shadow = Local_CR2;
+    USARTx -> CR3_Shadow = Local_CR3;
+    USARTx -> USART_x -> CR2 = Local_CR2;
+    USARTx -> USART_x -> CR3 = Local_CR3;
+    USARTx -> USART_x -> CR1 = Local_CR1;
 /*--------------------------------------------------------------------------------------------------*/
 // Fourth : define the Baud Rate
 /*--------------------------------------------------------------------------------------------------*/
-    // 1- get the value of the total DIV
-    f64 DIV = ((f64)(FCK)/(f64)((copy_u32BaudRate)*8*( 2 - GET_BIT(USARTx -> USART_x -> CR1 , CR1_OVER8) ) ) ) ;
-
-    // 2- get the DIV_mantissa value
-    u16 DIV_mantissa = (u16) DIV ;
-    // 3- put the DIV_mantissa into the (15-4)bits in the (BRR) register
-    USARTx -> USART_x -> BRR |= (DIV_mantissa << 4) ;
-
-    // 4- get the DIV_fraction value
-    u8 DIV_fraction = ( (DIV - DIV_mantissa) * 16 ) ;
-
-    // 5- Check if the value of the DIV_fraction is not greater the (15)
-    if (DIV_fraction <= 15)
-    {
-        // 6- if true, then put the DIV_fraction into the first four bits in the (BRR) register
-        USARTx -> USART_x -> BRR |= DIV_fraction ;
-    }
-    else
-    {
-        // 6- if false, then put zero into the first four bits in the (BRR) register
-        USARTx -> USART_x -> BRR &= (0xfff0) ;
-
-        // 7-add (1) to the DIV_mantissa value
-        DIV_mantissa++ ;
-
-        // 8- put the new DIV_mantissa into the (15-4)bits in the (BRR) register
-        USARTx -> USART_x -> BRR |= (DIV_mantissa << 4) ;
-    }
+    USARTx -> USART_x -> BRR = UART_Compute_BRR(copy_u32BaudRate, GET_BIT(Local_CR1 , CR1_OVER8));
+    __UART_CONTROL_WRITTEN(USARTx -> USART_x);
 /*--------------------------------------------------------------------------------------------------*/
 // Fifth : define the Error code in the USARTx Struct.
 /*--------------------------------------------------------------------------------------------------*/
     USARTx -> Error_Code = (u8 *)Error_1;
+/*--------------------------------------------------------------------------------------------------*/
+// Sixth : define the Receive Error policy and clear its counters.
+/*--------------------------------------------------------------------------------------------------*/
+    USARTx -> RX_Mode          = RX_Strict_Mode;
+    USARTx -> RX_Frame_Damaged = 0;
+    USARTx -> RX_Errors.PE_Counter     = 0;
+    USARTx -> RX_Errors.NE_Counter     = 0;
+    USARTx -> RX_Errors.FE_Counter     = 0;
+    USARTx -> RX_Errors.ORE_Counter    = 0;
+    USARTx -> RX_Errors.Damaged_Frames = 0;
+    USARTx -> Baud_Rate = copy_u32BaudRate;
+#if USART_BAUD_FALLBACK == Enable
+    USARTx -> Base_Baud_Rate   = copy_u32BaudRate;
+    USARTx -> Window_Elements  = 0;
+    USARTx -> Window_Errors    = 0;
+    USARTx -> Fallback_Pending = 0;
+    USARTx -> Fallback_Counter = 0;
+#endif
+    USARTx -> TX_CallBack = NULL;
+    USARTx -> RX_CallBack = NULL;
+#if USART_CRC == Enable
+    USARTx -> CRC_Type      = Uart_CRC_None;
+    USARTx -> RX_CRC_Check  = Disable;
+    USARTx -> TX_CRC_Pending = 0;
+    USARTx -> RX_CRC_Valid  = 0;
+#endif
+#if USART_STATISTICS == Enable
+    MCAL_UART_Stats_Reset(USARTx);
+#endif
+#if USART_TIMESTAMP == Enable
+    __UART_DWT_ENABLE();
+    USARTx -> RX_Time.First_Cycle        = 0;
+    USARTx -> RX_Time.End_Cycle          = 0;
+    USARTx -> RX_Time.Delivery_Cycle     = 0;
+    USARTx -> RX_Time.Latency_Cycles     = 0;
+    USARTx -> RX_Time.Max_Latency_Cycles = 0;
+    USARTx -> RX_Time_Delivered          = 1;
+#endif
+#if USART_TRACE == Enable
+    __UART_DWT_ENABLE();
+#endif
+#if USART_POOL == Enable
+    USARTx -> RX_Pool_Block = POOL_NO_BLOCK;
+    USARTx -> TX_Pool_Block = POOL_NO_BLOCK;
+    USARTx -> RX_Pool_In    = 0;
+    USARTx -> RX_Pool_Out   = 0;
+    USARTx -> RX_Pool_Drops = 0;
+#endif
+#if USART_SYNC == Enable
+    USARTx -> Sync_Active = 0;
+#endif
+#if USART_MODBUS == Enable
+    USARTx -> Modbus_Buffer = NULL;
+#endif
+#if USART_WRITE == Enable
+    USARTx -> Write_Buffer    = NULL;
+    USARTx -> Write_Streaming = 0;
+#endif
+#if USART_RX_RING == Enable
+    USARTx -> Ring_Buffer = NULL;
+#endif
+#if USART_RX_TIMEOUT == Enable
+    __UART_DWT_ENABLE();
+    USARTx -> RX_Gap_Cycles   = 0;
+    USARTx -> RX_Total_Cycles = 0;
+    USARTx -> RX_Gap_Idle     = 0;
+#endif
 /*--------------------------------------------------------------------------------------------------*/
     return  Uart_OK;
 }
@@ -136,7 +414,7 @@ Uart_Fun_Status	    MCAL_UART_Init_(USART_Struct *USARTx , MUSART_Frame_Config *
 /// @retval	Functions Status.
 Uart_Fun_Status	    MCAL_UART_Enable( USART_Struct *USARTx )
 {
-    __UART_ENABLE( USARTx -> USART_x );
+    __UART_ENABLE( USARTx );
     return Uart_OK;
 }
 
@@ -145,11 +423,112 @@ Uart_Fun_Status	    MCAL_UART_Enable( USART_Struct *USARTx )
 /// @retval	Functions Status.
 Uart_Fun_Status	    MCAL_UART_Disable( USART_Struct *USARTx )
 {
-    __UART_DISABLE( USARTx -> USART_x );
+    __UART_DISABLE( USARTx );
+    return Uart_OK;
+}
+
+
+
+/// @brief  MCAL_UART_Set_Baud : this function changes the Baud rate between frames, the last Transmitted element leaves
+///                              the shift register first, then (BRR) is written with the Peripheral disabled.
+/// @param  USARTx             : the Struct of Peripheral's Registers.
+/// @param  Copy_Baud          : the new Baud rate.
+/// @retval Functions Status, (Uart_BUSY) if a Transmission or the Reception of a frame is in progress.
+Uart_Fun_Status	    MCAL_UART_Set_Baud(USART_Struct *USARTx , u32 Copy_Baud)
+{
+    if ((USARTx == NULL) || (Copy_Baud == 0)){ return  Uart_ERROR; }
+    if (UART_Between_Frames(USARTx) == 0){ return Uart_BUSY; }
+
+    UART_Write_Baud(USARTx, Copy_Baud);
+#if USART_BAUD_FALLBACK == Enable
+    // the errors of the old Baud rate are not counted for the new one.
+    USARTx -> Window_Elements  = 0;
+    USARTx -> Window_Errors    = 0;
+    USARTx -> Fallback_Pending = 0;
+#endif
     return Uart_OK;
 }
 
 
+/// @brief  UART_Compute_BRR : it calculates the (BRR) value of a Baud rate.
+/// @param  Copy_Baud        : the Baud rate.
+/// @param  Copy_Over8       : the (OVER8) bit.
+/// @return the (BRR) value.
+static u32 UART_Compute_BRR(u32 Copy_Baud , u8 Copy_Over8)
+{
+    // 1- get the rounded (FCK / Baud), it is the DIV in (1/16) units with (OVER8 = 0), or in (1/8) units with (OVER8 = 1)
+    u32 Local_DIV = (u32)(((u64)FCK + (Copy_Baud / 2U)) / Copy_Baud) ;
+
+    // 2- get the DIV_mantissa value, a rounded fraction that reaches a whole one is carried into it here
+    u32 DIV_mantissa = Local_DIV >> (4U - Copy_Over8) ;
+
+    // 3- get the DIV_fraction value, with (OVER8 = 1) it has three bits and the bit (3) stays clear
+    u32 DIV_fraction = Local_DIV & ((Copy_Over8 != 0) ? 0x07U : 0x0FU) ;
+
+    // 4- put the DIV_mantissa into the (15-4)bits and the DIV_fraction into the first four bits of the (BRR) value
+    return (DIV_mantissa << 4) | DIV_fraction ;
+}
+
+
+/// @brief  UART_Between_Frames : it checks that no element is moving, the Reception may be waiting for its first element
+///                               or dropping a damaged frame.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @return (1) if the Baud rate can be changed, or (0) if not.
+static u8 UART_Between_Frames(USART_Struct *USARTx)
+{
+    if (USARTx -> TX_Lock_Flag == BUSY){ return 0; }
+    if ((USARTx -> RX_Lock_Flag == BUSY) && (USARTx -> RX_Frame_Damaged == 0) &&
+        (USARTx -> RX_Process_Count != (s16)(USARTx -> RX_Buffer_Size))){ return 0; }
+    return 1;
+}
+
+
+/// @brief  UART_Write_Baud : it waits for the end of the last Transmitted element (TC), then writes (BRR) with the
+///                           Peripheral disabled, so no element is sent or Received by two Baud rates.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @param  Copy_Baud       : the new Baud rate.
+/// @return None.
+static void UART_Write_Baud(USART_Struct *USARTx , u32 Copy_Baud)
+{
+    u32 Local_BRR  = UART_Compute_BRR(Copy_Baud, __UART_SHADOW_GET(USARTx, CR1, CR1_OVER8));
+    u8  Local_UE   = __UART_SHADOW_GET(USARTx, CR1, CR1_UE);
+
+    if (Local_UE == 1)
+    {
+        UART_Wait_TC(USARTx);
+    }
+    __UART_DISABLE(USARTx);
+    USARTx -> USART_x -> BRR = Local_BRR;
+    __UART_CONTROL_WRITTEN(USARTx -> USART_x);
+    if (Local_UE == 1)
+    {
+        __UART_ENABLE(USARTx);
+    }
+    USARTx -> Baud_Rate = Copy_Baud;
+#if USART_MODBUS == Enable
+    UART_Modbus_Times(USARTx);
+#endif
+}
+
+
+/// @brief  UART_Wait_TC : it waits for the end of the last Transmitted element (TC), up to one element time at the
+///                        current Baud rate (12 bits : start, 9 data and 2 stop bits) by the DWT cycle counter.
+/// @param  USARTx       : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Wait_TC(USART_Struct *USARTx)
+{
+    u32 Local_Baud  = (USARTx -> Baud_Rate != 0) ? USARTx -> Baud_Rate : 1U;
+    u32 Local_Limit = (u32)((12ULL * FCK) / Local_Baud);
+    u32 Local_Start;
+
+    __UART_DWT_ENABLE();
+    Local_Start = DWT_CYCCNT_R;
+    while ((__UART_GET_FLAG(USARTx -> USART_x, __TC__) == 0) && ((DWT_CYCCNT_R - Local_Start) < Local_Limit))
+    {
+    }
+}
+
+
 
 
 /// @brief MCAL_USART_Transmit   : this function Transmit a given data by the synchronous mode " Blocking".
@@ -159,6 +538,24 @@ Uart_Fun_Status	    MCAL_UART_Disable( USART_Struct *USARTx )
 /// @param Time_Limit            : the maximum time for this function. 
 ///@retval Functions Status.
 Uart_Fun_Status	    MCAL_UART_Transmit(USART_Struct *USARTx , u8 *ptData ,u16 Size, u32 Time_Limit ,u8 Last_element)
+{
+    __UART_STATS_START(Local_Cycles);
+    __UART_TRACE(USARTx, Trace_TX_Polling, Size);
+    Uart_Fun_Status Local_Status = UART_Transmit_Polling(USARTx, ptData, Size, Time_Limit, Last_element);
+    __UART_TRACE(USARTx, Trace_Return, Local_Status);
+    __UART_STATS_CPU_END(USARTx, Local_Cycles);
+    return Local_Status;
+}
+
+
+/// @brief UART_Transmit_Polling : the Blocking Transmission process of MCAL_UART_Transmit.
+/// @param USARTx                : the Struct of Peripheral's Registers.
+/// @param ptData                : pointer of data we want to Transmit.
+/// @param Size                  : the size of the data that will be Transmitted.
+/// @param Time_Limit            : the maximum time for this function.
+/// @param Last_element          : the last element that should be Transmitted.
+///@retval Functions Status.
+static Uart_Fun_Status UART_Transmit_Polling(USART_Struct *USARTx , u8 *ptData ,u16 Size, u32 Time_Limit ,u8 Last_element)
 {    
     // Check the Given data and the size values.
     if( (ptData == NULL ) || (Size == 0) || (Time_Limit == 0)){ return  Uart_ERROR; }
@@ -171,7 +568,8 @@ Uart_Fun_Status	    MCAL_UART_Transmit(USART_Struct *USARTx , u8 *ptData ,u16 Si
     USARTx ->TX_Lock_Flag = BUSY;
     USARTx ->TX_Lock_Counter = 0;
 
-    u8 *Local_buffer;
+    u8 Local_Element = 0;
+    Uart_Fun_Status Local_Status;
 
     // Disable Rx.
     __COMM_DISABLE(USARTx,RX);
@@ -179,11 +577,7 @@ Uart_Fun_Status	    MCAL_UART_Transmit(USART_Struct *USARTx , u8 *ptData ,u16 Si
     __COMM_ENABLE(USARTx,TX);
 
     // Define the rest of elements iin the USARTx Struct.
-    USARTx -> TX_Buffer_Ptr     = ptData;
-    USARTx -> TX_Buffer_Size    = Size;
-    USARTx -> TX_Process_Count  = (s16)Size;
-    USARTx -> Error_Code        = (u8 *)Error_1;
-    USARTx -> TX_Buffer_lastEL  = Last_element;
+    UART_Start_TX(USARTx, ptData, Size, Last_element, 0);
     // start timer;
     MSTK_voidStartTimer();
     // enter the Transmission process, send {MSB} first.
@@ -199,15 +593,11 @@ Uart_Fun_Status	    MCAL_UART_Transmit(USART_Struct *USARTx , u8 *ptData ,u16 Si
             __COMM_DISABLE(USARTx,TX);
             return Uart_TIMEOUT;
         }
-        /* Check the (TRANSMIT DATA REGISTER EMPTY) flag "TXE" in SR register if it is {1} or not , 
-           and check the local_counter to know if we in the first location or not. */
-        if((__UART_GET_FLAG(USARTx -> USART_x,__TXE__) == 1) || ( (USARTx -> TX_Process_Count) == Size) )
+        /* Check the (TRANSMIT DATA REGISTER EMPTY) flag "TXE" in SR register if it is {1} or not. */
+        if(__UART_GET_FLAG(USARTx -> USART_x,__TXE__) == 1)
         {
-            (USARTx -> TX_Process_Count)--;
-        	Local_buffer = (u8 *)ptData;
             // load the Transmit word into the (DR) register 
-            USARTx -> USART_x -> DR =  (*Local_buffer & (u8)0x00FF);
-            ptData += 1U ;
+            Local_Status = UART_Load_TX_Element(USARTx, &Local_Element);
             // Check the (TRANSMISSION COMPLETE) flag "TC" in SR register if it is {0} or not and wait till it is {1}.
             while (__UART_GET_FLAG(USARTx -> USART_x,__TC__) == 0 )
             { 
@@ -225,33 +615,22 @@ Uart_Fun_Status	    MCAL_UART_Transmit(USART_Struct *USARTx , u8 *ptData ,u16 Si
             }
             // clear the {TC} flag.
             __UART_CLEAR_FLAG(USARTx -> USART_x, __TC__);
-            // Check the last element.
-            if ( *Local_buffer == Last_element)
+            // Check the end of the Transmission, the inserted CRC digits are not counted.
+            if (Local_Status == Uart_OK)
             {
-                (USARTx -> TX_Buffer_Size) -= (USARTx -> TX_Process_Count+1);
-                MSTK_voidStopTimer();
-                USARTx ->TX_Lock_Flag = IDLE;
-                USARTx ->TX_Lock_Counter = 0;
-                // Disable Tx.
-                __COMM_DISABLE(USARTx,TX);
-                return Uart_UNDERSIZE ;
+                Local_Status = UART_TX_Element_Done(USARTx, Local_Element);
+                if (Local_Status != Uart_OK)
+                {
+                    MSTK_voidStopTimer();
+                    // Disable Tx.
+                    __COMM_DISABLE(USARTx,TX);
+                    return Local_Status;
+                }
             }
         }
     }
-    if (*Local_buffer != USARTx -> TX_Buffer_lastEL )
-    {
-        MSTK_voidStopTimer();
-        USARTx ->TX_Lock_Flag = IDLE;
-        USARTx ->TX_Lock_Counter = 0;
-        // Disable Tx.
-        __COMM_DISABLE(USARTx,TX);
-        return Uart_OVERSIZE ;
-    }
     // stop the Timer.
     MSTK_voidStopTimer();
-    USARTx -> TX_Process_Count = 0;
-    USARTx ->TX_Lock_Flag = IDLE;
-    USARTx ->TX_Lock_Counter = 0;
     // Disable Tx.
     __COMM_DISABLE(USARTx,TX);
     return Uart_OK;
@@ -266,6 +645,27 @@ Uart_Fun_Status	    MCAL_UART_Transmit(USART_Struct *USARTx , u8 *ptData ,u16 Si
 /// @param Last_element          : the last element that should be Received.
 ///@retval Functions Status
 Uart_Fun_Status MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_Limit , u32 Wait_Time, u8 Last_element)
+{
+    __UART_STATS_START(Local_Cycles);
+    __UART_TRACE(USARTx, Trace_RX_Polling, Size_Limit);
+    Uart_Fun_Status Local_Status = UART_Receive_Polling(USARTx, ptData, Size_Limit, Wait_Time, Last_element);
+    __UART_TRACE(USARTx, Trace_Return, Local_Status);
+#if USART_BAUD_FALLBACK == Enable
+    UART_Baud_Fallback(USARTx);
+#endif
+    __UART_STATS_CPU_END(USARTx, Local_Cycles);
+    return Local_Status;
+}
+
+
+/// @brief UART_Receive_Polling : the Blocking Reception process of MCAL_UART_Receive.
+/// @param USARTx               : the Struct of Peripheral's Registers.
+/// @param ptData               : pointer of the buffer that will hold the Received data.
+/// @param Size_Limit           : the size of the buffer.
+/// @param Wait_Time            : the maximum time to wait for the first element.
+/// @param Last_element         : the last element that should be Received.
+///@retval Functions Status
+static Uart_Fun_Status UART_Receive_Polling( USART_Struct *USARTx , u8 *ptData ,u16 Size_Limit , u32 Wait_Time, u8 Last_element)
 {
     // Check the Given data and the size values.
     if( (ptData == NULL ) || (Size_Limit == 0) || (Wait_Time == 0)){ return  Uart_ERROR; }
@@ -278,6 +678,9 @@ Uart_Fun_Status MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_L
     USARTx ->RX_Lock_Flag = BUSY;
 
     u8 *Local_buffer;
+    u8  Local_Element;
+    u32 Local_SR;
+    u32 Local_Deadline;
 
     // Disable Tx.
     __COMM_DISABLE(USARTx,TX);
@@ -291,6 +694,17 @@ Uart_Fun_Status MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_L
     USARTx -> RX_Process_Count  = (s16)Size_Limit;
     USARTx -> Error_Code        = (u8 *)Error_1;
     USARTx -> RX_Buffer_lastEL  = Last_element;
+    USARTx -> RX_Frame_Damaged  = 0;
+#if USART_CRC == Enable
+    USARTx -> RX_CRC            = __UART_CRC_INIT(USARTx -> CRC_Type);
+    USARTx -> RX_CRC_Valid      = 0;
+#endif
+#if USART_TIMESTAMP == Enable
+    USARTx -> RX_Time_Delivered = 0;
+#endif
+#if USART_RX_TIMEOUT == Enable
+    USARTx -> RX_Start_Cycle    = DWT_CYCCNT_R;
+#endif
 
     // start timer;
     MSTK_voidStartTimer();
@@ -298,6 +712,15 @@ Uart_Fun_Status MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_L
     // wait until Receive first element.
     while ( !( __UART_GET_FLAG(USARTx -> USART_x,__RXNE__) ) )
     {
+#if USART_RX_TIMEOUT == Enable
+        // the total time ends the Reception with no elements.
+        if (UART_RX_Timeout_Check(USARTx, 0) == 1)
+        {
+            MSTK_voidStopTimer();
+            __COMM_DISABLE(USARTx,RX);
+            return UART_RX_Timeout_End(USARTx);
+        }
+#endif
         if(MSTK_u32GetElapsedTime() >= Wait_Time)
         {
             // stop the Timer.
@@ -313,79 +736,104 @@ Uart_Fun_Status MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_L
         }
     }
 
-    // enter the Transmission process
-    USARTx -> Time_Limit += MSTK_u32GetElapsedTime();
-    while ((USARTx -> RX_Process_Count) > 0)
+    // enter the Transmission process, every element should come in (Time_Limit) after the previous one.
+    Local_Deadline = MSTK_u32GetElapsedTime() + USARTx -> Time_Limit;
+    while (((USARTx -> RX_Process_Count) > 0) || (USARTx -> RX_Frame_Damaged == 1))
     {
         // Check the (Read DATA REGISTER Not EMPTY) flag "RXNE" in SR register if it is {1} or not.
         if(__UART_GET_FLAG(USARTx -> USART_x,__RXNE__))
         {
-            // check the OverWrite Error flag.
-            if (__UART_GET_FLAG(USARTx -> USART_x,__ORE__) ==  1)
-            {
-                USARTx -> Error_Code = (u8 *)Error_5;
-                USARTx ->RX_Lock_Flag = IDLE;
-                USARTx ->RX_Lock_Counter = 0;
-
-                // stop the Timer.
-                MSTK_voidStopTimer();
-
-                // Disable Rx.
-                __COMM_DISABLE(USARTx,RX);
-                return  Uart_ERROR;
-            }
+            // read the SR then the DR register, this sequence also clears the Error flags.
+            Local_Element = UART_Read_Element(USARTx, &Local_SR);
 
-            if ((__UART_GET_FLAG(USARTx -> USART_x,__PE__)||__UART_GET_FLAG(USARTx -> USART_x,__FE__)||__UART_GET_FLAG(USARTx -> USART_x,__NE__)) != 0)
+            // check the Receive Error flags.
+            if ((Local_SR & UART_RX_ERRORS_MASK) != 0)
             {
-                USARTx ->RX_Lock_Flag = IDLE;
-                USARTx ->RX_Lock_Counter = 0;
+                UART_Handle_RX_Errors(USARTx, Local_SR);
+                if (USARTx -> RX_Mode == RX_Strict_Mode)
+                {
+                    USARTx ->RX_Lock_Flag = IDLE;
+                    USARTx ->RX_Lock_Counter = 0;
 
-                // stop the Timer.
-                MSTK_voidStopTimer();
+                    // stop the Timer.
+                    MSTK_voidStopTimer();
 
-                // Disable Rx.
-                __COMM_DISABLE(USARTx,RX);
-                return  Uart_ERROR;
+                    // Disable Rx.
+                    __COMM_DISABLE(USARTx,RX);
+                    return  Uart_ERROR;
+                }
+                UART_Mark_Damaged(USARTx);
             }
 
-            (USARTx -> RX_Process_Count)--;
-            Local_buffer = (u8 *)ptData;
-
-            // check the parity if Enabled or Disable.
-            if (GET_BIT(USARTx->USART_x -> CR1,CR1_PCE) == 0)
+            if (USARTx -> RX_Frame_Damaged == 1)
             {
-                // store the Recevied word into the given pointer location.
-                *Local_buffer = (u8)(USARTx -> USART_x -> DR & (u8)0x00FF);
-                __UART_CLEAR_FLAG(USARTx -> USART_x,__RXNE__);
+                __UART_STATS_ADD(USARTx, Dropped_Bytes, 1);
+                // drop the elements till the frame boundary, then restart at the start of the given buffer.
+                if (Local_Element == Last_element)
+                {
+                    ptData = USARTx -> RX_Buffer_Ptr;
+                    USARTx -> RX_Process_Count = (s16)Size_Limit;
+                    USARTx -> RX_Frame_Damaged = 0;
+#if USART_CRC == Enable
+                    USARTx -> RX_CRC = __UART_CRC_INIT(USARTx -> CRC_Type);
+#endif
+                }
             }
-            // the parity bit is the 8th-bit.
-            else   
+            else
             {
+                (USARTx -> RX_Process_Count)--;
+                Local_buffer = (u8 *)ptData;
+
                 // store the Received word into the given pointer location.
-                *Local_buffer = (u8)(USARTx -> USART_x -> DR & (u8)0x007F);
-                __UART_CLEAR_FLAG(USARTx -> USART_x,__RXNE__);
-            }
+                *Local_buffer = Local_Element;
+                ptData += 1U ;
 
-            ptData += 1U ;
+                // Check the Received element.
+                if (*Local_buffer == Last_element)
+                {
+#if USART_CRC == Enable
+                    USARTx -> RX_CRC_Valid = UART_RX_CRC_End(USARTx, Local_buffer,
+                                                             (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count - 1));
+#endif
+#if USART_CAPTURE == Enable
+                    USARTx -> Frame_End_Cycle = DWT_CYCCNT_R;
+                    USARTx -> Frame_End_Counter++;
+#endif
+                    USARTx -> RX_Buffer_Size -= (USARTx -> RX_Process_Count +1);
+                    MSTK_voidStopTimer();
+                    USARTx ->RX_Lock_Flag = IDLE;
+                    USARTx ->RX_Lock_Counter = 0;
+                    // Disable Rx.
+                    __COMM_DISABLE(USARTx,RX);
+                    return Uart_UNDERSIZE ;
+                }
+#if USART_CRC == Enable
+                UART_RX_CRC_Add(USARTx, ptData, (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count));
+#endif
 
-            // Check the Received element.
-            if (*Local_buffer == Last_element)
-            {
-                USARTx -> RX_Buffer_Size -= (USARTx -> RX_Process_Count +1);
-                MSTK_voidStopTimer();
-                USARTx ->RX_Lock_Flag = IDLE;
-                USARTx ->RX_Lock_Counter = 0;
-                // Disable Rx.
-                __COMM_DISABLE(USARTx,RX);
-                return Uart_UNDERSIZE ;
+                // the buffer is full without the last element, drop this frame in the Resilient mode.
+                if (((USARTx -> RX_Process_Count) == 0) && (USARTx -> RX_Mode == RX_Resilient_Mode))
+                {
+                    USARTx -> Error_Code = (u8 *)Error_7;
+                    UART_Mark_Damaged(USARTx);
+                }
             }
 
-            // update the Time_Limit value;
-            USARTx -> Time_Limit += MSTK_u32GetElapsedTime();
+            // the time limit of the next element, the configured (Time_Limit) is not changed.
+            Local_Deadline = MSTK_u32GetElapsedTime() + USARTx -> Time_Limit;
+        }
+#if USART_RX_TIMEOUT == Enable
+        // the silence after the Received elements (the IDLE flag or the gap) or the total time ends the Reception.
+        else if (UART_RX_Timeout_Check(USARTx, USARTx -> USART_x -> SR) == 1)
+        {
+            MSTK_voidStopTimer();
+            __COMM_DISABLE(USARTx,RX);
+            return UART_RX_Timeout_End(USARTx);
         }
+#endif
 
         // check the Timer.
-        if (MSTK_u32GetElapsedTime() == USARTx -> Time_Limit)
+        if (MSTK_u32GetElapsedTime() >= Local_Deadline)
         {
             // stop the Timer.
             MSTK_voidStopTimer();
@@ -431,85 +879,124 @@ Uart_Fun_Status MCAL_UART_Receive( USART_Struct *USARTx , u8 *ptData ,u16 Size_L
 /// @param USARTx                   : the Struct of Peripheral's Registers.
 /// @param ptData                   : pointer of data we want to Transmit.
 /// @param Size                     : the size of the data that will be Transmitted.
-/// @param Time_Limit               : the maximum time for this function. 
-///@retval Functions Status.
+/// @param Last_element             : the last element that should be Transmitted.
+///@retval Functions Status, (Uart_OK) when the Transmission is started, its end (even at the first element) calls the
+///        TX callback.
 Uart_Fun_Status	    MCAL_UART_Transmit_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size ,u8 Last_element)
 {
+    return UART_Transmit_INT(USARTx, ptData, Size, Last_element, 0);
+}
+
+
+/// @brief MCAL_UART_Transmit_Size_INT : this function Transmits (Size) elements by the Interrupt mode like
+///                                      MCAL_UART_Transmit_INT, no element ends it earlier, so it sends the binary
+///                                      frames and the parts of a frame (no CRC text is inserted).
+/// @param USARTx                      : the Struct of Peripheral's Registers.
+/// @param ptData                      : pointer of data we want to Transmit.
+/// @param Size                        : the number of the elements that will be Transmitted.
+///@retval Functions Status, its end calls the TX callback with (TX_Buffer_Size) equal to (Size).
+Uart_Fun_Status	    MCAL_UART_Transmit_Size_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size)
+{
+    return UART_Transmit_INT(USARTx, ptData, Size, 0, UART_TX_SIZE_ONLY);
+}
+
+
+#if USART_CRC == Enable
+/// @brief MCAL_UART_Transmit_CRC_INT : this function Transmits one frame by the Interrupt mode like MCAL_UART_Transmit_INT
+///                                     and inserts the CRC text of its elements before its last element (the wire format
+///                                     above the Uart_CRC_Type), the next frames are sent without it.
+/// @param USARTx                     : the Struct of Peripheral's Registers, with a CRC type.
+/// @param ptData                     : pointer of data we want to Transmit.
+/// @param Size                       : the size of the data that will be Transmitted.
+/// @param Last_element               : the last element that should be Transmitted (not a hex digit).
+///@retval Functions Status, (Uart_ERROR) if the port has no CRC type.
+Uart_Fun_Status	    MCAL_UART_Transmit_CRC_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size ,u8 Last_element)
+{
+    if ((USARTx == NULL) || (USARTx -> CRC_Type == Uart_CRC_None)){ return  Uart_ERROR; }
+    return UART_Transmit_INT(USARTx, ptData, Size, Last_element, UART_TX_CRC_TEXT);
+}
+#endif
+
+
+/// @brief UART_Transmit_INT  : the Interrupt Transmission start of MCAL_UART_Transmit_INT and its variants.
+/// @param USARTx             : the Struct of Peripheral's Registers.
+/// @param ptData             : pointer of data we want to Transmit.
+/// @param Size               : the size of the data that will be Transmitted.
+/// @param Last_element       : the last element that should be Transmitted.
+/// @param Copy_Options       : the (UART_TX_xxx) options of this Transmission only.
+///@retval Functions Status.
+static Uart_Fun_Status UART_Transmit_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size ,u8 Last_element , u8 Copy_Options)
+{
+    __UART_TRACE(USARTx, Trace_TX_INT, Size);
     // Check the Given data and the size values.
     if( (ptData == NULL ) || (Size == 0) ){ return  Uart_ERROR; }
     if (UART_Check_LockState(USARTx ,TX ) == BUSY)
     {
+        __UART_TRACE(USARTx, Trace_Return, Uart_BUSY);
         return Uart_BUSY;
     }
     // the Starting conditions:
     USARTx ->TX_Lock_Flag = BUSY;
     USARTx ->TX_Lock_Counter = 0;
-
-    u8 *Local_buffer;
+    __UART_TRACE(USARTx, Trace_TX_Lock, BUSY);
+
+    u8 Local_Element;
+    u8 Local_End = 0;
+    u32 Local_State;
+    Uart_Fun_Status Local_Status = Uart_OK;
+
+    // the control bits are changed with the Interrupts disabled, as the Handlers of a Reception change the same shadow.
+    __UART_ENTER_CRITICAL(Local_State);
+    // a Reception in progress keeps the Rx enabled, so the link works in full-duplex, the Rx gets back its state at the end.
+    u8 Local_RX_Enabled = __UART_SHADOW_GET(USARTx, CR1, CR1_RE);
+    u8 Local_RX_Busy = (USARTx -> RX_Lock_Flag == BUSY);
     
    // Disable Rx.
-    __COMM_DISABLE(USARTx,RX);
+    if (Local_RX_Busy == 0)
+    {
+        __COMM_DISABLE(USARTx,RX);
+    }
     // Enable Tx
     __COMM_ENABLE(USARTx,TX);
 
     // Define the rest of elements iin the USARTx Struct.
-    USARTx -> TX_Buffer_Ptr     = ptData;
-    USARTx -> TX_Buffer_Size    = Size;
-    USARTx -> TX_Process_Count  = (s16)Size;
-    USARTx -> Error_Code        = (u8 *)Error_1;
-    USARTx -> TX_Buffer_lastEL  = Last_element;
+    UART_Start_TX(USARTx, ptData, Size, Last_element, Copy_Options);
     
     // Clear the Transmit complete flag.
     __UART_CLEAR_FLAG(USARTx -> USART_x ,__TC__);
     // Enable the TX register empty interrupt.
-    SET_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
+    __UART_SHADOW_SET(USARTx, CR1, CR1_TCIE);
 
     // Send First element.
-    if((__UART_GET_FLAG(USARTx -> USART_x,__TXE__) == 1) || ( (USARTx -> TX_Process_Count) == Size) )
-    {
-        (USARTx -> TX_Process_Count)--;
-        Local_buffer = (u8 *)USARTx -> TX_Buffer_Ptr;
-        // load the Transmit word into the (DR) register 
-        USARTx -> USART_x -> DR =  (*Local_buffer & (u8)0x00FF);
-        USARTx -> TX_Buffer_Ptr ++;
-        if(--USARTx->TX_Process_Count < 0)
-        {
-          /* Disable the UART Transmit Complete Interrupt */
-          CLR_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-          if (*Local_buffer != USARTx -> TX_Buffer_lastEL )
-            {
-                USARTx ->TX_Lock_Flag = IDLE;
-                USARTx ->TX_Lock_Counter = 0;
-                // Enable Rx
-                __COMM_ENABLE(USARTx,RX);
-                return Uart_OVERSIZE ;
-            }
-        }
-        else
+    if(__UART_GET_FLAG(USARTx -> USART_x,__TXE__) == 1)
+    {
+        // load the Transmit word into the (DR) register, the rest is sent by the TC interrupt.
+        if (UART_Load_TX_Element(USARTx, &Local_Element) == Uart_OK)
         {
-            // Check the last Transmitted element.
-            if (*Local_buffer == USARTx -> TX_Buffer_lastEL )
-            {
-                /* Disable the UART Transmit Complete Interrupt */
-                CLR_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-                (USARTx -> TX_Buffer_Size) -= ((USARTx -> TX_Process_Count) +1);
-                USARTx ->TX_Lock_Flag = IDLE;
-                USARTx ->TX_Lock_Counter = 0;
-                // Enable Rx
-                __COMM_ENABLE(USARTx,RX);
-                return Uart_UNDERSIZE ;
-            }
+            // a frame that ends at its first element is ended here by the same path as the Interrupt.
+            Local_End = (UART_TX_Element_Done(USARTx, Local_Element) != Uart_OK);
         }
     }
     else
     {
-       // Enable Rx
-       __COMM_ENABLE(USARTx,RX);
-        return Uart_ERROR;
+        /* Disable the UART Transmit Complete Interrupt */
+        __UART_SHADOW_CLR(USARTx, CR1, CR1_TCIE);
+        USARTx ->TX_Lock_Flag = IDLE;
+        USARTx ->TX_Lock_Counter = 0;
+        Local_Status = Uart_ERROR;
     }
-    // Enable Rx
-    __COMM_ENABLE(USARTx,RX);
-    return Uart_OK;
+    // Restore Rx.
+    if (Local_RX_Enabled == 1)
+    {
+        __COMM_ENABLE(USARTx,RX);
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+    __UART_TRACE(USARTx, Trace_Return, Local_Status);
+    if (Local_End == 1)
+    {
+        UART_TX_End(USARTx);
+    }
+    return Local_Status;
 }
 
 
@@ -518,55 +1005,161 @@ Uart_Fun_Status	    MCAL_UART_Transmit_INT(USART_Struct *USARTx , u8 *ptData ,u1
 /// @return Functions Status.
 static Uart_Fun_Status UART_Transmit_Handler(USART_Struct *USARTx)
 {
+    u8 Local_RXNEIE = __UART_SHADOW_GET(USARTx, CR1, CR1_RXNEIE);
+
     // Disable Read register not empty interrupt. 
-    CLR_BIT(USARTx -> USART_x ->CR1, CR1_RXNEIE);
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
 
-    u8 *Local_buffer;
+    u8 Local_Element;
+    Uart_Fun_Status Local_Status = Uart_BUSY;
     if (__UART_GET_FLAG(USARTx -> USART_x, __TXE__))
     {
-        (USARTx -> TX_Process_Count)--;
-        // load the Transmit word into the Local_buffer. 
-        Local_buffer = (u8 *)USARTx -> TX_Buffer_Ptr;
-        // load the Transmit word into the (DR) register 
-        USARTx -> USART_x -> DR =  (*Local_buffer & (u8)0x00FF);
-        USARTx -> TX_Buffer_Ptr += 1U;
         USARTx -> TX_Lock_Counter = 0;
-        // Check if the buffer reaches its end. 
-        if(--USARTx->TX_Process_Count < 0)
+        // load the Transmit word into the (DR) register, then check the end of the Transmission.
+        Local_Status = UART_Load_TX_Element(USARTx, &Local_Element);
+        if (Local_Status == Uart_OK)
         {
-          /* Disable the UART Transmit Complete Interrupt */
-          CLR_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-          if (*Local_buffer != USARTx -> TX_Buffer_lastEL )
-            {
-                USARTx ->TX_Lock_Flag = IDLE;
-                USARTx ->TX_Lock_Counter = 0;
-                // Enable Read register not empty interrupt. 
-                SET_BIT(USARTx -> USART_x ->CR1, CR1_RXNEIE);
-                return Uart_OVERSIZE ;
-            }
+            Local_Status = UART_TX_Element_Done(USARTx, Local_Element);
         }
         else
         {
-            // Check the last Transmitted element.
-            if (*Local_buffer == USARTx -> TX_Buffer_lastEL )
-            {
-                /* Disable the UART Transmit Complete Interrupt */
-                CLR_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-                (USARTx -> TX_Buffer_Size) -= ((USARTx -> TX_Process_Count) +1);
-                USARTx ->TX_Lock_Flag = IDLE;
-                USARTx ->TX_Lock_Counter = 0;
-                // Enable Read register not empty interrupt. 
-                SET_BIT(USARTx -> USART_x ->CR1, CR1_RXNEIE);
-                return Uart_UNDERSIZE ;
-            }
+            // an inserted CRC digit.
+            Local_Status = Uart_OK;
         }
-        // Enable Read register not empty interrupt. 
-        SET_BIT(USARTx -> USART_x ->CR1, CR1_RXNEIE);
-        return Uart_OK;
     }
-    // Enable Read register not empty interrupt. 
-    SET_BIT(USARTx -> USART_x ->CR1, CR1_RXNEIE);
-    return Uart_BUSY;
+    // Enable Read register not empty interrupt, only if there is a Reception in progress.
+    if (Local_RXNEIE == 1)
+    {
+        __UART_SHADOW_SET(USARTx, CR1, CR1_RXNEIE);
+    }
+#if USART_BAUD_FALLBACK == Enable
+    UART_Baud_Fallback(USARTx);
+#endif
+    if ((Local_Status != Uart_OK) && (Local_Status != Uart_BUSY))
+    {
+        UART_TX_End(USARTx);
+    }
+    return Local_Status;
+}
+
+
+/// @brief  UART_TX_End : it is the end of every Interrupt Transmission, by the Handler or by MCAL_UART_Transmit_INT
+///                       for a frame that ends at its first element.
+/// @param  USARTx      : the Struct of Peripheral's Registers.
+/// @return Nothing.
+static void UART_TX_End(USART_Struct *USARTx)
+{
+#if USART_POOL == Enable
+    // the Transmitted pool block goes back to the pool.
+    if (USARTx -> TX_Pool_Block != POOL_NO_BLOCK)
+    {
+        (void)UART_Pool_Give(USARTx -> TX_Pool_Block);
+        USARTx -> TX_Pool_Block = POOL_NO_BLOCK;
+    }
+#endif
+    // the Transfer ended, so the next one can be started.
+    if (USARTx -> TX_CallBack != NULL)
+    {
+        USARTx -> TX_CallBack(USARTx);
+    }
+}
+
+
+/// @brief  UART_Start_TX : it defines the Transmission elements in the USARTx Struct.
+/// @param  USARTx        : the Struct of Peripheral's Registers.
+/// @param  ptData        : pointer of data we want to Transmit.
+/// @param  Size          : the size of the data that will be Transmitted.
+/// @param  Last_element  : the last element that should be Transmitted.
+/// @param  Copy_Options  : the (UART_TX_xxx) options of this Transmission only.
+/// @return Nothing.
+static void UART_Start_TX(USART_Struct *USARTx , u8 *ptData , u16 Size , u8 Last_element , u8 Copy_Options)
+{
+    USARTx -> TX_Buffer_Ptr     = ptData;
+    USARTx -> TX_Buffer_Size    = Size;
+    USARTx -> TX_Process_Count  = (s16)Size;
+    USARTx -> Error_Code        = (u8 *)Error_1;
+    USARTx -> TX_Buffer_lastEL  = Last_element;
+    USARTx -> TX_By_Size        = ((Copy_Options & UART_TX_SIZE_ONLY) != 0) ? 1 : 0;
+#if USART_CRC == Enable
+    USARTx -> TX_CRC            = __UART_CRC_INIT(USARTx -> CRC_Type);
+    USARTx -> TX_CRC_Pending    = ((Copy_Options & UART_TX_CRC_TEXT) != 0) ? __UART_CRC_DIGITS(USARTx -> CRC_Type) : 0;
+#endif
+}
+
+
+/// @brief  UART_Load_TX_Element : it loads the next element into the (DR) register, the element is the next one in the
+///                                TX buffer or one of the running CRC digits that are inserted before the last element.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @param  Copy_Element         : pointer to hold the loaded element.
+/// @return (Uart_OK) if the element is taken from the TX buffer, or (Uart_BUSY) if it is an inserted CRC digit.
+static Uart_Fun_Status UART_Load_TX_Element(USART_Struct *USARTx , u8 *Copy_Element)
+{
+    u8 Local_Element = *(USARTx -> TX_Buffer_Ptr);
+#if USART_CRC == Enable
+    if (__UART_TX_LAST_EL(USARTx, Local_Element))
+    {
+        if (USARTx -> TX_CRC_Pending > 0)
+        {
+            // the CRC is sent as hex text ({MSB} digit first) before the last element, so no CRC element is the last element.
+            u32 Local_CRC   = USARTx -> TX_CRC ^ __UART_CRC_XOROUT(USARTx -> CRC_Type);
+            Local_Element   = UART_Hex_Digits[(Local_CRC >> (4U * (USARTx -> TX_CRC_Pending - 1U))) & 0x0FU];
+            USARTx -> TX_CRC_Pending--;
+            __UART_DR_WRITE(USARTx, Local_Element);
+            __UART_STATS_ADD(USARTx, TX_Bytes, 1);
+            *Copy_Element = Local_Element;
+            return Uart_BUSY;
+        }
+    }
+    else
+    {
+        USARTx -> TX_CRC = UART_CRC_Update(USARTx -> CRC_Type, USARTx -> TX_CRC, Local_Element);
+    }
+#endif
+    // load the Transmit word into the (DR) register 
+    __UART_DR_WRITE(USARTx, (Local_Element & (u8)0x00FF));
+    __UART_STATS_ADD(USARTx, TX_Bytes, 1);
+    USARTx -> TX_Buffer_Ptr += 1U;
+    *Copy_Element = Local_Element;
+    return Uart_OK;
+}
+
+
+/// @brief  UART_TX_Element_Done : it counts the Transmitted element and ends the Transmission at the last element
+///                                or at the end of the TX buffer.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @param  Copy_Element         : the Transmitted element.
+/// @return (Uart_OK) if the Transmission continues, (Uart_UNDERSIZE) if it ends by the last element, or
+///         (Uart_OVERSIZE) if the buffer ends without the last element.
+static Uart_Fun_Status UART_TX_Element_Done(USART_Struct *USARTx , u8 Copy_Element)
+{
+    (USARTx -> TX_Process_Count)--;
+    // Check the last Transmitted element.
+    if (__UART_TX_LAST_EL(USARTx, Copy_Element))
+    {
+        /* Disable the UART Transmit Complete Interrupt */
+        __UART_SHADOW_CLR(USARTx, CR1, CR1_TCIE);
+        (USARTx -> TX_Buffer_Size) -= ((USARTx -> TX_Process_Count) +1);
+        USARTx -> TX_Process_Count = 0;
+        USARTx ->TX_Lock_Flag = IDLE;
+        USARTx ->TX_Lock_Counter = 0;
+        __UART_TRACE(USARTx, Trace_TX_End, Uart_UNDERSIZE);
+        return Uart_UNDERSIZE ;
+    }
+    // Check if the buffer reaches its end. 
+    if ((USARTx -> TX_Process_Count) == 0)
+    {
+#if USART_WRITE == Enable
+        // the elements written to the ring since the Transmission started are sent by it.
+        if ((USARTx -> Write_Streaming == 1) && (UART_Write_Next(USARTx) == Uart_OK)){ return Uart_OK; }
+#endif
+        /* Disable the UART Transmit Complete Interrupt */
+        __UART_SHADOW_CLR(USARTx, CR1, CR1_TCIE);
+        USARTx ->TX_Lock_Flag = IDLE;
+        USARTx ->TX_Lock_Counter = 0;
+        __UART_TRACE(USARTx, Trace_TX_End, Uart_OVERSIZE);
+        return Uart_OVERSIZE ;
+    }
+    return Uart_OK;
 }
 
 
@@ -580,20 +1173,26 @@ static Uart_Fun_Status UART_Transmit_Handler(USART_Struct *USARTx)
 ///@retval Functions Status.
 Uart_Fun_Status	    MCAL_UART_Receive_INT(USART_Struct *USARTx , u8 *ptData ,u16 Size_Limit, u8 Last_element)
 {
+    __UART_TRACE(USARTx, Trace_RX_INT, Size_Limit);
     // Check the Given data and the size values.
     if( (ptData == NULL ) || (Size_Limit == 0)){ return  Uart_ERROR; }
 
     if (UART_Check_LockState(USARTx ,RX ) == BUSY)
     {
+        __UART_TRACE(USARTx, Trace_Return, Uart_BUSY);
         return Uart_BUSY;
     }
+    u32 Local_State;
 
+    // the control bits are changed with the Interrupts disabled, as the Handlers of a Transmission change the same shadow.
+    __UART_ENTER_CRITICAL(Local_State);
     // Enable Rx
     __COMM_ENABLE(USARTx,RX);
 
     // the Starting conditions:
     USARTx ->RX_Lock_Flag = BUSY;
     USARTx ->RX_Lock_Counter = 0;
+    __UART_TRACE(USARTx, Trace_RX_Lock, BUSY);
 
     // Define the rest of elements iin the USARTx Struct.
     USARTx -> RX_Buffer_Ptr     = ptData;
@@ -601,14 +1200,34 @@ Uart_Fun_Status	    MCAL_UART_Receive_INT(USART_Struct *USARTx , u8 *ptData ,u16
     USARTx -> RX_Process_Count  = (s16)Size_Limit;
     USARTx -> Error_Code        = (u8 *)Error_1;
     USARTx -> RX_Buffer_lastEL  = Last_element;
+    USARTx -> RX_Frame_Damaged  = 0;
+#if USART_CRC == Enable
+    USARTx -> RX_CRC            = __UART_CRC_INIT(USARTx -> CRC_Type);
+    USARTx -> RX_CRC_Valid      = 0;
+#endif
+#if USART_TIMESTAMP == Enable
+    USARTx -> RX_Time_Delivered = 0;
+#endif
+#if USART_RX_TIMEOUT == Enable
+    USARTx -> RX_Start_Cycle    = DWT_CYCCNT_R;
+#endif
     
     // clear the DR register.
-    (void)USARTx ->USART_x ->DR;
+    (void)__UART_DR_READ(USARTx);
     // Clear the Transmit complete flag.
     __UART_CLEAR_FLAG(USARTx -> USART_x ,__RXNE__);
+#if USART_RX_TIMEOUT == Enable
+    // the IDLE line after the Received elements ends the Reception, an old IDLE flag is ignored as no element came.
+    if (USARTx -> RX_Gap_Idle == 1)
+    {
+        __UART_SHADOW_SET(USARTx, CR1, CR1_IDLEIE);
+    }
+#endif
     // Enable Read register not empty interrupt. 
-    SET_BIT(USARTx ->USART_x ->CR1, CR1_RXNEIE);
+    __UART_SHADOW_SET(USARTx, CR1, CR1_RXNEIE);
+    __UART_EXIT_CRITICAL(Local_State);
 
+    __UART_TRACE(USARTx, Trace_Return, Uart_OK);
     return Uart_OK;
 }
 
@@ -618,111 +1237,282 @@ Uart_Fun_Status	    MCAL_UART_Receive_INT(USART_Struct *USARTx , u8 *ptData ,u16
 /// @return Functions Status.
 static Uart_Fun_Status UART_Receive_Handler(USART_Struct *USARTx)
 {
-    /* Disable the UART Transmit Complete Interrupt */
-    CLR_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
+    Uart_Fun_Status Local_Status;
+    u8 Local_TCIE = __UART_SHADOW_GET(USARTx, CR1, CR1_TCIE);
 
-    u8 *Local_buffer;
-    u8 Error_counter = 0;
+    /* Disable the UART Transmit Complete Interrupt */
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_TCIE);
 
-    if (__UART_GET_FLAG(USARTx -> USART_x, __ORE__))
+    Local_Status = Uart_OK;
+#if USART_SYNC == Enable
+    // every Received element of a Synchronous Transfer loads the next Transmitted one.
+    if (USARTx -> Sync_Active == 1)
     {
-        USARTx -> Error_Code = (u8 *)Error_5;
-        USARTx ->RX_Lock_Flag = IDLE;
-        USARTx ->RX_Lock_Counter = 0;
-        /* Enable the UART Transmit Complete Interrupt */
-        SET_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-        return Uart_ERROR; 
+        UART_Sync_Element(USARTx);
     }
-    if ((__UART_GET_FLAG(USARTx -> USART_x,__PE__)||__UART_GET_FLAG(USARTx -> USART_x,__FE__)||__UART_GET_FLAG(USARTx -> USART_x,__NE__)) == 0)
+    else
+#endif
+#if USART_MODBUS == Enable
+    // the Modbus frames end by the line silence, not by a last element.
+    if (USARTx -> Modbus_Buffer != NULL)
     {
-        (USARTx -> RX_Process_Count)--;
-        Local_buffer = (u8 *)USARTx -> RX_Buffer_Ptr;
-        // check the parity if Enabled or Disable.
-        if (GET_BIT(USARTx->USART_x -> CR1,CR1_PCE) == 0)
-        {
-            // store the Recevied word into the given pointer location.
-            *Local_buffer = (u8)(USARTx -> USART_x -> DR & (u8)0x00FF);
-        }
-        // the parity bit is the 8th-bit.
-        else   
-        {
-            // store the Recevied word into the given pointer location.
-            *Local_buffer = (u8)(USARTx -> USART_x -> DR & (u8)0x007F);
-        }
-        USARTx -> RX_Buffer_Ptr += 1U;
-        USARTx -> RX_Lock_Counter = 0;
-        // Check if the buffer reaches its end. 
-        if(--USARTx->TX_Process_Count < 0)
-        {
-          // Disable the UART Read register Not empty Interrupt. 
-          CLR_BIT(USARTx -> USART_x ->CR1, CR1_RXNEIE);
-           if (*Local_buffer != USARTx -> RX_Buffer_lastEL )
-            {
-                USARTx ->RX_Lock_Flag = IDLE;
-                USARTx ->RX_Lock_Counter = 0;
-                /* Enable the UART Transmit Complete Interrupt */
-                SET_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-                return Uart_OVERSIZE ;
-            }
-        }
-        else
-        {
-            // Check the Received element.
-            if (*Local_buffer == USARTx -> RX_Buffer_lastEL)
-            {
-                USARTx -> RX_Buffer_Size -= ((USARTx -> RX_Process_Count) +1);
-                USARTx -> RX_Lock_Flag = IDLE;
-                USARTx -> RX_Lock_Counter = 0;
-                /* Enable the UART Transmit Complete Interrupt */
-                SET_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-                return Uart_UNDERSIZE ;
-            }
-        }
+        UART_Modbus_Element(USARTx);
     }
     else
+#endif
+#if USART_RX_RING == Enable
+    // the stream is stored in the ring, it has no frames.
+    if (USARTx -> Ring_Buffer != NULL)
     {
-        if (__UART_GET_FLAG(USARTx -> USART_x,__PE__))
-        {
-            USARTx -> Error_Code = (u8 *)Error_2;
-            Error_counter += 2;
-        }
-        if(__UART_GET_FLAG(USARTx -> USART_x,__NE__))
-        {
-            USARTx -> Error_Code = (u8 *)Error_3;
-            Error_counter += 3;
-        }
-        if(__UART_GET_FLAG(USARTx -> USART_x,__FE__))
-        {
-            USARTx -> Error_Code = (u8 *)Error_4;
-            Error_counter += 4;
-        }
-        // two or more errors had happened.
-        if (Error_counter > 4)
-        {
-            switch (Error_counter)
-            {
-            case 5: USARTx -> Error_Code = (u8 *)"Parity and Noise Errors ";
-                break;
-            case 7: USARTx -> Error_Code = (u8 *)"Noise and Frame Errors ";
-                break;
-            case 6: USARTx -> Error_Code = (u8 *)"Parity and Frame Errors ";
-                break;
-            case 9: USARTx -> Error_Code = (u8 *)"Parity, Frame, and Noise Errors ";
-                break;
-            }
+        UART_Ring_Element(USARTx);
+    }
+    else
+#endif
+    {
+        Local_Status = UART_Receive_Element(USARTx);
+    }
+
+    /* Enable the UART Transmit Complete Interrupt, only if there is a Transmission in progress */
+    if (Local_TCIE == 1)
+    {
+        __UART_SHADOW_SET(USARTx, CR1, CR1_TCIE);
+    }
+#if USART_BAUD_FALLBACK == Enable
+    UART_Baud_Fallback(USARTx);
+#endif
+#if USART_POOL == Enable
+    // the block of the frame waits for the application and the Reception goes on in a new block.
+    if ((USARTx -> RX_Lock_Flag == IDLE) && (USARTx -> RX_Pool_Block != POOL_NO_BLOCK))
+    {
+        UART_Pool_RX_End(USARTx, Local_Status);
+    }
+#endif
+    // the frame ended, so the next Reception can be started.
+    if ((USARTx -> RX_Lock_Flag == IDLE) && (USARTx -> RX_CallBack != NULL))
+    {
+        USARTx -> RX_CallBack(USARTx);
+    }
+    return Local_Status;
+}
+
+
+/// @brief  UART_Receive_Element : it stores one Received element of the Interrupt Reception and checks the frame end.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @return Functions Status.
+static Uart_Fun_Status UART_Receive_Element(USART_Struct *USARTx)
+{
+    u32 Local_SR;
+    // read the SR then the DR register, this sequence also clears the Error flags.
+    u8  Local_Element = UART_Read_Element(USARTx, &Local_SR);
+
+    // check the Receive Error flags.
+    if ((Local_SR & UART_RX_ERRORS_MASK) != 0)
+    {
+        UART_Handle_RX_Errors(USARTx, Local_SR);
+        if (USARTx -> RX_Mode == RX_Strict_Mode)
+        {
+            // the element is kept after the Received ones (it is not counted), so a pool Reception sees if it ended the frame.
+            *(USARTx -> RX_Buffer_Ptr) = Local_Element;
+            // Disable the UART Read register Not empty Interrupt.
+            __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
+            USARTx ->RX_Lock_Flag = IDLE;
+            USARTx ->RX_Lock_Counter = 0;
+            __UART_TRACE(USARTx, Trace_RX_End, Uart_ERROR);
+            return Uart_ERROR;
+        }
+        UART_Mark_Damaged(USARTx);
+    }
+
+    USARTx -> RX_Lock_Counter = 0;
+    if (USARTx -> RX_Frame_Damaged == 1)
+    {
+        __UART_STATS_ADD(USARTx, Dropped_Bytes, 1);
+        // drop the elements till the frame boundary, then restart at the start of the given buffer.
+        if (Local_Element == USARTx -> RX_Buffer_lastEL)
+        {
+            USARTx -> RX_Buffer_Ptr   -= (USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count);
+            USARTx -> RX_Process_Count = (s16)(USARTx -> RX_Buffer_Size);
+            USARTx -> RX_Frame_Damaged = 0;
+#if USART_CRC == Enable
+            USARTx -> RX_CRC = __UART_CRC_INIT(USARTx -> CRC_Type);
+#endif
+        }
+        return Uart_ERROR;
+    }
+
+    // store the Received word into the buffer.
+    *(USARTx -> RX_Buffer_Ptr) = Local_Element;
+    USARTx -> RX_Buffer_Ptr += 1U;
+    (USARTx -> RX_Process_Count)--;
+
+    // Check the Received element.
+    if (Local_Element == USARTx -> RX_Buffer_lastEL)
+    {
+#if USART_CRC == Enable
+        // the frame is valid when the CRC text before the last element is the CRC of the elements before it.
+        USARTx -> RX_CRC_Valid = UART_RX_CRC_End(USARTx, USARTx -> RX_Buffer_Ptr - 1,
+                                                 (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count - 1));
+#endif
+#if USART_CAPTURE == Enable
+        USARTx -> Frame_End_Cycle = DWT_CYCCNT_R;
+        USARTx -> Frame_End_Counter++;
+#endif
+        // Disable the UART Read register Not empty Interrupt till the next Reception.
+        __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
+        USARTx -> RX_Buffer_Size -= ((USARTx -> RX_Process_Count) +1);
+        USARTx -> RX_Lock_Flag = IDLE;
+        USARTx -> RX_Lock_Counter = 0;
+        __UART_TRACE(USARTx, Trace_RX_End, Uart_UNDERSIZE);
+        return Uart_UNDERSIZE ;
+    }
+#if USART_CRC == Enable
+    UART_RX_CRC_Add(USARTx, USARTx -> RX_Buffer_Ptr, (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count));
+#endif
+    // Check if the buffer reaches its end.
+    if ((USARTx -> RX_Process_Count) == 0)
+    {
+        USARTx -> Error_Code = (u8 *)Error_7;
+        if (USARTx -> RX_Mode == RX_Resilient_Mode)
+        {
+            // drop this frame and keep receiving.
+            UART_Mark_Damaged(USARTx);
+            return Uart_ERROR;
         }
+        // Disable the UART Read register Not empty Interrupt.
+        __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
         USARTx ->RX_Lock_Flag = IDLE;
         USARTx ->RX_Lock_Counter = 0;
-        /* Enable the UART Transmit Complete Interrupt */
-        SET_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
-        return Uart_ERROR; 
+        __UART_TRACE(USARTx, Trace_RX_End, Uart_OVERSIZE);
+        return Uart_OVERSIZE ;
+    }
+#if USART_RX_TIMEOUT == Enable
+    // the IDLE flag is cleared by the reading of the element, so the line silence after it is checked here.
+    if ((USARTx -> RX_Gap_Idle == 1) && (GET_BIT(Local_SR, __IDLE__) == 1))
+    {
+        return UART_RX_Timeout_End(USARTx);
     }
-    /* Enable the UART Transmit Complete Interrupt */
-    SET_BIT(USARTx -> USART_x ->CR1, CR1_TCIE);
+#endif
     return Uart_OK;
 }
 
 
+/// @brief  UART_Read_Element : it reads the SR register then the DR register, this is the software sequence that clears
+///                             the (PE), (FE), (NE), (ORE) and (IDLE) flags.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @param  Local_SR          : pointer to hold the SR register value before reading the DR register.
+/// @return the Received element.
+static u8 UART_Read_Element(USART_Struct *USARTx , u32 *Local_SR)
+{
+    u8 Local_Element;
+
+    *Local_SR = USARTx -> USART_x -> SR;
+#if USART_RX_TIMEOUT == Enable
+    USARTx -> RX_Last_Cycle = DWT_CYCCNT_R;
+#endif
+#if USART_TIMESTAMP == Enable
+    // the first element of the frame (or of its restart after a damaged one) and the last Received element.
+    USARTx -> RX_Time.End_Cycle = DWT_CYCCNT_R;
+    if (USARTx -> RX_Process_Count == (s16)(USARTx -> RX_Buffer_Size))
+    {
+        USARTx -> RX_Time.First_Cycle = USARTx -> RX_Time.End_Cycle;
+    }
+#endif
+    __UART_STATS_ADD(USARTx, RX_Bytes, 1);
+#if USART_BAUD_FALLBACK == Enable
+    UART_Baud_Window(USARTx, *Local_SR);
+#endif
+    // check the parity if Enabled or Disable, if Enabled then the parity bit is the 8th-bit.
+    if (__UART_SHADOW_GET(USARTx, CR1, CR1_PCE) == 0)
+    {
+        Local_Element = (u8)(__UART_DR_READ(USARTx) & (u8)0x00FF);
+    }
+    else
+    {
+        Local_Element = (u8)(__UART_DR_READ(USARTx) & (u8)0x007F);
+    }
+#if USART_CAPTURE == Enable
+    // record the element with the time since the previous one.
+    if ((USARTx -> Capture_Buffer != NULL) && (USARTx -> Capture_Count < USARTx -> Capture_Size))
+    {
+        u32 Local_Cycle = DWT_CYCCNT_R;
+        USARTx -> Capture_Buffer[USARTx -> Capture_Count].Delta_Cycles = Local_Cycle - USARTx -> Capture_Last_Cycle;
+        USARTx -> Capture_Buffer[USARTx -> Capture_Count].Element      = Local_Element;
+        USARTx -> Capture_Buffer[USARTx -> Capture_Count].Error_Flags  = (u8)(*Local_SR & UART_RX_ERRORS_MASK);
+        USARTx -> Capture_Last_Cycle = Local_Cycle;
+        USARTx -> Capture_Count++;
+    }
+#endif
+    return Local_Element;
+}
+
+
+/// @brief  UART_Handle_RX_Errors : it counts the Receive Errors in the given SR value and updates the Error code.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Local_SR              : the SR register value of the Received element.
+/// @return Nothing.
+static void UART_Handle_RX_Errors(USART_Struct *USARTx , u32 Local_SR)
+{
+    u8 Error_counter = 0;
+
+    __UART_TRACE(USARTx, Trace_RX_Error, (Local_SR & UART_RX_ERRORS_MASK));
+
+    if (GET_BIT(Local_SR, __PE__))
+    {
+        USARTx -> RX_Errors.PE_Counter++;
+        USARTx -> Error_Code = (u8 *)Error_2;
+        Error_counter += 2;
+    }
+    if (GET_BIT(Local_SR, __NE__))
+    {
+        USARTx -> RX_Errors.NE_Counter++;
+        USARTx -> Error_Code = (u8 *)Error_3;
+        Error_counter += 3;
+    }
+    if (GET_BIT(Local_SR, __FE__))
+    {
+        USARTx -> RX_Errors.FE_Counter++;
+        USARTx -> Error_Code = (u8 *)Error_4;
+        Error_counter += 4;
+    }
+    // two or more errors had happened.
+    if (Error_counter > 4)
+    {
+        switch (Error_counter)
+        {
+        case 5: USARTx -> Error_Code = (u8 *)"Parity and Noise Errors ";
+            break;
+        case 7: USARTx -> Error_Code = (u8 *)"Noise and Frame Errors ";
+            break;
+        case 6: USARTx -> Error_Code = (u8 *)"Parity and Frame Errors ";
+            break;
+        case 9: USARTx -> Error_Code = (u8 *)"Parity, Frame, and Noise Errors ";
+            break;
+        }
+    }
+    // the Overrun error is the last one as it means that elements were lost.
+    if (GET_BIT(Local_SR, __ORE__))
+    {
+        USARTx -> RX_Errors.ORE_Counter++;
+        __UART_STATS_ADD(USARTx, Dropped_Bytes, 1);
+        USARTx -> Error_Code = (u8 *)Error_5;
+    }
+}
+
+
+/// @brief  UART_Mark_Damaged : it marks the current Received frame as a damaged one, so the Reception drops
+///                             the rest of it and resynchronises on the next frame boundary (the last element).
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @return Nothing.
+static void UART_Mark_Damaged(USART_Struct *USARTx)
+{
+    if (USARTx -> RX_Frame_Damaged == 0)
+    {
+        USARTx -> RX_Frame_Damaged = 1;
+        USARTx -> RX_Errors.Damaged_Frames++;
+    }
+}
+
+
 
 
 
@@ -752,6 +1542,106 @@ Uart_Fun_Status	    MCAL_UART_INTT_CALLBACK(USART_Struct *USARTx , USART_INT_TYP
 }
 
 
+/// @brief  MCAL_UART_TX_CALLBACK : this function is Used to add a function that will be executed at the Handler when
+///                                 the Transfer of MCAL_UART_Transmit_INT ends, so the next Transfer can be started from it.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_ptr              : pointer to the function that will be executed with the Struct, or NULL to remove it.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_TX_CALLBACK(USART_Struct *USARTx , void (*Copy_ptr)(USART_Struct *USARTx))
+{
+    if (USARTx == NULL){ return  Uart_ERROR; }
+
+    USARTx -> TX_CallBack = Copy_ptr;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_RX_CALLBACK : this function is Used to add a function that will be executed at the Handler when
+///                                 the Reception of MCAL_UART_Receive_INT ends (by the last element, the buffer end or an
+///                                 error), so the next Reception can be started from it.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_ptr              : pointer to the function that will be executed with the Struct, or NULL to remove it.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_RX_CALLBACK(USART_Struct *USARTx , void (*Copy_ptr)(USART_Struct *USARTx))
+{
+    if (USARTx == NULL){ return  Uart_ERROR; }
+
+    USARTx -> RX_CallBack = Copy_ptr;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Claim_CALLBACKS : this function sets the TX and RX callbacks of a service that owns the port, a
+///                                     callback is set only if it is free or it is the same function, so two services
+///                                     can share a port when they use different callbacks.
+/// @param  USARTx                    : the Struct of Peripheral's Registers.
+/// @param  Copy_TX                   : the TX callback, or NULL if the service does not use it.
+/// @param  Copy_RX                   : the RX callback, or NULL if the service does not use it.
+/// @retval Functions Status, (Uart_BUSY) if a callback is owned by another function, then no callback is set.
+Uart_Fun_Status	    MCAL_UART_Claim_CALLBACKS(USART_Struct *USARTx , void (*Copy_TX)(USART_Struct *USARTx) ,
+                                              void (*Copy_RX)(USART_Struct *USARTx))
+{
+    Uart_Fun_Status Local_Status = Uart_OK;
+    u32 Local_State;
+
+    if (USARTx == NULL){ return  Uart_ERROR; }
+
+    __UART_ENTER_CRITICAL(Local_State);
+    if (((Copy_TX != NULL) && (USARTx -> TX_CallBack != NULL) && (USARTx -> TX_CallBack != Copy_TX)) ||
+        ((Copy_RX != NULL) && (USARTx -> RX_CallBack != NULL) && (USARTx -> RX_CallBack != Copy_RX)))
+    {
+        Local_Status = Uart_BUSY;
+    }
+    else
+    {
+        if (Copy_TX != NULL){ USARTx -> TX_CallBack = Copy_TX; }
+        if (Copy_RX != NULL){ USARTx -> RX_CallBack = Copy_RX; }
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+    return Local_Status;
+}
+
+
+
+
+/// @brief  MCAL_UART_Set_RX_Mode  : this function selects the Receive Error policy of the Peripheral.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Mode              : the Receive Error policy (RX_Strict_Mode) or (RX_Resilient_Mode).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Set_RX_Mode(USART_Struct *USARTx , Uart_RX_Mode Copy_Mode)
+{
+    if ((USARTx == NULL) || (Copy_Mode > RX_Resilient_Mode)){ return  Uart_ERROR; }
+    // the policy can not be changed in the middle of a Reception.
+    if (USARTx -> RX_Lock_Flag == BUSY){ return Uart_BUSY; }
+
+    USARTx -> RX_Mode          = Copy_Mode;
+    USARTx -> RX_Frame_Damaged = 0;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Get_RX_Errors : this function copies the Receive Error counters of the Peripheral.
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @param  Copy_Counters           : pointer to the struct that will hold the counters.
+/// @param  Copy_Clear              : (Enable) to clear the counters after reading them, (Disable) to keep them.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Get_RX_Errors(USART_Struct *USARTx , USART_Error_Counters *Copy_Counters, u8 Copy_Clear)
+{
+    if ((USARTx == NULL) || (Copy_Counters == NULL)){ return  Uart_ERROR; }
+
+    *Copy_Counters = USARTx -> RX_Errors;
+    if (Copy_Clear == Enable)
+    {
+        USARTx -> RX_Errors.PE_Counter     = 0;
+        USARTx -> RX_Errors.NE_Counter     = 0;
+        USARTx -> RX_Errors.FE_Counter     = 0;
+        USARTx -> RX_Errors.ORE_Counter    = 0;
+        USARTx -> RX_Errors.Damaged_Frames = 0;
+    }
+    return Uart_OK;
+}
+
+
 
 
 /// @brief  USART1_IRQHandler   : the HANDLER Function of The USART1_IRQHandler interrupt.
@@ -759,10 +1649,13 @@ Uart_Fun_Status	    MCAL_UART_INTT_CALLBACK(USART_Struct *USARTx , USART_INT_TYP
 /// @retval return Nothing.
 void USART1_IRQHandler(void)
 {
+    __UART_STATS_START(Local_Cycles);
+    __UART_TRACE(USART1_Struct, Trace_ISR, USART1_Struct -> USART_x -> SR);
     // UART in mode Transmitter. 
-	if(GET_BIT(USART1_Struct -> USART_x -> CR1,CR1_TCIE) && __UART_GET_FLAG(USART1_Struct -> USART_x ,__TC__))
+	if(__UART_SHADOW_GET(USART1_Struct, CR1, CR1_TCIE) && __UART_GET_FLAG(USART1_Struct -> USART_x ,__TC__))
 	{
 	    UART_Transmit_Handler(USART1_Struct);
+        __UART_STATS_ADD(USART1_Struct, TX_Interrupts, 1);
         if (GET_BIT(USART1_Struct -> USART_x ->SR ,__USART1__INTERRUPT_TYPE__))
         {
             USART1_CallBack();
@@ -770,15 +1663,24 @@ void USART1_IRQHandler(void)
         __UART_CLEAR_FLAG(USART1_Struct -> USART_x ,__TC__);
 	}
     // UART in mode Receiver.
-	if(GET_BIT(USART1_Struct -> USART_x -> CR1,CR1_RXNEIE) && __UART_GET_FLAG(USART1_Struct -> USART_x ,__RXNE__))
+	if(__UART_SHADOW_GET(USART1_Struct, CR1, CR1_RXNEIE) && __UART_GET_FLAG(USART1_Struct -> USART_x ,__RXNE__))
 	{
 	    UART_Receive_Handler(USART1_Struct);
+        __UART_STATS_ADD(USART1_Struct, RX_Interrupts, 1);
         if (GET_BIT(USART1_Struct -> USART_x ->SR ,__USART1__INTERRUPT_TYPE__))
         {
         USART1_CallBack();
         }
         __UART_CLEAR_FLAG(USART1_Struct -> USART_x ,__RXNE__);
 	}
+#if (USART_MODBUS == Enable) || (USART_RX_TIMEOUT == Enable)
+    // the line is silent after a Modbus frame or a burst.
+	if(__UART_SHADOW_GET(USART1_Struct, CR1, CR1_IDLEIE) && __UART_GET_FLAG(USART1_Struct -> USART_x ,__IDLE__))
+	{
+	    UART_Idle_Handler(USART1_Struct);
+	}
+#endif
+    __UART_STATS_ISR_END(USART1_Struct, Local_Cycles);
 }
 
 /// @brief  USART2_IRQHandler   : the HANDLER Function of The USART2_IRQHandler interrupt.
@@ -786,16 +1688,28 @@ void USART1_IRQHandler(void)
 /// @retval return Nothing.
 void USART2_IRQHandler(void)
 {
+    __UART_STATS_START(Local_Cycles);
+    __UART_TRACE(USART2_Struct, Trace_ISR, USART2_Struct -> USART_x -> SR);
     // UART in mode Transmitter. 
-	if(GET_BIT(USART2_Struct -> USART_x -> CR1,CR1_TCIE) && __UART_GET_FLAG(USART2_Struct -> USART_x ,__TC__))
+	if(__UART_SHADOW_GET(USART2_Struct, CR1, CR1_TCIE) && __UART_GET_FLAG(USART2_Struct -> USART_x ,__TC__))
 	{
 	    UART_Transmit_Handler(USART2_Struct);
+        __UART_STATS_ADD(USART2_Struct, TX_Interrupts, 1);
 	}
     // UART in mode Receiver.
-	if(GET_BIT(USART2_Struct -> USART_x -> CR1,CR1_RXNEIE) && __UART_GET_FLAG(USART2_Struct -> USART_x ,__RXNE__))
+	if(__UART_SHADOW_GET(USART2_Struct, CR1, CR1_RXNEIE) && __UART_GET_FLAG(USART2_Struct -> USART_x ,__RXNE__))
 	{
 	    UART_Receive_Handler(USART2_Struct);
+        __UART_STATS_ADD(USART2_Struct, RX_Interrupts, 1);
 	}
+#if (USART_MODBUS == Enable) || (USART_RX_TIMEOUT == Enable)
+    // the line is silent after a Modbus frame or a burst.
+	if(__UART_SHADOW_GET(USART2_Struct, CR1, CR1_IDLEIE) && __UART_GET_FLAG(USART2_Struct -> USART_x ,__IDLE__))
+	{
+	    UART_Idle_Handler(USART2_Struct);
+	}
+#endif
+    __UART_STATS_ISR_END(USART2_Struct, Local_Cycles);
 }
 
 /// @brief  USART6_IRQHandler   : the HANDLER Function of The USART6_IRQHandler interrupt.
@@ -803,16 +1717,28 @@ void USART2_IRQHandler(void)
 /// @retval return Nothing.
 void USART6_IRQHandler(void)
 {
+    __UART_STATS_START(Local_Cycles);
+    __UART_TRACE(USART6_Struct, Trace_ISR, USART6_Struct -> USART_x -> SR);
     // UART in mode Transmitter. 
-	if(GET_BIT(USART6_Struct -> USART_x -> CR1,CR1_TCIE) && __UART_GET_FLAG(USART6_Struct -> USART_x ,__TC__))
+	if(__UART_SHADOW_GET(USART6_Struct, CR1, CR1_TCIE) && __UART_GET_FLAG(USART6_Struct -> USART_x ,__TC__))
 	{
 	    UART_Transmit_Handler(USART6_Struct);
+        __UART_STATS_ADD(USART6_Struct, TX_Interrupts, 1);
 	}
     // UART in mode Receiver.
-	if(GET_BIT(USART6_Struct -> USART_x -> CR1,CR1_RXNEIE) && __UART_GET_FLAG(USART6_Struct -> USART_x ,__RXNE__))
+	if(__UART_SHADOW_GET(USART6_Struct, CR1, CR1_RXNEIE) && __UART_GET_FLAG(USART6_Struct -> USART_x ,__RXNE__))
 	{
 	    UART_Receive_Handler(USART6_Struct);
+        __UART_STATS_ADD(USART6_Struct, RX_Interrupts, 1);
+	}
+#if (USART_MODBUS == Enable) || (USART_RX_TIMEOUT == Enable)
+    // the line is silent after a Modbus frame or a burst.
+	if(__UART_SHADOW_GET(USART6_Struct, CR1, CR1_IDLEIE) && __UART_GET_FLAG(USART6_Struct -> USART_x ,__IDLE__))
+	{
+	    UART_Idle_Handler(USART6_Struct);
 	}
+#endif
+    __UART_STATS_ISR_END(USART6_Struct, Local_Cycles);
 }
 
 
@@ -837,6 +1763,7 @@ static Uart_LOCK_ST    UART_Check_LockState(USART_Struct *USARTx ,COMM_TYPE _Com
                 // perform the Unlock process.
                 USARTx -> TX_Lock_Flag = IDLE ;
                 USARTx -> TX_Lock_Counter = 0 ;
+                __UART_TRACE(USARTx, Trace_TX_Unlock, LOCK_TIME_LIMIT);
                 return IDLE;
             }
             else
@@ -859,6 +1786,7 @@ static Uart_LOCK_ST    UART_Check_LockState(USART_Struct *USARTx ,COMM_TYPE _Com
                 // perform the Unlock process.
                 USARTx -> RX_Lock_Flag = IDLE ;
                 USARTx -> RX_Lock_Counter = 0 ;
+                __UART_TRACE(USARTx, Trace_RX_Unlock, LOCK_TIME_LIMIT);
                 return IDLE;
             }
             else
@@ -876,4 +1804,1929 @@ static Uart_LOCK_ST    UART_Check_LockState(USART_Struct *USARTx ,COMM_TYPE _Com
         break;
     }
     return ERROR_IN;
-}
\ No newline at end of file
+}
+
+
+
+
+#if USART_STATISTICS == Enable
+/// @brief  MCAL_UART_Stats_Reset : this function clears the Transfer statistics and starts a new measurement window.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Stats_Reset(USART_Struct *USARTx)
+{
+    if (USARTx == NULL){ return  Uart_ERROR; }
+
+    // Enable the DWT cycle counter.
+    __UART_DWT_ENABLE();
+
+    USARTx -> Stats.TX_Bytes       = 0;
+    USARTx -> Stats.RX_Bytes       = 0;
+    USARTx -> Stats.TX_Interrupts  = 0;
+    USARTx -> Stats.RX_Interrupts  = 0;
+    USARTx -> Stats.CPU_Cycles     = 0;
+    USARTx -> Stats.ISR_Max_Cycles = 0;
+    USARTx -> Stats.Dropped_Bytes  = 0;
+    USARTx -> Stats.Start_Cycle    = DWT_CYCCNT_R;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Get_Stats : this function copies the raw Transfer statistics of the Peripheral.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @param  Copy_Stats          : pointer to the struct that will hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Get_Stats(USART_Struct *USARTx , USART_Statistics *Copy_Stats)
+{
+    if ((USARTx == NULL) || (Copy_Stats == NULL)){ return  Uart_ERROR; }
+
+    *Copy_Stats = USARTx -> Stats;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Stats_Report : this function writes one CSV record (see USART_STATS_CSV_HEADER) of the derived figures:
+///                                  wire utilisation, interrupts per byte, cycles per byte, max ISR time and drop rate.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Buffer            : the buffer that will hold the record.
+/// @param  Copy_Size              : the size of the buffer (at least 120 elements).
+/// @param  Copy_Length            : pointer to hold the length of the record.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Stats_Report(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size , u16 *Copy_Length)
+{
+    // ten numbers of ten digits at most and their separators.
+    if ((USARTx == NULL) || (Copy_Buffer == NULL) || (Copy_Length == NULL) || (Copy_Size < 120)){ return  Uart_ERROR; }
+
+    USART_Statistics Local_Stats = USARTx -> Stats;
+    u32 Local_Elapsed = DWT_CYCCNT_R - Local_Stats.Start_Cycle;
+    u32 Local_Bytes   = Local_Stats.TX_Bytes + Local_Stats.RX_Bytes;
+    u8  Local_Index   = 0;
+    u8  Local_Port    = 0;
+
+    // the frame length in half bits : start bit + (8 or 9) data bits + the stop bits {1, 0.5, 2, 1.5}.
+    u8  Local_StopBits_x2[4] = {2, 1, 4, 3};
+    u32 Local_FrameBits_x2   = (2 * (9 + __UART_SHADOW_GET(USARTx, CR1, CR1_M))) +
+                               Local_StopBits_x2[(USARTx -> CR2_Shadow >> CR2_STOP0) & 0x03];
+
+    if      (USARTx -> USART_x == USART1_R){ Local_Port = 1; }
+    else if (USARTx -> USART_x == USART2_R){ Local_Port = 2; }
+    else if (USARTx -> USART_x == USART6_R){ Local_Port = 6; }
+
+    // the derived figures, the divisions are guarded against the empty measurement window.
+    u32 Local_Utilisation = 0, Local_INT_Per_KByte = 0, Local_Cycles_Per_Byte = 0, Local_Drop_PPM = 0;
+    if ((Local_Elapsed != 0) && (USARTx -> Baud_Rate != 0))
+    {
+        Local_Utilisation = (u32)(((f64)Local_Bytes * Local_FrameBits_x2 * FCK * 1000.0) /
+                                  ((f64)2 * USARTx -> Baud_Rate * Local_Elapsed));
+    }
+    if (Local_Bytes != 0)
+    {
+        Local_INT_Per_KByte   = (u32)(((f64)(Local_Stats.TX_Interrupts + Local_Stats.RX_Interrupts) * 1000.0) / Local_Bytes);
+        Local_Cycles_Per_Byte = Local_Stats.CPU_Cycles / Local_Bytes;
+    }
+    if (Local_Stats.RX_Bytes != 0)
+    {
+        Local_Drop_PPM = (u32)(((f64)Local_Stats.Dropped_Bytes * 1000000.0) / Local_Stats.RX_Bytes);
+    }
+
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Port,                 ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], USARTx -> Baud_Rate,        ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_FrameBits_x2,         ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Stats.TX_Bytes,       ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Stats.RX_Bytes,       ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Utilisation,          ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_INT_Per_KByte,        ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Cycles_Per_Byte,      ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Stats.ISR_Max_Cycles, ',');
+    Local_Index += UART_Append_Number(&Copy_Buffer[Local_Index], Local_Drop_PPM,             '\n');
+
+    *Copy_Length = Local_Index;
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Stats_ISR_End : it adds the execution time of the current ISR to the statistics of the port.
+/// @param  USARTx             : the Struct of Peripheral's Registers.
+/// @param  Copy_Start         : the DWT cycle at the ISR entry.
+/// @return Nothing.
+static void UART_Stats_ISR_End(USART_Struct *USARTx , u32 Copy_Start)
+{
+    u32 Local_Cycles = DWT_CYCCNT_R - Copy_Start;
+
+    USARTx -> Stats.CPU_Cycles += Local_Cycles;
+    if (Local_Cycles > USARTx -> Stats.ISR_Max_Cycles)
+    {
+        USARTx -> Stats.ISR_Max_Cycles = Local_Cycles;
+    }
+}
+
+
+/// @brief  UART_Append_Number : it writes the decimal digits of a number followed by a separator.
+/// @param  Copy_Buffer        : the location of the first digit.
+/// @param  Copy_Number        : the number.
+/// @param  Copy_Separator     : the element written after the digits.
+/// @return the number of the written elements.
+static u8 UART_Append_Number(u8 *Copy_Buffer , u32 Copy_Number , u8 Copy_Separator)
+{
+    u8 Local_Digits[10];
+    u8 Local_Count = 0;
+    u8 Local_Index = 0;
+
+    do
+    {
+        Local_Digits[Local_Count++] = (u8)('0' + (Copy_Number % 10));
+        Copy_Number /= 10;
+    } while (Copy_Number != 0);
+
+    // the digits are generated from the LSB, so write them in the reversed order.
+    while (Local_Count > 0)
+    {
+        Copy_Buffer[Local_Index++] = Local_Digits[--Local_Count];
+    }
+    Copy_Buffer[Local_Index++] = Copy_Separator;
+    return Local_Index;
+}
+#endif
+
+
+
+
+#if USART_CAPTURE == Enable
+/// @brief  MCAL_UART_Capture_Start : this function starts recording the Received elements with their inter-element timing.
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @param  Copy_Records            : the buffer of the records.
+/// @param  Copy_Size               : the number of the records in the buffer, the capture stops when it is full.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Capture_Start(USART_Struct *USARTx , USART_Capture_Record *Copy_Records , u16 Copy_Size)
+{
+    if ((USARTx == NULL) || (Copy_Records == NULL) || (Copy_Size == 0)){ return  Uart_ERROR; }
+
+    __UART_DWT_ENABLE();
+    USARTx -> Capture_Count      = 0;
+    USARTx -> Capture_Size       = Copy_Size;
+    USARTx -> Capture_Last_Cycle = DWT_CYCCNT_R;
+    // the buffer is the last one to be set as it starts the capture.
+    USARTx -> Capture_Buffer     = Copy_Records;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Capture_Stop : this function stops the capture.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Count             : pointer to hold the number of the captured records.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Capture_Stop(USART_Struct *USARTx , u16 *Copy_Count)
+{
+    if ((USARTx == NULL) || (Copy_Count == NULL)){ return  Uart_ERROR; }
+
+    USARTx -> Capture_Buffer = NULL;
+    *Copy_Count = USARTx -> Capture_Count;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Replay : this function Transmits captured records by the Blocking mode with their original
+///                            (or scaled) inter-element timing, while the Sink port receives them by its Interrupt path,
+///                            the Sink RX pin is wired to the TX pin of the Transmitting port (or the two ports are a
+///                            pseudo-terminal pair of the host model), the frames that are not Received at the end are
+///                            waited for (REPLAY_DRAIN_US) at most.
+/// @param  USARTx           : the Struct of the Transmitting Peripheral.
+/// @param  Copy_Config      : the replay configuration.
+/// @param  Copy_Report      : pointer to hold the drops, overruns and frame latencies measured at the Sink.
+/// @retval Functions Status, the status of the Sink Reception when it can not be started.
+Uart_Fun_Status	    MCAL_UART_Replay(USART_Struct *USARTx , USART_Replay_Config *Copy_Config , USART_Replay_Report *Copy_Report)
+{
+    if ((USARTx == NULL) || (Copy_Config == NULL) || (Copy_Report == NULL) ||
+        (Copy_Config -> Records == NULL) || (Copy_Config -> Records_Count == 0)){ return  Uart_ERROR; }
+    if ((Copy_Config -> Sink != NULL) && ((Copy_Config -> Sink_Buffer == NULL) || (Copy_Config -> Sink_Size == 0))){ return  Uart_ERROR; }
+
+    if (UART_Check_LockState(USARTx ,TX ) == BUSY)
+    {
+        return Uart_BUSY;
+    }
+    // the Starting conditions:
+    USARTx ->TX_Lock_Flag = BUSY;
+    USARTx ->TX_Lock_Counter = 0;
+
+    USART_Struct *Local_Sink = Copy_Config -> Sink;
+    UART_Replay_Pending Local_Pending = { .Head = 0, .Count = 0, .Sink_Frames = 0 };
+    u32 Local_Sink_ORE      = 0;
+    u32 Local_Sink_Damaged  = 0;
+    u32 Local_Last_Cycle;
+    u32 Local_Index;
+
+    Copy_Report -> Sent_Elements        = 0;
+    Copy_Report -> Sent_Frames          = 0;
+    Copy_Report -> Received_Frames      = 0;
+    Copy_Report -> Overruns             = 0;
+    Copy_Report -> Dropped_Frames       = 0;
+    Copy_Report -> Max_Latency_Cycles   = 0;
+    Copy_Report -> Total_Latency_Cycles = 0;
+    Copy_Report -> Sink_Failures        = 0;
+
+    __UART_DWT_ENABLE();
+    if (Local_Sink != NULL)
+    {
+        Local_Pending.Sink_Frames = Local_Sink -> Frame_End_Counter;
+        Local_Sink_ORE     = Local_Sink -> RX_Errors.ORE_Counter;
+        Local_Sink_Damaged = Local_Sink -> RX_Errors.Damaged_Frames;
+        Uart_Fun_Status Local_Status = MCAL_UART_Receive_INT(Local_Sink, Copy_Config -> Sink_Buffer, Copy_Config -> Sink_Size, Copy_Config -> Last_element);
+        if (Local_Status != Uart_OK)
+        {
+            // nothing is measured without the Sink, so nothing is sent.
+            USARTx ->TX_Lock_Flag = IDLE;
+            return Local_Status;
+        }
+    }
+
+    // Enable Tx
+    __COMM_ENABLE(USARTx,TX);
+    Local_Last_Cycle = DWT_CYCCNT_R;
+
+    for (Local_Index = 0; Local_Index < Copy_Config -> Records_Count; Local_Index++)
+    {
+        USART_Capture_Record *Local_Record = &(Copy_Config -> Records[Local_Index]);
+        u32 Local_Gap = (u32)(((u64)Local_Record -> Delta_Cycles * Copy_Config -> Scale_Percent) / 100U);
+
+        // wait for the (scaled) inter-element gap and for the (TRANSMIT DATA REGISTER EMPTY) flag.
+        while (((DWT_CYCCNT_R - Local_Last_Cycle) < Local_Gap) || (__UART_GET_FLAG(USARTx -> USART_x,__TXE__) == 0))
+        {
+            // serve the Sink meanwhile.
+            UART_Replay_Serve(Copy_Config, Copy_Report, &Local_Pending, 1);
+        }
+        Local_Last_Cycle = DWT_CYCCNT_R;
+        // load the Transmit word into the (DR) register
+        __UART_DR_WRITE(USARTx, Local_Record -> Element);
+        __UART_STATS_ADD(USARTx, TX_Bytes, 1);
+        Copy_Report -> Sent_Elements++;
+
+        if (Local_Record -> Element == Copy_Config -> Last_element)
+        {
+            Copy_Report -> Sent_Frames++;
+            // the oldest frame is forgotten when the Sink does not deliver the frames.
+            if (Local_Pending.Count == REPLAY_PENDING_FRAMES)
+            {
+                Local_Pending.Head = (Local_Pending.Head + 1) % REPLAY_PENDING_FRAMES;
+                Local_Pending.Count--;
+            }
+            Local_Pending.End_Cycle[(Local_Pending.Head + Local_Pending.Count) % REPLAY_PENDING_FRAMES] = Local_Last_Cycle;
+            Local_Pending.Count++;
+        }
+    }
+
+    // wait for the last element to leave the shift register.
+    UART_Wait_TC(USARTx);
+
+    if (Local_Sink != NULL)
+    {
+        // the Sink delivers the last frames after their Transmission, they are waited for (REPLAY_DRAIN_US) at most.
+        Local_Last_Cycle = DWT_CYCCNT_R;
+        while ((Local_Pending.Count > 0) && ((DWT_CYCCNT_R - Local_Last_Cycle) < __UART_US_TO_CYCLES(REPLAY_DRAIN_US)))
+        {
+            UART_Replay_Serve(Copy_Config, Copy_Report, &Local_Pending, 0);
+        }
+        Copy_Report -> Overruns       = Local_Sink -> RX_Errors.ORE_Counter    - Local_Sink_ORE;
+        Copy_Report -> Dropped_Frames = Local_Sink -> RX_Errors.Damaged_Frames - Local_Sink_Damaged;
+    }
+
+    USARTx ->TX_Lock_Flag = IDLE;
+    USARTx ->TX_Lock_Counter = 0;
+    // Disable Tx.
+    __COMM_DISABLE(USARTx,TX);
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Replay_Serve : it counts the frames delivered by the Sink with their latencies, and starts its next
+///                             Reception, after the last record only while replayed frames are still waited for.
+/// @param  Copy_Config       : the replay configuration.
+/// @param  Copy_Report       : the replay report.
+/// @param  Copy_Pending      : the replayed frames that are not Received yet.
+/// @param  Copy_Restart      : (1) the Reception is always started again, (0) only for the waiting frames.
+/// @return Nothing.
+static void UART_Replay_Serve(USART_Replay_Config *Copy_Config , USART_Replay_Report *Copy_Report ,
+                              UART_Replay_Pending *Copy_Pending , u8 Copy_Restart)
+{
+    USART_Struct *Local_Sink = Copy_Config -> Sink;
+
+    if (Local_Sink == NULL){ return; }
+    if (Local_Sink -> Frame_End_Counter != Copy_Pending -> Sink_Frames)
+    {
+        Copy_Pending -> Sink_Frames++;
+        Copy_Report -> Received_Frames++;
+        if (Copy_Pending -> Count > 0)
+        {
+            u32 Local_Latency = Local_Sink -> Frame_End_Cycle - Copy_Pending -> End_Cycle[Copy_Pending -> Head];
+            Copy_Pending -> Head = (Copy_Pending -> Head + 1) % REPLAY_PENDING_FRAMES;
+            Copy_Pending -> Count--;
+            Copy_Report -> Total_Latency_Cycles += Local_Latency;
+            if (Local_Latency > Copy_Report -> Max_Latency_Cycles)
+            {
+                Copy_Report -> Max_Latency_Cycles = Local_Latency;
+            }
+        }
+    }
+    if ((Local_Sink -> RX_Lock_Flag == IDLE) && ((Copy_Restart == 1) || (Copy_Pending -> Count > 0)) &&
+        (MCAL_UART_Receive_INT(Local_Sink, Copy_Config -> Sink_Buffer, Copy_Config -> Sink_Size, Copy_Config -> Last_element) != Uart_OK))
+    {
+        Copy_Report -> Sink_Failures++;
+    }
+}
+#endif
+
+
+
+
+#if USART_CRC == Enable
+/// @brief  MCAL_UART_CRC_Config : this function selects the running CRC of the Peripheral, it is updated by every
+///                                Transmitted and Received element, so the frame is not read again to check it.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @param  Copy_Type            : the CRC type (Uart_CRC_None), (Uart_CRC_16) or (Uart_CRC_32).
+/// @param  Copy_RX_Check        : (Enable) the Received frames end by the CRC text (the wire format above the
+///                                Uart_CRC_Type), it is checked by MCAL_UART_CRC_Check, the Transmitted frames are not
+///                                changed (MCAL_UART_Transmit_CRC_INT sends one with the text).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_CRC_Config(USART_Struct *USARTx , Uart_CRC_Type Copy_Type , u8 Copy_RX_Check)
+{
+    if ((USARTx == NULL) || (Copy_Type > Uart_CRC_32)){ return  Uart_ERROR; }
+    // the CRC can not be changed in the middle of a Transmission or a Reception.
+    if ((USARTx -> TX_Lock_Flag == BUSY) || (USARTx -> RX_Lock_Flag == BUSY)){ return Uart_BUSY; }
+
+    USARTx -> CRC_Type      = Copy_Type;
+    USARTx -> RX_CRC_Check  = (Copy_Type == Uart_CRC_None) ? Disable : Copy_RX_Check;
+    USARTx -> TX_CRC        = __UART_CRC_INIT(Copy_Type);
+    USARTx -> RX_CRC        = __UART_CRC_INIT(Copy_Type);
+    USARTx -> RX_CRC_Valid  = 0;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_CRC_Get : this function gets the CRC of the last (or the current) frame.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @param  Copy_CommType     : (TX) the CRC of the Transmitted elements, (RX) the CRC of the Received elements.
+/// @param  Copy_CRC          : pointer to hold the CRC value.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_CRC_Get(USART_Struct *USARTx , COMM_TYPE Copy_CommType , u32 *Copy_CRC)
+{
+    if ((USARTx == NULL) || (Copy_CRC == NULL) || (Copy_CommType == TX_RX)){ return  Uart_ERROR; }
+
+    u32 Local_CRC = (Copy_CommType == TX) ? USARTx -> TX_CRC : USARTx -> RX_CRC;
+    *Copy_CRC = Local_CRC ^ __UART_CRC_XOROUT(USARTx -> CRC_Type);
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_CRC_Check : this function checks the last Received frame, its CRC (hex text, {MSB} digit first)
+///                               should be just before the last element, it needs the (Copy_RX_Check) of the CRC Config.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @retval (Uart_OK) if the frame is valid, or (Uart_ERROR) if not.
+Uart_Fun_Status	    MCAL_UART_CRC_Check(USART_Struct *USARTx)
+{
+    if ((USARTx == NULL) || (USARTx -> CRC_Type == Uart_CRC_None)){ return  Uart_ERROR; }
+
+    return (USARTx -> RX_CRC_Valid == 1) ? Uart_OK : Uart_ERROR;
+}
+
+
+/// @brief  MCAL_UART_CRC_Block : this function calculates the CRC of a block by the same tables of the running CRC.
+/// @param  Copy_Type           : the CRC type (Uart_CRC_16) or (Uart_CRC_32).
+/// @param  Copy_Data           : pointer to the block.
+/// @param  Copy_Size           : the size of the block.
+/// @retval the CRC value.
+u32	                MCAL_UART_CRC_Block(Uart_CRC_Type Copy_Type , const u8 *Copy_Data , u16 Copy_Size)
+{
+    u32 Local_CRC = __UART_CRC_INIT(Copy_Type);
+
+    while (Copy_Size-- > 0)
+    {
+        Local_CRC = UART_CRC_Update(Copy_Type, Local_CRC, *Copy_Data++);
+    }
+    return Local_CRC ^ __UART_CRC_XOROUT(Copy_Type);
+}
+
+
+/// @brief  UART_CRC_Update : it adds an element to a running CRC by the table-driven method.
+/// @param  Copy_Type       : the CRC type.
+/// @param  Copy_CRC        : the running CRC value.
+/// @param  Copy_Element    : the new element.
+/// @return the new running CRC value.
+static u32 UART_CRC_Update(Uart_CRC_Type Copy_Type , u32 Copy_CRC , u8 Copy_Element)
+{
+    switch (Copy_Type)
+    {
+    case Uart_CRC_16:
+        return (Copy_CRC >> 8) ^ UART_CRC16_Table[(Copy_CRC ^ Copy_Element) & 0xFF];
+    case Uart_CRC_32:
+        return (Copy_CRC >> 8) ^ UART_CRC32_Table[(Copy_CRC ^ Copy_Element) & 0xFF];
+    default:
+        return Copy_CRC;
+    }
+}
+
+
+/// @brief  UART_RX_CRC_Add : it adds a stored element to the Receive running CRC, with the CRC text the element that is
+///                           added is the one before the digits that may follow it, so the text is not in the CRC.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @param  Copy_Next       : the buffer place after the stored element.
+/// @param  Copy_Count      : the number of the stored elements of the frame.
+/// @return None.
+static void UART_RX_CRC_Add(USART_Struct *USARTx , const u8 *Copy_Next , u16 Copy_Count)
+{
+    u8 Local_Delay = (USARTx -> RX_CRC_Check == Enable) ? __UART_CRC_DIGITS(USARTx -> CRC_Type) : 0;
+
+    if (Copy_Count > Local_Delay)
+    {
+        USARTx -> RX_CRC = UART_CRC_Update(USARTx -> CRC_Type, USARTx -> RX_CRC, *(Copy_Next - 1 - Local_Delay));
+    }
+}
+
+
+/// @brief  UART_RX_CRC_End : it checks the CRC text of a Received frame at its last element.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @param  Copy_End        : the buffer place of the last element.
+/// @param  Copy_Count      : the number of the elements before the last element.
+/// @return (1) if the CRC text is the CRC of the elements before it, or (0) if not.
+static u8 UART_RX_CRC_End(USART_Struct *USARTx , const u8 *Copy_End , u16 Copy_Count)
+{
+    u8  Local_Digits = __UART_CRC_DIGITS(USARTx -> CRC_Type);
+    u32 Local_CRC    = 0;
+    u8  Local_Value;
+
+    if ((USARTx -> RX_CRC_Check != Enable) || (Local_Digits == 0) || (Copy_Count < Local_Digits)){ return 0; }
+    for (Copy_End -= Local_Digits; Local_Digits > 0; Local_Digits--)
+    {
+        Local_Value = *Copy_End++;
+        if ((Local_Value >= '0') && (Local_Value <= '9'))     { Local_Value = (u8)(Local_Value - '0'); }
+        else if ((Local_Value >= 'A') && (Local_Value <= 'F')){ Local_Value = (u8)(Local_Value - 'A' + 10); }
+        else if ((Local_Value >= 'a') && (Local_Value <= 'f')){ Local_Value = (u8)(Local_Value - 'a' + 10); }
+        else { return 0; }
+        Local_CRC = (Local_CRC << 4) | Local_Value;
+    }
+    return (Local_CRC == (USARTx -> RX_CRC ^ __UART_CRC_XOROUT(USARTx -> CRC_Type))) ? 1U : 0U;
+}
+#endif
+
+
+
+#if USART_TIMESTAMP == Enable
+/// @brief  MCAL_UART_Get_RX_Time : this function gets the timestamps of the last Received frame, the first call for a
+///                                 frame marks its delivery, so the latency is the time the frame waited for the application.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_Time             : pointer to hold the timestamps.
+/// @retval Functions Status, (Uart_BUSY) if the Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Get_RX_Time(USART_Struct *USARTx , USART_Frame_Time *Copy_Time)
+{
+    if ((USARTx == NULL) || (Copy_Time == NULL)){ return  Uart_ERROR; }
+    if (USARTx -> RX_Lock_Flag == BUSY){ return Uart_BUSY; }
+
+    if (USARTx -> RX_Time_Delivered == 0)
+    {
+        USARTx -> RX_Time.Delivery_Cycle = DWT_CYCCNT_R;
+        USARTx -> RX_Time.Latency_Cycles = USARTx -> RX_Time.Delivery_Cycle - USARTx -> RX_Time.End_Cycle;
+        if (USARTx -> RX_Time.Latency_Cycles > USARTx -> RX_Time.Max_Latency_Cycles)
+        {
+            USARTx -> RX_Time.Max_Latency_Cycles = USARTx -> RX_Time.Latency_Cycles;
+        }
+        USARTx -> RX_Time_Delivered = 1;
+    }
+    *Copy_Time = USARTx -> RX_Time;
+    return Uart_OK;
+}
+#endif
+
+
+
+#if USART_POOL == Enable
+/// @brief  MCAL_UART_Pool_Alloc : this function takes a free frame block of (POOL_BLOCK_SIZE) elements, it can be
+///                                called by the application and by the Interrupts.
+/// @retval pointer to the block, or NULL if all the blocks are used.
+u8 *	            MCAL_UART_Pool_Alloc(void)
+{
+    u8 Local_Block = UART_Pool_Take();
+
+    return (Local_Block == POOL_NO_BLOCK) ? NULL : UART_Pool[Local_Block];
+}
+
+
+/// @brief  MCAL_UART_Pool_Free : this function gives a frame block back to the pool, it can be called by the
+///                               application and by the Interrupts.
+/// @param  Copy_Block          : pointer to the block.
+/// @retval Functions Status, (Uart_ERROR) if it is not a used block of the pool.
+Uart_Fun_Status	    MCAL_UART_Pool_Free(u8 *Copy_Block)
+{
+    u32 Local_Offset = (u32)(Copy_Block - UART_Pool[0]);
+
+    if ((Copy_Block < UART_Pool[0]) || (Local_Offset >= (POOL_BLOCKS_NUM * POOL_BLOCK_SIZE)) ||
+        ((Local_Offset % POOL_BLOCK_SIZE) != 0)){ return Uart_ERROR; }
+
+    return UART_Pool_Give((u8)(Local_Offset / POOL_BLOCK_SIZE));
+}
+
+
+/// @brief  MCAL_UART_Pool_Free_Blocks : this function gets the number of the free blocks.
+/// @retval the number of the free blocks.
+u8	                MCAL_UART_Pool_Free_Blocks(void)
+{
+    u32 Local_Map  = ~UART_Pool_Map & POOL_FULL_MAP;
+    u8  Local_Free = 0;
+
+    while (Local_Map != 0)
+    {
+        Local_Map &= Local_Map - 1;
+        Local_Free++;
+    }
+    return Local_Free;
+}
+
+
+/// @brief  MCAL_UART_Receive_Pool : this function starts a continuous Interrupt Reception into the pool blocks, the
+///                                  block of every Received frame waits for the application and the Reception goes on
+///                                  in a new block, so the frames are not copied.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Last_element           : the last element of the frames.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Receive_Pool(USART_Struct *USARTx , u8 Last_element)
+{
+    u8 Local_Block;
+    Uart_Fun_Status Local_Status;
+
+    if (USARTx == NULL){ return  Uart_ERROR; }
+    if (USARTx -> RX_Pool_Block != POOL_NO_BLOCK){ return Uart_BUSY; }
+
+    Local_Block = UART_Pool_Take();
+    if (Local_Block == POOL_NO_BLOCK){ return Uart_OVERSIZE; }
+    USARTx -> RX_Pool_Block = Local_Block;
+    Local_Status = MCAL_UART_Receive_INT(USARTx, UART_Pool[Local_Block], POOL_BLOCK_SIZE, Last_element);
+    if (Local_Status != Uart_OK)
+    {
+        USARTx -> RX_Pool_Block = POOL_NO_BLOCK;
+        (void)UART_Pool_Give(Local_Block);
+    }
+    return Local_Status;
+}
+
+
+/// @brief  MCAL_UART_Pool_Get_Frame : this function takes the oldest Received block of the port, the application owns
+///                                    it and gives it back by MCAL_UART_Pool_Free or MCAL_UART_Transmit_Pool.
+/// @param  USARTx                   : the Struct of Peripheral's Registers.
+/// @param  Copy_Size                : pointer to hold the frame size with its last element.
+/// @retval pointer to the block, or NULL if no frame is waiting.
+u8 *	            MCAL_UART_Pool_Get_Frame(USART_Struct *USARTx , u16 *Copy_Size)
+{
+    u8 Local_Out;
+    u8 *Local_Block;
+
+    if ((USARTx == NULL) || (Copy_Size == NULL)){ return NULL; }
+    // the Interrupt only writes (RX_Pool_In) and the application only writes (RX_Pool_Out), so no lock is needed.
+    Local_Out = USARTx -> RX_Pool_Out;
+    if (Local_Out == USARTx -> RX_Pool_In){ return NULL; }
+
+    Local_Block = UART_Pool[USARTx -> RX_Pool_Queue[Local_Out]];
+    *Copy_Size  = USARTx -> RX_Pool_Size[Local_Out];
+    USARTx -> RX_Pool_Out = (Local_Out + 1) % (POOL_RX_QUEUE + 1);
+    return Local_Block;
+}
+
+
+/// @brief  MCAL_UART_Transmit_Pool : this function Transmits a pool block by the Interrupt, the driver owns the block
+///                                   and frees it at the end of the Transmission.
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @param  Copy_Block              : pointer to the block.
+/// @param  Size                    : the size of the frame in the block.
+/// @param  Last_element            : the last element that should be Transmitted.
+/// @retval Functions Status, the block stays with the caller only for (Uart_BUSY) and (Uart_ERROR).
+Uart_Fun_Status	    MCAL_UART_Transmit_Pool(USART_Struct *USARTx , u8 *Copy_Block , u16 Size , u8 Last_element)
+{
+    u32 Local_Offset = (u32)(Copy_Block - UART_Pool[0]);
+    Uart_Fun_Status Local_Status;
+
+    if ((USARTx == NULL) || (Copy_Block < UART_Pool[0]) || (Local_Offset >= (POOL_BLOCKS_NUM * POOL_BLOCK_SIZE)) ||
+        ((Local_Offset % POOL_BLOCK_SIZE) != 0) || (Size > POOL_BLOCK_SIZE)){ return Uart_ERROR; }
+    if (UART_Check_LockState(USARTx, TX) == BUSY){ return Uart_BUSY; }
+    // a Transmission that was unlocked by the lock time limit leaves its block.
+    if (USARTx -> TX_Pool_Block != POOL_NO_BLOCK)
+    {
+        (void)UART_Pool_Give(USARTx -> TX_Pool_Block);
+    }
+
+    // the block is known before the first element, as the end of the Transmission gives it back.
+    USARTx -> TX_Pool_Block = (u8)(Local_Offset / POOL_BLOCK_SIZE);
+    Local_Status = MCAL_UART_Transmit_INT(USARTx, Copy_Block, Size, Last_element);
+    if (Local_Status != Uart_OK)
+    {
+        USARTx -> TX_Pool_Block = POOL_NO_BLOCK;
+    }
+    return Local_Status;
+}
+
+
+/// @brief  UART_Pool_Take : it sets the bit of the first free block by the exclusive access, an Interrupt between the
+///                          LDREX and the STREX fails the STREX, so the map is read again.
+/// @return the block index, or (POOL_NO_BLOCK).
+static u8 UART_Pool_Take(void)
+{
+    u32 Local_Map;
+    u32 Local_Result;
+    u8  Local_Block;
+
+    do
+    {
+        __UART_LDREX(&UART_Pool_Map, Local_Map);
+        if (Local_Map == POOL_FULL_MAP)
+        {
+            __UART_CLREX();
+            return POOL_NO_BLOCK;
+        }
+        Local_Block = (u8)__builtin_ctz(~Local_Map);
+        __UART_STREX(&UART_Pool_Map, (Local_Map | (1UL << Local_Block)), Local_Result);
+    } while (Local_Result != 0);
+
+    return Local_Block;
+}
+
+
+/// @brief  UART_Pool_Give : it clears the bit of a used block by the exclusive access.
+/// @param  Copy_Block     : the block index.
+/// @return Functions Status, (Uart_ERROR) if the block is free.
+static Uart_Fun_Status UART_Pool_Give(u8 Copy_Block)
+{
+    u32 Local_Map;
+    u32 Local_Result;
+
+    do
+    {
+        __UART_LDREX(&UART_Pool_Map, Local_Map);
+        if (GET_BIT(Local_Map, Copy_Block) == 0)
+        {
+            __UART_CLREX();
+            return Uart_ERROR;
+        }
+        __UART_STREX(&UART_Pool_Map, (Local_Map & ~(1UL << Copy_Block)), Local_Result);
+    } while (Local_Result != 0);
+
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Pool_RX_End : it is executed by the Handler at the end of a pool Reception, it queues the block of the
+///                            frame and Receives into a new block, or it drops the frame if there is no block or place.
+///                            a Reception that ended by an error or by the block end is not a frame, it is dropped,
+///                            its block is used again and the rest of its frame is dropped till the last element.
+/// @param  USARTx           : the Struct of Peripheral's Registers.
+/// @param  Copy_Status      : the end status of the Reception, a frame ends by (Uart_UNDERSIZE) (its last element) or
+///                            by (Uart_TIMEOUT) with elements (the Receive timeouts).
+/// @return None.
+static void UART_Pool_RX_End(USART_Struct *USARTx , Uart_Fun_Status Copy_Status)
+{
+    u8  Local_Block = USARTx -> RX_Pool_Block;
+    u8  Local_In    = USARTx -> RX_Pool_In;
+    u8  Local_Next  = (Local_In + 1) % (POOL_RX_QUEUE + 1);
+    u16 Local_Size  = USARTx -> RX_Buffer_Size;
+    u8  Local_New   = POOL_NO_BLOCK;
+    u8  Local_Resync = 0;
+
+    if ((Copy_Status != Uart_UNDERSIZE) && (Copy_Status != Uart_TIMEOUT))
+    {
+        // the strict mode error or the block end, the Received elements are dropped.
+        USARTx -> RX_Pool_Drops++;
+        __UART_STATS_ADD(USARTx, Dropped_Bytes, (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count));
+        // the rest of the frame is not a frame, so it is dropped till the last element (the damaged element of an
+        // error is kept after the Received ones).
+        Local_Resync = (Copy_Status == Uart_OVERSIZE) ||
+                       (UART_Pool[Local_Block][USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count] != USARTx -> RX_Buffer_lastEL);
+    }
+    else if (Local_Size == 0)
+    {
+        // a timeout without elements (or with a damaged frame only) has no frame.
+    }
+    else
+    {
+        // the frame is given with its last element, so it can be Transmitted from its block.
+        if ((Local_Size < POOL_BLOCK_SIZE) && (UART_Pool[Local_Block][Local_Size] == USARTx -> RX_Buffer_lastEL))
+        {
+            Local_Size++;
+        }
+        if (Local_Next != USARTx -> RX_Pool_Out)
+        {
+            Local_New = UART_Pool_Take();
+        }
+        if (Local_New == POOL_NO_BLOCK)
+        {
+            // the application is late, the frame is dropped and its block is used again.
+            USARTx -> RX_Pool_Drops++;
+            __UART_STATS_ADD(USARTx, Dropped_Bytes, Local_Size);
+        }
+    }
+    if (Local_New != POOL_NO_BLOCK)
+    {
+        USARTx -> RX_Pool_Queue[Local_In] = Local_Block;
+        USARTx -> RX_Pool_Size[Local_In]  = Local_Size;
+        USARTx -> RX_Pool_In    = Local_Next;
+        USARTx -> RX_Pool_Block = Local_New;
+    }
+    if (MCAL_UART_Receive_INT(USARTx, UART_Pool[USARTx -> RX_Pool_Block], POOL_BLOCK_SIZE, USARTx -> RX_Buffer_lastEL) != Uart_OK)
+    {
+        (void)UART_Pool_Give(USARTx -> RX_Pool_Block);
+        USARTx -> RX_Pool_Block = POOL_NO_BLOCK;
+    }
+    else if (Local_Resync == 1)
+    {
+        USARTx -> RX_Frame_Damaged = 1;
+    }
+}
+#endif
+
+
+
+#if USART_TRACE == Enable
+/// @brief  MCAL_UART_Trace_Control : this function starts or stops the recording of the events, it is stopped to keep
+///                                   the records of a fault.
+/// @param  Copy_State              : (Enable) or (Disable).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Trace_Control(u8 Copy_State)
+{
+    if ((Copy_State != Enable) && (Copy_State != Disable)){ return  Uart_ERROR; }
+
+    UART_Trace_State = Copy_State;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Trace_Read : this function copies the trace records, the oldest first.
+/// @param  Copy_Records         : the buffer of the records.
+/// @param  Copy_Max             : the number of the records in the buffer.
+/// @retval the number of the copied records.
+u16	                MCAL_UART_Trace_Read(USART_Trace_Record *Copy_Records , u16 Copy_Max)
+{
+    u32 Local_Count = UART_Trace_Count;
+    u32 Local_First = (Local_Count > TRACE_RECORDS) ? (Local_Count - TRACE_RECORDS) : 0;
+    u16 Local_Index = 0;
+    u32 Local_State;
+
+    if (Copy_Records == NULL){ return 0; }
+
+    // the newest records are kept when the buffer is smaller than the trace.
+    if ((Local_Count - Local_First) > Copy_Max)
+    {
+        Local_First = Local_Count - Copy_Max;
+    }
+    while (Local_First < Local_Count)
+    {
+        // an Interrupt does not write the record in the middle of its copy.
+        __UART_ENTER_CRITICAL(Local_State);
+        Copy_Records[Local_Index++] = UART_Trace[Local_First & (TRACE_RECORDS - 1)];
+        __UART_EXIT_CRITICAL(Local_State);
+        Local_First++;
+    }
+    return Local_Index;
+}
+
+
+/// @brief  MCAL_UART_Trace_Dump : this function stops the recording and sends the records, the oldest first, as hex text
+///                                lines (16 digits each) by writing the DR register directly, so it works from a fault
+///                                handler or with a wedged port, the host decoder is (trace_decode.py).
+/// @param  USARTx               : the Struct of the initialized Peripheral.
+/// @retval Functions Status, (Uart_TIMEOUT) if the (TXE) flag is not set in two element times (the dump stops).
+Uart_Fun_Status	    MCAL_UART_Trace_Dump(USART_Struct *USARTx)
+{
+    static const u8 Local_Hex[16] = "0123456789ABCDEF";
+    u32 Local_Count;
+    u32 Local_Index;
+    u8  Local_Byte;
+    u8 *Local_Record;
+
+    if (USARTx == NULL){ return  Uart_ERROR; }
+
+    UART_Trace_State = Disable;
+    Local_Count = UART_Trace_Count;
+    Local_Index = (Local_Count > TRACE_RECORDS) ? (Local_Count - TRACE_RECORDS) : 0;
+    __COMM_ENABLE(USARTx,TX);
+    for (; Local_Index < Local_Count; Local_Index++)
+    {
+        // the record elements as they are in the memory (little endian).
+        Local_Record = (u8 *)&UART_Trace[Local_Index & (TRACE_RECORDS - 1)];
+        for (Local_Byte = 0; Local_Byte < sizeof(USART_Trace_Record); Local_Byte++)
+        {
+            if ((UART_Trace_Put(USARTx, Local_Hex[Local_Record[Local_Byte] >> 4])   != Uart_OK) ||
+                (UART_Trace_Put(USARTx, Local_Hex[Local_Record[Local_Byte] & 0x0F]) != Uart_OK)){ return Uart_TIMEOUT; }
+        }
+        if (UART_Trace_Put(USARTx, '\n') != Uart_OK){ return Uart_TIMEOUT; }
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Trace_Add : it records one event, it claims the record by the exclusive access then fills it.
+/// @param  USARTx         : the Struct of Peripheral's Registers.
+/// @param  Copy_Event     : the event.
+/// @param  Copy_Data      : the event data.
+/// @return None.
+static void UART_Trace_Add(USART_Struct *USARTx , USART_Trace_Event Copy_Event , u16 Copy_Data)
+{
+    u32 Local_Count;
+    u32 Local_Result;
+    USART_Trace_Record *Local_Record;
+
+    if (UART_Trace_State == Disable){ return; }
+    do
+    {
+        __UART_LDREX(&UART_Trace_Count, Local_Count);
+        __UART_STREX(&UART_Trace_Count, (Local_Count + 1), Local_Result);
+    } while (Local_Result != 0);
+
+    Local_Record = &UART_Trace[Local_Count & (TRACE_RECORDS - 1)];
+    Local_Record -> Cycle = DWT_CYCCNT_R;
+    Local_Record -> Event = (u8)Copy_Event;
+    Local_Record -> Port  = (u8)((uintptr_t)(USARTx -> USART_x) >> 8);
+    Local_Record -> Data  = Copy_Data;
+}
+
+
+/// @brief  UART_Trace_Put : it sends one element of the dump when the (TXE) flag is set, it waits up to two element
+///                          times at the current Baud rate (12 bits each) by the DWT cycle counter.
+/// @param  USARTx         : the Struct of Peripheral's Registers.
+/// @param  Copy_Element   : the element.
+/// @return Functions Status, (Uart_TIMEOUT) if the (TXE) flag is not set in time (a wedged port).
+static Uart_Fun_Status UART_Trace_Put(USART_Struct *USARTx , u8 Copy_Element)
+{
+    u32 Local_Baud  = (USARTx -> Baud_Rate != 0) ? USARTx -> Baud_Rate : 1U;
+    u32 Local_Limit = (u32)((24ULL * FCK) / Local_Baud);
+    u32 Local_Start = DWT_CYCCNT_R;
+
+    while (__UART_GET_FLAG(USARTx -> USART_x, __TXE__) == 0)
+    {
+        if ((DWT_CYCCNT_R - Local_Start) >= Local_Limit){ return Uart_TIMEOUT; }
+    }
+    __UART_DR_WRITE(USARTx, Copy_Element);
+    return Uart_OK;
+}
+#endif
+
+
+
+#if USART_BAUD_FALLBACK == Enable
+/// @brief  UART_Baud_Window : it counts the Received elements and their Frame and Noise errors, the fallback is started
+///                            when the errors of one window reach (BAUD_ERROR_LIMIT).
+/// @param  USARTx           : the Struct of Peripheral's Registers.
+/// @param  Copy_SR          : the SR register of the element.
+/// @return None.
+static void UART_Baud_Window(USART_Struct *USARTx , u32 Copy_SR)
+{
+    USARTx -> Window_Elements++;
+    if ((GET_BIT(Copy_SR, __FE__) == 1) || (GET_BIT(Copy_SR, __NE__) == 1))
+    {
+        USARTx -> Window_Errors++;
+        if ((USARTx -> Window_Errors >= BAUD_ERROR_LIMIT) && (USARTx -> Baud_Rate != USARTx -> Base_Baud_Rate))
+        {
+            USARTx -> Fallback_Pending = 1;
+        }
+    }
+    if (USARTx -> Window_Elements >= BAUD_ERROR_WINDOW)
+    {
+        USARTx -> Window_Elements = 0;
+        USARTx -> Window_Errors   = 0;
+    }
+}
+
+
+/// @brief  UART_Baud_Fallback : it goes back to the Base Baud rate when the fallback is started and no element is moving,
+///                              no notice is sent, the peer goes back only if it Receives elements at the old rate
+///                              (it sees Frame errors at its faster Baud rate) and it has the fallback option too.
+/// @param  USARTx             : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Baud_Fallback(USART_Struct *USARTx)
+{
+    if ((USARTx -> Fallback_Pending == 1) && (UART_Between_Frames(USARTx) == 1))
+    {
+        UART_Write_Baud(USARTx, USARTx -> Base_Baud_Rate);
+        USARTx -> Fallback_Pending = 0;
+        USARTx -> Window_Elements  = 0;
+        USARTx -> Window_Errors    = 0;
+        USARTx -> Fallback_Counter++;
+    }
+}
+#endif
+
+
+
+
+#if USART_SYNC == Enable
+/// @brief  MCAL_UART_Sync_Config : this function selects the Synchronous master mode, the (CK) pin gives the clock of
+///                                 the Transmitted elements, the Baud rate can be up to (FCK / 8) with (Sampling_By_8).
+/// @param  USARTx                : the Struct of the initialized Peripheral.
+/// @param  Copy_Config           : the clock polarity, phase and last bit clock, or NULL to go back to the Asynchronous
+///                                 mode.
+/// @retval Functions Status, (Uart_BUSY) if a Transmission or a Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Sync_Config(USART_Struct *USARTx , MUSART_Sync_Config *Copy_Config)
+{
+    if (USARTx == NULL){ return  Uart_ERROR; }
+    if ((USARTx -> TX_Lock_Flag == BUSY) || (USARTx -> RX_Lock_Flag == BUSY)){ return Uart_BUSY; }
+
+    u32 Local_CR2 = USARTx -> CR2_Shadow & ~((1UL << CR2_CLKEN) | (1UL << CR2_CPOL) | (1UL << CR2_CPHA) | (1UL << CR2_LBCL));
+    u8  Local_UE  = __UART_SHADOW_GET(USARTx, CR1, CR1_UE);
+
+    if (Copy_Config != NULL)
+    {
+        // the LIN, Smartcard, IrDA and Half-duplex modes stay Disabled (MCAL_UART_Init_ clears them).
+        Local_CR2 |= (1UL << CR2_CLKEN)                                       |
+                     ((u32)(Copy_Config -> Clock_Polarity & 1U) << CR2_CPOL)  |
+                     ((u32)(Copy_Config -> Clock_Phase    & 1U) << CR2_CPHA)  |
+                     ((u32)(Copy_Config -> Last_Bit       & 1U) << CR2_LBCL);
+    }
+    // the clock bits are written while the Peripheral is disabled.
+    __UART_DISABLE(USARTx);
+    USARTx -> CR2_Shadow     = Local_CR2;
+    USARTx -> USART_x -> CR2 = Local_CR2;
+    if (Local_UE == 1)
+    {
+        __UART_ENABLE(USARTx);
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Sync_Transfer_INT : this function Transmits and Receives a number of elements at the same time by the
+///                                       Interrupt, like a {SPI} transaction, the elements end by the size only.
+/// @param  USARTx                      : the Struct of the Peripheral in the Synchronous mode.
+/// @param  Copy_TX_Data                : the elements to Transmit, or NULL to Transmit (0xFF).
+/// @param  Copy_RX_Data                : the buffer of the Received elements, or NULL to drop them.
+/// @param  Copy_Size                   : the number of the elements.
+/// @retval Functions Status, the RX callback is called at the end of the Transfer.
+Uart_Fun_Status	    MCAL_UART_Sync_Transfer_INT(USART_Struct *USARTx , u8 *Copy_TX_Data , u8 *Copy_RX_Data , u16 Copy_Size)
+{
+    if ((USARTx == NULL) || (Copy_Size == 0) || (__UART_SHADOW_GET(USARTx, CR2, CR2_CLKEN) == 0)){ return  Uart_ERROR; }
+    __UART_TRACE(USARTx, Trace_TX_INT, Copy_Size);
+
+    if ((UART_Check_LockState(USARTx ,TX ) == BUSY) || (UART_Check_LockState(USARTx ,RX ) == BUSY))
+    {
+        __UART_TRACE(USARTx, Trace_Return, Uart_BUSY);
+        return Uart_BUSY;
+    }
+    // the two directions are one Transfer.
+    USARTx -> TX_Lock_Flag    = BUSY;
+    USARTx -> TX_Lock_Counter = 0;
+    USARTx -> RX_Lock_Flag    = BUSY;
+    USARTx -> RX_Lock_Counter = 0;
+    __UART_TRACE(USARTx, Trace_TX_Lock, BUSY);
+    __UART_TRACE(USARTx, Trace_RX_Lock, BUSY);
+
+    USARTx -> Sync_TX_Ptr   = Copy_TX_Data;
+    USARTx -> Sync_RX_Ptr   = Copy_RX_Data;
+    USARTx -> Sync_Size     = Copy_Size;
+    USARTx -> Sync_TX_Count = 0;
+    USARTx -> Sync_RX_Count = 0;
+    USARTx -> Error_Code    = (u8 *)Error_1;
+    USARTx -> Sync_Active   = 1;
+
+    __COMM_ENABLE(USARTx,TX);
+    __COMM_ENABLE(USARTx,RX);
+    // clear an old element and the Overrun flag.
+    (void)USARTx -> USART_x -> SR;
+    (void)__UART_DR_READ(USARTx);
+    // the first two elements are loaded before the interrupt is enabled, so the clock does not stop between them.
+    UART_Sync_Load(USARTx);
+    __UART_SHADOW_SAFE_SET(USARTx, CR1, CR1_RXNEIE);
+
+    __UART_TRACE(USARTx, Trace_Return, Uart_OK);
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Sync_Load : it loads the next Transmitted elements while (DR) is empty, one element is shifted and one
+///                          waits in (DR), so a Received element is read before the next one ends.
+/// @param  USARTx         : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Sync_Load(USART_Struct *USARTx)
+{
+    while ((USARTx -> Sync_TX_Count < USARTx -> Sync_Size) &&
+           (USARTx -> Sync_TX_Count < (USARTx -> Sync_RX_Count + 2U)) &&
+           (__UART_GET_FLAG(USARTx -> USART_x, __TXE__) == 1))
+    {
+        u8 Local_Element = (USARTx -> Sync_TX_Ptr != NULL) ? USARTx -> Sync_TX_Ptr[USARTx -> Sync_TX_Count] : 0xFFU;
+        __UART_DR_WRITE(USARTx, Local_Element);
+        __UART_STATS_ADD(USARTx, TX_Bytes, 1);
+        USARTx -> Sync_TX_Count++;
+    }
+}
+
+
+/// @brief  UART_Sync_Element : it stores one Received element of the Synchronous Transfer and loads the next Transmitted
+///                             one, the Transfer ends by its size.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Sync_Element(USART_Struct *USARTx)
+{
+    u32 Local_SR;
+    u8  Local_Element = UART_Read_Element(USARTx, &Local_SR);
+
+    // the elements are counted even with an error, as the clock gave them.
+    if ((Local_SR & UART_RX_ERRORS_MASK) != 0)
+    {
+        UART_Handle_RX_Errors(USARTx, Local_SR);
+    }
+    if (USARTx -> Sync_RX_Ptr != NULL)
+    {
+        USARTx -> Sync_RX_Ptr[USARTx -> Sync_RX_Count] = Local_Element;
+    }
+    USARTx -> Sync_RX_Count++;
+    if (USARTx -> Sync_RX_Count < USARTx -> Sync_Size)
+    {
+        UART_Sync_Load(USARTx);
+        return;
+    }
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
+    USARTx -> Sync_Active     = 0;
+    USARTx -> TX_Lock_Flag    = IDLE;
+    USARTx -> TX_Lock_Counter = 0;
+    USARTx -> RX_Lock_Flag    = IDLE;
+    USARTx -> RX_Lock_Counter = 0;
+    __UART_TRACE(USARTx, Trace_TX_End, Uart_OK);
+    __UART_TRACE(USARTx, Trace_RX_End, Uart_OK);
+}
+#endif
+
+
+
+#if USART_MODBUS == Enable
+/// @brief  MCAL_UART_Modbus_Start : this function starts the Modbus RTU mode of the port, the Receive elements are stored
+///                                  in one half of the buffer while the last valid frame waits in the other half, a frame
+///                                  ends by the IDLE line with a valid CRC and it is given by the RX callback.
+/// @param  USARTx                 : the Struct of the initialized Peripheral (8 data bits, its Baud rate is used for t1.5
+///                                  and t3.5).
+/// @param  Copy_Buffer            : the buffer of two frames.
+/// @param  Copy_Size              : the size of one frame (up to 256).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Modbus_Start(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size)
+{
+    if ((USARTx == NULL) || (Copy_Buffer == NULL) || (Copy_Size < 4)){ return  Uart_ERROR; }
+    if ((USARTx -> TX_Lock_Flag == BUSY) || (USARTx -> RX_Lock_Flag == BUSY)){ return Uart_BUSY; }
+
+    __UART_DWT_ENABLE();
+    // the CRC is added by MCAL_UART_Modbus_Send, and checked by the running CRC of the frame,
+    // the CRC configuration of the port is saved, so MCAL_UART_Modbus_Stop gives it back.
+    USARTx -> Modbus_Saved_CRC_Type  = USARTx -> CRC_Type;
+    USARTx -> Modbus_Saved_CRC_Check = USARTx -> RX_CRC_Check;
+    USARTx -> CRC_Type      = Uart_CRC_16;
+    USARTx -> RX_CRC_Check  = Disable;
+    USARTx -> Modbus_Size    = Copy_Size;
+    USARTx -> Modbus_Length  = 0;
+    USARTx -> Modbus_Half    = 0;
+    USARTx -> Modbus_Open    = 0;
+    USARTx -> Modbus_Damaged = 0;
+    USARTx -> Modbus_Ready   = 0;
+    USARTx -> Modbus_CRC     = UART_CRC16_INIT;
+    USARTx -> Modbus_Stats.Frames      = 0;
+    USARTx -> Modbus_Stats.CRC_Errors  = 0;
+    USARTx -> Modbus_Stats.Gap_Errors  = 0;
+    USARTx -> Modbus_Stats.Damaged     = 0;
+    USARTx -> Modbus_Stats.Overwritten = 0;
+    USARTx -> Modbus_Buffer  = Copy_Buffer;
+    UART_Modbus_Times(USARTx);
+    // the line is taken as silent since t3.5.
+    USARTx -> Modbus_Last_Cycle = DWT_CYCCNT_R - USARTx -> Modbus_T35;
+
+    // the Reception stays on, so the Receive buffer is not used by the other Receive functions.
+    USARTx -> RX_Lock_Flag     = BUSY;
+    USARTx -> RX_Lock_Counter  = 0;
+    USARTx -> RX_Buffer_Size   = 0;
+    USARTx -> RX_Process_Count = 0;
+    USARTx -> RX_Frame_Damaged = 0;
+    __UART_TRACE(USARTx, Trace_RX_Lock, BUSY);
+    __COMM_ENABLE(USARTx,RX);
+    (void)USARTx -> USART_x -> SR;
+    (void)__UART_DR_READ(USARTx);
+    __UART_SHADOW_SAFE_SET(USARTx, CR1, CR1_RXNEIE);
+    __UART_SHADOW_SAFE_SET(USARTx, CR1, CR1_IDLEIE);
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Modbus_Stop : this function stops the Modbus RTU mode of the port, the CRC type and the RX CRC
+///                                 check of the port before MCAL_UART_Modbus_Start are given back.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Modbus_Stop(USART_Struct *USARTx)
+{
+    if ((USARTx == NULL) || (USARTx -> Modbus_Buffer == NULL)){ return  Uart_ERROR; }
+    if (USARTx -> TX_Lock_Flag == BUSY){ return Uart_BUSY; }
+
+    __UART_SHADOW_SAFE_CLR(USARTx, CR1, CR1_IDLEIE);
+    __UART_SHADOW_SAFE_CLR(USARTx, CR1, CR1_RXNEIE);
+    USARTx -> Modbus_Buffer = NULL;
+    USARTx -> CRC_Type      = USARTx -> Modbus_Saved_CRC_Type;
+    USARTx -> RX_CRC_Check  = USARTx -> Modbus_Saved_CRC_Check;
+    USARTx -> RX_Lock_Flag  = IDLE;
+    __UART_TRACE(USARTx, Trace_RX_Lock, IDLE);
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Modbus_Get_Frame : this function takes the last valid frame, it stays valid till the next frame ends.
+/// @param  USARTx                     : the Struct of Peripheral's Registers.
+/// @param  Copy_Frame                 : pointer to hold the frame (address, function, data).
+/// @param  Copy_Size                  : pointer to hold the frame size without its CRC.
+/// @retval Functions Status, (Uart_BUSY) if there is no new frame.
+Uart_Fun_Status	    MCAL_UART_Modbus_Get_Frame(USART_Struct *USARTx , u8 **Copy_Frame , u16 *Copy_Size)
+{
+    if ((USARTx == NULL) || (Copy_Frame == NULL) || (Copy_Size == NULL) || (USARTx -> Modbus_Buffer == NULL))
+    {
+        return  Uart_ERROR;
+    }
+    // the Interrupts are disabled, so a frame that ends here does not change the half and the length between the reads.
+    u32 Local_State;
+    __UART_ENTER_CRITICAL(Local_State);
+    if (USARTx -> Modbus_Ready == 0)
+    {
+        __UART_EXIT_CRITICAL(Local_State);
+        return Uart_BUSY;
+    }
+    // the waiting frame is in the other half of the current frame.
+    *Copy_Frame = USARTx -> Modbus_Buffer + ((USARTx -> Modbus_Half ^ 1U) * USARTx -> Modbus_Size);
+    *Copy_Size  = USARTx -> Modbus_Ready_Length - 2U;
+    USARTx -> Modbus_Ready = 0;
+    __UART_EXIT_CRITICAL(Local_State);
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Modbus_Send : this function adds the CRC to a frame and sends it by the Interrupt after t3.5 of
+///                                 silence, the elements are not checked for a last element.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_Frame            : the frame, it should have two more elements for the CRC.
+/// @param  Copy_Size             : the frame size without its CRC.
+/// @retval Functions Status, (Uart_BUSY) if the line was active in the last t3.5 or a Transmission is in progress.
+Uart_Fun_Status	    MCAL_UART_Modbus_Send(USART_Struct *USARTx , u8 *Copy_Frame , u16 Copy_Size)
+{
+    if ((USARTx == NULL) || (Copy_Frame == NULL) || (Copy_Size < 2) || (USARTx -> Modbus_Buffer == NULL))
+    {
+        return  Uart_ERROR;
+    }
+    // a frame with a wrong CRC is dropped after t3.5 of silence, no element can continue it, so it does not wait for one.
+    if (USARTx -> Modbus_Open == 1)
+    {
+        u32 Local_State;
+        __UART_ENTER_CRITICAL(Local_State);
+        if ((USARTx -> Modbus_Open == 1) && ((DWT_CYCCNT_R - USARTx -> Modbus_Last_Cycle) >= USARTx -> Modbus_T35))
+        {
+            UART_Modbus_Drop(USARTx);
+        }
+        __UART_EXIT_CRITICAL(Local_State);
+    }
+    // a frame is on the line, or the line is not silent for t3.5.
+    if ((USARTx -> Modbus_Length > 0) || ((DWT_CYCCNT_R - USARTx -> Modbus_Last_Cycle) < USARTx -> Modbus_T35))
+    {
+        return Uart_BUSY;
+    }
+    u16 Local_CRC = (u16)MCAL_UART_CRC_Block(Uart_CRC_16, Copy_Frame, Copy_Size);
+    Copy_Frame[Copy_Size]      = (u8)(Local_CRC & 0xFF);
+    Copy_Frame[Copy_Size + 1U] = (u8)(Local_CRC >> 8);
+
+    // the Transmission ends by its size.
+    return MCAL_UART_Transmit_INT(USARTx, Copy_Frame, Copy_Size + 2U, 0);
+}
+
+
+/// @brief  MCAL_UART_Modbus_Get_Stats : this function gets the Modbus RTU statistics of the port.
+/// @param  USARTx                     : the Struct of Peripheral's Registers.
+/// @param  Copy_Stats                 : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Modbus_Get_Stats(USART_Struct *USARTx , USART_Modbus_Stats *Copy_Stats)
+{
+    if ((USARTx == NULL) || (Copy_Stats == NULL)){ return  Uart_ERROR; }
+
+    *Copy_Stats = USARTx -> Modbus_Stats;
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Modbus_Times : it calculates t1.5 and t3.5 in DWT cycles, as the times between the ends of two elements
+///                             (one element time is added), they are fixed to 750us and 1750us above 19200 Baud.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Modbus_Times(USART_Struct *USARTx)
+{
+    // one element of the RTU mode is 11 bits.
+    u32 Local_Char = (FCK * 11UL) / USARTx -> Baud_Rate;
+
+    if (USARTx -> Baud_Rate > 19200U)
+    {
+        USARTx -> Modbus_T15 = Local_Char + ((FCK / 1000000UL) * 750UL);
+        USARTx -> Modbus_T35 = Local_Char + ((FCK / 1000000UL) * 1750UL);
+    }
+    else
+    {
+        USARTx -> Modbus_T15 = Local_Char + ((Local_Char * 3U) / 2U);
+        USARTx -> Modbus_T35 = Local_Char + ((Local_Char * 7U) / 2U);
+    }
+}
+
+
+/// @brief  UART_Modbus_Element : it stores one Received element of the Modbus frame, a silence longer than t1.5 inside
+///                               the frame ends it, and a frame that starts before t3.5 of silence is dropped.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Modbus_Element(USART_Struct *USARTx)
+{
+    u32 Local_SR;
+#if USART_TIMESTAMP == Enable
+    // the Reception of the Modbus mode has no size, so the first element of the frame is set here.
+    u32 Local_First   = USARTx -> RX_Time.First_Cycle;
+#endif
+    u8  Local_Element = UART_Read_Element(USARTx, &Local_SR);
+    u32 Local_Cycle   = DWT_CYCCNT_R;
+    u32 Local_Gap     = Local_Cycle - USARTx -> Modbus_Last_Cycle;
+
+    USARTx -> Modbus_Last_Cycle = Local_Cycle;
+    // the frame with a wrong CRC at the IDLE line continues only if the silence is less than t1.5.
+    if ((USARTx -> Modbus_Open == 1) && (Local_Gap > USARTx -> Modbus_T15))
+    {
+        UART_Modbus_Drop(USARTx);
+    }
+#if USART_TIMESTAMP == Enable
+    USARTx -> RX_Time.First_Cycle = (USARTx -> Modbus_Length == 0) ? USARTx -> RX_Time.End_Cycle : Local_First;
+#endif
+    if ((USARTx -> Modbus_Length == 0) && (Local_Gap < USARTx -> Modbus_T35))
+    {
+        USARTx -> Modbus_Stats.Gap_Errors++;
+        USARTx -> Modbus_Damaged = 1;
+    }
+    if ((Local_SR & UART_RX_ERRORS_MASK) != 0)
+    {
+        UART_Handle_RX_Errors(USARTx, Local_SR);
+        USARTx -> Modbus_Damaged = 1;
+    }
+    if (USARTx -> Modbus_Length < USARTx -> Modbus_Size)
+    {
+        USARTx -> Modbus_Buffer[(USARTx -> Modbus_Half * USARTx -> Modbus_Size) + USARTx -> Modbus_Length] = Local_Element;
+        USARTx -> Modbus_CRC = UART_CRC_Update(Uart_CRC_16, USARTx -> Modbus_CRC, Local_Element);
+        USARTx -> Modbus_Length++;
+    }
+    else
+    {
+        USARTx -> Modbus_Damaged = 1;
+    }
+    // the IDLE flag is cleared by the reading of the element, so the frame end is checked here.
+    if (GET_BIT(Local_SR, __IDLE__) == 1)
+    {
+        UART_Modbus_End(USARTx);
+    }
+}
+
+
+/// @brief  UART_Modbus_Idle : it is the IDLE line interrupt of the Modbus mode, the element that has just been Received
+///                            is left to the (RXNE) interrupt, it checks the IDLE flag itself.
+/// @param  USARTx           : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Modbus_Idle(USART_Struct *USARTx)
+{
+    u32 Local_SR = USARTx -> USART_x -> SR;
+
+    if (GET_BIT(Local_SR, __RXNE__) == 1){ return; }
+    // the SR then DR reading clears the IDLE flag.
+    (void)__UART_DR_READ(USARTx);
+    UART_Modbus_End(USARTx);
+}
+
+
+/// @brief  UART_Modbus_End : it checks the frame at the IDLE line, a valid frame waits for the application and the next
+///                           one is Received in the other half, a frame with a wrong CRC stays open till t1.5 ends.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Modbus_End(USART_Struct *USARTx)
+{
+    if (USARTx -> Modbus_Length == 0){ return; }
+
+    if (USARTx -> Modbus_Damaged == 1)
+    {
+        USARTx -> Modbus_Stats.Damaged++;
+        USARTx -> RX_Errors.Damaged_Frames++;
+        __UART_TRACE(USARTx, Trace_RX_End, Uart_ERROR);
+    }
+    else if ((USARTx -> Modbus_CRC == 0) && (USARTx -> Modbus_Length >= 4))
+    {
+        if (USARTx -> Modbus_Ready == 1)
+        {
+            USARTx -> Modbus_Stats.Overwritten++;
+        }
+        USARTx -> Modbus_Ready_Length = USARTx -> Modbus_Length;
+        USARTx -> Modbus_Half ^= 1U;
+        USARTx -> Modbus_Ready = 1;
+        USARTx -> Modbus_Stats.Frames++;
+#if USART_CAPTURE == Enable
+        USARTx -> Frame_End_Cycle = DWT_CYCCNT_R;
+        USARTx -> Frame_End_Counter++;
+#endif
+#if USART_TIMESTAMP == Enable
+        USARTx -> RX_Time_Delivered = 0;
+#endif
+        __UART_TRACE(USARTx, Trace_RX_End, Uart_OK);
+        if (USARTx -> RX_CallBack != NULL)
+        {
+            USARTx -> RX_CallBack(USARTx);
+        }
+    }
+    else
+    {
+        // the silence may still be shorter than t1.5, it is checked by the next element or by MCAL_UART_Modbus_Send.
+        USARTx -> Modbus_Open = 1;
+        return;
+    }
+    USARTx -> Modbus_Open    = 0;
+    USARTx -> Modbus_Length  = 0;
+    USARTx -> Modbus_Damaged = 0;
+    USARTx -> Modbus_CRC     = UART_CRC16_INIT;
+}
+
+
+/// @brief  UART_Modbus_Drop : it drops the open frame with a wrong CRC, the silence after it is longer than t1.5.
+/// @param  USARTx           : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Modbus_Drop(USART_Struct *USARTx)
+{
+    USARTx -> Modbus_Stats.CRC_Errors++;
+    __UART_TRACE(USARTx, Trace_RX_End, Uart_ERROR);
+    USARTx -> Modbus_Open    = 0;
+    USARTx -> Modbus_Length  = 0;
+    USARTx -> Modbus_Damaged = 0;
+    USARTx -> Modbus_CRC     = UART_CRC16_INIT;
+}
+#endif
+
+
+#if USART_WRITE == Enable
+/// @brief  MCAL_UART_Write_Start : this function starts the buffered write mode of the port, the written elements wait in
+///                                 a ring till they reach the threshold or the oldest one reaches the deadline.
+/// @param  USARTx                : the Struct of the initialized Peripheral.
+/// @param  Copy_Buffer           : the ring, it holds (Copy_Size - 1) elements.
+/// @param  Copy_Size             : the size of the ring.
+/// @param  Copy_Threshold        : the waiting elements that start the Transmission (1 to send every write at once).
+/// @param  Copy_Deadline_us      : the longest wait of an element in microseconds, it is checked by MCAL_UART_Write and
+///                                 MCAL_UART_Write_Tick.
+/// @retval Functions Status, (Uart_BUSY) if a Transmission is in progress.
+Uart_Fun_Status	    MCAL_UART_Write_Start(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size , u16 Copy_Threshold , u32 Copy_Deadline_us)
+{
+    if ((USARTx == NULL) || (Copy_Buffer == NULL) || (Copy_Size < 2) || (Copy_Threshold == 0)){ return  Uart_ERROR; }
+    if (USARTx -> TX_Lock_Flag == BUSY){ return Uart_BUSY; }
+
+    __UART_DWT_ENABLE();
+    USARTx -> Write_Size      = Copy_Size;
+    USARTx -> Write_Threshold = (Copy_Threshold < Copy_Size) ? Copy_Threshold : (Copy_Size - 1);
+    USARTx -> Write_Deadline  = (FCK / 1000000UL) * Copy_Deadline_us;
+    USARTx -> Write_In        = 0;
+    USARTx -> Write_Out       = 0;
+    USARTx -> Write_Span      = 0;
+    USARTx -> Write_Streaming = 0;
+    USARTx -> Write_Stats.Messages = 0;
+    USARTx -> Write_Stats.Bytes    = 0;
+    USARTx -> Write_Stats.Streams  = 0;
+    USARTx -> Write_Stats.Extended = 0;
+    USARTx -> Write_Stats.Full     = 0;
+    USARTx -> Write_Stats.Max_Wait_Cycles = 0;
+    USARTx -> Write_Buffer    = Copy_Buffer;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Write_Stop : this function stops the buffered write mode, the waiting elements are dropped.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @retval Functions Status, (Uart_BUSY) if the ring is being sent.
+Uart_Fun_Status	    MCAL_UART_Write_Stop(USART_Struct *USARTx)
+{
+    if ((USARTx == NULL) || (USARTx -> Write_Buffer == NULL)){ return  Uart_ERROR; }
+    if (USARTx -> Write_Streaming == 1){ return Uart_BUSY; }
+
+    USARTx -> Write_Buffer = NULL;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Write : this function copies elements into the ring, they are added to the Transmission in progress
+///                           or they start one at the threshold or the deadline, it is called by the application only.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @param  ptData          : pointer of the elements.
+/// @param  Size            : the number of the elements.
+/// @retval Functions Status, (Uart_BUSY) if the ring has no place for all the elements (none is copied).
+Uart_Fun_Status	    MCAL_UART_Write(USART_Struct *USARTx , const u8 *ptData , u16 Size)
+{
+    if ((USARTx == NULL) || (USARTx -> Write_Buffer == NULL) || (ptData == NULL) || (Size == 0)){ return  Uart_ERROR; }
+
+    u16 Local_In    = USARTx -> Write_In;
+    u16 Local_Count = (u16)((Local_In + USARTx -> Write_Size - USARTx -> Write_Out) % USARTx -> Write_Size);
+
+    // the elements of the Transmission in progress keep their place till it ends.
+    if (Size > (USARTx -> Write_Size - 1U - Local_Count))
+    {
+        USARTx -> Write_Stats.Full++;
+        return Uart_BUSY;
+    }
+    if (Local_Count == 0)
+    {
+        USARTx -> Write_First_Cycle = DWT_CYCCNT_R;
+    }
+    USARTx -> Write_Stats.Bytes += Size;
+    while (Size > 0)
+    {
+        USARTx -> Write_Buffer[Local_In] = *ptData++;
+        Local_In = (Local_In + 1U == USARTx -> Write_Size) ? 0 : (u16)(Local_In + 1U);
+        Size--;
+    }
+    // the Interrupt takes the elements by the index, so they are stored before it.
+    __UART_COMPILER_BARRIER();
+    USARTx -> Write_In = Local_In;
+    USARTx -> Write_Stats.Messages++;
+    return UART_Write_Send(USARTx, 0);
+}
+
+
+/// @brief  MCAL_UART_Write_Flush : this function starts the Transmission of the waiting elements without the threshold.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Write_Flush(USART_Struct *USARTx)
+{
+    if ((USARTx == NULL) || (USARTx -> Write_Buffer == NULL)){ return  Uart_ERROR; }
+
+    return UART_Write_Send(USARTx, 1);
+}
+
+
+/// @brief  MCAL_UART_Write_Tick : this function checks the deadline of the waiting elements, it is called periodically
+///                                (by the main loop or the STK timer) when the application may stop writing.
+/// @param  USARTx               : the Struct of Peripheral's Registers.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Write_Tick(USART_Struct *USARTx)
+{
+    if ((USARTx == NULL) || (USARTx -> Write_Buffer == NULL)){ return  Uart_ERROR; }
+
+    return UART_Write_Send(USARTx, 0);
+}
+
+
+/// @brief  MCAL_UART_Write_Get_Stats : this function gets the buffered write statistics, (Messages / Streams) is the
+///                                     number of the writes that share one Transmission setup.
+/// @param  USARTx                    : the Struct of Peripheral's Registers.
+/// @param  Copy_Stats                : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Write_Get_Stats(USART_Struct *USARTx , USART_Write_Stats *Copy_Stats)
+{
+    if ((USARTx == NULL) || (Copy_Stats == NULL)){ return  Uart_ERROR; }
+
+    *Copy_Stats = USARTx -> Write_Stats;
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Write_Span : it gets the waiting elements that follow each other in the ring from its out index.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @return the number of the elements.
+static u16 UART_Write_Span(USART_Struct *USARTx)
+{
+    u16 Local_In  = USARTx -> Write_In;
+    u16 Local_Out = USARTx -> Write_Out;
+
+    return (Local_In >= Local_Out) ? (u16)(Local_In - Local_Out) : (u16)(USARTx -> Write_Size - Local_Out);
+}
+
+
+/// @brief  UART_Write_Next : it is executed by the Handler at the end of a span of the ring, the span place is given back
+///                           and the next written elements are sent by the same Transmission.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @return (Uart_OK) if the Transmission goes on, or (Uart_OVERSIZE) if the ring is empty.
+static Uart_Fun_Status UART_Write_Next(USART_Struct *USARTx)
+{
+    u16 Local_Out  = USARTx -> Write_Out + USARTx -> Write_Span;
+    u16 Local_Span;
+
+    USARTx -> Write_Out = (Local_Out >= USARTx -> Write_Size) ? (u16)(Local_Out - USARTx -> Write_Size) : Local_Out;
+    Local_Span = UART_Write_Span(USARTx);
+    USARTx -> Write_Span = Local_Span;
+    if (Local_Span == 0)
+    {
+        USARTx -> Write_Streaming = 0;
+        return Uart_OVERSIZE;
+    }
+    USARTx -> TX_Buffer_Ptr    = &USARTx -> Write_Buffer[USARTx -> Write_Out];
+    USARTx -> TX_Buffer_Size   = Local_Span;
+    USARTx -> TX_Process_Count = (s16)Local_Span;
+    USARTx -> Write_Stats.Extended++;
+    // the span is a new frame of the same Transmission.
+    __UART_TRACE(USARTx, Trace_TX_INT, Local_Span);
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Write_Send : it starts the Transmission of the ring if the port is free and the waiting elements reach
+///                           the threshold or the deadline.
+/// @param  USARTx          : the Struct of Peripheral's Registers.
+/// @param  Copy_Force      : (1) to start it without the threshold and the deadline.
+/// @return Functions Status, (Uart_OK) if the elements are sent or wait for their threshold.
+static Uart_Fun_Status UART_Write_Send(USART_Struct *USARTx , u8 Copy_Force)
+{
+    Uart_Fun_Status Local_Status;
+    u16 Local_Count;
+    u16 Local_Span;
+    u32 Local_Wait;
+
+    // a running Transmission of the ring takes the new elements at the end of its span, and the Interrupt can only end
+    // the Transmission (not start it), so the port is checked without a critical section.
+    if ((USARTx -> Write_Streaming == 1) || (USARTx -> TX_Lock_Flag == BUSY)){ return Uart_OK; }
+
+    Local_Count = (u16)((USARTx -> Write_In + USARTx -> Write_Size - USARTx -> Write_Out) % USARTx -> Write_Size);
+    if (Local_Count == 0){ return Uart_OK; }
+    if ((Copy_Force == 0) && (Local_Count < USARTx -> Write_Threshold) &&
+        ((DWT_CYCCNT_R - USARTx -> Write_First_Cycle) < USARTx -> Write_Deadline))
+    {
+        return Uart_OK;
+    }
+
+    Local_Span = UART_Write_Span(USARTx);
+    Local_Wait = DWT_CYCCNT_R - USARTx -> Write_First_Cycle;
+    USARTx -> Write_Span      = Local_Span;
+    USARTx -> Write_Streaming = 1;
+    USARTx -> Write_Stats.Streams++;
+    if (Local_Wait > USARTx -> Write_Stats.Max_Wait_Cycles)
+    {
+        USARTx -> Write_Stats.Max_Wait_Cycles = Local_Wait;
+    }
+    Local_Status = MCAL_UART_Transmit_INT(USARTx, &USARTx -> Write_Buffer[USARTx -> Write_Out], Local_Span, 0);
+    if (Local_Status != Uart_OK)
+    {
+        // it is not started, the elements wait for the next call.
+        USARTx -> Write_Streaming = 0;
+        USARTx -> Write_Stats.Streams--;
+    }
+    return Local_Status;
+}
+#endif
+
+
+#if USART_RX_TIMEOUT == Enable
+/// @brief  MCAL_UART_Set_RX_Timeouts : this function sets the end rules of the next Receptions (polling and Interrupt),
+///                                     a Reception ends by the first one of : its buffer size (the elements number), its
+///                                     last element, a silence after its elements, or its total time. The two timeouts end
+///                                     it with (Uart_TIMEOUT), (Error_6) and the Received elements number in RX_Buffer_Size.
+/// @param  USARTx                    : the Struct of Peripheral's Registers.
+/// @param  Copy_Gap_us               : the silence after a Received element in microseconds, (UART_RX_GAP_IDLE) for one
+///                                     element time (the IDLE line by the hardware), or (0) for no gap rule.
+/// @param  Copy_Total_us             : the longest time of a Reception in microseconds, or (0) for no total rule.
+/// @retval Functions Status, (Uart_BUSY) if a Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Set_RX_Timeouts(USART_Struct *USARTx , u32 Copy_Gap_us , u32 Copy_Total_us)
+{
+    if (USARTx == NULL){ return  Uart_ERROR; }
+    // the rules can not be changed in the middle of a Reception.
+    if (USARTx -> RX_Lock_Flag == BUSY){ return Uart_BUSY; }
+
+    USARTx -> RX_Gap_Idle     = (Copy_Gap_us == UART_RX_GAP_IDLE);
+    USARTx -> RX_Gap_Cycles   = (Copy_Gap_us == UART_RX_GAP_IDLE) ? 0 : ((FCK / 1000000UL) * Copy_Gap_us);
+    USARTx -> RX_Total_Cycles = (FCK / 1000000UL) * Copy_Total_us;
+    if (USARTx -> RX_Gap_Idle == 0)
+    {
+        __UART_SHADOW_SAFE_CLR(USARTx, CR1, CR1_IDLEIE);
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_RX_Tick : this function checks the gap (longer than one element time) and the total time of the
+///                             Interrupt Reception, it is called periodically by the STK timer, as the USART of the
+///                             STM32F4 has no Receive timeout; the IDLE gap and the polling Reception do not need it.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @retval Functions Status, (Uart_TIMEOUT) if the Reception is ended by this call.
+Uart_Fun_Status	    MCAL_UART_RX_Tick(USART_Struct *USARTx)
+{
+    Uart_Fun_Status Local_Status = Uart_OK;
+    u32 Local_State;
+
+    if (USARTx == NULL){ return  Uart_ERROR; }
+
+    // the Handler can end the Reception at the same time, so the check and the end are done with no Interrupts.
+    __UART_ENTER_CRITICAL(Local_State);
+    if ((USARTx -> RX_Lock_Flag == BUSY) && (__UART_SHADOW_GET(USARTx, CR1, CR1_RXNEIE) == 1) &&
+        (UART_RX_Timeout_Check(USARTx, 0) == 1))
+    {
+        UART_RX_Timeout_Finish(USARTx);
+        Local_Status = Uart_TIMEOUT;
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+    return Local_Status;
+}
+
+
+/// @brief  UART_RX_Timeout_Check : it checks the timeouts of the Reception in progress, the gap starts at the first
+///                                 element (no gap is checked before it), the total time starts with the Reception.
+/// @param  USARTx                : the Struct of Peripheral's Registers.
+/// @param  Copy_SR               : the SR register value for the IDLE flag, or (0).
+/// @return (1) if the Reception should end, or (0).
+static u8 UART_RX_Timeout_Check(USART_Struct *USARTx , u32 Copy_SR)
+{
+    u32 Local_Cycle = DWT_CYCCNT_R;
+
+#if USART_MODBUS == Enable
+    // the Modbus frames have their own silence rules.
+    if (USARTx -> Modbus_Buffer != NULL){ return 0; }
+#endif
+#if USART_SYNC == Enable
+    if (USARTx -> Sync_Active == 1){ return 0; }
+#endif
+#if USART_RX_RING == Enable
+    // the ring Reception is a stream, it does not end.
+    if (USARTx -> Ring_Buffer != NULL){ return 0; }
+#endif
+    if ((USARTx -> RX_Total_Cycles != 0) && ((Local_Cycle - USARTx -> RX_Start_Cycle) >= USARTx -> RX_Total_Cycles))
+    {
+        return 1;
+    }
+    // no element of the current frame, a dropped frame waits for its end.
+    if ((USARTx -> RX_Process_Count == (s16)(USARTx -> RX_Buffer_Size)) || (USARTx -> RX_Frame_Damaged == 1)){ return 0; }
+    if (USARTx -> RX_Gap_Idle == 1)
+    {
+        return (u8)GET_BIT(Copy_SR, __IDLE__);
+    }
+    return (u8)((USARTx -> RX_Gap_Cycles != 0) && ((Local_Cycle - USARTx -> RX_Last_Cycle) >= USARTx -> RX_Gap_Cycles));
+}
+
+
+/// @brief  UART_RX_Timeout_End : it ends the Reception by a timeout, RX_Buffer_Size holds the Received elements.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @return (Uart_TIMEOUT).
+static Uart_Fun_Status UART_RX_Timeout_End(USART_Struct *USARTx)
+{
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_IDLEIE);
+    USARTx -> RX_Buffer_Size  = (USARTx -> RX_Frame_Damaged == 1) ? 0 : (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count);
+    USARTx -> RX_Frame_Damaged = 0;
+    USARTx -> Error_Code      = (u8 *)Error_6;
+    USARTx -> RX_Lock_Flag    = IDLE;
+    USARTx -> RX_Lock_Counter = 0;
+    __UART_TRACE(USARTx, Trace_RX_End, Uart_TIMEOUT);
+    return Uart_TIMEOUT;
+}
+
+
+/// @brief  UART_RX_Timeout_Finish : it ends the Interrupt Reception by a timeout out of the (RXNE) Handler, and does the
+///                                  same end steps (the pool block and the RX callback).
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_RX_Timeout_Finish(USART_Struct *USARTx)
+{
+    (void)UART_RX_Timeout_End(USARTx);
+#if USART_POOL == Enable
+    if (USARTx -> RX_Pool_Block != POOL_NO_BLOCK)
+    {
+        UART_Pool_RX_End(USARTx, Uart_TIMEOUT);
+    }
+#endif
+    if (USARTx -> RX_CallBack != NULL)
+    {
+        USARTx -> RX_CallBack(USARTx);
+    }
+}
+#endif
+
+
+
+#if (USART_MODBUS == Enable) || (USART_RX_TIMEOUT == Enable)
+/// @brief  UART_Idle_Handler : it is the IDLE line interrupt, it ends a Modbus frame or a burst of the Interrupt
+///                             Reception, the element that has just been Received is left to the (RXNE) interrupt.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Idle_Handler(USART_Struct *USARTx)
+{
+#if USART_MODBUS == Enable
+    if (USARTx -> Modbus_Buffer != NULL)
+    {
+        UART_Modbus_Idle(USARTx);
+        return;
+    }
+#endif
+#if USART_RX_TIMEOUT == Enable
+    u32 Local_SR = USARTx -> USART_x -> SR;
+
+    if (GET_BIT(Local_SR, __RXNE__) == 1){ return; }
+    // the SR then DR reading clears the IDLE flag.
+    (void)__UART_DR_READ(USARTx);
+    if ((USARTx -> RX_Lock_Flag == BUSY) && (__UART_SHADOW_GET(USARTx, CR1, CR1_RXNEIE) == 1) &&
+        (UART_RX_Timeout_Check(USARTx, Local_SR) == 1))
+    {
+        UART_RX_Timeout_Finish(USARTx);
+    }
+#endif
+}
+#endif
+
+
+#if USART_RX_RING == Enable
+/// @brief  MCAL_UART_Receive_Ring : this function starts the continuous Reception of the port into a ring by the Interrupt,
+///                                  it goes on till MCAL_UART_Ring_Stop, the elements with an error are dropped.
+/// @param  USARTx                 : the Struct of the initialized Peripheral.
+/// @param  Copy_Buffer            : the ring, it holds (Copy_Size - 1) elements.
+/// @param  Copy_Size              : the size of the ring.
+/// @retval Functions Status, (Uart_BUSY) if a Reception is in progress.
+Uart_Fun_Status	    MCAL_UART_Receive_Ring(USART_Struct *USARTx , u8 *Copy_Buffer , u16 Copy_Size)
+{
+    if ((USARTx == NULL) || (Copy_Buffer == NULL) || (Copy_Size < 2)){ return  Uart_ERROR; }
+    if (UART_Check_LockState(USARTx ,RX ) == BUSY){ return Uart_BUSY; }
+
+    // the Reception stays on, so the Receive buffer is not used by the other Receive functions.
+    USARTx -> RX_Lock_Flag     = BUSY;
+    USARTx -> RX_Lock_Counter  = 0;
+    USARTx -> RX_Frame_Damaged = 0;
+    USARTx -> Error_Code       = (u8 *)Error_1;
+    __UART_TRACE(USARTx, Trace_RX_Lock, BUSY);
+    USARTx -> Ring_Size   = Copy_Size;
+    USARTx -> Ring_In     = 0;
+    USARTx -> Ring_Out    = 0;
+    USARTx -> Ring_Drops  = 0;
+    USARTx -> Ring_Buffer = Copy_Buffer;
+
+    __COMM_ENABLE(USARTx,RX);
+    (void)USARTx -> USART_x -> SR;
+    (void)__UART_DR_READ(USARTx);
+    __UART_SHADOW_SAFE_SET(USARTx, CR1, CR1_RXNEIE);
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Ring_Peek : this function gives the Received elements in their place, the oldest first, as two spans
+///                               (the second one is the part after the ring end), they stay valid till they are consumed.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @param  Copy_Spans          : pointer to two spans.
+/// @param  Copy_Count          : pointer to hold the number of all the Received elements (the sum of the spans).
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Ring_Peek(USART_Struct *USARTx , USART_RX_Span Copy_Spans[2] , u16 *Copy_Count)
+{
+    if ((USARTx == NULL) || (USARTx -> Ring_Buffer == NULL) || (Copy_Spans == NULL) || (Copy_Count == NULL)){ return  Uart_ERROR; }
+
+    // the index is read once, the Interrupt only adds elements after it.
+    u16 Local_In  = USARTx -> Ring_In;
+    u16 Local_Out = USARTx -> Ring_Out;
+
+    __UART_COMPILER_BARRIER();
+    Copy_Spans[0].Data = &USARTx -> Ring_Buffer[Local_Out];
+    Copy_Spans[1].Data = USARTx -> Ring_Buffer;
+    if (Local_In >= Local_Out)
+    {
+        Copy_Spans[0].Size = Local_In - Local_Out;
+        Copy_Spans[1].Size = 0;
+    }
+    else
+    {
+        Copy_Spans[0].Size = USARTx -> Ring_Size - Local_Out;
+        Copy_Spans[1].Size = Local_In;
+    }
+    *Copy_Count = Copy_Spans[0].Size + Copy_Spans[1].Size;
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Ring_Consume : this function gives the place of the oldest elements back to the Reception.
+/// @param  USARTx                 : the Struct of Peripheral's Registers.
+/// @param  Copy_Count             : the number of the read elements.
+/// @retval Functions Status, (Uart_ERROR) if it is more than the Received elements.
+Uart_Fun_Status	    MCAL_UART_Ring_Consume(USART_Struct *USARTx , u16 Copy_Count)
+{
+    if ((USARTx == NULL) || (USARTx -> Ring_Buffer == NULL)){ return  Uart_ERROR; }
+
+    u16 Local_Out   = USARTx -> Ring_Out;
+    u16 Local_Count = (u16)((USARTx -> Ring_In + USARTx -> Ring_Size - Local_Out) % USARTx -> Ring_Size);
+
+    if (Copy_Count > Local_Count){ return  Uart_ERROR; }
+    // the elements are read before their place is given back.
+    __UART_COMPILER_BARRIER();
+    USARTx -> Ring_Out = (u16)((Local_Out + Copy_Count) % USARTx -> Ring_Size);
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Ring_Stop : this function stops the ring Reception.
+/// @param  USARTx              : the Struct of Peripheral's Registers.
+/// @param  Copy_Drops          : pointer to hold the number of the dropped elements, or NULL.
+/// @retval Functions Status.
+Uart_Fun_Status	    MCAL_UART_Ring_Stop(USART_Struct *USARTx , u32 *Copy_Drops)
+{
+    if ((USARTx == NULL) || (USARTx -> Ring_Buffer == NULL)){ return  Uart_ERROR; }
+
+    __UART_SHADOW_SAFE_CLR(USARTx, CR1, CR1_RXNEIE);
+    USARTx -> Ring_Buffer     = NULL;
+    USARTx -> RX_Lock_Flag    = IDLE;
+    USARTx -> RX_Lock_Counter = 0;
+    __UART_TRACE(USARTx, Trace_RX_Lock, IDLE);
+    if (Copy_Drops != NULL)
+    {
+        *Copy_Drops = USARTx -> Ring_Drops;
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  UART_Ring_Element : it stores one Received element of the ring Reception.
+/// @param  USARTx            : the Struct of Peripheral's Registers.
+/// @return None.
+static void UART_Ring_Element(USART_Struct *USARTx)
+{
+    u32 Local_SR;
+    u8  Local_Element = UART_Read_Element(USARTx, &Local_SR);
+    u16 Local_In      = USARTx -> Ring_In;
+    u16 Local_Next    = (Local_In + 1U == USARTx -> Ring_Size) ? 0 : (u16)(Local_In + 1U);
+
+    USARTx -> RX_Lock_Counter = 0;
+    if ((Local_SR & UART_RX_ERRORS_MASK) != 0)
+    {
+        UART_Handle_RX_Errors(USARTx, Local_SR);
+        USARTx -> Ring_Drops++;
+        return;
+    }
+    // the ring is full, the application has not consumed its elements.
+    if (Local_Next == USARTx -> Ring_Out)
+    {
+        __UART_STATS_ADD(USARTx, Dropped_Bytes, 1);
+        USARTx -> Ring_Drops++;
+        return;
+    }
+    USARTx -> Ring_Buffer[Local_In] = Local_Element;
+    // the element is stored before the application can see it.
+    __UART_COMPILER_BARRIER();
+    USARTx -> Ring_In = Local_Next;
+}
+#endif
+
+
+#if USART_SELF_TEST == Enable
+/// @brief  MCAL_UART_Set_Loopback : this function connects the TX and the RX lines inside the Peripheral (the half-duplex
+///                                  mode), every Transmitted element is Received by the same port. The TX pin is the
+///                                  line (an open-drain pin with a pull-up), no wire is needed.
+/// @param  USARTx                 : the Struct of the initialized Peripheral.
+/// @param  Copy_State             : (Enable) or (Disable).
+/// @retval Functions Status, (Uart_BUSY) if a Transmission or the Reception of a frame is in progress.
+Uart_Fun_Status	    MCAL_UART_Set_Loopback(USART_Struct *USARTx , u8 Copy_State)
+{
+    u8  Local_UE;
+
+    if ((USARTx == NULL) || ((Copy_State != Enable) && (Copy_State != Disable))){ return  Uart_ERROR; }
+    if (UART_Between_Frames(USARTx) == 0){ return Uart_BUSY; }
+
+    // the (HDSEL) bit is written with the Peripheral disabled, the last element leaves the shift register first.
+    Local_UE = __UART_SHADOW_GET(USARTx, CR1, CR1_UE);
+    if (Local_UE == 1)
+    {
+        UART_Wait_TC(USARTx);
+    }
+    __UART_DISABLE(USARTx);
+    if (Copy_State == Enable)
+    {
+        __UART_SHADOW_SAFE_SET(USARTx, CR3, CR3_HDSEL);
+    }
+    else
+    {
+        __UART_SHADOW_SAFE_CLR(USARTx, CR3, CR3_HDSEL);
+    }
+    if (Local_UE == 1)
+    {
+        __UART_ENABLE(USARTx);
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  MCAL_UART_Receive_Abort : this function stops the Reception of MCAL_UART_Receive_INT without its callback, and
+///                                   drops the element that is not read (so its error flags are cleared).
+/// @param  USARTx                  : the Struct of Peripheral's Registers.
+/// @retval Functions Status, (Uart_ERROR) for the ring, the Modbus and the pool Receptions, they have their own stop.
+Uart_Fun_Status	    MCAL_UART_Receive_Abort(USART_Struct *USARTx)
+{
+    u32 Local_State;
+
+    if (USARTx == NULL){ return  Uart_ERROR; }
+#if USART_RX_RING == Enable
+    if (USARTx -> Ring_Buffer != NULL){ return  Uart_ERROR; }
+#endif
+#if USART_MODBUS == Enable
+    if (USARTx -> Modbus_Buffer != NULL){ return  Uart_ERROR; }
+#endif
+#if USART_SYNC == Enable
+    if (USARTx -> Sync_Active == 1){ return  Uart_ERROR; }
+#endif
+#if USART_POOL == Enable
+    if (USARTx -> RX_Pool_Block != POOL_NO_BLOCK){ return  Uart_ERROR; }
+#endif
+
+    // an element that comes in the middle is not taken by the Interrupt after the lock is released.
+    __UART_ENTER_CRITICAL(Local_State);
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
+#if USART_RX_TIMEOUT == Enable
+    __UART_SHADOW_CLR(USARTx, CR1, CR1_IDLEIE);
+#endif
+    // the SR then DR reading clears the (RXNE), (PE), (FE), (NE) and (ORE) flags.
+    (void)USARTx -> USART_x -> SR;
+    (void)__UART_DR_READ(USARTx);
+    USARTx -> RX_Frame_Damaged = 0;
+    if (USARTx -> RX_Lock_Flag == BUSY)
+    {
+        USARTx -> RX_Buffer_Size = (u16)(USARTx -> RX_Buffer_Size - USARTx -> RX_Process_Count);
+        USARTx -> RX_Lock_Flag   = IDLE;
+        __UART_TRACE(USARTx, Trace_RX_Lock, IDLE);
+    }
+    USARTx -> RX_Lock_Counter = 0;
+    __UART_EXIT_CRITICAL(Local_State);
+    return Uart_OK;
+}
+#endif
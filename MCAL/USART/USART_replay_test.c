@@ -0,0 +1,191 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the capture and replay test of the host model (USART_POSIX)	*/
+/********************************************************************************************/
+/*	USART1 sends frames with a pause after every one to USART2 over a pseudo-terminal pair,	*/
+/*	USART2 captures them. the test checks the captured elements and their timing, then it	*/
+/*	replays the capture from USART1 to USART2 (the Sink) with its original timing and at the	*/
+/*	wire speed, and checks the replay reports and their times.							*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_CAPTURE=Enable -I. -IMCAL/USART				*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_replay_test.c	*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_CAPTURE == Disable
+#error "the test replays a capture, so it is built with USART_CAPTURE"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_FRAMES             20U
+#define     TEST_FRAME_SIZE         12U
+#define     TEST_RECORDS            (TEST_FRAMES * TEST_FRAME_SIZE)
+#define     TEST_BAUD               115200UL
+/*	the pause after every frame	*/
+#define     TEST_PAUSE_US           5000UL
+/*	the elements of a frame are closer than this time (the host scheduler delays some of them)	*/
+#define     TEST_ELEMENT_US         (TEST_PAUSE_US / 2U)
+/********************************************************************************************/
+static USART_Struct         Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct         Test_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static USART_Capture_Record Test_Records[TEST_RECORDS];
+static u8                   Test_Frame[TEST_FRAME_SIZE];
+static u8                   Test_RX_Frame[TEST_FRAME_SIZE];
+static volatile u8          Test_TX_Done;
+static volatile u16         Test_RX_Frames;
+/********************************************************************************************/
+
+
+/// @brief  Test_TX_End    : the TX callback of USART1.
+/// @param  USARTx         : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_TX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_TX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_RX_End    : the RX callback of USART2 while it captures, it starts the Reception of the next frame,
+///                          so USART2 is idle after the last one (the replay starts the Sink).
+/// @param  USARTx         : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    Test_RX_Frames++;
+    if (Test_RX_Frames < TEST_FRAMES)
+    {
+        (void)MCAL_UART_Receive_INT(USARTx, Test_RX_Frame, TEST_FRAME_SIZE, '\n');
+    }
+}
+
+
+/// @brief  Test_Replay    : it replays the capture and checks its report.
+/// @param  Copy_Scale     : the timing scale in percent.
+/// @param  Copy_Cycles    : pointer to hold the time of the replay in cycles.
+/// @return (1) if the report is right, (0) if not.
+static u8 Test_Replay(u16 Copy_Scale , u32 *Copy_Cycles)
+{
+    USART_Replay_Config Local_Config = { Test_Records, TEST_RECORDS, Copy_Scale, &Test_RX, Test_RX_Frame, TEST_FRAME_SIZE, '\n' };
+    USART_Replay_Report Local_Report;
+    u32 Local_Start = DWT_CYCCNT_R;
+
+    memset(Test_RX_Frame, 0, sizeof(Test_RX_Frame));
+    if (MCAL_UART_Replay(&Test_TX, &Local_Config, &Local_Report) != Uart_OK)
+    {
+        printf("FAIL : the replay at %u%% does not start\n", Copy_Scale);
+        return 0;
+    }
+    *Copy_Cycles = DWT_CYCCNT_R - Local_Start;
+    printf("scale %u%% : %lu elements, %lu frames sent, %lu received, %lu dropped, %lu overruns, max latency %lu cycles, %lu us\n",
+           Copy_Scale, (unsigned long)Local_Report.Sent_Elements, (unsigned long)Local_Report.Sent_Frames,
+           (unsigned long)Local_Report.Received_Frames, (unsigned long)Local_Report.Dropped_Frames,
+           (unsigned long)Local_Report.Overruns, (unsigned long)Local_Report.Max_Latency_Cycles,
+           (unsigned long)(*Copy_Cycles / (FCK / 1000000UL)));
+    if ((Local_Report.Sent_Elements != TEST_RECORDS) || (Local_Report.Sent_Frames != TEST_FRAMES) ||
+        (Local_Report.Received_Frames != TEST_FRAMES) || (Local_Report.Dropped_Frames != 0) ||
+        (Local_Report.Overruns != 0) || (Local_Report.Sink_Failures != 0) || (Local_Report.Max_Latency_Cycles == 0) ||
+        (memcmp(Test_RX_Frame, Test_Frame, TEST_FRAME_SIZE) != 0))
+    {
+        printf("FAIL : the replay report at %u%%\n", Copy_Scale);
+        return 0;
+    }
+    return 1;
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    struct timespec Local_Pause   = { 0, TEST_PAUSE_US * 1000L };
+    struct timespec Local_Poll    = { 0, 20000L };
+    char Local_Name[64];
+    u32  Local_Original, Local_Fast;
+    u16  Local_Count = 0, Local_Index, Local_Wait;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_TX_CALLBACK(&Test_TX, Test_TX_End);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, Test_RX_End);
+    for (Local_Index = 0; Local_Index < (TEST_FRAME_SIZE - 1U); Local_Index++)
+    {
+        Test_Frame[Local_Index] = (u8)('a' + Local_Index);
+    }
+    Test_Frame[TEST_FRAME_SIZE - 1U] = '\n';
+
+    // the capture : the frames with a pause after every one.
+    (void)MCAL_UART_Capture_Start(&Test_RX, Test_Records, TEST_RECORDS);
+    (void)MCAL_UART_Receive_INT(&Test_RX, Test_RX_Frame, TEST_FRAME_SIZE, '\n');
+    for (Local_Index = 0; Local_Index < TEST_FRAMES; Local_Index++)
+    {
+        Test_TX_Done = 0;
+        if (MCAL_UART_Transmit_INT(&Test_TX, Test_Frame, TEST_FRAME_SIZE, '\n') != Uart_OK)
+        {
+            printf("FAIL : MCAL_UART_Transmit_INT\n");
+            return 1;
+        }
+        for (Local_Wait = 0; (Local_Wait < 50000U) && (__atomic_load_n(&Test_TX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+        {
+            nanosleep(&Local_Poll, NULL);
+        }
+        nanosleep(&Local_Pause, NULL);
+    }
+    (void)MCAL_UART_Capture_Stop(&Test_RX, &Local_Count);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, NULL);
+
+    if ((Local_Count != TEST_RECORDS) || (Test_RX_Frames != TEST_FRAMES))
+    {
+        printf("FAIL : %u records of %u frames are captured\n", Local_Count, Test_RX_Frames);
+        return 1;
+    }
+    for (Local_Index = 0; Local_Index < TEST_RECORDS; Local_Index++)
+    {
+        u8  Local_Position = (u8)(Local_Index % TEST_FRAME_SIZE);
+        u32 Local_Delta    = Test_Records[Local_Index].Delta_Cycles;
+        // the first element of a frame comes after the pause, the others one element time after the previous one.
+        if ((Test_Records[Local_Index].Element != Test_Frame[Local_Position]) || (Test_Records[Local_Index].Error_Flags != 0) ||
+            ((Local_Index != 0) && (Local_Position == 0) && (Local_Delta < __UART_US_TO_CYCLES(TEST_PAUSE_US))) ||
+            ((Local_Position != 0) && (Local_Delta >= __UART_US_TO_CYCLES(TEST_ELEMENT_US))))
+        {
+            printf("FAIL : the record %u (element 0x%02X, %lu cycles)\n", Local_Index, Test_Records[Local_Index].Element,
+                   (unsigned long)Local_Delta);
+            Local_Pass = 0;
+            break;
+        }
+    }
+
+    // the replay with the captured timing, then at the wire speed.
+    Local_Pass &= Test_Replay(100U, &Local_Original);
+    Local_Pass &= Test_Replay(0U, &Local_Fast);
+    if ((Local_Original < ((TEST_FRAMES - 1U) * __UART_US_TO_CYCLES(TEST_PAUSE_US))) || (Local_Fast >= (Local_Original / 2U)))
+    {
+        printf("FAIL : the replay times do not follow the scale\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : capture and replay loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,167 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Receive ring, it runs on the host	*/
+/*					   model of the USART driver (USART_POSIX)								*/
+/********************************************************************************************/
+/*	USART1 sends a stream in bursts to USART2 over a pseudo-terminal pair, USART2 Receives	*/
+/*	it into a small ring. the application reads the elements in their place by				*/
+/*	MCAL_UART_Ring_Peek and gives back a few of them at a time by MCAL_UART_Ring_Consume, so	*/
+/*	the spans wrap around the ring end. the test checks that the stream is read in order,	*/
+/*	that the other Receptions are refused while the ring runs, and that a burst longer than	*/
+/*	the free place is cut and counted when the application stops reading.					*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_RX_RING=Enable -I. -IMCAL/USART				*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_ring_test.c		*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_RX_RING == Disable
+#error "the test Receives into the ring, so it is built with USART_RX_RING"
+#endif
+#include <stdio.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_BAUD               921600UL
+#define     TEST_RING_SIZE          64U
+#define     TEST_STREAM_SIZE        2000U
+#define     TEST_BURST_SIZE         40U
+/*	the elements given back by one MCAL_UART_Ring_Consume	*/
+#define     TEST_CONSUME_SIZE       7U
+#define     TEST_OVERFLOW_SIZE      100U
+/*	the longest wait of a burst, in pauses (100 us)	*/
+#define     TEST_WAITS              2000U
+/********************************************************************************************/
+static USART_Struct     Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Test_Ring[TEST_RING_SIZE];
+static u8               Test_Stream[TEST_STREAM_SIZE];
+static u8               Test_Frame[TEST_RING_SIZE];
+/********************************************************************************************/
+
+
+/// @brief  Test_Pause   : it waits one pause (100 us).
+/// @return None.
+static void Test_Pause(void)
+{
+    struct timespec Local_Pause = { 0, 100000L };
+
+    nanosleep(&Local_Pause, NULL);
+}
+
+
+/// @brief  Test_Element : it gets an element of the peeked spans.
+/// @param  Copy_Spans   : the two spans.
+/// @param  Copy_Index   : the index from the oldest element.
+/// @return the element.
+static u8 Test_Element(const USART_RX_Span Copy_Spans[2] , u16 Copy_Index)
+{
+    return (Copy_Index < Copy_Spans[0].Size) ? Copy_Spans[0].Data[Copy_Index] : Copy_Spans[1].Data[Copy_Index - Copy_Spans[0].Size];
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    USART_RX_Span Local_Spans[2];
+    char Local_Name[64];
+    u32  Local_Drops = 0;
+    u16  Local_Sent = 0, Local_Read = 0, Local_Count, Local_Index, Local_Take, Local_Wait;
+    u16  Local_Wraps = 0, Local_Max_Count = 0;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    for (Local_Index = 0; Local_Index < TEST_STREAM_SIZE; Local_Index++)
+    {
+        Test_Stream[Local_Index] = (u8)(Local_Index % 251U);
+    }
+    if ((MCAL_UART_Receive_Ring(&Test_RX, Test_Ring, TEST_RING_SIZE) != Uart_OK) ||
+        (MCAL_UART_Receive_INT(&Test_RX, Test_Frame, TEST_RING_SIZE, '\n') != Uart_BUSY))
+    {
+        printf("FAIL : the ring does not start, or it does not hold the Reception\n");
+        return 1;
+    }
+
+    // the stream : the next burst is sent when the previous one is Received, the elements are read a few at a time.
+    for (Local_Wait = 0; (Local_Read < TEST_STREAM_SIZE) && (Local_Wait < TEST_WAITS); Local_Wait++)
+    {
+        if ((Local_Sent == Local_Read) && (Local_Sent < TEST_STREAM_SIZE))
+        {
+            Local_Take = ((TEST_STREAM_SIZE - Local_Sent) < TEST_BURST_SIZE) ? (u16)(TEST_STREAM_SIZE - Local_Sent) : TEST_BURST_SIZE;
+            if (MCAL_UART_Transmit_Size_INT(&Test_TX, &Test_Stream[Local_Sent], Local_Take) == Uart_OK)
+            {
+                Local_Sent += Local_Take;
+                Local_Wait = 0;
+            }
+        }
+        (void)MCAL_UART_Ring_Peek(&Test_RX, Local_Spans, &Local_Count);
+        if (Local_Spans[1].Size != 0){ Local_Wraps++; }
+        if (Local_Count > Local_Max_Count){ Local_Max_Count = Local_Count; }
+        Local_Take = (Local_Count < TEST_CONSUME_SIZE) ? Local_Count : TEST_CONSUME_SIZE;
+        for (Local_Index = 0; Local_Index < Local_Take; Local_Index++)
+        {
+            if (Test_Element(Local_Spans, Local_Index) != Test_Stream[Local_Read + Local_Index])
+            {
+                printf("FAIL : the element %u is 0x%02X\n", Local_Read + Local_Index, Test_Element(Local_Spans, Local_Index));
+                Local_Pass = 0;
+                Local_Wait = TEST_WAITS;
+                break;
+            }
+        }
+        (void)MCAL_UART_Ring_Consume(&Test_RX, Local_Take);
+        Local_Read += Local_Take;
+        Test_Pause();
+    }
+    printf("stream : %u elements read, %u peeks of two spans, up to %u waiting elements\n", Local_Read, Local_Wraps, Local_Max_Count);
+    if ((Local_Read != TEST_STREAM_SIZE) || (Local_Wraps == 0) || (Test_RX.Ring_Drops != 0))
+    {
+        printf("FAIL : the stream is not read in order in the ring (%lu drops)\n", (unsigned long)Test_RX.Ring_Drops);
+        Local_Pass = 0;
+    }
+
+    // the application stops reading, the ring keeps its oldest elements and drops the rest of the burst.
+    (void)MCAL_UART_Transmit_Size_INT(&Test_TX, Test_Stream, TEST_OVERFLOW_SIZE);
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (Test_RX.Ring_Drops < (TEST_OVERFLOW_SIZE - (TEST_RING_SIZE - 1U))); Local_Wait++)
+    {
+        Test_Pause();
+    }
+    (void)MCAL_UART_Ring_Peek(&Test_RX, Local_Spans, &Local_Count);
+    for (Local_Index = 0; (Local_Index < Local_Count) && (Test_Element(Local_Spans, Local_Index) == Test_Stream[Local_Index]); Local_Index++){}
+    if ((Local_Count != (TEST_RING_SIZE - 1U)) || (Local_Index != Local_Count) ||
+        (MCAL_UART_Ring_Consume(&Test_RX, Local_Count + 1U) != Uart_ERROR) || (MCAL_UART_Ring_Consume(&Test_RX, Local_Count) != Uart_OK))
+    {
+        printf("FAIL : the full ring holds %u elements\n", Local_Count);
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Ring_Stop(&Test_RX, &Local_Drops);
+    printf("overflow : %u elements kept, %lu dropped\n", Local_Count, (unsigned long)Local_Drops);
+    if ((Local_Drops != (TEST_OVERFLOW_SIZE - (TEST_RING_SIZE - 1U))) || (Test_RX.RX_Lock_Flag != IDLE))
+    {
+        printf("FAIL : the dropped elements are not counted, or the ring does not stop\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : Receive ring loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,191 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the transfer statistics sweep of the host model (USART_POSIX)	*/
+/********************************************************************************************/
+/*	USART1 Transmits frames by MCAL_UART_Transmit_INT to USART2 over a pseudo-terminal pair	*/
+/*	for every Baud rate, frame size, oversampling and parity of the sweep, USART2 Receives	*/
+/*	them by MCAL_UART_Receive_INT. every run is about a quarter of a second of wire time,	*/
+/*	then the statistics record of MCAL_UART_Stats_Report of both ports is printed after the	*/
+/*	run columns, so the rows are CSV :														*/
+/*	sampling,parity,frame_size,frames,lost_frames,port,baud,frame_bits_x2,tx_bytes,rx_bytes,	*/
+/*	wire_util_permille,int_per_kbyte,cycles_per_byte,isr_max_cycles,drop_ppm				*/
+/*	the cycles are the host time at (FCK), so they are the cost of the handlers on the host.	*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -O2 -DUSART_POSIX=Enable -DUSART_STATISTICS=Enable -I. -IMCAL/USART		*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_sweep_bench.c	*/
+/*	    -lpthread																			*/
+/*	run : ./a.out																			*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_STATISTICS == Disable
+#error "the sweep prints the transfer statistics, so it is built with USART_STATISTICS"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     SWEEP_MAX_SIZE          256U
+/*	the wire time of one run is (1 / SWEEP_RUN_PART) second	*/
+#define     SWEEP_RUN_PART          4U
+/*	the wait of one frame, in pauses (20 us), after its wire time	*/
+#define     SWEEP_EXTRA_WAITS       25000UL
+#define     SWEEP_REPORT_SIZE       128U
+/********************************************************************************************/
+static USART_Struct     Sweep_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Sweep_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Sweep_TX_Frame[SWEEP_MAX_SIZE];
+static u8               Sweep_RX_Frame[SWEEP_MAX_SIZE];
+static volatile u8      Sweep_RX_Done;
+static volatile u8      Sweep_TX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Sweep_RX_End : the RX callback.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @return None.
+static void Sweep_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Sweep_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Sweep_TX_End : the TX callback.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @return None.
+static void Sweep_TX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Sweep_TX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Sweep_Print  : it prints the statistics record of a port after the run columns.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @param  Copy_Columns : the run columns.
+/// @return None.
+static void Sweep_Print(USART_Struct *USARTx , const char *Copy_Columns)
+{
+    u8  Local_Record[SWEEP_REPORT_SIZE];
+    u16 Local_Length = 0;
+
+    if (MCAL_UART_Stats_Report(USARTx, Local_Record, sizeof(Local_Record), &Local_Length) == Uart_OK)
+    {
+        printf("%s%.*s", Copy_Columns, (int)Local_Length, (const char *)Local_Record);
+    }
+}
+
+
+/// @brief  Sweep_Run    : it sends the frames of one point of the sweep and prints its rows.
+/// @param  Copy_Baud    : the Baud rate.
+/// @param  Copy_Size    : the frame size, with its last element.
+/// @param  Copy_Frame   : the frame configuration.
+/// @param  Copy_Receive : the Receiving configuration.
+/// @return None.
+static void Sweep_Run(u32 Copy_Baud , u16 Copy_Size , MUSART_Frame_Config *Copy_Frame , MUSART_Receiving_Config *Copy_Receive)
+{
+    struct timespec Local_Pause = { 0, 20000L };
+    char Local_Columns[64];
+    u32  Local_Wait, Local_Waits;
+    u16  Local_Index, Local_Lost = 0;
+    // the element has 10 bits at least, so the run is not longer than its part of a second.
+    u16  Local_Frames = (u16)((Copy_Baud / (10UL * SWEEP_RUN_PART)) / Copy_Size);
+
+    if (Local_Frames == 0){ Local_Frames = 1; }
+    // the wire time of a frame in pauses, then the time of the model and the handlers.
+    Local_Waits = (u32)(((u64)Copy_Size * 12ULL * 50000ULL) / Copy_Baud) + SWEEP_EXTRA_WAITS;
+    (void)MCAL_UART_Init_(&Sweep_TX, Copy_Frame, Copy_Receive, Copy_Baud);
+    (void)MCAL_UART_Init_(&Sweep_RX, Copy_Frame, Copy_Receive, Copy_Baud);
+    (void)MCAL_UART_Enable(&Sweep_TX);
+    (void)MCAL_UART_Enable(&Sweep_RX);
+    // MCAL_UART_Init_ clears the callbacks.
+    (void)MCAL_UART_TX_CALLBACK(&Sweep_TX, Sweep_TX_End);
+    (void)MCAL_UART_RX_CALLBACK(&Sweep_RX, Sweep_RX_End);
+    for (Local_Index = 0; Local_Index < Copy_Size; Local_Index++)
+    {
+        Sweep_TX_Frame[Local_Index] = (u8)('A' + (Local_Index % 26U));
+    }
+    Sweep_TX_Frame[Copy_Size - 1U] = '\n';
+    (void)MCAL_UART_Stats_Reset(&Sweep_TX);
+    (void)MCAL_UART_Stats_Reset(&Sweep_RX);
+
+    for (Local_Index = 0; Local_Index < Local_Frames; Local_Index++)
+    {
+        Sweep_RX_Done = 0;
+        Sweep_TX_Done = 0;
+        if ((MCAL_UART_Receive_INT(&Sweep_RX, Sweep_RX_Frame, SWEEP_MAX_SIZE, '\n') != Uart_OK) ||
+            (MCAL_UART_Transmit_INT(&Sweep_TX, Sweep_TX_Frame, Copy_Size, '\n') != Uart_OK))
+        {
+            Local_Lost++;
+            continue;
+        }
+        for (Local_Wait = 0; (Local_Wait < Local_Waits) &&
+             ((__atomic_load_n(&Sweep_RX_Done, __ATOMIC_ACQUIRE) == 0) || (Sweep_TX_Done == 0)); Local_Wait++)
+        {
+            nanosleep(&Local_Pause, NULL);
+        }
+        if ((Sweep_RX_Done == 0) || (Sweep_TX_Done == 0) || (memcmp(Sweep_RX_Frame, Sweep_TX_Frame, Copy_Size) != 0))
+        {
+#if USART_SELF_TEST == Enable
+            // the Reception is stopped, so the next frame starts from its first element.
+            (void)MCAL_UART_Receive_Abort(&Sweep_RX);
+#endif
+            Local_Lost++;
+        }
+    }
+    (void)snprintf(Local_Columns, sizeof(Local_Columns), "%u,%s,%u,%u,%u,",
+                   (Copy_Receive -> Oversampling_type == Sampling_By_8) ? 8U : 16U,
+                   (Copy_Frame -> parity_op == Parity_Disable) ? "none" : ((Copy_Frame -> parity_op == Even_Parity) ? "even" : "odd"),
+                   Copy_Size, Local_Frames, Local_Lost);
+    Sweep_Print(&Sweep_TX, Local_Columns);
+    Sweep_Print(&Sweep_RX, Local_Columns);
+}
+
+
+int main(void)
+{
+    static const u32 Local_Bauds[] = { 19200UL, 115200UL, 921600UL };
+    static const u16 Local_Sizes[] = { 1U, 16U, 64U, 256U };
+    static const Oversampling_Value Local_Samplings[] = { Sampling_By_16, Sampling_By_8 };
+    static const Parity_Op Local_Parities[] = { Parity_Disable, Even_Parity };
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    char Local_Name[64];
+    u8   Local_Baud, Local_Size, Local_Sampling, Local_Parity;
+
+    if ((MCAL_UART_Posix_Pty(&Sweep_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Sweep_RX, Local_Name) != Uart_OK))
+    {
+        fprintf(stderr, "no pseudo-terminal\n");
+        return 1;
+    }
+    printf("sampling,parity,frame_size,frames,lost_frames,%s", USART_STATS_CSV_HEADER);
+    for (Local_Baud = 0; Local_Baud < (sizeof(Local_Bauds) / sizeof(Local_Bauds[0])); Local_Baud++)
+    {
+        for (Local_Size = 0; Local_Size < (sizeof(Local_Sizes) / sizeof(Local_Sizes[0])); Local_Size++)
+        {
+            for (Local_Sampling = 0; Local_Sampling < (sizeof(Local_Samplings) / sizeof(Local_Samplings[0])); Local_Sampling++)
+            {
+                for (Local_Parity = 0; Local_Parity < (sizeof(Local_Parities) / sizeof(Local_Parities[0])); Local_Parity++)
+                {
+                    // with a parity the 9th bit is the parity bit, so the data has 8 bits.
+                    Local_Frame.M_VALUE   = (Local_Parities[Local_Parity] == Parity_Disable) ? _8_Bit : _9_Bit;
+                    Local_Frame.parity_op = Local_Parities[Local_Parity];
+                    Local_Receiving.Oversampling_type = Local_Samplings[Local_Sampling];
+                    Sweep_Run(Local_Bauds[Local_Baud], Local_Sizes[Local_Size], &Local_Frame, &Local_Receiving);
+                }
+            }
+        }
+    }
+    (void)MCAL_UART_Posix_Close(&Sweep_RX);
+    (void)MCAL_UART_Posix_Close(&Sweep_TX);
+    return 0;
+}
+#endif
@@ -0,0 +1,203 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Receive timeouts, it runs on the	*/
+/*					   host model of the USART driver (USART_POSIX)							*/
+/********************************************************************************************/
+/*	USART1 sends bursts without a last element to USART2 over a pseudo-terminal pair, the	*/
+/*	Receptions of USART2 are longer than the bursts, so they end by their timeouts. the		*/
+/*	test checks the gap rule (the Interrupt Reception with MCAL_UART_RX_Tick, and the		*/
+/*	Blocking one), a pause shorter than the gap inside a Reception, the IDLE line gap and	*/
+/*	the total time of a Reception with no elements : the end status, the Received elements	*/
+/*	and the end time.																		*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_RX_TIMEOUT=Enable -I. -IMCAL/USART			*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_timeout_test.c	*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_RX_TIMEOUT == Disable
+#error "the test ends the Receptions by their timeouts, so it is built with USART_RX_TIMEOUT"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_BAUD               115200UL
+#define     TEST_BURST_SIZE         10U
+#define     TEST_BUFFER_SIZE        64U
+/*	the wire time of a burst, an element is 10 bits	*/
+#define     TEST_WIRE_US            ((TEST_BURST_SIZE * 10UL * 1000000UL) / TEST_BAUD)
+#define     TEST_GAP_US             5000UL
+#define     TEST_TOTAL_US           5000UL
+/*	the pause inside a Reception, shorter than the gap	*/
+#define     TEST_PAUSE_US           1000UL
+/*	the time the host scheduler may add to a measured time	*/
+#define     TEST_JITTER_US          3000UL
+/*	the Reception ends by its size or its timeouts, no element is this one	*/
+#define     TEST_NO_ELEMENT         0xFFU
+/*	the time limit of the Blocking Reception, in STK ticks	*/
+#define     TEST_RX_LIMIT           100000UL
+/*	the longest wait of a Reception, in ticks (100 us)	*/
+#define     TEST_WAITS              1000U
+/********************************************************************************************/
+static USART_Struct     Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_RX = { .USART_x = USART2_R, .Time_Limit = 100000 };
+static u8               Test_Burst[TEST_BURST_SIZE];
+static u8               Test_Buffer[TEST_BUFFER_SIZE];
+static volatile u8      Test_RX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Test_RX_End  : the RX callback of USART2.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_Sleep_us : it waits some micro seconds.
+/// @param  Copy_us       : the time.
+/// @return None.
+static void Test_Sleep_us(u32 Copy_us)
+{
+    struct timespec Local_Time = { (time_t)(Copy_us / 1000000UL), (long)((Copy_us % 1000000UL) * 1000UL) };
+
+    nanosleep(&Local_Time, NULL);
+}
+
+
+/// @brief  Test_Check   : it checks the end of a Reception by a timeout.
+/// @param  Copy_Name    : the case name of the messages.
+/// @param  Copy_Size    : the expected Received elements.
+/// @param  Copy_Time_us : the time from the Reception start to its end.
+/// @param  Copy_Min_us  : the shortest expected time.
+/// @param  Copy_Max_us  : the longest expected time.
+/// @return (1) if the Reception ended as expected, (0) if not.
+static u8 Test_Check(const char *Copy_Name , u16 Copy_Size , u32 Copy_Time_us , u32 Copy_Min_us , u32 Copy_Max_us)
+{
+    u16 Local_Index;
+    u8  Local_Pass = 1;
+
+    printf("%s : %u elements, ended after %lu us (%lu to %lu us)\n", Copy_Name, Test_RX.RX_Buffer_Size,
+           (unsigned long)Copy_Time_us, (unsigned long)Copy_Min_us, (unsigned long)Copy_Max_us);
+    if ((Test_RX.RX_Buffer_Size != Copy_Size) || (strcmp((const char *)Test_RX.Error_Code, Error_6) != 0) ||
+        (Copy_Time_us < Copy_Min_us) || (Copy_Time_us > Copy_Max_us))
+    {
+        Local_Pass = 0;
+    }
+    for (Local_Index = 0; Local_Index < Copy_Size; Local_Index++)
+    {
+        if (Test_Buffer[Local_Index] != Test_Burst[Local_Index % TEST_BURST_SIZE]){ Local_Pass = 0; }
+    }
+    if (Local_Pass == 0)
+    {
+        printf("FAIL : %s\n", Copy_Name);
+    }
+    return Local_Pass;
+}
+
+
+/// @brief  Test_Run_INT : it runs one Interrupt Reception with its timeouts, the bursts are sent after its start and
+///                        MCAL_UART_RX_Tick is called every 100 us as by the STK timer.
+/// @param  Copy_Gap_us  : the gap rule.
+/// @param  Copy_Total_us : the total rule.
+/// @param  Copy_Bursts  : the number of the bursts, with a pause between them.
+/// @return the time from the Reception start to its end in micro seconds.
+static u32 Test_Run_INT(u32 Copy_Gap_us , u32 Copy_Total_us , u8 Copy_Bursts)
+{
+    u32 Local_Start;
+    u16 Local_Wait;
+    u8  Local_Burst;
+
+    memset(Test_Buffer, 0, sizeof(Test_Buffer));
+    (void)MCAL_UART_Set_RX_Timeouts(&Test_RX, Copy_Gap_us, Copy_Total_us);
+    Test_RX_Done = 0;
+    Local_Start = DWT_CYCCNT_R;
+    (void)MCAL_UART_Receive_INT(&Test_RX, Test_Buffer, TEST_BUFFER_SIZE, TEST_NO_ELEMENT);
+    for (Local_Burst = 0; Local_Burst < Copy_Bursts; Local_Burst++)
+    {
+        if (Local_Burst != 0){ Test_Sleep_us(TEST_WIRE_US + TEST_PAUSE_US); }
+        (void)MCAL_UART_Transmit_INT(&Test_TX, Test_Burst, TEST_BURST_SIZE, 0);
+    }
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+    {
+        (void)MCAL_UART_RX_Tick(&Test_RX);
+        Test_Sleep_us(100UL);
+    }
+    return USART_CYCLES_TO_US(DWT_CYCCNT_R - Local_Start);
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    Uart_Fun_Status Local_Status;
+    char Local_Name[64];
+    u32  Local_Time, Local_Start;
+    u8   Local_Index, Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, Test_RX_End);
+    for (Local_Index = 0; Local_Index < TEST_BURST_SIZE; Local_Index++)
+    {
+        Test_Burst[Local_Index] = (u8)('0' + Local_Index);
+    }
+
+    // the gap rule ends the Reception after the silence that follows the burst.
+    Local_Time = Test_Run_INT(TEST_GAP_US, 0, 1);
+    Local_Pass &= Test_Check("gap", TEST_BURST_SIZE, Local_Time, TEST_WIRE_US + TEST_GAP_US,
+                             TEST_WIRE_US + TEST_GAP_US + TEST_JITTER_US);
+    // a pause shorter than the gap does not end it.
+    Local_Time = Test_Run_INT(TEST_GAP_US, 0, 2);
+    Local_Pass &= Test_Check("gap with a pause", 2U * TEST_BURST_SIZE, Local_Time,
+                             (2U * TEST_WIRE_US) + TEST_PAUSE_US + TEST_GAP_US,
+                             (2U * TEST_WIRE_US) + TEST_PAUSE_US + TEST_GAP_US + TEST_JITTER_US);
+    // the IDLE line ends it one element time after the burst (with the host slack of the model).
+    Local_Time = Test_Run_INT(UART_RX_GAP_IDLE, 0, 1);
+    Local_Pass &= Test_Check("IDLE gap", TEST_BURST_SIZE, Local_Time, TEST_WIRE_US, TEST_WIRE_US + TEST_JITTER_US);
+    // the total time ends a Reception with no elements.
+    Local_Time = Test_Run_INT(0, TEST_TOTAL_US, 0);
+    Local_Pass &= Test_Check("total", 0U, Local_Time, TEST_TOTAL_US, TEST_TOTAL_US + TEST_JITTER_US);
+
+    // the Blocking Reception checks the gap by itself.
+    (void)MCAL_UART_Set_RX_Timeouts(&Test_RX, TEST_GAP_US, 0);
+    memset(Test_Buffer, 0, sizeof(Test_Buffer));
+    Local_Start = DWT_CYCCNT_R;
+    (void)MCAL_UART_Transmit_INT(&Test_TX, Test_Burst, TEST_BURST_SIZE, 0);
+    Local_Status = MCAL_UART_Receive(&Test_RX, Test_Buffer, TEST_BUFFER_SIZE, TEST_RX_LIMIT, TEST_NO_ELEMENT);
+    Local_Time = USART_CYCLES_TO_US(DWT_CYCCNT_R - Local_Start);
+    if (Local_Status != Uart_TIMEOUT)
+    {
+        printf("FAIL : the Blocking Reception ends by %u\n", Local_Status);
+        Local_Pass = 0;
+    }
+    Local_Pass &= Test_Check("Blocking gap", TEST_BURST_SIZE, Local_Time, TEST_WIRE_US + TEST_GAP_US,
+                             TEST_WIRE_US + TEST_GAP_US + TEST_JITTER_US);
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : Receive timeouts loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
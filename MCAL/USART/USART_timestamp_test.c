@@ -0,0 +1,191 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Received frame timestamps, it runs	*/
+/*					   on the host model of the USART driver (USART_POSIX)					*/
+/********************************************************************************************/
+/*	USART1 sends frames to USART2 over a pseudo-terminal pair, the application takes every	*/
+/*	frame after a known delay. the test checks that the frame time (End_Cycle - First_Cycle)	*/
+/*	is its wire time, that the latency is the delay of the application and is measured by	*/
+/*	the first MCAL_UART_Get_RX_Time of the frame only, and the longest latency. in the		*/
+/*	resilient mode, it checks that the first element of a good frame after a damaged one	*/
+/*	starts its time. the rows are printed as :												*/
+/*	frame_us,wire_us,delay_us,latency_us													*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_TIMESTAMP=Enable -I. -IMCAL/USART			*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_timestamp_test.c	*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_TIMESTAMP == Disable
+#error "the test reads the frame timestamps, so it is built with USART_TIMESTAMP"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_FRAME_SIZE         32U
+#define     TEST_BAUD               115200UL
+/*	the wire time of the frame elements after the first one, an element is 10 bits	*/
+#define     TEST_WIRE_US            (((TEST_FRAME_SIZE - 1UL) * 10UL * 1000000UL) / TEST_BAUD)
+/*	the time the host scheduler may add to a measured time	*/
+#define     TEST_JITTER_US          3000UL
+/*	the time limit of the Blocking Transmission, in STK ticks	*/
+#define     TEST_TX_LIMIT           100000UL
+/*	the longest wait of a frame, in pauses (100 us)	*/
+#define     TEST_WAITS              1000U
+/********************************************************************************************/
+static USART_Struct     Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Test_Frame[TEST_FRAME_SIZE];
+static u8               Test_RX_Frame[TEST_FRAME_SIZE];
+static volatile u8      Test_RX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Test_RX_End  : the RX callback of USART2.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_Sleep_us : it waits some micro seconds.
+/// @param  Copy_us       : the time.
+/// @return None.
+static void Test_Sleep_us(u32 Copy_us)
+{
+    struct timespec Local_Time = { (time_t)(Copy_us / 1000000UL), (long)((Copy_us % 1000000UL) * 1000UL) };
+
+    nanosleep(&Local_Time, NULL);
+}
+
+
+/// @brief  Test_Frame_Run : it sends one frame, waits for its end and takes it after a delay.
+/// @param  Copy_Delay_us  : the delay of the application.
+/// @param  Copy_Time      : pointer to hold the timestamps of the frame.
+/// @return (1) if the frame is received with the right times, (0) if not.
+static u8 Test_Frame_Run(u32 Copy_Delay_us , USART_Frame_Time *Copy_Time)
+{
+    USART_Frame_Time Local_Again;
+    u32 Local_Frame_us, Local_Latency_us;
+    u16 Local_Wait;
+
+    Test_RX_Done = 0;
+    if ((MCAL_UART_Receive_INT(&Test_RX, Test_RX_Frame, TEST_FRAME_SIZE, '\n') != Uart_OK) ||
+        (MCAL_UART_Get_RX_Time(&Test_RX, Copy_Time) != Uart_BUSY) ||
+        (MCAL_UART_Transmit_INT(&Test_TX, Test_Frame, TEST_FRAME_SIZE, '\n') != Uart_OK))
+    {
+        printf("FAIL : the frame does not start, or its time is given in its Reception\n");
+        return 0;
+    }
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+    {
+        Test_Sleep_us(100UL);
+    }
+    // the frame waits for the application.
+    Test_Sleep_us(Copy_Delay_us);
+    if ((Test_RX_Done == 0) || (MCAL_UART_Get_RX_Time(&Test_RX, Copy_Time) != Uart_OK))
+    {
+        printf("FAIL : the frame is not received\n");
+        return 0;
+    }
+    // the next calls of the same frame do not measure it again.
+    Test_Sleep_us(1000UL);
+    (void)MCAL_UART_Get_RX_Time(&Test_RX, &Local_Again);
+    Local_Frame_us   = USART_CYCLES_TO_US(Copy_Time -> End_Cycle - Copy_Time -> First_Cycle);
+    Local_Latency_us = USART_CYCLES_TO_US(Copy_Time -> Latency_Cycles);
+    printf("%lu,%lu,%lu,%lu\n", (unsigned long)Local_Frame_us, (unsigned long)TEST_WIRE_US, (unsigned long)Copy_Delay_us,
+           (unsigned long)Local_Latency_us);
+    if ((Local_Frame_us < ((TEST_WIRE_US * 8UL) / 10UL)) || (Local_Frame_us > (TEST_WIRE_US + TEST_JITTER_US)) ||
+        (Local_Latency_us < Copy_Delay_us) || (Local_Latency_us > (Copy_Delay_us + TEST_JITTER_US)) ||
+        (Local_Again.Latency_Cycles != Copy_Time -> Latency_Cycles) || (Local_Again.Delivery_Cycle != Copy_Time -> Delivery_Cycle))
+    {
+        printf("FAIL : the frame time or the latency\n");
+        return 0;
+    }
+    return 1;
+}
+
+
+int main(void)
+{
+    static const u32 Local_Delays[] = { 500UL, 5000UL, 2000UL };
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    USART_Noise_Model       Local_Noise     = { 0, 1000000UL, 0, 0x1234U, 1 };
+    USART_Frame_Time        Local_Time;
+    char Local_Name[64];
+    u32  Local_Start;
+    u16  Local_Wait;
+    u8   Local_Index, Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, Test_RX_End);
+    for (Local_Index = 0; Local_Index < (TEST_FRAME_SIZE - 1U); Local_Index++)
+    {
+        Test_Frame[Local_Index] = (u8)('A' + Local_Index);
+    }
+    Test_Frame[TEST_FRAME_SIZE - 1U] = '\n';
+
+    printf("frame_us,wire_us,delay_us,latency_us\n");
+    for (Local_Index = 0; Local_Index < (sizeof(Local_Delays) / sizeof(Local_Delays[0])); Local_Index++)
+    {
+        Local_Pass &= Test_Frame_Run(Local_Delays[Local_Index], &Local_Time);
+    }
+    // the longest latency is the one of the longest delay.
+    if ((USART_CYCLES_TO_US(Local_Time.Max_Latency_Cycles) < 5000UL) ||
+        (USART_CYCLES_TO_US(Local_Time.Max_Latency_Cycles) > (5000UL + TEST_JITTER_US)))
+    {
+        printf("FAIL : the longest latency is %lu us\n", (unsigned long)USART_CYCLES_TO_US(Local_Time.Max_Latency_Cycles));
+        Local_Pass = 0;
+    }
+
+    // the resilient mode drops a damaged frame, the time of the next frame starts at its own first element.
+    (void)MCAL_UART_Set_RX_Mode(&Test_RX, RX_Resilient_Mode);
+    Test_RX_Done = 0;
+    (void)MCAL_UART_Receive_INT(&Test_RX, Test_RX_Frame, TEST_FRAME_SIZE, '\n');
+    (void)MCAL_UART_Posix_Noise(&Test_RX, &Local_Noise);
+    (void)MCAL_UART_Transmit(&Test_TX, Test_Frame, TEST_FRAME_SIZE, TEST_TX_LIMIT, '\n');
+    Test_Sleep_us(10000UL);
+    (void)MCAL_UART_Posix_Noise(&Test_RX, NULL);
+    Local_Start = DWT_CYCCNT_R;
+    (void)MCAL_UART_Transmit_INT(&Test_TX, Test_Frame, TEST_FRAME_SIZE, '\n');
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+    {
+        Test_Sleep_us(100UL);
+    }
+    if ((Test_RX_Done == 0) || (Test_RX.RX_Errors.Damaged_Frames == 0) || (MCAL_UART_Get_RX_Time(&Test_RX, &Local_Time) != Uart_OK) ||
+        ((s32)(Local_Time.First_Cycle - Local_Start) < 0) ||
+        (USART_CYCLES_TO_US(Local_Time.End_Cycle - Local_Time.First_Cycle) > (TEST_WIRE_US + TEST_JITTER_US)))
+    {
+        printf("FAIL : the frame after the damaged one does not start its time (%lu us)\n",
+               (unsigned long)USART_CYCLES_TO_US(Local_Time.End_Cycle - Local_Time.First_Cycle));
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : timestamp loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
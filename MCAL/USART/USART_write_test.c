@@ -0,0 +1,195 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the buffered write mode, it runs on the	*/
+/*					   host model of the USART driver (USART_POSIX)							*/
+/********************************************************************************************/
+/*	USART1 writes small messages by MCAL_UART_Write to USART2 over a pseudo-terminal pair :	*/
+/*	a burst of messages that share the Transmissions, one message below the threshold that	*/
+/*	is sent at its deadline by MCAL_UART_Write_Tick, and one that is sent by				*/
+/*	MCAL_UART_Write_Flush. the test checks that the elements arrive in order, the			*/
+/*	statistics of the writes and the times of the deadline and the flush.					*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_WRITE=Enable -I. -IMCAL/USART				*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c MCAL/USART/USART_write_test.c	*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "USART_private.h"
+#include "USART_config.h"
+#include "USART_interface.h"
+
+#if USART_POSIX == Enable
+#if USART_WRITE == Disable
+#error "the test writes by the buffered write mode, so it is built with USART_WRITE"
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_BAUD               921600UL
+#define     TEST_RING_SIZE          256U
+#define     TEST_THRESHOLD          64U
+#define     TEST_DEADLINE_US        2000UL
+#define     TEST_MESSAGES           200U
+#define     TEST_MESSAGE_SIZE       8U
+#define     TEST_BURST_SIZE         (TEST_MESSAGES * TEST_MESSAGE_SIZE)
+#define     TEST_SMALL_SIZE         5U
+/*	the Reception ends by its size, no element is this one	*/
+#define     TEST_NO_ELEMENT         0xFFU
+/*	the time the host scheduler may add to a measured time	*/
+#define     TEST_JITTER_US          3000UL
+/*	the longest wait of the Reception, in pauses (100 us)	*/
+#define     TEST_WAITS              20000U
+/********************************************************************************************/
+static USART_Struct     Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Test_Ring[TEST_RING_SIZE];
+static u8               Test_Sent[TEST_BURST_SIZE];
+static u8               Test_Stream[TEST_BURST_SIZE];
+static volatile u8      Test_RX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Test_RX_End  : the RX callback of USART2.
+/// @param  USARTx       : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_Pause   : it waits one pause (100 us).
+/// @return None.
+static void Test_Pause(void)
+{
+    struct timespec Local_Pause = { 0, 100000L };
+
+    nanosleep(&Local_Pause, NULL);
+}
+
+
+/// @brief  Test_Wait    : it waits for the end of the Reception, it checks the deadline of the waiting elements in
+///                        every pause.
+/// @return the time of the wait in micro seconds, or (0xFFFFFFFF) if the Reception does not end.
+static u32 Test_Wait(void)
+{
+    u32 Local_Start = DWT_CYCCNT_R;
+    u16 Local_Wait;
+
+    for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+    {
+        (void)MCAL_UART_Write_Tick(&Test_TX);
+        Test_Pause();
+    }
+    return (Test_RX_Done == 0) ? 0xFFFFFFFFUL : USART_CYCLES_TO_US(DWT_CYCCNT_R - Local_Start);
+}
+
+
+/// @brief  Test_Receive : it starts a Reception that ends by its size.
+/// @param  Copy_Size    : the size.
+/// @return None.
+static void Test_Receive(u16 Copy_Size)
+{
+    Test_RX_Done = 0;
+    memset(Test_Stream, 0, sizeof(Test_Stream));
+    (void)MCAL_UART_Receive_INT(&Test_RX, Test_Stream, Copy_Size, TEST_NO_ELEMENT);
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    USART_Write_Stats       Local_Stats;
+    char Local_Name[64];
+    u32  Local_Time;
+    u16  Local_Index, Local_Wait;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, Test_RX_End);
+    for (Local_Index = 0; Local_Index < TEST_BURST_SIZE; Local_Index++)
+    {
+        Test_Sent[Local_Index] = (u8)((Local_Index % TEST_MESSAGE_SIZE) == 0 ? (Local_Index / TEST_MESSAGE_SIZE) : ('a' + (Local_Index % 26U)));
+    }
+    (void)MCAL_UART_Write_Start(&Test_TX, Test_Ring, TEST_RING_SIZE, TEST_THRESHOLD, TEST_DEADLINE_US);
+
+    // the burst : the messages are added to the Transmission in progress, a full ring waits for it.
+    Test_Receive(TEST_BURST_SIZE);
+    for (Local_Index = 0; Local_Index < TEST_MESSAGES; Local_Index++)
+    {
+        for (Local_Wait = 0; (Local_Wait < TEST_WAITS) &&
+             (MCAL_UART_Write(&Test_TX, &Test_Sent[Local_Index * TEST_MESSAGE_SIZE], TEST_MESSAGE_SIZE) == Uart_BUSY); Local_Wait++)
+        {
+            Test_Pause();
+        }
+    }
+    Local_Time = Test_Wait();
+    (void)MCAL_UART_Write_Get_Stats(&Test_TX, &Local_Stats);
+    printf("burst : %lu messages, %lu elements, %lu streams, %lu extended, %lu full, %lu messages per stream\n",
+           (unsigned long)Local_Stats.Messages, (unsigned long)Local_Stats.Bytes, (unsigned long)Local_Stats.Streams,
+           (unsigned long)Local_Stats.Extended, (unsigned long)Local_Stats.Full,
+           (unsigned long)((Local_Stats.Streams == 0) ? 0 : (Local_Stats.Messages / Local_Stats.Streams)));
+    if ((Local_Time == 0xFFFFFFFFUL) || (memcmp(Test_Stream, Test_Sent, TEST_BURST_SIZE) != 0))
+    {
+        printf("FAIL : the burst is not received in order\n");
+        Local_Pass = 0;
+    }
+    // a stream carries the messages written while it runs, so it has many of them.
+    if ((Local_Stats.Messages != TEST_MESSAGES) || (Local_Stats.Bytes != TEST_BURST_SIZE) ||
+        (Local_Stats.Streams == 0) || ((Local_Stats.Messages / Local_Stats.Streams) < 4U))
+    {
+        printf("FAIL : the burst statistics\n");
+        Local_Pass = 0;
+    }
+
+    // one message below the threshold waits for its deadline.
+    while (MCAL_UART_Write_Stop(&Test_TX) == Uart_BUSY){ Test_Pause(); }
+    (void)MCAL_UART_Write_Start(&Test_TX, Test_Ring, TEST_RING_SIZE, TEST_THRESHOLD, TEST_DEADLINE_US);
+    Test_Receive(TEST_SMALL_SIZE);
+    (void)MCAL_UART_Write(&Test_TX, Test_Sent, TEST_SMALL_SIZE);
+    Local_Time = Test_Wait();
+    (void)MCAL_UART_Write_Get_Stats(&Test_TX, &Local_Stats);
+    printf("deadline : %lu us to the Reception end, %lu us of wait, deadline %lu us\n", (unsigned long)Local_Time,
+           (unsigned long)USART_CYCLES_TO_US(Local_Stats.Max_Wait_Cycles), (unsigned long)TEST_DEADLINE_US);
+    if ((Local_Time == 0xFFFFFFFFUL) || (memcmp(Test_Stream, Test_Sent, TEST_SMALL_SIZE) != 0) ||
+        (Local_Time < TEST_DEADLINE_US) || (Local_Time > (TEST_DEADLINE_US + TEST_JITTER_US)) ||
+        (USART_CYCLES_TO_US(Local_Stats.Max_Wait_Cycles) < TEST_DEADLINE_US) || (Local_Stats.Streams != 1U))
+    {
+        printf("FAIL : the message is not sent at its deadline\n");
+        Local_Pass = 0;
+    }
+
+    // the flush sends a message below the threshold at once.
+    Test_Receive(TEST_SMALL_SIZE);
+    (void)MCAL_UART_Write(&Test_TX, &Test_Sent[TEST_MESSAGE_SIZE], TEST_SMALL_SIZE);
+    (void)MCAL_UART_Write_Flush(&Test_TX);
+    Local_Time = Test_Wait();
+    printf("flush : %lu us to the Reception end\n", (unsigned long)Local_Time);
+    if ((Local_Time == 0xFFFFFFFFUL) || (memcmp(Test_Stream, &Test_Sent[TEST_MESSAGE_SIZE], TEST_SMALL_SIZE) != 0) ||
+        (Local_Time >= TEST_DEADLINE_US))
+    {
+        printf("FAIL : the flush does not send the message at once\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : buffered write loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+"""RAM and flash footprint of the USART driver.
+
+The input is the firmware ELF file (or the object of USART_program.c), built
+with debug information (-g). The report gives:
+  - the USART_Struct size, its fields and the padding holes, so the RAM of one
+    port is known for the enabled options of USART_config.h,
+  - the RAM of one port: the struct and the per-port globals of the driver,
+  - the RAM of the shared driver buffers (the pool, the trace, ...),
+  - the flash of every driver function, the biggest first.
+
+usage: footprint.py firmware.elf [--tools arm-none-eabi-] [--match REGEX]
+"""
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+
+DIE = re.compile(r"^\s*<(\d+)><([0-9a-f]+)>: Abbrev Number: \d+ \((DW_TAG_\w+)\)")
+ATTRIBUTE = re.compile(r"^\s*<[0-9a-f]+>\s+(DW_AT_\w+)\s*: (.*)$")
+REFERENCE = re.compile(r"<0x([0-9a-f]+)>")
+DRIVER = r"^(MCAL_UART_|UART_|USART\d_IRQHandler|USART\d_Struct$|USART\d_CallBack$|__USART\d__INTERRUPT_TYPE__$)"
+PORT_GLOBALS = re.compile(r"^(USART\d_Struct|USART\d_CallBack|__USART\d__INTERRUPT_TYPE__)$")
+
+
+def run(tools, tool, *args):
+    name = tools + tool
+    if shutil.which(name) is None:
+        name = tool
+    return subprocess.run([name] + list(args), check=True, capture_output=True, text=True).stdout
+
+
+def read_dies(text):
+    """the DWARF entries by their offset, with their attributes and children"""
+    dies = {}
+    stack = []
+    for line in text.splitlines():
+        match = DIE.match(line)
+        if match:
+            depth, offset, tag = int(match.group(1)), int(match.group(2), 16), match.group(3)
+            die = {"tag": tag, "children": []}
+            dies[offset] = die
+            del stack[depth:]
+            if stack:
+                stack[-1]["children"].append(offset)
+            stack.append(die)
+            continue
+        match = ATTRIBUTE.match(line)
+        if match and stack:
+            name, value = match.group(1), match.group(2).strip()
+            if name == "DW_AT_name":
+                # "(indirect string, offset: 0x..): NAME" or "NAME"
+                value = value.rsplit("): ", 1)[-1]
+            stack[-1][name] = value
+    return dies
+
+
+def number(value):
+    return int(value.split()[0], 0)
+
+
+def type_of(dies, die):
+    match = REFERENCE.search(die.get("DW_AT_type", ""))
+    return dies.get(int(match.group(1), 16)) if match else None
+
+
+def size_of(dies, die):
+    if die is None:
+        return 0
+    if "DW_AT_byte_size" in die:
+        return number(die["DW_AT_byte_size"])
+    if die["tag"] == "DW_TAG_array_type":
+        count = 1
+        for child in die["children"]:
+            bound = dies[child]
+            if "DW_AT_upper_bound" in bound:
+                count *= number(bound["DW_AT_upper_bound"]) + 1
+            elif "DW_AT_count" in bound:
+                count *= number(bound["DW_AT_count"])
+        return count * size_of(dies, type_of(dies, die))
+    return size_of(dies, type_of(dies, die))
+
+
+def find_struct(dies, name):
+    for die in dies.values():
+        if die["tag"] == "DW_TAG_typedef" and die.get("DW_AT_name") == name:
+            target = type_of(dies, die)
+            if target is not None and target["tag"] == "DW_TAG_structure_type":
+                return target
+    return None
+
+
+def struct_report(dies, name):
+    struct = find_struct(dies, name)
+    if struct is None:
+        sys.exit("no %s in the debug information, build with -g" % name)
+    total = size_of(dies, struct)
+    print("%s : %d bytes" % (name, total))
+    holes = 0
+    end = 0
+    for child in struct["children"]:
+        member = dies[child]
+        if member["tag"] != "DW_TAG_member":
+            continue
+        offset = number(member.get("DW_AT_data_member_location", "0"))
+        if offset > end:
+            print("    %4d  %-22s %3d bytes" % (end, "<hole>", offset - end))
+            holes += offset - end
+        size = size_of(dies, type_of(dies, member))
+        print("    %4d  %-22s %3d" % (offset, member.get("DW_AT_name", "?"), size))
+        end = offset + size
+    if total > end:
+        print("    %4d  %-22s %3d bytes" % (end, "<tail padding>", total - end))
+        holes += total - end
+    print("    padding : %d bytes" % holes)
+    return total
+
+
+def symbols(tools, elf, pattern):
+    """(name, size, kind) of the driver symbols, the biggest first"""
+    result = []
+    for line in run(tools, "nm", "-S", "--size-sort", "-r", elf).splitlines():
+        parts = line.split()
+        if len(parts) != 4 or not re.match(pattern, parts[3]):
+            continue
+        result.append((parts[3], int(parts[1], 16), parts[2].lower()))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="the ELF file or the object, built with -g")
+    parser.add_argument("--tools", default="arm-none-eabi-", help="the prefix of nm and readelf")
+    parser.add_argument("--match", default=DRIVER, help="the regular expression of the driver symbols")
+    args = parser.parse_args()
+
+    dies = read_dies(run(args.tools, "readelf", "--debug-dump=info", args.elf))
+    struct_size = struct_report(dies, "USART_Struct")
+
+    found = symbols(args.tools, args.elf, args.match)
+    port_globals = sum(size for name, size, kind in found if PORT_GLOBALS.match(name)) // 3
+    print("\nRAM of one port : %d bytes (the struct and %d bytes of the driver globals)"
+          % (struct_size + port_globals, port_globals))
+
+    shared = [(name, size) for name, size, kind in found if kind in "bdgs" and not PORT_GLOBALS.match(name)]
+    print("\nshared RAM : %d bytes" % sum(size for name, size in shared))
+    for name, size in shared:
+        print("    %6d  %s" % (size, name))
+
+    flash = [(name, size) for name, size, kind in found if kind in "trc"]
+    print("\nflash : %d bytes" % sum(size for name, size in flash))
+    for name, size in flash:
+        print("    %6d  %s" % (size, name))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Host decoder of the USART Event Trace (USART_TRACE).
+
+MCAL_UART_Trace_Dump sends one record per line, 16 hex digits of the record
+as it is in the memory (little endian), the oldest record first:
+    [cycle : u32][event : u8][port : u8][data : u16]
+The records of MCAL_UART_Trace_Read can be given as a binary file (--raw).
+
+usage: trace_decode.py dump.txt [--fck 16000000]
+       trace_decode.py /dev/ttyUSB0 --baud 115200               (needs pyserial)
+       trace_decode.py records.bin --raw
+
+The last lines report the ports whose TX or RX lock was left BUSY, with the
+events that led to it.
+"""
+import argparse
+import struct
+import sys
+
+RECORD = struct.Struct("<IBBH")
+
+PORTS = {0x10: "USART1", 0x44: "USART2", 0x14: "USART6"}
+STATUS = {0: "OK", 1: "ERROR", 2: "TIMEOUT", 3: "OVERSIZE", 4: "UNDERSIZE", 5: "BUSY"}
+LOCK = {0: "IDLE", 1: "BUSY", 2: "ERROR_IN"}
+SR_FLAGS = ["PE", "FE", "NE", "ORE", "IDLE", "RXNE", "TC", "TXE", "LBD", "CTS"]
+
+EVENTS = {
+    0x01: ("Transmit_INT", "size"),
+    0x02: ("Receive_INT", "size"),
+    0x03: ("Transmit", "size"),
+    0x04: ("Receive", "size"),
+    0x08: ("return", "status"),
+    0x10: ("ISR", "sr"),
+    0x20: ("TX lock", "lock"),
+    0x21: ("RX lock", "lock"),
+    0x22: ("TX forced unlock", "size"),
+    0x23: ("RX forced unlock", "size"),
+    0x30: ("RX error", "sr"),
+    0x40: ("TX end", "status"),
+    0x41: ("RX end", "status"),
+}
+
+
+def flags(sr):
+    return "|".join(name for bit, name in enumerate(SR_FLAGS) if sr >> bit & 1) or "0"
+
+
+def describe(event, data):
+    name, kind = EVENTS.get(event, ("event 0x%02X" % event, "size"))
+    if kind == "status":
+        return "%s %s" % (name, STATUS.get(data, data))
+    if kind == "lock":
+        return "%s %s" % (name, LOCK.get(data, data))
+    if kind == "sr":
+        return "%s SR=%s" % (name, flags(data))
+    return "%s %d" % (name, data)
+
+
+def read_lines(source, baud):
+    if source.startswith("/dev/") or source.upper().startswith("COM"):
+        import serial
+        port = serial.Serial(source, baud, timeout=2)
+        while True:
+            line = port.readline()
+            if not line:
+                return
+            yield line.decode("ascii", "replace")
+    else:
+        for line in open(source, "r", errors="replace"):
+            yield line
+
+
+def records(args):
+    if args.raw:
+        data = open(args.input, "rb").read()
+        for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+            yield RECORD.unpack_from(data, offset)
+        return
+    for line in read_lines(args.input, args.baud):
+        line = line.strip()
+        if len(line) != 2 * RECORD.size:
+            continue
+        try:
+            yield RECORD.unpack(bytes.fromhex(line))
+        except ValueError:
+            continue
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="a dump file, a serial port, or a binary records file (--raw)")
+    parser.add_argument("--raw", action="store_true", help="the input is binary records")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--fck", type=int, default=16000000, help="the DWT cycle counter clock (FCK)")
+    args = parser.parse_args()
+
+    first = previous = None
+    elapsed = 0
+    locks = {}
+    history = {}
+    for cycle, event, port, data in records(args):
+        if first is None:
+            first = previous = cycle
+        # the cycle counter wraps every 2^32 cycles, the events are in order so the delta is positive.
+        elapsed += (cycle - previous) & 0xFFFFFFFF
+        previous = cycle
+        name = PORTS.get(port, "port 0x%02X" % port)
+        text = describe(event, data)
+        print("%12.1f us  %-7s %s" % (elapsed * 1e6 / args.fck, name, text))
+
+        history.setdefault(name, []).append(text)
+        history[name] = history[name][-8:]
+        if event in (0x20, 0x21):
+            locks[(name, event & 1)] = data
+        elif event in (0x40, 0x41, 0x22, 0x23):
+            locks[(name, event & 1)] = 0
+
+    if first is None:
+        sys.exit("no trace records")
+    for (name, direction), state in sorted(locks.items()):
+        if state == 1:
+            print("\n%s %s lock left BUSY, the last events:" % (name, "TX" if direction == 0 else "RX"))
+            for text in history[name]:
+                print("    " + text)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,31 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Baud Rate Negotiation 		*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BAUD_CONFIG_H
+#define		BAUD_CONFIG_H
+
+/********************************************************************************************/
+/*	the time (in micro seconds) to wait for every answer of the peer						*/
+/********************************************************************************************/
+#define BAUD_TIMEOUT_US         100000UL
+/********************************************************************************************/
+/*	the time (in micro seconds) the proposer waits after the change before its check line,	*/
+/*	so the peer has changed its Baud rate too												*/
+/********************************************************************************************/
+#define BAUD_SETTLE_US          2000UL
+/********************************************************************************************/
+/*	the highest Baud rate that is accepted from the peer, up to (FCK / 16)					*/
+/********************************************************************************************/
+#define BAUD_MAX_RATE           921600UL
+/********************************************************************************************/
+/*	the lowest Baud rate that is accepted from the peer, from (FCK / 8 / 4095) so the		*/
+/*	mantissa of (BRR) fits its 12 bits with both the oversampling by 8 and by 16			*/
+/********************************************************************************************/
+#define BAUD_MIN_RATE           1200UL
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,44 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Baud Rate Negotiation 			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BAUD_INTERFACE_H
+#define		BAUD_INTERFACE_H
+
+/********************************************************************************************/
+/*	The two ends of a link agree on a faster Baud rate by text lines at the current rate,	*/
+/*	then both change it by MCAL_UART_Set_Baud and check the link by one line at the new		*/
+/*	rate, if the check fails both go back to the old rate. It is used before the			*/
+/*	application traffic starts, as it uses the Transmission and the Reception of the port.	*/
+/*	The (USART_BAUD_FALLBACK) option of the driver takes a port back to its MCAL_UART_Init_	*/
+/*	rate when it Receives too many Frame errors. It sends no notice : the peer goes back	*/
+/*	only if it has the option too and Receives elements sent at the old rate, so a side	*/
+/*	that only listens stays at the new rate. After a fallback (the Fallback_Counter of the	*/
+/*	USART Struct) the application should send traffic, or negotiate again.					*/
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Baud Negotiation Functions Prototypes           		        */
+/********************************************************************************************/
+/// @brief  BAUD_Propose : this function proposes a Baud rate to the peer and changes to it if the peer accepts it and
+///                        the check line passes.
+/// @param  USARTx       : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Baud    : the proposed Baud rate.
+/// @retval Functions Status, (Uart_ERROR) if the peer refuses it or it is out of the accepted range, (Uart_TIMEOUT) if the peer does not answer or the
+///         check fails (the old Baud rate is used).
+Uart_Fun_Status	    BAUD_Propose(USART_Struct *USARTx , u32 Copy_Baud);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BAUD_Listen : this function waits for a proposal of the peer, accepts it (from BAUD_MIN_RATE to BAUD_MAX_RATE)
+///                       and changes to it if the check line passes.
+/// @param  USARTx      : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Wait_US: the time (in micro seconds) to wait for the proposal.
+/// @retval Functions Status, (Uart_ERROR) if the proposal is refused or it is another line, (Uart_TIMEOUT) if there is
+///         no proposal or the check fails (the old Baud rate is used).
+Uart_Fun_Status	    BAUD_Listen(USART_Struct *USARTx , u32 Copy_Wait_US);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
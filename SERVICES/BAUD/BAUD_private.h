@@ -0,0 +1,30 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Baud Rate Negotiation 				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BAUD_PRIVATE_H
+#define		BAUD_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Negotiation Lines                      			    */
+/********************************************************************************************/
+/*	proposer : "BAUD <rate>\n"		peer : "BAUD OK <rate>\n" or "BAUD NO <rate>\n"			*/
+/*	both change the Baud rate, then   proposer : "BAUD SYNC\n"		peer : "BAUD SYNC\n"	*/
+/********************************************************************************************/
+#define     BAUD_LINE_MAX           24U
+#define     BAUD_LINE_END           '\n'
+
+#define     BAUD_PROPOSE            "BAUD "
+#define     BAUD_ACCEPT             "BAUD OK "
+#define     BAUD_REFUSE             "BAUD NO "
+#define     BAUD_SYNC               "BAUD SYNC"
+/********************************************************************************************/
+
+#if BAUD_MIN_RATE <= (FCK / 8UL / 4095UL)
+#error "BAUD_MIN_RATE is too low, the mantissa of BRR does not fit its 12 bits"
+#endif
+
+#endif
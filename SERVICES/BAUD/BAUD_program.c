@@ -0,0 +1,218 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Baud Rate Negotiation 				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "BAUD_config.h"
+#include "BAUD_private.h"
+#include "BAUD_interface.h"
+/********************************************************************************************/
+static Uart_Fun_Status BAUD_Send(USART_Struct *USARTx , const char *Copy_Text , u32 Copy_Baud);
+static Uart_Fun_Status BAUD_Arm(USART_Struct *USARTx);
+static Uart_Fun_Status BAUD_Wait(USART_Struct *USARTx , u32 Copy_Cycles);
+static u32             BAUD_u32Match(const char *Copy_Text);
+static Uart_Fun_Status BAUD_Change(USART_Struct *USARTx , u32 Copy_Baud);
+/********************************************************************************************/
+static u8   BAUD_TX_Line[BAUD_LINE_MAX];
+static u8   BAUD_RX_Line[BAUD_LINE_MAX];
+/********************************************************************************************/
+
+
+/// @brief  BAUD_Propose : this function proposes a Baud rate to the peer and changes to it if the peer accepts it and
+///                        the check line passes.
+/// @param  USARTx       : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Baud    : the proposed Baud rate.
+/// @retval Functions Status, (Uart_ERROR) if the peer refuses it or it is out of the accepted range, (Uart_TIMEOUT) if the peer does not answer or the
+///         check fails (the old Baud rate is used).
+Uart_Fun_Status	    BAUD_Propose(USART_Struct *USARTx , u32 Copy_Baud)
+{
+    u32 Local_Old;
+    u32 Local_Start;
+
+    if ((USARTx == NULL) || (Copy_Baud < BAUD_MIN_RATE) || (Copy_Baud > BAUD_MAX_RATE)){ return Uart_ERROR; }
+    __UART_DWT_ENABLE();
+    Local_Old = USARTx -> Baud_Rate;
+
+    // the answer may come before the proposal returns, so the Reception starts first.
+    if (BAUD_Arm(USARTx) != Uart_OK){ return Uart_BUSY; }
+    if (BAUD_Send(USARTx, BAUD_PROPOSE, Copy_Baud) != Uart_OK){ return Uart_TIMEOUT; }
+    if (BAUD_Wait(USARTx, __UART_US_TO_CYCLES(BAUD_TIMEOUT_US)) != Uart_OK){ return Uart_TIMEOUT; }
+    if (BAUD_u32Match(BAUD_ACCEPT) != Copy_Baud){ return Uart_ERROR; }
+
+    // the peer changes when its answer is sent, the check line is sent after it.
+    if (BAUD_Change(USARTx, Copy_Baud) != Uart_OK){ return Uart_TIMEOUT; }
+    Local_Start = DWT_CYCCNT_R;
+    while ((DWT_CYCCNT_R - Local_Start) < __UART_US_TO_CYCLES(BAUD_SETTLE_US));
+    if ((BAUD_Arm(USARTx) == Uart_OK) && (BAUD_Send(USARTx, BAUD_SYNC, 0) == Uart_OK) &&
+        (BAUD_Wait(USARTx, __UART_US_TO_CYCLES(BAUD_TIMEOUT_US)) == Uart_OK) && (BAUD_u32Match(BAUD_SYNC) == 0))
+    {
+        return Uart_OK;
+    }
+    (void)BAUD_Change(USARTx, Local_Old);
+    return Uart_TIMEOUT;
+}
+
+
+/// @brief  BAUD_Listen : this function waits for a proposal of the peer, accepts it (from BAUD_MIN_RATE to BAUD_MAX_RATE)
+///                       and changes to it if the check line passes.
+/// @param  USARTx      : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Wait_US: the time (in micro seconds) to wait for the proposal.
+/// @retval Functions Status, (Uart_ERROR) if the proposal is refused or it is another line, (Uart_TIMEOUT) if there is
+///         no proposal or the check fails (the old Baud rate is used).
+Uart_Fun_Status	    BAUD_Listen(USART_Struct *USARTx , u32 Copy_Wait_US)
+{
+    u32 Local_Old;
+    u32 Local_Baud;
+
+    if (USARTx == NULL){ return Uart_ERROR; }
+    __UART_DWT_ENABLE();
+    Local_Old = USARTx -> Baud_Rate;
+
+    if (BAUD_Arm(USARTx) != Uart_OK){ return Uart_BUSY; }
+    if (BAUD_Wait(USARTx, __UART_US_TO_CYCLES(Copy_Wait_US)) != Uart_OK){ return Uart_TIMEOUT; }
+    Local_Baud = BAUD_u32Match(BAUD_PROPOSE);
+    if ((Local_Baud == 0) || (Local_Baud == 0xFFFFFFFFUL)){ return Uart_ERROR; }
+    if ((Local_Baud < BAUD_MIN_RATE) || (Local_Baud > BAUD_MAX_RATE))
+    {
+        (void)BAUD_Send(USARTx, BAUD_REFUSE, Local_Baud);
+        return Uart_ERROR;
+    }
+
+    if (BAUD_Send(USARTx, BAUD_ACCEPT, Local_Baud) != Uart_OK){ return Uart_TIMEOUT; }
+    // MCAL_UART_Set_Baud waits for the last element of the answer.
+    if ((BAUD_Change(USARTx, Local_Baud) == Uart_OK) && (BAUD_Arm(USARTx) == Uart_OK) &&
+        (BAUD_Wait(USARTx, __UART_US_TO_CYCLES(BAUD_TIMEOUT_US)) == Uart_OK) && (BAUD_u32Match(BAUD_SYNC) == 0) &&
+        (BAUD_Send(USARTx, BAUD_SYNC, 0) == Uart_OK))
+    {
+        return Uart_OK;
+    }
+    (void)BAUD_Change(USARTx, Local_Old);
+    return Uart_TIMEOUT;
+}
+
+
+/// @brief  BAUD_Send : it sends a line (the text then the Baud rate if it is not zero) and waits for its end.
+/// @param  USARTx    : the Struct of the USART Peripheral.
+/// @param  Copy_Text : the text of the line.
+/// @param  Copy_Baud : the Baud rate, or (0).
+/// @retval Functions Status.
+static Uart_Fun_Status BAUD_Send(USART_Struct *USARTx , const char *Copy_Text , u32 Copy_Baud)
+{
+    u8  Local_Size = 0;
+    u8  Local_Digits[10];
+    u8  Local_Count = 0;
+    u32 Local_Start;
+    Uart_Fun_Status Local_Status;
+
+    while (*Copy_Text != '\0')
+    {
+        BAUD_TX_Line[Local_Size++] = (u8)*Copy_Text++;
+    }
+    while (Copy_Baud != 0)
+    {
+        Local_Digits[Local_Count++] = (u8)('0' + (Copy_Baud % 10));
+        Copy_Baud /= 10;
+    }
+    while (Local_Count > 0)
+    {
+        BAUD_TX_Line[Local_Size++] = Local_Digits[--Local_Count];
+    }
+    BAUD_TX_Line[Local_Size++] = BAUD_LINE_END;
+
+    Local_Status = MCAL_UART_Transmit_INT(USARTx, BAUD_TX_Line, Local_Size, BAUD_LINE_END);
+    if (Local_Status != Uart_OK){ return Local_Status; }
+
+    Local_Start = DWT_CYCCNT_R;
+    while (USARTx -> TX_Lock_Flag == BUSY)
+    {
+        if ((DWT_CYCCNT_R - Local_Start) > __UART_US_TO_CYCLES(BAUD_TIMEOUT_US)){ return Uart_TIMEOUT; }
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  BAUD_Arm : it starts the Reception of one line.
+/// @param  USARTx   : the Struct of the USART Peripheral.
+/// @retval Functions Status.
+static Uart_Fun_Status BAUD_Arm(USART_Struct *USARTx)
+{
+    BAUD_RX_Line[0] = '\0';
+    return MCAL_UART_Receive_INT(USARTx, BAUD_RX_Line, BAUD_LINE_MAX - 1, BAUD_LINE_END);
+}
+
+
+/// @brief  BAUD_Wait : it waits for the end of the line Reception, it stops the Reception if the time ends.
+/// @param  USARTx    : the Struct of the USART Peripheral.
+/// @param  Copy_Cycles: the DWT cycles to wait.
+/// @retval Functions Status.
+static Uart_Fun_Status BAUD_Wait(USART_Struct *USARTx , u32 Copy_Cycles)
+{
+    u32 Local_Start = DWT_CYCCNT_R;
+
+    while (USARTx -> RX_Lock_Flag == BUSY)
+    {
+        if ((DWT_CYCCNT_R - Local_Start) > Copy_Cycles)
+        {
+            // the Reception of the missing line is stopped, so the port can be used again,
+            // the Interrupts are disabled, so the Handler does not end the line between these writes.
+            u32 Local_State;
+            __UART_ENTER_CRITICAL(Local_State);
+            __UART_SHADOW_CLR(USARTx, CR1, CR1_RXNEIE);
+            USARTx -> RX_Lock_Flag    = IDLE;
+            USARTx -> RX_Lock_Counter = 0;
+            __UART_EXIT_CRITICAL(Local_State);
+            return Uart_TIMEOUT;
+        }
+    }
+    // the line ends by its last element, so it ends the text.
+    BAUD_RX_Line[USARTx -> RX_Buffer_Size] = '\0';
+    return Uart_OK;
+}
+
+
+/// @brief  BAUD_u32Match : it checks that the Received line starts by a text, then reads the Baud rate after it.
+/// @param  Copy_Text     : the text.
+/// @retval the Baud rate, (0) if there is no number after the text, or (0xFFFFFFFF) if the line does not match.
+static u32 BAUD_u32Match(const char *Copy_Text)
+{
+    u8  Local_Index = 0;
+    u32 Local_Baud  = 0;
+
+    while (Copy_Text[Local_Index] != '\0')
+    {
+        if (BAUD_RX_Line[Local_Index] != (u8)Copy_Text[Local_Index]){ return 0xFFFFFFFFUL; }
+        Local_Index++;
+    }
+    while ((BAUD_RX_Line[Local_Index] >= '0') && (BAUD_RX_Line[Local_Index] <= '9') && (Local_Baud < 100000000UL))
+    {
+        Local_Baud = (Local_Baud * 10) + (BAUD_RX_Line[Local_Index++] - '0');
+    }
+    // the other elements (such as '\r') are not expected.
+    return (BAUD_RX_Line[Local_Index] == '\0') ? Local_Baud : 0xFFFFFFFFUL;
+}
+
+
+/// @brief  BAUD_Change : it changes the Baud rate when the port is between frames.
+/// @param  USARTx      : the Struct of the USART Peripheral.
+/// @param  Copy_Baud   : the Baud rate.
+/// @retval Functions Status.
+static Uart_Fun_Status BAUD_Change(USART_Struct *USARTx , u32 Copy_Baud)
+{
+    u32 Local_Start = DWT_CYCCNT_R;
+    Uart_Fun_Status Local_Status;
+
+    do
+    {
+        Local_Status = MCAL_UART_Set_Baud(USARTx, Copy_Baud);
+    } while ((Local_Status == Uart_BUSY) && ((DWT_CYCCNT_R - Local_Start) < __UART_US_TO_CYCLES(BAUD_TIMEOUT_US)));
+    return Local_Status;
+}
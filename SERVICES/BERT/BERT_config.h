@@ -0,0 +1,41 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Loopback Bit Error Rate Test	*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BERT_CONFIG_H
+#define		BERT_CONFIG_H
+
+/********************************************************************************************/
+/*	the elements of one test frame (the last one is the frame end), from 2 to 1024			*/
+/********************************************************************************************/
+#define BERT_FRAME_SIZE         64U
+/********************************************************************************************/
+/*	the test time (in micro seconds) of every Baud rate, the whole sweep takes about		*/
+/*	(the rates number * BERT_RATE_TIME_US)													*/
+/********************************************************************************************/
+#define BERT_RATE_TIME_US       200000UL
+/********************************************************************************************/
+/*	the element times waited after a frame that ended before its end, so its late elements	*/
+/*	are dropped before the next frame														*/
+/********************************************************************************************/
+#define BERT_GUARD_ELEMENTS     4U
+/********************************************************************************************/
+/*	the time (in micro seconds) added to the waits of a frame (its end and the guard after	*/
+/*	it) for the Interrupt latency of the system, a frame that is not sent after it stops	*/
+/*	the test (Uart_TIMEOUT). it can also be given to the compiler, like						*/
+/*	(-DBERT_LATENCY_US=20000UL) on a host.													*/
+/********************************************************************************************/
+#ifndef BERT_LATENCY_US
+#define BERT_LATENCY_US         1000UL
+#endif
+/********************************************************************************************/
+/*	the sweep stops at the first Baud rate with an error (the rates are given from the		*/
+/*	slowest one), the options are : (Enable) or (Disable).									*/
+/********************************************************************************************/
+#define BERT_STOP_ON_FAIL       Enable
+/********************************************************************************************/
+
+#endif
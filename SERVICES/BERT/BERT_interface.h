@@ -0,0 +1,61 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Loopback Bit Error Rate Test		*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BERT_INTERFACE_H
+#define		BERT_INTERFACE_H
+
+/********************************************************************************************/
+/*	The port sends PRBS frames to itself by the normal Interrupt Transmission and			*/
+/*	Reception, through the internal loopback of the driver (MCAL_UART_Set_Loopback) or an	*/
+/*	external loopback plug (TX wired to RX). Every Baud rate of the sweep is tested for		*/
+/*	BERT_RATE_TIME_US : the Received bits are compared with the sent ones, and the (PE),	*/
+/*	(FE), (NE) and (ORE) errors of the port are counted. The result is the highest rate		*/
+/*	with no error. The service needs the USART_SELF_TEST option of the driver, it uses the	*/
+/*	port alone (its callbacks are not changed) and gives back its Baud rate at the end.		*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The Loopback Types                      			    */
+/********************************************************************************************/
+#define     BERT_LOOP_INTERNAL      0U
+#define     BERT_LOOP_EXTERNAL      1U
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The result of one Baud rate.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Baud;						/*	 		The tested Baud rate						  		  */
+	u32				 Frames;					/*	 	Number of the sent frames, (0) if it was not tested	  */
+	u32				 Bits;						/*	 		Number of the compared bits					  		  */
+	u32				 Bit_Errors;				/*	 	Number of the Received bits that are not the sent ones	  */
+	u32				 Lost_Elements;				/*	 Number of the frame elements that were not Received (an error ends the frame) */
+	USART_Error_Counters Errors;				/*	 	The (PE), (NE), (FE) and (ORE) errors of the rate		  */
+	u8				 Clean;						/*	 		(1) if the rate has no error				  		  */
+
+}BERT_Result;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Bit Error Rate Test Functions Prototypes           		        */
+/********************************************************************************************/
+/// @brief  BERT_Sweep   : this function tests the port at every Baud rate of a list, it blocks for the test time.
+/// @param  USARTx       : the Struct of the initialized USART Peripheral, with no Transfer in progress.
+/// @param  Copy_Loop    : BERT_LOOP_INTERNAL or BERT_LOOP_EXTERNAL.
+/// @param  Copy_Rates   : the Baud rates, from the slowest one.
+/// @param  Copy_Count   : the number of the rates.
+/// @param  Copy_Results : the array (of Copy_Count results) to hold the result of every rate.
+/// @param  Copy_Best    : pointer to hold the highest rate with no error, or (0).
+/// @retval Functions Status, (Uart_ERROR) if no rate is clean, (Uart_BUSY) or (Uart_TIMEOUT) if the port stopped
+///         the test.
+Uart_Fun_Status	    BERT_Sweep(USART_Struct *USARTx , u8 Copy_Loop , const u32 *Copy_Rates , u8 Copy_Count ,
+                               BERT_Result *Copy_Results , u32 *Copy_Best);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
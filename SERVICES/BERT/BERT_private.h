@@ -0,0 +1,29 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Loopback Bit Error Rate Test		*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BERT_PRIVATE_H
+#define		BERT_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Test Frame                      			        */
+/********************************************************************************************/
+/*	the frame is a PRBS-9 (x^9 + x^5 + 1) sequence that goes on from frame to frame, an		*/
+/*	element equal to the frame end has its lowest bit inverted.								*/
+#define     BERT_FRAME_END          0x7EU
+#define     BERT_PRBS_SEED          0x1FFU
+#define     BERT_PRBS_MASK          0x1FFU
+/*	the longest time (in micro seconds) to wait for the port to change its Baud rate		*/
+#define     BERT_CHANGE_US          100000UL
+/*	the DWT cycles of the longest element (start bit, 9 data bits and 2 stop bits)	*/
+#define     __BERT_ELEMENT_CYCLES(__BAUD__)     ((u32)((FCK / (__BAUD__)) * 12UL))
+/********************************************************************************************/
+
+#if (BERT_FRAME_SIZE < 2) || (BERT_FRAME_SIZE > 1024)
+#error "BERT_FRAME_SIZE should be from 2 to 1024"
+#endif
+
+#endif
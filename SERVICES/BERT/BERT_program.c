@@ -0,0 +1,255 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Loopback Bit Error Rate Test		*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "BERT_config.h"
+#include "BERT_private.h"
+#include "BERT_interface.h"
+
+#if USART_SELF_TEST != Enable
+#error "the Bit Error Rate Test needs the USART_SELF_TEST option (MCAL_UART_Set_Loopback and MCAL_UART_Receive_Abort)"
+#endif
+/********************************************************************************************/
+static Uart_Fun_Status BERT_Rate(USART_Struct *USARTx , u32 Copy_Baud , BERT_Result *Copy_Result);
+static Uart_Fun_Status BERT_Frame(USART_Struct *USARTx , u32 Copy_Element_Cycles , BERT_Result *Copy_Result);
+static void            BERT_voidFill(u8 Copy_Mask);
+static Uart_Fun_Status BERT_Change(USART_Struct *USARTx , u32 Copy_Baud);
+/********************************************************************************************/
+static u8   BERT_TX_Frame[BERT_FRAME_SIZE];
+static u8   BERT_RX_Frame[BERT_FRAME_SIZE];
+static u16  BERT_PRBS_State = BERT_PRBS_SEED;
+/********************************************************************************************/
+
+
+/// @brief  BERT_Sweep   : this function tests the port at every Baud rate of a list, it blocks for the test time.
+/// @param  USARTx       : the Struct of the initialized USART Peripheral, with no Transfer in progress.
+/// @param  Copy_Loop    : BERT_LOOP_INTERNAL or BERT_LOOP_EXTERNAL.
+/// @param  Copy_Rates   : the Baud rates, from the slowest one.
+/// @param  Copy_Count   : the number of the rates.
+/// @param  Copy_Results : the array (of Copy_Count results) to hold the result of every rate.
+/// @param  Copy_Best    : pointer to hold the highest rate with no error, or (0).
+/// @retval Functions Status, (Uart_ERROR) if no rate is clean, (Uart_BUSY) or (Uart_TIMEOUT) if the port stopped
+///         the test.
+Uart_Fun_Status	    BERT_Sweep(USART_Struct *USARTx , u8 Copy_Loop , const u32 *Copy_Rates , u8 Copy_Count ,
+                               BERT_Result *Copy_Results , u32 *Copy_Best)
+{
+    u32 Local_Old;
+    u8  Local_Mode;
+    u8  Local_Index;
+    u8  Local_Stop = 0;
+    Uart_Fun_Status Local_Status = Uart_OK;
+
+    if ((USARTx == NULL) || (Copy_Rates == NULL) || (Copy_Count == 0) || (Copy_Results == NULL) || (Copy_Best == NULL) ||
+        ((Copy_Loop != BERT_LOOP_INTERNAL) && (Copy_Loop != BERT_LOOP_EXTERNAL))){ return Uart_ERROR; }
+    if ((USARTx -> TX_Lock_Flag == BUSY) || (USARTx -> RX_Lock_Flag == BUSY)){ return Uart_BUSY; }
+
+    __UART_DWT_ENABLE();
+    Local_Old  = USARTx -> Baud_Rate;
+    Local_Mode = USARTx -> RX_Mode;
+    *Copy_Best = 0;
+    if ((Copy_Loop == BERT_LOOP_INTERNAL) && (MCAL_UART_Set_Loopback(USARTx, Enable) != Uart_OK)){ return Uart_BUSY; }
+    // an error ends the frame, so the Received elements are always in the place of the sent ones.
+    (void)MCAL_UART_Set_RX_Mode(USARTx, RX_Strict_Mode);
+
+    for (Local_Index = 0; Local_Index < Copy_Count; Local_Index++)
+    {
+        BERT_Result *Local_Result = &Copy_Results[Local_Index];
+
+        Local_Result -> Baud          = Copy_Rates[Local_Index];
+        Local_Result -> Frames        = 0;
+        Local_Result -> Bits          = 0;
+        Local_Result -> Bit_Errors    = 0;
+        Local_Result -> Lost_Elements = 0;
+        Local_Result -> Clean         = 0;
+        Local_Result -> Errors.PE_Counter     = 0;
+        Local_Result -> Errors.NE_Counter     = 0;
+        Local_Result -> Errors.FE_Counter     = 0;
+        Local_Result -> Errors.ORE_Counter    = 0;
+        Local_Result -> Errors.Damaged_Frames = 0;
+        // the rates after a stop are not tested.
+        if (Local_Stop == 1){ continue; }
+
+        Local_Status = BERT_Rate(USARTx, Copy_Rates[Local_Index], Local_Result);
+        if ((Local_Status == Uart_BUSY) || (Local_Status == Uart_TIMEOUT))
+        {
+            Local_Stop = 1;
+            continue;
+        }
+        if ((Local_Result -> Frames != 0) && (Local_Result -> Bit_Errors == 0) && (Local_Result -> Lost_Elements == 0) &&
+            (Local_Result -> Errors.PE_Counter == 0) && (Local_Result -> Errors.NE_Counter == 0) &&
+            (Local_Result -> Errors.FE_Counter == 0) && (Local_Result -> Errors.ORE_Counter == 0))
+        {
+            Local_Result -> Clean = 1;
+            if (Local_Result -> Baud > *Copy_Best)
+            {
+                *Copy_Best = Local_Result -> Baud;
+            }
+        }
+#if BERT_STOP_ON_FAIL == Enable
+        else
+        {
+            Local_Stop = 1;
+        }
+#endif
+        Local_Status = Uart_OK;
+    }
+
+    // the port is given back as it was.
+    (void)BERT_Change(USARTx, Local_Old);
+    (void)MCAL_UART_Set_RX_Mode(USARTx, (Uart_RX_Mode)Local_Mode);
+    if (Copy_Loop == BERT_LOOP_INTERNAL)
+    {
+        (void)MCAL_UART_Set_Loopback(USARTx, Disable);
+    }
+    if (Local_Status != Uart_OK){ return Local_Status; }
+    return (*Copy_Best != 0) ? Uart_OK : Uart_ERROR;
+}
+
+
+/// @brief  BERT_Rate   : it tests one Baud rate for BERT_RATE_TIME_US.
+/// @param  USARTx      : the Struct of the USART Peripheral.
+/// @param  Copy_Baud   : the Baud rate.
+/// @param  Copy_Result : pointer to the result of the rate.
+/// @retval Functions Status, (Uart_ERROR) if the port can not use the rate.
+static Uart_Fun_Status BERT_Rate(USART_Struct *USARTx , u32 Copy_Baud , BERT_Result *Copy_Result)
+{
+    u32 Local_Element = __BERT_ELEMENT_CYCLES(Copy_Baud);
+    u32 Local_Start;
+    Uart_Fun_Status Local_Status = Uart_OK;
+
+    if (BERT_Change(USARTx, Copy_Baud) != Uart_OK){ return Uart_ERROR; }
+    // the errors of the old rate are not counted.
+    (void)MCAL_UART_Receive_Abort(USARTx);
+    (void)MCAL_UART_Get_RX_Errors(USARTx, &Copy_Result -> Errors, Enable);
+
+    Local_Start = DWT_CYCCNT_R;
+    while (((DWT_CYCCNT_R - Local_Start) < __UART_US_TO_CYCLES(BERT_RATE_TIME_US)) && (Local_Status == Uart_OK))
+    {
+        Local_Status = BERT_Frame(USARTx, Local_Element, Copy_Result);
+    }
+    (void)MCAL_UART_Get_RX_Errors(USARTx, &Copy_Result -> Errors, Enable);
+    return Local_Status;
+}
+
+
+/// @brief  BERT_Frame  : it sends one frame to the port, waits for its Reception and compares it.
+/// @param  USARTx      : the Struct of the USART Peripheral.
+/// @param  Copy_Element_Cycles : the DWT cycles of one element.
+/// @param  Copy_Result : pointer to the result of the rate.
+/// @retval Functions Status, (Uart_TIMEOUT) if the Transmission does not end.
+static Uart_Fun_Status BERT_Frame(USART_Struct *USARTx , u32 Copy_Element_Cycles , BERT_Result *Copy_Result)
+{
+    u32 Local_Limit = (Copy_Element_Cycles * (BERT_FRAME_SIZE + BERT_GUARD_ELEMENTS)) + __UART_US_TO_CYCLES(BERT_LATENCY_US);
+    u32 Local_Start;
+    u16 Local_Received;
+    u16 Local_Index;
+    // the parity bit is not a data bit.
+    u8  Local_Mask = (__UART_SHADOW_GET(USARTx, CR1, CR1_PCE) == 1) ? 0x7FU : 0xFFU;
+    u8  Local_Diff;
+
+    BERT_voidFill(Local_Mask);
+    // the Reception starts first, as the elements come back while the frame is sent.
+    if (MCAL_UART_Receive_INT(USARTx, BERT_RX_Frame, BERT_FRAME_SIZE, BERT_FRAME_END) != Uart_OK){ return Uart_BUSY; }
+    if (MCAL_UART_Transmit_INT(USARTx, BERT_TX_Frame, BERT_FRAME_SIZE, BERT_FRAME_END) != Uart_OK)
+    {
+        (void)MCAL_UART_Receive_Abort(USARTx);
+        return Uart_BUSY;
+    }
+
+    Local_Start = DWT_CYCCNT_R;
+    while (((USARTx -> TX_Lock_Flag == BUSY) || (USARTx -> RX_Lock_Flag == BUSY)) && ((DWT_CYCCNT_R - Local_Start) < Local_Limit));
+    if (USARTx -> TX_Lock_Flag == BUSY)
+    {
+        (void)MCAL_UART_Receive_Abort(USARTx);
+        return Uart_TIMEOUT;
+    }
+    Local_Received = (u16)(USARTx -> RX_Buffer_Ptr - BERT_RX_Frame);
+    if (Local_Received < BERT_FRAME_SIZE)
+    {
+        // an error (or an inverted element equal to the frame end) ended the frame, its late elements are dropped : a
+        // late element restarts the guard, so the line is quiet before the next frame.
+        Local_Limit = (Copy_Element_Cycles * BERT_GUARD_ELEMENTS) + __UART_US_TO_CYCLES(BERT_LATENCY_US);
+        Local_Start = DWT_CYCCNT_R;
+        while ((DWT_CYCCNT_R - Local_Start) < Local_Limit)
+        {
+            if (GET_BIT(USARTx -> USART_x -> SR, __RXNE__) == 1)
+            {
+                (void)__UART_DR_READ(USARTx);
+                Local_Start = DWT_CYCCNT_R;
+            }
+        }
+    }
+    (void)MCAL_UART_Receive_Abort(USARTx);
+
+    for (Local_Index = 0; Local_Index < Local_Received; Local_Index++)
+    {
+        Local_Diff = (u8)((BERT_RX_Frame[Local_Index] ^ BERT_TX_Frame[Local_Index]) & Local_Mask);
+        while (Local_Diff != 0)
+        {
+            Copy_Result -> Bit_Errors++;
+            Local_Diff &= (u8)(Local_Diff - 1U);
+        }
+    }
+    Copy_Result -> Frames++;
+    Copy_Result -> Bits          += (u32)Local_Received * ((Local_Mask == 0x7FU) ? 7UL : 8UL);
+    Copy_Result -> Lost_Elements += BERT_FRAME_SIZE - Local_Received;
+    return Uart_OK;
+}
+
+
+/// @brief  BERT_voidFill : it fills the frame by the next PRBS-9 elements, then the frame end.
+/// @param  Copy_Mask     : the data bits of an element.
+/// @retval None.
+static void BERT_voidFill(u8 Copy_Mask)
+{
+    u16 Local_Index;
+    u8  Local_Bit;
+    u8  Local_Count;
+    u8  Local_Element;
+
+    for (Local_Index = 0; Local_Index < (BERT_FRAME_SIZE - 1U); Local_Index++)
+    {
+        Local_Element = 0;
+        for (Local_Count = 0; Local_Count < 8U; Local_Count++)
+        {
+            Local_Bit       = (u8)(((BERT_PRBS_State >> 8) ^ (BERT_PRBS_State >> 4)) & 1U);
+            BERT_PRBS_State = (u16)(((BERT_PRBS_State << 1) | Local_Bit) & BERT_PRBS_MASK);
+            Local_Element   = (u8)((Local_Element << 1) | Local_Bit);
+        }
+        Local_Element &= Copy_Mask;
+        // the frame end is not sent inside the frame.
+        if (Local_Element == BERT_FRAME_END)
+        {
+            Local_Element ^= 0x01U;
+        }
+        BERT_TX_Frame[Local_Index] = Local_Element;
+    }
+    BERT_TX_Frame[BERT_FRAME_SIZE - 1U] = BERT_FRAME_END;
+}
+
+
+/// @brief  BERT_Change : it changes the Baud rate when the port is between frames.
+/// @param  USARTx      : the Struct of the USART Peripheral.
+/// @param  Copy_Baud   : the Baud rate.
+/// @retval Functions Status.
+static Uart_Fun_Status BERT_Change(USART_Struct *USARTx , u32 Copy_Baud)
+{
+    u32 Local_Start = DWT_CYCCNT_R;
+    Uart_Fun_Status Local_Status;
+
+    do
+    {
+        Local_Status = MCAL_UART_Set_Baud(USARTx, Copy_Baud);
+    } while ((Local_Status == Uart_BUSY) && ((DWT_CYCCNT_R - Local_Start) < __UART_US_TO_CYCLES(BERT_CHANGE_US)));
+    return Local_Status;
+}
@@ -0,0 +1,125 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Bit Error Rate Test Service, it runs	*/
+/*					   on the host model of the USART driver (USART_POSIX)					*/
+/********************************************************************************************/
+/*	USART1 is tested alone through the internal loopback of the driver (the half-duplex		*/
+/*	line of the model), no line is opened for it. the test checks a clean sweep (every rate	*/
+/*	is clean, the port is given back with its Baud rate and without the loopback), then it	*/
+/*	adds the noise model of the driver to the Received elements : the measured bit error	*/
+/*	rate is the one of the model, a framing noise is counted as errors and lost elements,	*/
+/*	and the sweep stops at the first rate with an error. the rows are printed as :			*/
+/*	baud,frames,bits,bit_errors,lost,fe,clean												*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_SELF_TEST=Enable -DBERT_LATENCY_US=20000UL	*/
+/*	    -I. -IMCAL/USART																		*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c SERVICES/BERT/BERT_program.c		*/
+/*	    SERVICES/BERT/BERT_test.c -lpthread													*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "BERT_config.h"
+#include "BERT_interface.h"
+
+#if USART_POSIX == Enable
+#include <stdio.h>
+/********************************************************************************************/
+#define     TEST_OLD_BAUD           9600UL
+#define     TEST_NOISE_BAUD         115200UL
+/*	the bit error rate of the noise model, in parts per million	*/
+#define     TEST_BER_PPM            5000UL
+#define     TEST_FE_PPM             2000UL
+#define     TEST_SEED               0x2468ACEUL
+/********************************************************************************************/
+static USART_Struct     Test_Port = { .USART_x = USART1_R, .Time_Limit = 1000 };
+/********************************************************************************************/
+
+
+/// @brief  Test_Print   : it prints the results of a sweep.
+/// @param  Copy_Results : the results.
+/// @param  Copy_Count   : the number of the results.
+/// @return None.
+static void Test_Print(const BERT_Result *Copy_Results , u8 Copy_Count)
+{
+    u8 Local_Index;
+
+    for (Local_Index = 0; Local_Index < Copy_Count; Local_Index++)
+    {
+        printf("%lu,%lu,%lu,%lu,%lu,%lu,%u\n", (unsigned long)Copy_Results[Local_Index].Baud,
+               (unsigned long)Copy_Results[Local_Index].Frames, (unsigned long)Copy_Results[Local_Index].Bits,
+               (unsigned long)Copy_Results[Local_Index].Bit_Errors, (unsigned long)Copy_Results[Local_Index].Lost_Elements,
+               (unsigned long)Copy_Results[Local_Index].Errors.FE_Counter, Copy_Results[Local_Index].Clean);
+    }
+}
+
+
+int main(void)
+{
+    static const u32 Local_Rates[]       = { 9600UL, 57600UL, 115200UL, 460800UL };
+    static const u32 Local_Noise_Rates[] = { TEST_NOISE_BAUD, 230400UL };
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    USART_Noise_Model       Local_Bits      = { TEST_BER_PPM, 0, 0, TEST_SEED, 1 };
+    USART_Noise_Model       Local_Framing   = { 0, TEST_FE_PPM, 0, TEST_SEED, 1 };
+    BERT_Result Local_Results[4];
+    Uart_Fun_Status Local_Status;
+    u32 Local_Best;
+    u32 Local_BER_ppm;
+    u8  Local_Index, Local_Pass = 1;
+
+    (void)MCAL_UART_Init_(&Test_Port, &Local_Frame, &Local_Receiving, TEST_OLD_BAUD);
+    (void)MCAL_UART_Enable(&Test_Port);
+
+    // a clean line : every rate is clean, the port is given back as it was.
+    printf("baud,frames,bits,bit_errors,lost,fe,clean\n");
+    Local_Status = BERT_Sweep(&Test_Port, BERT_LOOP_INTERNAL, Local_Rates, 4, Local_Results, &Local_Best);
+    Test_Print(Local_Results, 4);
+    for (Local_Index = 0; Local_Index < 4U; Local_Index++)
+    {
+        if ((Local_Results[Local_Index].Clean == 0) || (Local_Results[Local_Index].Bits == 0)){ Local_Pass = 0; }
+    }
+    if ((Local_Status != Uart_OK) || (Local_Best != 460800UL) || (Test_Port.Baud_Rate != TEST_OLD_BAUD) ||
+        (GET_BIT(Test_Port.USART_x -> CR3, CR3_HDSEL) == 1) || (Local_Pass == 0))
+    {
+        printf("FAIL : the clean sweep (%u, best %lu)\n", Local_Status, (unsigned long)Local_Best);
+        Local_Pass = 0;
+    }
+
+    // the bit errors of the model : the measured rate is the model rate, the next rate is not tested.
+    (void)MCAL_UART_Posix_Noise(&Test_Port, &Local_Bits);
+    Local_Status = BERT_Sweep(&Test_Port, BERT_LOOP_INTERNAL, Local_Noise_Rates, 2, Local_Results, &Local_Best);
+    Test_Print(Local_Results, 2);
+    Local_BER_ppm = (Local_Results[0].Bits == 0) ? 0 :
+                    (u32)(((u64)Local_Results[0].Bit_Errors * 1000000ULL) / Local_Results[0].Bits);
+    printf("bit noise : %lu ppm measured, %lu ppm of the model\n", (unsigned long)Local_BER_ppm, (unsigned long)TEST_BER_PPM);
+    if ((Local_Status != Uart_ERROR) || (Local_Best != 0) || (Local_Results[0].Clean != 0) ||
+        (Local_BER_ppm < ((TEST_BER_PPM * 7UL) / 10UL)) || (Local_BER_ppm > ((TEST_BER_PPM * 13UL) / 10UL)) ||
+        (Local_Results[1].Frames != 0))
+    {
+        printf("FAIL : the measured bit error rate\n");
+        Local_Pass = 0;
+    }
+
+    // the framing errors end the frames, their elements are counted as lost.
+    (void)MCAL_UART_Posix_Noise(&Test_Port, &Local_Framing);
+    Local_Status = BERT_Sweep(&Test_Port, BERT_LOOP_INTERNAL, Local_Noise_Rates, 1, Local_Results, &Local_Best);
+    Test_Print(Local_Results, 1);
+    (void)MCAL_UART_Posix_Noise(&Test_Port, NULL);
+    if ((Local_Status != Uart_ERROR) || (Local_Results[0].Errors.FE_Counter == 0) || (Local_Results[0].Lost_Elements == 0) ||
+        (Local_Results[0].Bit_Errors != 0))
+    {
+        printf("FAIL : the framing errors\n");
+        Local_Pass = 0;
+    }
+    printf("%s : BERT loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,21 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Binary Logging Service 		*/
+/*											over the USART Peripheral						*/
+/********************************************************************************************/
+#ifndef		BLOG_CONFIG_H
+#define		BLOG_CONFIG_H
+
+/********************************************************************************************/
+/*	the number of the log records that can wait for their Transmission						*/
+/********************************************************************************************/
+#define BLOG_SLOTS_NUM          16U
+/********************************************************************************************/
+/*	the maximum number of the arguments of one log record									*/
+/********************************************************************************************/
+#define BLOG_MAX_ARGS           6U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,55 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Binary Logging Service 			*/
+/*											over the USART Peripheral						*/
+/********************************************************************************************/
+#ifndef		BLOG_INTERFACE_H
+#define		BLOG_INTERFACE_H
+
+/********************************************************************************************/
+/*	The format strings are not formatted nor sent by the target, they are kept in the		*/
+/*	(blog_fmt) section and only their offset in it (the format ID) and the raw arguments	*/
+/*	are sent, the host decoder (blog_decode.py) rebuilds the text from the ELF file.		*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The Logging Macros                      			        */
+/********************************************************************************************/
+/// @brief  BLOG_PRINT : logs a printf-like message, the arguments are integers, chars or BLOG_FLOAT(x),
+///                      strings (%s) are not supported as only the raw arguments are sent.
+/// @param  __FMT__    : the format string literal.
+#define     BLOG_PRINT(__FMT__, ...)    do{ static const char Local_Format[] __attribute__((section("blog_fmt"), used)) = __FMT__;   \
+                                            BLOG_voidLog(Local_Format, BLOG_NARGS(__VA_ARGS__), ##__VA_ARGS__); }while(0)
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BLOG_FLOAT : passes a float argument by its bits, it is printed by %f, %e or %g.
+#define     BLOG_FLOAT(__VALUE__)       (((union{ f32 F; u32 U; }){ .F = (f32)(__VALUE__) }).U)
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BLOG_NARGS : the number of the given arguments (up to 6).
+#define     BLOG_NARGS(...)             BLOG_NARGS_(0, ##__VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define     BLOG_NARGS_(_0, _1, _2, _3, _4, _5, _6, _N, ...)    _N
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Binary Logging Functions Prototypes           		            */
+/********************************************************************************************/
+/// @brief  BLOG_voidInit : this function selects the USART port of the log records.
+/// @param  USARTx        : the Struct of the initialized USART Peripheral.
+/// @retval None.
+void    BLOG_voidInit(USART_Struct *USARTx);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BLOG_voidLog : this function queues one log record, it is used by the BLOG_PRINT macro and it can be
+///                        called from the Interrupt context.
+/// @param  Copy_Format  : the format string in the (blog_fmt) section.
+/// @param  Copy_ArgsNum : the number of the arguments.
+/// @retval None.
+void    BLOG_voidLog(const char *Copy_Format , u8 Copy_ArgsNum , ...);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BLOG_u32GetDropped : this function gets the number of the records that were dropped as the queue was full.
+/// @retval the number of the dropped records.
+u32     BLOG_u32GetDropped(void);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
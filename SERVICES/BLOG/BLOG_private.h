@@ -0,0 +1,34 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Binary Logging Service 				*/
+/*											over the USART Peripheral						*/
+/********************************************************************************************/
+#ifndef		BLOG_PRIVATE_H
+#define		BLOG_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Log Record Format                      			    */
+/********************************************************************************************/
+/*	the record is : [sequence][format ID LSB][format ID MSB][argument varints ...],			*/
+/*	it is COBS encoded, so the only (0x00) on the wire is the record delimiter.				*/
+/********************************************************************************************/
+/*	the maximum size of a zigzag varint of 32-bit argument					*/
+#define     BLOG_VARINT_MAX         5U
+/*	the maximum size of a raw record										*/
+#define     BLOG_RAW_MAX            (3U + (BLOG_VARINT_MAX * BLOG_MAX_ARGS))
+/*	the maximum size of an encoded record with its delimiter				*/
+#define     BLOG_SLOT_SIZE          COBS_ENCODED_MAX(BLOG_RAW_MAX)
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The Log Slot State                      			        */
+/********************************************************************************************/
+#define     BLOG_SLOT_FREE          0U
+#define     BLOG_SLOT_READY         1U
+#define     BLOG_SLOT_WRITING       2U
+#define     BLOG_SLOT_SENDING       3U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,180 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Binary Logging Service 				*/
+/*											over the USART Peripheral						*/
+/********************************************************************************************/
+#include <stdarg.h>
+
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "SERVICES/COBS/COBS_interface.h"
+
+#include "BLOG_config.h"
+#include "BLOG_private.h"
+#include "BLOG_interface.h"
+/********************************************************************************************/
+static void BLOG_voidKick(void);
+static void BLOG_voidTXDone(USART_Struct *USARTx);
+static u8   BLOG_u8PutVarint(u8 *Copy_Buffer , u32 Copy_Value);
+/********************************************************************************************/
+/*	the start of the format strings section, it is defined by the linker.	*/
+extern const char __start_blog_fmt[];
+
+static USART_Struct *BLOG_Port = NULL;
+
+static u8           BLOG_Slots[BLOG_SLOTS_NUM][BLOG_SLOT_SIZE];
+static u8           BLOG_Slot_Length[BLOG_SLOTS_NUM];
+static volatile u8  BLOG_Slot_State[BLOG_SLOTS_NUM];
+static u8           BLOG_Head = 0;			/*	the next slot to be filled	*/
+static u8           BLOG_Tail = 0;			/*	the next slot to be sent	*/
+static u8           BLOG_Sequence = 0;
+static volatile u32 BLOG_Dropped = 0;
+/********************************************************************************************/
+
+
+/// @brief  BLOG_voidInit : this function selects the USART port of the log records.
+/// @param  USARTx        : the Struct of the initialized USART Peripheral.
+/// @retval None.
+void    BLOG_voidInit(USART_Struct *USARTx)
+{
+    u8 Local_Index;
+
+    for (Local_Index = 0; Local_Index < BLOG_SLOTS_NUM; Local_Index++)
+    {
+        BLOG_Slot_State[Local_Index] = BLOG_SLOT_FREE;
+    }
+    BLOG_Head    = 0;
+    BLOG_Tail    = 0;
+    BLOG_Dropped = 0;
+    BLOG_Port    = USARTx;
+    // the next record is sent when the current one ends.
+    MCAL_UART_TX_CALLBACK(USARTx, BLOG_voidTXDone);
+}
+
+
+/// @brief  BLOG_voidLog : this function queues one log record, it is used by the BLOG_PRINT macro and it can be
+///                        called from the Interrupt context.
+/// @param  Copy_Format  : the format string in the (blog_fmt) section.
+/// @param  Copy_ArgsNum : the number of the arguments.
+/// @retval None.
+void    BLOG_voidLog(const char *Copy_Format , u8 Copy_ArgsNum , ...)
+{
+    u8  Local_Raw[BLOG_RAW_MAX];
+    u8  Local_Length = 0;
+    u8  Local_Slot;
+    u32 Local_State;
+    u16 Local_ID = (u16)(Copy_Format - __start_blog_fmt);
+    va_list Local_Args;
+
+    if ((BLOG_Port == NULL) || (Copy_ArgsNum > BLOG_MAX_ARGS)){ return; }
+
+    // reserve the next slot and its sequence number.
+    __UART_ENTER_CRITICAL(Local_State);
+    Local_Slot = BLOG_Head;
+    if (BLOG_Slot_State[Local_Slot] != BLOG_SLOT_FREE)
+    {
+        BLOG_Dropped++;
+        BLOG_Sequence++;
+        __UART_EXIT_CRITICAL(Local_State);
+        return;
+    }
+    BLOG_Slot_State[Local_Slot] = BLOG_SLOT_WRITING;
+    BLOG_Head = (BLOG_Head + 1) % BLOG_SLOTS_NUM;
+    Local_Raw[Local_Length++] = BLOG_Sequence++;
+    __UART_EXIT_CRITICAL(Local_State);
+
+    // the raw record : the format ID then the zigzag varints of the arguments.
+    Local_Raw[Local_Length++] = (u8)(Local_ID);
+    Local_Raw[Local_Length++] = (u8)(Local_ID >> 8);
+    va_start(Local_Args, Copy_ArgsNum);
+    while (Copy_ArgsNum-- > 0)
+    {
+        s32 Local_Value = (s32)va_arg(Local_Args, u32);
+        Local_Length += BLOG_u8PutVarint(&Local_Raw[Local_Length], ((u32)Local_Value << 1) ^ (u32)(Local_Value >> 31));
+    }
+    va_end(Local_Args);
+
+    BLOG_Slot_Length[Local_Slot] = (u8)COBS_u16Encode(Local_Raw, Local_Length, BLOG_Slots[Local_Slot]);
+    BLOG_Slot_State[Local_Slot]  = BLOG_SLOT_READY;
+    BLOG_voidKick();
+}
+
+
+/// @brief  BLOG_u32GetDropped : this function gets the number of the records that were dropped as the queue was full.
+/// @retval the number of the dropped records.
+u32     BLOG_u32GetDropped(void)
+{
+    return BLOG_Dropped;
+}
+
+
+/// @brief  BLOG_voidKick : it starts the Transmission of the oldest record if the port is free.
+/// @retval None.
+static void BLOG_voidKick(void)
+{
+    u32 Local_State;
+    u8  Local_Slot;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    Local_Slot = BLOG_Tail;
+    if (BLOG_Slot_State[Local_Slot] == BLOG_SLOT_READY)
+    {
+        BLOG_Slot_State[Local_Slot] = BLOG_SLOT_SENDING;
+        switch (MCAL_UART_Transmit_INT(BLOG_Port, BLOG_Slots[Local_Slot], BLOG_Slot_Length[Local_Slot], COBS_DELIMITER))
+        {
+        case Uart_OK:
+            // the record is sent by the Interrupt, BLOG_voidTXDone is called at its end.
+            break;
+        case Uart_BUSY:
+            // the port is used by another Transfer, try again with the next record.
+            BLOG_Slot_State[Local_Slot] = BLOG_SLOT_READY;
+            break;
+        default:
+            // the record can not be sent.
+            BLOG_Dropped++;
+            BLOG_Slot_State[Local_Slot] = BLOG_SLOT_FREE;
+            BLOG_Tail = (BLOG_Tail + 1) % BLOG_SLOTS_NUM;
+            break;
+        }
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  BLOG_voidTXDone : it is executed by the USART Handler at the end of a record Transmission.
+/// @param  USARTx          : the Struct of the USART Peripheral.
+/// @retval None.
+static void BLOG_voidTXDone(USART_Struct *USARTx)
+{
+    if (BLOG_Slot_State[BLOG_Tail] == BLOG_SLOT_SENDING)
+    {
+        BLOG_Slot_State[BLOG_Tail] = BLOG_SLOT_FREE;
+        BLOG_Tail = (BLOG_Tail + 1) % BLOG_SLOTS_NUM;
+    }
+    BLOG_voidKick();
+}
+
+
+/// @brief  BLOG_u8PutVarint : it writes a value as a varint (7 bits per element, {LSB} first).
+/// @param  Copy_Buffer      : the location of the first element.
+/// @param  Copy_Value       : the value.
+/// @retval the number of the written elements.
+static u8   BLOG_u8PutVarint(u8 *Copy_Buffer , u32 Copy_Value)
+{
+    u8 Local_Length = 0;
+
+    while (Copy_Value >= 0x80)
+    {
+        Copy_Buffer[Local_Length++] = (u8)(Copy_Value | 0x80);
+        Copy_Value >>= 7;
+    }
+    Copy_Buffer[Local_Length++] = (u8)Copy_Value;
+    return Local_Length;
+}
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Host decoder of the Binary Logging Service (BLOG).
+
+The target sends COBS encoded records delimited by 0x00:
+    [sequence][format ID LSB][format ID MSB][zigzag varint arguments ...]
+The format ID is the offset of the format string in the (blog_fmt) section of
+the firmware ELF file, so the text is rebuilt here and never formatted on target.
+
+usage: blog_decode.py firmware.elf capture.bin
+       blog_decode.py firmware.elf /dev/ttyUSB0 --baud 115200   (needs pyserial)
+"""
+import argparse
+import re
+import struct
+import sys
+
+SECTION = "blog_fmt"
+SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diuxXoc%fFeEgG])")
+
+
+def read_section(elf_path, name):
+    """Return the bytes of the named section of a 32-bit little-endian ELF file."""
+    data = open(elf_path, "rb").read()
+    if data[:4] != b"\x7fELF" or data[4] != 1:
+        sys.exit("%s is not an ELF32 file" % elf_path)
+    shoff, = struct.unpack_from("<I", data, 0x20)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", data, 0x2E)
+    headers = [struct.unpack_from("<IIIIIIIIII", data, shoff + i * shentsize) for i in range(shnum)]
+    names = headers[shstrndx]
+    for sh in headers:
+        end = data.index(b"\0", names[4] + sh[0])
+        if data[names[4] + sh[0]:end].decode() == name:
+            return data[sh[4]:sh[4] + sh[5]]
+    sys.exit("no (%s) section in %s" % (name, elf_path))
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            raise ValueError("bad COBS code")
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def varints(data):
+    value = shift = 0
+    for byte in data:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            yield ((value >> 1) ^ -(value & 1)) & 0xFFFFFFFF
+            value = shift = 0
+    if shift:
+        raise ValueError("truncated varint")
+
+
+def render(fmt, args):
+    """printf the 32-bit raw arguments by the C format string."""
+    args = list(args)
+
+    def one(match):
+        flags, _, conv = match.groups()
+        if conv == "%":
+            return "%"
+        raw = args.pop(0)
+        if conv in "di":
+            value = raw - (1 << 32) if raw & 0x80000000 else raw
+        elif conv in "fFeEgG":
+            value = struct.unpack("<f", struct.pack("<I", raw))[0]
+        elif conv == "c":
+            value = chr(raw & 0xFF)
+        else:
+            value = raw
+        return ("%" + flags + conv.replace("u", "d")) % value
+
+    return SPEC.sub(one, fmt)
+
+
+def decode(stream, formats, out=sys.stdout):
+    expected = None
+    dropped = 0
+    for frame in stream:
+        try:
+            raw = cobs_decode(frame)
+            seq, fmt_id = raw[0], raw[1] | (raw[2] << 8)
+            end = formats.index(b"\0", fmt_id)
+            text = render(formats[fmt_id:end].decode(errors="replace"), varints(raw[3:]))
+        except (ValueError, IndexError) as error:
+            out.write("<bad record: %s>\n" % error)
+            expected = None
+            continue
+        if expected is not None and seq != expected:
+            lost = (seq - expected) & 0xFF
+            dropped += lost
+            out.write("<%d record(s) lost>\n" % lost)
+        expected = (seq + 1) & 0xFF
+        out.write(text if text.endswith("\n") else text + "\n")
+    return dropped
+
+
+def frames(source):
+    buffer = bytearray()
+    while True:
+        chunk = source.read(256)
+        if not chunk:
+            return
+        buffer += chunk
+        while b"\0" in buffer:
+            end = buffer.index(b"\0")
+            if end:
+                yield bytes(buffer[:end])
+            del buffer[:end + 1]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf")
+    parser.add_argument("input", help="a capture file or a serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    options = parser.parse_args()
+
+    formats = read_section(options.elf, SECTION)
+    if options.input.startswith("/dev/"):
+        import serial
+        source = serial.Serial(options.input, options.baud)
+    else:
+        source = open(options.input, "rb")
+    dropped = decode(frames(source), formats)
+    if dropped:
+        sys.stderr.write("%d record(s) lost\n" % dropped)
+
+
+if __name__ == "__main__":
+    main()
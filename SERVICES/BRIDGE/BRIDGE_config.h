@@ -0,0 +1,26 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Port to Port Bridge 			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BRIDGE_CONFIG_H
+#define		BRIDGE_CONFIG_H
+
+/********************************************************************************************/
+/*	the number of the frame buffers shared by all the routes								*/
+/********************************************************************************************/
+#define BRIDGE_BUFFERS_NUM      8U
+/********************************************************************************************/
+/*	the size of one frame buffer with its last element, a longer frame is dropped			*/
+/********************************************************************************************/
+#define BRIDGE_BUFFER_SIZE      64U
+/********************************************************************************************/
+/*	the maximum number of the frames waiting for one destination port, the newer frames	*/
+/*	are dropped when a slower port is full, so it does not take all the buffers				*/
+/********************************************************************************************/
+#define BRIDGE_QUEUE_LIMIT      4U
+/********************************************************************************************/
+
+#endif
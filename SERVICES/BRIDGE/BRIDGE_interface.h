@@ -0,0 +1,57 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Port to Port Bridge 				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BRIDGE_INTERFACE_H
+#define		BRIDGE_INTERFACE_H
+
+/********************************************************************************************/
+/*	A route forwards the frames Received on a source port to a destination port. The frame	*/
+/*	buffer itself is moved from the source Reception to the destination TX queue and back	*/
+/*	to the free buffers when it is sent, so the frames are never copied and the application	*/
+/*	is not involved. The ports may have different Baud rates, the TX queue of a slower		*/
+/*	port absorbs the bursts and drops the newer frames when it reaches BRIDGE_QUEUE_LIMIT.	*/
+/*	The RX callback of the source and the TX callback of the destination are claimed by the	*/
+/*	route (MCAL_UART_Claim_CALLBACKS), so a port of another service is not taken over.		*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The Bridge route statistics.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Frames;					/*	 		Number of the forwarded frames				  		  */
+	u32				 Bytes;						/*	 		Number of the forwarded elements			  		  */
+	u32				 Filtered;					/*	 		Number of the frames dropped by the filter	  		  */
+	u32				 Dropped;					/*	 Number of the dropped frames (no buffer, no queue place, TX error) */
+	u8				 Queue_Max;					/*	 		The highest depth of the destination queue	  		  */
+
+}BRIDGE_Stats;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Bridge Functions Prototypes           		            		*/
+/********************************************************************************************/
+/// @brief  BRIDGE_Add_Route : this function starts forwarding the frames of a source port to a destination port, a port
+///                            can be the source of one route and the destination of many routes.
+/// @param  Copy_Source      : the Struct of the initialized source USART Peripheral.
+/// @param  Copy_Destination : the Struct of the initialized destination USART Peripheral.
+/// @param  Copy_Last_element: the last element of the frames.
+/// @param  Copy_Filter      : NULL, or a function that is called by the Interrupt for every frame, it may change the
+///                            frame in its buffer (and its size) and it returns (1) to forward it or (0) to drop it.
+/// @retval Functions Status, (Uart_BUSY) if the route exists or a callback of the ports is owned by another service.
+Uart_Fun_Status	    BRIDGE_Add_Route(USART_Struct *Copy_Source , USART_Struct *Copy_Destination , u8 Copy_Last_element ,
+                                     u8 (*Copy_Filter)(u8 *Frame , u16 *Size));
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BRIDGE_Get_Stats : this function gets the statistics of the route of a source port.
+/// @param  Copy_Source      : the Struct of the source USART Peripheral.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    BRIDGE_Get_Stats(USART_Struct *Copy_Source , BRIDGE_Stats *Copy_Stats);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,26 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Port to Port Bridge 				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		BRIDGE_PRIVATE_H
+#define		BRIDGE_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Bridge Ports                      			        */
+/********************************************************************************************/
+/*	the USART1, USART2 and USART6 ports		*/
+#define     BRIDGE_PORTS_NUM        3U
+/*	no buffer		*/
+#define     BRIDGE_NO_BUFFER        0xFFU
+/*	no port			*/
+#define     BRIDGE_NO_PORT          0xFFU
+/********************************************************************************************/
+
+#if BRIDGE_BUFFERS_NUM >= BRIDGE_NO_BUFFER
+#error "BRIDGE_BUFFERS_NUM should be less than 255"
+#endif
+
+#endif
@@ -0,0 +1,360 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Port to Port Bridge 				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "BRIDGE_config.h"
+#include "BRIDGE_private.h"
+#include "BRIDGE_interface.h"
+/********************************************************************************************/
+/*	The port entry : the route of its Received frames and the queue of the frames it sends.	*/
+typedef struct{
+
+	USART_Struct	*Port;
+	u8				 Route_Active;
+	u8				 Destination;							/*	the destination port entry		*/
+	u8				 Last_element;
+	u8			   (*Filter)(u8 *Frame , u16 *Size);
+	u8				 RX_Buffer;								/*	the buffer of the Reception		*/
+	BRIDGE_Stats	 Stats;
+	u8				 Queue[BRIDGE_BUFFERS_NUM];				/*	the buffers waiting to be sent	*/
+	u8				 Queue_Head;
+	u8				 Queue_Count;
+	u8				 TX_Busy;
+
+}BRIDGE_Port_Entry;
+/********************************************************************************************/
+static u8   BRIDGE_u8GetEntry(USART_Struct *USARTx , u8 Copy_Create);
+static u8   BRIDGE_u8TakeBuffer(void);
+static void BRIDGE_voidRelease(u8 Copy_Source , u8 Copy_Destination);
+static void BRIDGE_voidFrameEnd(u8 Copy_Entry);
+static void BRIDGE_voidKick(u8 Copy_Entry);
+static void BRIDGE_voidTXDone(u8 Copy_Entry);
+static void BRIDGE_voidRXCallBack(USART_Struct *USARTx);
+static void BRIDGE_voidTXCallBack(USART_Struct *USARTx);
+/********************************************************************************************/
+static BRIDGE_Port_Entry BRIDGE_Ports[BRIDGE_PORTS_NUM];
+
+static u8   BRIDGE_Buffers[BRIDGE_BUFFERS_NUM][BRIDGE_BUFFER_SIZE];
+static u16  BRIDGE_Length[BRIDGE_BUFFERS_NUM];
+static u8   BRIDGE_Last_element[BRIDGE_BUFFERS_NUM];	/*	the last element of the route of the buffer	*/
+static u8   BRIDGE_Source[BRIDGE_BUFFERS_NUM];		/*	the source port entry of the buffer			*/
+/*	the free buffers stack.	*/
+static u8   BRIDGE_Free[BRIDGE_BUFFERS_NUM];
+static u8   BRIDGE_Free_Count = 0;
+static u8   BRIDGE_Pool_Ready = 0;
+/********************************************************************************************/
+
+
+/// @brief  BRIDGE_Add_Route : this function starts forwarding the frames of a source port to a destination port, a port
+///                            can be the source of one route and the destination of many routes.
+/// @param  Copy_Source      : the Struct of the initialized source USART Peripheral.
+/// @param  Copy_Destination : the Struct of the initialized destination USART Peripheral.
+/// @param  Copy_Last_element: the last element of the frames.
+/// @param  Copy_Filter      : NULL, or a function that is called by the Interrupt for every frame, it may change the
+///                            frame in its buffer (and its size) and it returns (1) to forward it or (0) to drop it.
+/// @retval Functions Status, (Uart_BUSY) if the route exists or a callback of the ports is owned by another service.
+Uart_Fun_Status	    BRIDGE_Add_Route(USART_Struct *Copy_Source , USART_Struct *Copy_Destination , u8 Copy_Last_element ,
+                                     u8 (*Copy_Filter)(u8 *Frame , u16 *Size))
+{
+    u8  Local_Index;
+    u8  Local_Source;
+    u8  Local_Destination;
+    u32 Local_State;
+    BRIDGE_Port_Entry *Local_Entry;
+    Uart_Fun_Status    Local_Status;
+
+    if ((Copy_Source == NULL) || (Copy_Destination == NULL) || (Copy_Source == Copy_Destination)){ return Uart_ERROR; }
+
+    if (BRIDGE_Pool_Ready == 0)
+    {
+        for (Local_Index = 0; Local_Index < BRIDGE_BUFFERS_NUM; Local_Index++)
+        {
+            BRIDGE_Free[Local_Index] = Local_Index;
+        }
+        BRIDGE_Free_Count = BRIDGE_BUFFERS_NUM;
+        BRIDGE_Pool_Ready = 1;
+    }
+
+    Local_Source      = BRIDGE_u8GetEntry(Copy_Source, 1);
+    Local_Destination = BRIDGE_u8GetEntry(Copy_Destination, 1);
+    if ((Local_Source == BRIDGE_NO_PORT) || (Local_Destination == BRIDGE_NO_PORT)){ return Uart_ERROR; }
+    Local_Entry = &BRIDGE_Ports[Local_Source];
+    if (Local_Entry -> Route_Active == 1){ return Uart_BUSY; }
+
+    // the frames are sent by the destination Interrupt and Received by the source Interrupt, the destination callback is
+    // shared by all its routes.
+    if (MCAL_UART_Claim_CALLBACKS(Copy_Source, NULL, BRIDGE_voidRXCallBack) != Uart_OK){ return Uart_BUSY; }
+    if (MCAL_UART_Claim_CALLBACKS(Copy_Destination, BRIDGE_voidTXCallBack, NULL) != Uart_OK)
+    {
+        (void)MCAL_UART_RX_CALLBACK(Copy_Source, NULL);
+        return Uart_BUSY;
+    }
+
+    Local_Entry -> RX_Buffer = BRIDGE_u8TakeBuffer();
+    if (Local_Entry -> RX_Buffer == BRIDGE_NO_BUFFER)
+    {
+        BRIDGE_voidRelease(Local_Source, Local_Destination);
+        return Uart_OVERSIZE;
+    }
+    Local_Entry -> Destination    = Local_Destination;
+    Local_Entry -> Last_element   = Copy_Last_element;
+    Local_Entry -> Filter         = Copy_Filter;
+    Local_Entry -> Stats.Frames    = 0;
+    Local_Entry -> Stats.Bytes     = 0;
+    Local_Entry -> Stats.Filtered  = 0;
+    Local_Entry -> Stats.Dropped   = 0;
+    Local_Entry -> Stats.Queue_Max = 0;
+    Local_Entry -> Route_Active   = 1;
+
+    // a damaged frame is dropped by the Resilient mode without ending the Reception.
+    MCAL_UART_Set_RX_Mode(Copy_Source, RX_Resilient_Mode);
+    Local_Status = MCAL_UART_Receive_INT(Copy_Source, BRIDGE_Buffers[Local_Entry -> RX_Buffer], BRIDGE_BUFFER_SIZE, Copy_Last_element);
+    if (Local_Status != Uart_OK)
+    {
+        // the route is not started, so its buffer and its callbacks are given back.
+        Local_Entry -> Route_Active = 0;
+        __UART_ENTER_CRITICAL(Local_State);
+        BRIDGE_Free[BRIDGE_Free_Count++] = Local_Entry -> RX_Buffer;
+        __UART_EXIT_CRITICAL(Local_State);
+        Local_Entry -> RX_Buffer = BRIDGE_NO_BUFFER;
+        BRIDGE_voidRelease(Local_Source, Local_Destination);
+    }
+    return Local_Status;
+}
+
+
+/// @brief  BRIDGE_Get_Stats : this function gets the statistics of the route of a source port.
+/// @param  Copy_Source      : the Struct of the source USART Peripheral.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    BRIDGE_Get_Stats(USART_Struct *Copy_Source , BRIDGE_Stats *Copy_Stats)
+{
+    u8  Local_Source = BRIDGE_u8GetEntry(Copy_Source, 0);
+    u32 Local_State;
+
+    if ((Copy_Stats == NULL) || (Local_Source == BRIDGE_NO_PORT)){ return Uart_ERROR; }
+
+    __UART_ENTER_CRITICAL(Local_State);
+    *Copy_Stats = BRIDGE_Ports[Local_Source].Stats;
+    __UART_EXIT_CRITICAL(Local_State);
+    return Uart_OK;
+}
+
+
+/// @brief  BRIDGE_u8GetEntry : it finds the entry of a port.
+/// @param  USARTx            : the Struct of the USART Peripheral.
+/// @param  Copy_Create       : (1) to use a free entry if the port has no entry.
+/// @retval the entry index, or BRIDGE_NO_PORT.
+static u8 BRIDGE_u8GetEntry(USART_Struct *USARTx , u8 Copy_Create)
+{
+    u8 Local_Index;
+
+    for (Local_Index = 0; Local_Index < BRIDGE_PORTS_NUM; Local_Index++)
+    {
+        if (BRIDGE_Ports[Local_Index].Port == USARTx){ return Local_Index; }
+    }
+    if (Copy_Create == 0){ return BRIDGE_NO_PORT; }
+    for (Local_Index = 0; Local_Index < BRIDGE_PORTS_NUM; Local_Index++)
+    {
+        if (BRIDGE_Ports[Local_Index].Port == NULL)
+        {
+            BRIDGE_Ports[Local_Index].Port         = USARTx;
+            BRIDGE_Ports[Local_Index].Route_Active = 0;
+            BRIDGE_Ports[Local_Index].Queue_Head   = 0;
+            BRIDGE_Ports[Local_Index].Queue_Count  = 0;
+            BRIDGE_Ports[Local_Index].TX_Busy      = 0;
+            return Local_Index;
+        }
+    }
+    return BRIDGE_NO_PORT;
+}
+
+
+/// @brief  BRIDGE_u8TakeBuffer : it takes a free buffer.
+/// @retval the buffer index, or BRIDGE_NO_BUFFER.
+static u8 BRIDGE_u8TakeBuffer(void)
+{
+    u8  Local_Buffer = BRIDGE_NO_BUFFER;
+    u32 Local_State;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    if (BRIDGE_Free_Count > 0)
+    {
+        Local_Buffer = BRIDGE_Free[--BRIDGE_Free_Count];
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+    return Local_Buffer;
+}
+
+
+/// @brief  BRIDGE_voidRelease : it gives back the callbacks of a route that is not started, the destination one is kept
+///                              if the port is the destination of another route.
+/// @param  Copy_Source        : the source port entry.
+/// @param  Copy_Destination   : the destination port entry.
+/// @retval None.
+static void BRIDGE_voidRelease(u8 Copy_Source , u8 Copy_Destination)
+{
+    u8 Local_Index;
+
+    (void)MCAL_UART_RX_CALLBACK(BRIDGE_Ports[Copy_Source].Port, NULL);
+    for (Local_Index = 0; Local_Index < BRIDGE_PORTS_NUM; Local_Index++)
+    {
+        if ((BRIDGE_Ports[Local_Index].Route_Active == 1) && (BRIDGE_Ports[Local_Index].Destination == Copy_Destination)){ return; }
+    }
+    (void)MCAL_UART_TX_CALLBACK(BRIDGE_Ports[Copy_Destination].Port, NULL);
+}
+
+
+/// @brief  BRIDGE_voidFrameEnd : it is executed by the source USART Handler at the end of a frame (or of a full buffer),
+///                               it moves the buffer to the destination queue and Receives into a free buffer.
+/// @param  Copy_Entry          : the source port entry.
+/// @retval None.
+static void BRIDGE_voidFrameEnd(u8 Copy_Entry)
+{
+    BRIDGE_Port_Entry *Local_Source      = &BRIDGE_Ports[Copy_Entry];
+    BRIDGE_Port_Entry *Local_Destination = &BRIDGE_Ports[Local_Source -> Destination];
+    USART_Struct      *Local_Port        = Local_Source -> Port;
+    u8   Local_Buffer = Local_Source -> RX_Buffer;
+    u8   Local_Next;
+    u16  Local_Size   = Local_Port -> RX_Buffer_Size;
+    u32  Local_State;
+
+    // the frame is forwarded with its last element, the Resilient mode drops the frames that do not fit in the buffer.
+    if ((Local_Size < BRIDGE_BUFFER_SIZE) && (BRIDGE_Buffers[Local_Buffer][Local_Size] == Local_Source -> Last_element))
+    {
+        Local_Size++;
+    }
+
+    if ((Local_Source -> Filter != NULL) && (Local_Source -> Filter(BRIDGE_Buffers[Local_Buffer], &Local_Size) == 0))
+    {
+        Local_Source -> Stats.Filtered++;
+    }
+    else if ((Local_Size == 0) || (Local_Size > BRIDGE_BUFFER_SIZE))
+    {
+        Local_Source -> Stats.Dropped++;
+    }
+    else
+    {
+        __UART_ENTER_CRITICAL(Local_State);
+        Local_Next = BRIDGE_NO_BUFFER;
+        if ((Local_Destination -> Queue_Count < BRIDGE_QUEUE_LIMIT) && (BRIDGE_Free_Count > 0))
+        {
+            Local_Next = BRIDGE_Free[--BRIDGE_Free_Count];
+        }
+        if (Local_Next != BRIDGE_NO_BUFFER)
+        {
+            // the buffer is owned by the destination queue now, the Reception goes on in the free one.
+            BRIDGE_Length[Local_Buffer]       = Local_Size;
+            BRIDGE_Last_element[Local_Buffer] = Local_Source -> Last_element;
+            BRIDGE_Source[Local_Buffer]       = Copy_Entry;
+            Local_Destination -> Queue[(Local_Destination -> Queue_Head + Local_Destination -> Queue_Count) % BRIDGE_BUFFERS_NUM] = Local_Buffer;
+            Local_Destination -> Queue_Count++;
+            if (Local_Destination -> Queue_Count > Local_Source -> Stats.Queue_Max)
+            {
+                Local_Source -> Stats.Queue_Max = Local_Destination -> Queue_Count;
+            }
+            Local_Source -> RX_Buffer = Local_Next;
+            Local_Source -> Stats.Frames++;
+            Local_Source -> Stats.Bytes += Local_Size;
+        }
+        else
+        {
+            // the destination is slower than the source, so the newer frame is dropped.
+            Local_Source -> Stats.Dropped++;
+        }
+        __UART_EXIT_CRITICAL(Local_State);
+        BRIDGE_voidKick(Local_Source -> Destination);
+    }
+    (void)MCAL_UART_Receive_INT(Local_Port, BRIDGE_Buffers[Local_Source -> RX_Buffer], BRIDGE_BUFFER_SIZE, Local_Source -> Last_element);
+}
+
+
+/// @brief  BRIDGE_voidKick : it starts the Transmission of the oldest queued buffer if the destination port is free.
+/// @param  Copy_Entry      : the destination port entry.
+/// @retval None.
+static void BRIDGE_voidKick(u8 Copy_Entry)
+{
+    BRIDGE_Port_Entry *Local_Entry = &BRIDGE_Ports[Copy_Entry];
+    u8  Local_Buffer;
+    u32 Local_State;
+    Uart_Fun_Status Local_Status;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    while ((Local_Entry -> TX_Busy == 0) && (Local_Entry -> Queue_Count > 0))
+    {
+        Local_Buffer = Local_Entry -> Queue[Local_Entry -> Queue_Head];
+        // the buffer is sent from its place, it ends by the last element of its route or by its length.
+        Local_Entry -> TX_Busy = 1;
+        Local_Status = MCAL_UART_Transmit_INT(Local_Entry -> Port, BRIDGE_Buffers[Local_Buffer], BRIDGE_Length[Local_Buffer],
+                                              BRIDGE_Last_element[Local_Buffer]);
+        if (Local_Status == Uart_OK)
+        {
+            // BRIDGE_voidTXDone is called at its end.
+            break;
+        }
+        Local_Entry -> TX_Busy = 0;
+        if (Local_Status == Uart_BUSY)
+        {
+            // the port is used by another Transfer, the queue is sent from the next frame end.
+            break;
+        }
+        // the buffer can not be sent, it is dropped from its route.
+        BRIDGE_Ports[BRIDGE_Source[Local_Buffer]].Stats.Dropped++;
+        BRIDGE_voidTXDone(Copy_Entry);
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  BRIDGE_voidTXDone : it gives the sent buffer back to the free buffers.
+/// @param  Copy_Entry        : the destination port entry.
+/// @retval None.
+static void BRIDGE_voidTXDone(u8 Copy_Entry)
+{
+    BRIDGE_Port_Entry *Local_Entry = &BRIDGE_Ports[Copy_Entry];
+    u32 Local_State;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    if (Local_Entry -> Queue_Count > 0)
+    {
+        BRIDGE_Free[BRIDGE_Free_Count++] = Local_Entry -> Queue[Local_Entry -> Queue_Head];
+        Local_Entry -> Queue_Head = (Local_Entry -> Queue_Head + 1) % BRIDGE_BUFFERS_NUM;
+        Local_Entry -> Queue_Count--;
+    }
+    Local_Entry -> TX_Busy = 0;
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  BRIDGE_voidRXCallBack : the USART RX callback of the source ports, it forwards the Received frame.
+/// @param  USARTx                : the Struct of the USART Peripheral.
+/// @retval None.
+static void BRIDGE_voidRXCallBack(USART_Struct *USARTx)
+{
+    u8 Local_Entry = BRIDGE_u8GetEntry(USARTx, 0);
+
+    if (Local_Entry != BRIDGE_NO_PORT){ BRIDGE_voidFrameEnd(Local_Entry); }
+}
+
+
+/// @brief  BRIDGE_voidTXCallBack : the USART TX callback of the destination ports, it sends the next queued buffer.
+/// @param  USARTx                : the Struct of the USART Peripheral.
+/// @retval None.
+static void BRIDGE_voidTXCallBack(USART_Struct *USARTx)
+{
+    u8 Local_Entry = BRIDGE_u8GetEntry(USARTx, 0);
+
+    if (Local_Entry == BRIDGE_NO_PORT){ return; }
+    BRIDGE_voidTXDone(Local_Entry);
+    BRIDGE_voidKick(Local_Entry);
+}
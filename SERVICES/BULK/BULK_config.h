@@ -0,0 +1,37 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Windowed Bulk Transfer 		*/
+/*											Service over the USART Peripheral				*/
+/********************************************************************************************/
+#ifndef		BULK_CONFIG_H
+#define		BULK_CONFIG_H
+
+/********************************************************************************************/
+/*	the payload size of one block															*/
+/********************************************************************************************/
+#define BULK_BLOCK_SIZE         128U
+/********************************************************************************************/
+/*	the number of the blocks that can be sent before their acknowledgement (up to 16), (1)	*/
+/*	is the stop-and-wait transfer. it can also be given to the compiler, like				*/
+/*	(-DBULK_WINDOW_SIZE=1U).																*/
+/********************************************************************************************/
+#ifndef BULK_WINDOW_SIZE
+#define BULK_WINDOW_SIZE        8U
+#endif
+/********************************************************************************************/
+/*	the number of the Received frames that can wait for the storage writing					*/
+/********************************************************************************************/
+#define BULK_RX_FRAMES          4U
+/********************************************************************************************/
+/*	the time (in micro seconds) after which an unacknowledged block is sent again			*/
+/********************************************************************************************/
+#define BULK_RETRY_TIMEOUT_US   50000UL
+/********************************************************************************************/
+/*	the maximum number of the retransmissions of one block before the transfer fails		*/
+/********************************************************************************************/
+#define BULK_MAX_RETRIES        10U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,81 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Windowed Bulk Transfer 			*/
+/*											Service over the USART Peripheral				*/
+/********************************************************************************************/
+#ifndef		BULK_INTERFACE_H
+#define		BULK_INTERFACE_H
+
+/********************************************************************************************/
+/*	The sender keeps up to BULK_WINDOW_SIZE blocks on the wire before their acknowledgement,	*/
+/*	the receiver acknowledges every block with a bitmap of the window, so only the missing	*/
+/*	blocks are sent again. The sender and the receiver can run at the same time on two 		*/
+/*	ports, this is the loopback measurement of the goodput.									*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The Bulk Transfer state.          	  		        				*/
+/********************************************************************************************/
+typedef enum
+{
+	BULK_IDLE   = 0x00U,
+	BULK_BUSY   = 0x01U,
+	BULK_DONE   = 0x02U,
+	BULK_FAILED = 0x03U
+
+}BULK_State;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The Bulk Transfer report.          	  		        				*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Payload_Bytes;				/*	 		Number of the transferred payload elements	  		  */
+	u64				 Elapsed_Cycles;			/*	 	The transfer time in DWT cycles (64 bits, no wrap)	  */
+	u32				 Goodput;					/*	 		The payload elements per second				  		  */
+	u32				 Goodput_Permille;			/*	 The goodput ratio to the raw Baud rate (10 bits per element) */
+	u32				 Sent_Blocks;				/*	 		Number of the sent blocks					  		  */
+	u32				 Resent_Blocks;				/*	 		Number of the retransmitted blocks			  		  */
+	u32				 Bad_Frames;				/*	 		Number of the frames with bad CRC or format	  		  */
+
+}BULK_Report;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Bulk Transfer Functions Prototypes           		            */
+/********************************************************************************************/
+/// @brief  BULK_Send_Start : this function starts sending a data set (e.g. a firmware image).
+/// @param  USARTx          : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Size       : the data set size.
+/// @param  Copy_Read       : the function that copies (Size) elements at (Offset) of the data set to (Buffer), it may
+///                           be called again for the same block when it is retransmitted.
+/// @retval Functions Status.
+Uart_Fun_Status	    BULK_Send_Start(USART_Struct *USARTx , u32 Copy_Size , void (*Copy_Read)(u32 Offset , u8 *Buffer , u16 Size));
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BULK_Send_Run : this function runs the sender, it is called from the main loop.
+/// @retval the sender state.
+BULK_State	        BULK_Send_Run(void);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BULK_Receive_Start : this function starts receiving a data set.
+/// @param  USARTx             : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Write         : the function that stores (Size) elements at (Offset) of the data set, the blocks may
+///                              come out of order.
+/// @retval Functions Status.
+Uart_Fun_Status	    BULK_Receive_Start(USART_Struct *USARTx , void (*Copy_Write)(u32 Offset , const u8 *Data , u16 Size));
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BULK_Receive_Run : this function runs the receiver, it is called from the main loop, the storage writing
+///                            is done here and not in the Interrupt.
+/// @retval the receiver state.
+BULK_State	        BULK_Receive_Run(void);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  BULK_Get_Report : this function gets the goodput and the retransmissions of the last (or current) sending.
+/// @param  Copy_Report     : pointer to hold the report.
+/// @retval Functions Status.
+Uart_Fun_Status	    BULK_Get_Report(BULK_Report *Copy_Report);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
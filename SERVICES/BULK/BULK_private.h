@@ -0,0 +1,81 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Windowed Bulk Transfer 				*/
+/*											Service over the USART Peripheral				*/
+/********************************************************************************************/
+#ifndef		BULK_PRIVATE_H
+#define		BULK_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Bulk Frame Format                      			    */
+/********************************************************************************************/
+/*	the raw frame is : [type][block LSB][block MSB][payload or ACK bitmap][CRC-16 LSB][MSB],	*/
+/*	it is COBS encoded, so the only (0x00) on the wire is the frame delimiter.				*/
+/********************************************************************************************/
+/*	a data block								*/
+#define     BULK_TYPE_DATA          0x01U
+/*	the last data block of the transfer			*/
+#define     BULK_TYPE_LAST          0x02U
+/*	the acknowledgement : [block] is the first missing block and the bitmap's bit (i) is	*/
+/*	the block (block + 1 + i) that is already Received.										*/
+#define     BULK_TYPE_ACK           0x03U
+
+#define     BULK_HEADER_SIZE        3U
+#define     BULK_CRC_SIZE           2U
+#define     BULK_ACK_SIZE           (BULK_HEADER_SIZE + 2U + BULK_CRC_SIZE)
+#define     BULK_RAW_MAX            (BULK_HEADER_SIZE + BULK_BLOCK_SIZE + BULK_CRC_SIZE)
+#define     BULK_FRAME_MAX          COBS_ENCODED_MAX(BULK_RAW_MAX)
+#define     BULK_ACK_FRAME_MAX      COBS_ENCODED_MAX(BULK_ACK_SIZE)
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The Timing Macros                      			        */
+/********************************************************************************************/
+/*	the DWT cycles of the retransmission timeout	*/
+#define     BULK_RETRY_CYCLES       ((u32)((FCK / 1000000UL) * BULK_RETRY_TIMEOUT_US))
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The Window Slot Flags                      			    */
+/********************************************************************************************/
+#define     BULK_SLOT_SENT          0x01U
+#define     BULK_SLOT_ACKED         0x02U
+#define     BULK_SLOT_RESEND        0x04U
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The TX Frame States                      			        */
+/********************************************************************************************/
+#define     BULK_TX_FREE            0x00U
+#define     BULK_TX_READY           0x01U
+#define     BULK_TX_SENDING         0x02U
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*                   			    The Received Frames Ring                      			    */
+/********************************************************************************************/
+/*	the Interrupt receives into the buffer (Head) while the main loop handles the buffer (Tail)	*/
+typedef struct{
+
+	USART_Struct	*Port;
+	u8				*Frames;
+	u16				 Frame_Size;
+	u8				 Frames_Num;
+	u16				 Length[BULK_RX_FRAMES];
+	volatile u8		 Head;
+	volatile u8		 Tail;
+	volatile u8		 Count;
+
+}BULK_RX_Ring;
+/********************************************************************************************/
+
+#if BULK_WINDOW_SIZE > 16
+#error "BULK_WINDOW_SIZE should not be greater than 16 (the ACK bitmap size)"
+#endif
+#if BULK_RX_FRAMES < 2
+#error "BULK_RX_FRAMES should be 2 or more"
+#endif
+
+#endif
@@ -0,0 +1,612 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Windowed Bulk Transfer 				*/
+/*											Service over the USART Peripheral				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "SERVICES/COBS/COBS_interface.h"
+
+#include "BULK_config.h"
+#include "BULK_private.h"
+#include "BULK_interface.h"
+
+#if USART_CRC != Enable
+#error "the Bulk Transfer Service needs the USART_CRC option (MCAL_UART_CRC_Block)"
+#endif
+/********************************************************************************************/
+static Uart_Fun_Status BULK_Ring_Start(BULK_RX_Ring *Copy_Ring , USART_Struct *USARTx , u8 *Copy_Frames , u16 Copy_Frame_Size , u8 Copy_Frames_Num);
+static void            BULK_Ring_FrameEnd(BULK_RX_Ring *Copy_Ring);
+static u16             BULK_Ring_Get(BULK_RX_Ring *Copy_Ring , u8 **Copy_Frame);
+static void            BULK_Ring_Release(BULK_RX_Ring *Copy_Ring);
+static u16             BULK_u16Build(u8 *Copy_Frame , u8 Copy_Type , u16 Copy_Block , const u8 *Copy_Payload , u16 Copy_Size);
+static u16             BULK_u16Check(u8 *Copy_Frame , u16 Copy_Size);
+static void            BULK_voidSenderAck(u16 Copy_Base , u16 Copy_Bitmap);
+static void            BULK_voidSenderFill(u32 Copy_Now);
+static void            BULK_voidSenderKick(void);
+static void            BULK_voidSenderTXDone(USART_Struct *USARTx);
+static void            BULK_voidSenderRXDone(USART_Struct *USARTx);
+static void            BULK_voidReceiverBlock(u8 *Copy_Raw , u16 Copy_Size);
+static void            BULK_voidReceiverAck(void);
+static void            BULK_voidReceiverTXDone(USART_Struct *USARTx);
+static void            BULK_voidReceiverRXDone(USART_Struct *USARTx);
+/********************************************************************************************/
+/*	The sender.		*/
+static USART_Struct *BULK_TX_Port = NULL;
+static void        (*BULK_Read)(u32 Offset , u8 *Buffer , u16 Size) = NULL;
+static BULK_State    BULK_Send_State = BULK_IDLE;
+static BULK_Report   BULK_Send_Report;
+static u32           BULK_Size;
+static u16           BULK_Blocks;
+static u16           BULK_Base;								/*	the oldest unacknowledged block	*/
+static u16           BULK_Next;								/*	the next new block				*/
+static u8            BULK_Slot_Flags[BULK_WINDOW_SIZE];
+static u8            BULK_Slot_Retries[BULK_WINDOW_SIZE];
+static u32           BULK_Slot_Cycle[BULK_WINDOW_SIZE];
+static u32           BULK_Last_Cycle;
+/*	two TX frames, one is sent by the Interrupt while the next one is prepared.	*/
+static u8            BULK_TX_Frames[2][BULK_FRAME_MAX];
+static u16           BULK_TX_Length[2];
+static volatile u8   BULK_TX_State[2];
+static u8            BULK_TX_Fill;
+static u8            BULK_TX_Send;
+static u8            BULK_Ack_Frames[2][BULK_ACK_FRAME_MAX];
+static BULK_RX_Ring  BULK_Ack_Ring;
+
+/*	The receiver.	*/
+static USART_Struct *BULK_RX_Port = NULL;
+static void        (*BULK_Write)(u32 Offset , const u8 *Data , u16 Size) = NULL;
+static BULK_State    BULK_Receive_State = BULK_IDLE;
+static u16           BULK_Expected;							/*	the first missing block			*/
+static u16           BULK_Received;							/*	the bit (i) is the block (BULK_Expected + 1 + i) */
+static u16           BULK_Last_Block;
+static u8            BULK_Last_Known;
+static u8            BULK_Ack_Pending;
+static volatile u8   BULK_Ack_Sending;
+static u8            BULK_Ack_TX[BULK_ACK_FRAME_MAX];
+static u8            BULK_RX_Frames[BULK_RX_FRAMES][BULK_FRAME_MAX];
+static BULK_RX_Ring  BULK_Data_Ring;
+/********************************************************************************************/
+
+
+/// @brief  BULK_Send_Start : this function starts sending a data set (e.g. a firmware image).
+/// @param  USARTx          : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Size       : the data set size.
+/// @param  Copy_Read       : the function that copies (Size) elements at (Offset) of the data set to (Buffer), it may
+///                           be called again for the same block when it is retransmitted.
+/// @retval Functions Status.
+Uart_Fun_Status	    BULK_Send_Start(USART_Struct *USARTx , u32 Copy_Size , void (*Copy_Read)(u32 Offset , u8 *Buffer , u16 Size))
+{
+    u8 Local_Index;
+
+    if ((USARTx == NULL) || (Copy_Read == NULL) || (Copy_Size == 0)){ return Uart_ERROR; }
+    // the block number is sent in two elements.
+    if (((Copy_Size + BULK_BLOCK_SIZE - 1) / BULK_BLOCK_SIZE) > 0xFFFFUL){ return Uart_OVERSIZE; }
+    if (BULK_Send_State == BULK_BUSY){ return Uart_BUSY; }
+
+    BULK_TX_Port = USARTx;
+    BULK_Read    = Copy_Read;
+    BULK_Size    = Copy_Size;
+    BULK_Blocks  = (u16)((Copy_Size + BULK_BLOCK_SIZE - 1) / BULK_BLOCK_SIZE);
+    BULK_Base    = 0;
+    BULK_Next    = 0;
+    for (Local_Index = 0; Local_Index < BULK_WINDOW_SIZE; Local_Index++)
+    {
+        BULK_Slot_Flags[Local_Index]   = 0;
+        BULK_Slot_Retries[Local_Index] = 0;
+    }
+    BULK_TX_State[0] = BULK_TX_FREE;
+    BULK_TX_State[1] = BULK_TX_FREE;
+    BULK_TX_Fill     = 0;
+    BULK_TX_Send     = 0;
+
+    BULK_Send_Report.Payload_Bytes    = 0;
+    BULK_Send_Report.Elapsed_Cycles   = 0;
+    BULK_Send_Report.Goodput          = 0;
+    BULK_Send_Report.Goodput_Permille = 0;
+    BULK_Send_Report.Sent_Blocks      = 0;
+    BULK_Send_Report.Resent_Blocks    = 0;
+    BULK_Send_Report.Bad_Frames       = 0;
+
+    __UART_DWT_ENABLE();
+    BULK_Last_Cycle = DWT_CYCCNT_R;
+
+    // the next frame is sent from the end of the current one, and the ACKs are Received while sending.
+    MCAL_UART_TX_CALLBACK(USARTx, BULK_voidSenderTXDone);
+    MCAL_UART_RX_CALLBACK(USARTx, BULK_voidSenderRXDone);
+    MCAL_UART_Set_RX_Mode(USARTx, RX_Resilient_Mode);
+    BULK_Send_State = BULK_BUSY;
+    if (BULK_Ring_Start(&BULK_Ack_Ring, USARTx, &BULK_Ack_Frames[0][0], BULK_ACK_FRAME_MAX, 2) != Uart_OK)
+    {
+        BULK_Send_State = BULK_FAILED;
+        return Uart_ERROR;
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  BULK_Send_Run : this function runs the sender, it is called from the main loop.
+/// @retval the sender state.
+BULK_State	        BULK_Send_Run(void)
+{
+    u8  *Local_Frame;
+    u16  Local_Size;
+    u16  Local_Block;
+    u8   Local_Slot;
+    u32  Local_Now;
+
+    if (BULK_Send_State != BULK_BUSY){ return BULK_Send_State; }
+
+    Local_Now = DWT_CYCCNT_R;
+    // the counter wraps after 2^32 cycles (268 s at 16 MHz), so its steps are accumulated in 64 bits.
+    BULK_Send_Report.Elapsed_Cycles += (u32)(Local_Now - BULK_Last_Cycle);
+    BULK_Last_Cycle = Local_Now;
+
+    // apply the Received ACKs.
+    while ((Local_Size = BULK_Ring_Get(&BULK_Ack_Ring, &Local_Frame)) != 0)
+    {
+        Local_Size = BULK_u16Check(Local_Frame, Local_Size);
+        if ((Local_Size == BULK_ACK_SIZE - BULK_CRC_SIZE) && (Local_Frame[0] == BULK_TYPE_ACK))
+        {
+            BULK_voidSenderAck((u16)(Local_Frame[1] | (Local_Frame[2] << 8)), (u16)(Local_Frame[3] | (Local_Frame[4] << 8)));
+        }
+        else
+        {
+            BULK_Send_Report.Bad_Frames++;
+        }
+        BULK_Ring_Release(&BULK_Ack_Ring);
+    }
+
+    if (BULK_Base == BULK_Blocks)
+    {
+        BULK_Send_Report.Payload_Bytes = BULK_Size;
+        // the integer math has no floating point (the f64 is done by software on the Cortex-M4), the product of the size
+        // and FCK is below 2^64.
+        if (BULK_Send_Report.Elapsed_Cycles != 0)
+        {
+            BULK_Send_Report.Goodput = (u32)(((u64)BULK_Size * FCK) / BULK_Send_Report.Elapsed_Cycles);
+        }
+        // the raw Baud rate carries (Baud / 10) elements per second (start + 8 data + stop bits), the goodput is below it
+        // so the product holds in 32 bits.
+        if (BULK_TX_Port -> Baud_Rate >= 10U)
+        {
+            BULK_Send_Report.Goodput_Permille = (BULK_Send_Report.Goodput * 1000U) / (BULK_TX_Port -> Baud_Rate / 10U);
+        }
+        BULK_Send_State = BULK_DONE;
+        return BULK_Send_State;
+    }
+
+    // the blocks that are not acknowledged in time are sent again.
+    for (Local_Block = BULK_Base; Local_Block != BULK_Next; Local_Block++)
+    {
+        Local_Slot = Local_Block % BULK_WINDOW_SIZE;
+        if ((BULK_Slot_Flags[Local_Slot] == BULK_SLOT_SENT) &&
+            ((Local_Now - BULK_Slot_Cycle[Local_Slot]) > BULK_RETRY_CYCLES))
+        {
+            BULK_Slot_Flags[Local_Slot] |= BULK_SLOT_RESEND;
+        }
+    }
+
+    BULK_voidSenderFill(Local_Now);
+    BULK_voidSenderKick();
+    return BULK_Send_State;
+}
+
+
+/// @brief  BULK_Receive_Start : this function starts receiving a data set.
+/// @param  USARTx             : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Write         : the function that stores (Size) elements at (Offset) of the data set, the blocks may
+///                              come out of order.
+/// @retval Functions Status.
+Uart_Fun_Status	    BULK_Receive_Start(USART_Struct *USARTx , void (*Copy_Write)(u32 Offset , const u8 *Data , u16 Size))
+{
+    if ((USARTx == NULL) || (Copy_Write == NULL)){ return Uart_ERROR; }
+    if (BULK_Receive_State == BULK_BUSY){ return Uart_BUSY; }
+
+    BULK_RX_Port     = USARTx;
+    BULK_Write       = Copy_Write;
+    BULK_Expected    = 0;
+    BULK_Received    = 0;
+    BULK_Last_Block  = 0;
+    BULK_Last_Known  = 0;
+    BULK_Ack_Pending = 0;
+    BULK_Ack_Sending = 0;
+
+    MCAL_UART_TX_CALLBACK(USARTx, BULK_voidReceiverTXDone);
+    MCAL_UART_RX_CALLBACK(USARTx, BULK_voidReceiverRXDone);
+    MCAL_UART_Set_RX_Mode(USARTx, RX_Resilient_Mode);
+    BULK_Receive_State = BULK_BUSY;
+    if (BULK_Ring_Start(&BULK_Data_Ring, USARTx, &BULK_RX_Frames[0][0], BULK_FRAME_MAX, BULK_RX_FRAMES) != Uart_OK)
+    {
+        BULK_Receive_State = BULK_FAILED;
+        return Uart_ERROR;
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  BULK_Receive_Run : this function runs the receiver, it is called from the main loop, the storage writing
+///                            is done here and not in the Interrupt.
+/// @retval the receiver state.
+BULK_State	        BULK_Receive_Run(void)
+{
+    u8  *Local_Frame;
+    u16  Local_Size;
+
+    if ((BULK_Receive_State != BULK_BUSY) && (BULK_Receive_State != BULK_DONE)){ return BULK_Receive_State; }
+
+    // the receiver keeps answering after the last block, as the last ACK may be lost.
+    while ((Local_Size = BULK_Ring_Get(&BULK_Data_Ring, &Local_Frame)) != 0)
+    {
+        Local_Size = BULK_u16Check(Local_Frame, Local_Size);
+        if ((Local_Size > BULK_HEADER_SIZE) &&
+            ((Local_Frame[0] == BULK_TYPE_DATA) || (Local_Frame[0] == BULK_TYPE_LAST)))
+        {
+            BULK_voidReceiverBlock(Local_Frame, Local_Size);
+            BULK_Ack_Pending = 1;
+        }
+        BULK_Ring_Release(&BULK_Data_Ring);
+    }
+
+    if ((BULK_Last_Known == 1) && (BULK_Expected > BULK_Last_Block))
+    {
+        BULK_Receive_State = BULK_DONE;
+    }
+    if (BULK_Ack_Pending == 1)
+    {
+        BULK_voidReceiverAck();
+    }
+    return BULK_Receive_State;
+}
+
+
+/// @brief  BULK_Get_Report : this function gets the goodput and the retransmissions of the last (or current) sending.
+/// @param  Copy_Report     : pointer to hold the report.
+/// @retval Functions Status.
+Uart_Fun_Status	    BULK_Get_Report(BULK_Report *Copy_Report)
+{
+    if (Copy_Report == NULL){ return Uart_ERROR; }
+
+    *Copy_Report = BULK_Send_Report;
+    return (BULK_Send_State == BULK_BUSY) ? Uart_BUSY : Uart_OK;
+}
+
+
+/// @brief  BULK_Ring_Start : it starts the Reception of the frames into a ring of frame buffers.
+/// @param  Copy_Ring       : the ring.
+/// @param  USARTx          : the Struct of the USART Peripheral.
+/// @param  Copy_Frames     : the frame buffers.
+/// @param  Copy_Frame_Size : the size of one frame buffer.
+/// @param  Copy_Frames_Num : the number of the frame buffers.
+/// @return Functions Status.
+static Uart_Fun_Status BULK_Ring_Start(BULK_RX_Ring *Copy_Ring , USART_Struct *USARTx , u8 *Copy_Frames , u16 Copy_Frame_Size , u8 Copy_Frames_Num)
+{
+    Copy_Ring -> Port       = USARTx;
+    Copy_Ring -> Frames     = Copy_Frames;
+    Copy_Ring -> Frame_Size = Copy_Frame_Size;
+    Copy_Ring -> Frames_Num = Copy_Frames_Num;
+    Copy_Ring -> Head       = 0;
+    Copy_Ring -> Tail       = 0;
+    Copy_Ring -> Count      = 0;
+    return MCAL_UART_Receive_INT(USARTx, Copy_Frames, Copy_Frame_Size, COBS_DELIMITER);
+}
+
+
+/// @brief  BULK_Ring_FrameEnd : it is executed by the USART Handler at the end of a frame, it queues the frame and
+///                              restarts the Reception into the next free buffer (or the same one if the ring is full).
+/// @param  Copy_Ring          : the ring.
+/// @return Nothing.
+static void BULK_Ring_FrameEnd(BULK_RX_Ring *Copy_Ring)
+{
+    USART_Struct *Local_Port = Copy_Ring -> Port;
+    u8           *Local_Frame = &Copy_Ring -> Frames[Copy_Ring -> Head * Copy_Ring -> Frame_Size];
+
+    // a frame ends by the delimiter, the Resilient mode drops the damaged ones by itself.
+    if ((Local_Port -> RX_Buffer_Size != 0) && (Local_Port -> RX_Buffer_Ptr[-1] == COBS_DELIMITER) &&
+        ((Copy_Ring -> Count + 1) < Copy_Ring -> Frames_Num))
+    {
+        Copy_Ring -> Length[Copy_Ring -> Head] = Local_Port -> RX_Buffer_Size;
+        Copy_Ring -> Head = (Copy_Ring -> Head + 1) % Copy_Ring -> Frames_Num;
+        Copy_Ring -> Count++;
+        Local_Frame = &Copy_Ring -> Frames[Copy_Ring -> Head * Copy_Ring -> Frame_Size];
+    }
+    (void)MCAL_UART_Receive_INT(Local_Port, Local_Frame, Copy_Ring -> Frame_Size, COBS_DELIMITER);
+}
+
+
+/// @brief  BULK_Ring_Get : it gets the oldest queued frame.
+/// @param  Copy_Ring     : the ring.
+/// @param  Copy_Frame    : pointer to hold the frame location.
+/// @return the frame size (without its delimiter), or (0) if there is no frame.
+static u16 BULK_Ring_Get(BULK_RX_Ring *Copy_Ring , u8 **Copy_Frame)
+{
+    if (Copy_Ring -> Count == 0){ return 0; }
+
+    *Copy_Frame = &Copy_Ring -> Frames[Copy_Ring -> Tail * Copy_Ring -> Frame_Size];
+    return Copy_Ring -> Length[Copy_Ring -> Tail];
+}
+
+
+/// @brief  BULK_Ring_Release : it frees the oldest queued frame.
+/// @param  Copy_Ring         : the ring.
+/// @return Nothing.
+static void BULK_Ring_Release(BULK_RX_Ring *Copy_Ring)
+{
+    u32 Local_State;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    Copy_Ring -> Tail = (Copy_Ring -> Tail + 1) % Copy_Ring -> Frames_Num;
+    Copy_Ring -> Count--;
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  BULK_u16Build : it builds a raw frame with its CRC then encodes it.
+/// @param  Copy_Frame    : the buffer of the encoded frame.
+/// @param  Copy_Type     : the frame type.
+/// @param  Copy_Block    : the block number.
+/// @param  Copy_Payload  : the payload.
+/// @param  Copy_Size     : the payload size.
+/// @return the encoded frame size with its delimiter.
+static u16 BULK_u16Build(u8 *Copy_Frame , u8 Copy_Type , u16 Copy_Block , const u8 *Copy_Payload , u16 Copy_Size)
+{
+    u8  Local_Raw[BULK_RAW_MAX];
+    u16 Local_Length = 0;
+    u16 Local_CRC;
+
+    Local_Raw[Local_Length++] = Copy_Type;
+    Local_Raw[Local_Length++] = (u8)(Copy_Block);
+    Local_Raw[Local_Length++] = (u8)(Copy_Block >> 8);
+    while (Copy_Size-- > 0)
+    {
+        Local_Raw[Local_Length++] = *Copy_Payload++;
+    }
+    Local_CRC = (u16)MCAL_UART_CRC_Block(Uart_CRC_16, Local_Raw, Local_Length);
+    Local_Raw[Local_Length++] = (u8)(Local_CRC);
+    Local_Raw[Local_Length++] = (u8)(Local_CRC >> 8);
+    return COBS_u16Encode(Local_Raw, Local_Length, Copy_Frame);
+}
+
+
+/// @brief  BULK_u16Check : it decodes a Received frame in place and checks its CRC.
+/// @param  Copy_Frame    : the Received frame (without its delimiter).
+/// @param  Copy_Size     : the Received frame size.
+/// @return the raw frame size without the CRC, or (0) if the frame is not valid.
+static u16 BULK_u16Check(u8 *Copy_Frame , u16 Copy_Size)
+{
+    u16 Local_Size = COBS_u16Decode(Copy_Frame, Copy_Size, Copy_Frame);
+
+    if (Local_Size < (BULK_HEADER_SIZE + BULK_CRC_SIZE)){ return 0; }
+    Local_Size -= BULK_CRC_SIZE;
+    if ((u16)MCAL_UART_CRC_Block(Uart_CRC_16, Copy_Frame, Local_Size) !=
+        (u16)(Copy_Frame[Local_Size] | (Copy_Frame[Local_Size + 1] << 8)))
+    {
+        return 0;
+    }
+    return Local_Size;
+}
+
+
+/// @brief  BULK_voidSenderAck : it applies an ACK to the window and slides it.
+/// @param  Copy_Base          : the first block that is missing at the receiver.
+/// @param  Copy_Bitmap        : the blocks after (Copy_Base) that are already Received.
+/// @return Nothing.
+static void BULK_voidSenderAck(u16 Copy_Base , u16 Copy_Bitmap)
+{
+    u16 Local_Block;
+    u16 Local_Highest = Copy_Base;
+    u8  Local_Bit;
+    u8  Local_Slot;
+
+    // an ACK of a block that is not sent yet is a stale or a wrong one.
+    if ((u16)(Copy_Base - BULK_Base) > (u16)(BULK_Next - BULK_Base)){ return; }
+
+    while (BULK_Base != Copy_Base)
+    {
+        BULK_Slot_Flags[BULK_Base % BULK_WINDOW_SIZE]   = 0;
+        BULK_Slot_Retries[BULK_Base % BULK_WINDOW_SIZE] = 0;
+        BULK_Base++;
+    }
+    for (Local_Bit = 0; Local_Bit < (BULK_WINDOW_SIZE - 1); Local_Bit++)
+    {
+        Local_Block = Copy_Base + 1 + Local_Bit;
+        if ((GET_BIT(Copy_Bitmap, Local_Bit) == 1) && ((u16)(Local_Block - BULK_Base) < (u16)(BULK_Next - BULK_Base)))
+        {
+            BULK_Slot_Flags[Local_Block % BULK_WINDOW_SIZE] |= BULK_SLOT_ACKED;
+            Local_Highest = Local_Block;
+        }
+    }
+    // a missing block that was sent before a Received one is lost, so it is sent again without waiting the timeout.
+    for (Local_Block = BULK_Base; Local_Block != Local_Highest; Local_Block++)
+    {
+        Local_Slot = Local_Block % BULK_WINDOW_SIZE;
+        if ((BULK_Slot_Flags[Local_Slot] == BULK_SLOT_SENT) &&
+            ((s32)(BULK_Slot_Cycle[Local_Highest % BULK_WINDOW_SIZE] - BULK_Slot_Cycle[Local_Slot]) > 0))
+        {
+            BULK_Slot_Flags[Local_Slot] |= BULK_SLOT_RESEND;
+        }
+    }
+}
+
+
+/// @brief  BULK_voidSenderFill : it prepares the next frames in the free TX frames, the lost blocks first.
+/// @param  Copy_Now            : the current DWT cycle.
+/// @return Nothing.
+static void BULK_voidSenderFill(u32 Copy_Now)
+{
+    u8  Local_Payload[BULK_BLOCK_SIZE];
+    u16 Local_Block;
+    u16 Local_Size;
+    u8  Local_Slot;
+    u8  Local_Found;
+
+    while (BULK_TX_State[BULK_TX_Fill] == BULK_TX_FREE)
+    {
+        Local_Found = 0;
+        for (Local_Block = BULK_Base; Local_Block != BULK_Next; Local_Block++)
+        {
+            Local_Slot = Local_Block % BULK_WINDOW_SIZE;
+            if ((BULK_Slot_Flags[Local_Slot] & BULK_SLOT_RESEND) != 0)
+            {
+                if (BULK_Slot_Retries[Local_Slot] >= BULK_MAX_RETRIES)
+                {
+                    BULK_Send_State = BULK_FAILED;
+                    return;
+                }
+                BULK_Slot_Retries[Local_Slot]++;
+                BULK_Send_Report.Resent_Blocks++;
+                Local_Found = 1;
+                break;
+            }
+        }
+        if (Local_Found == 0)
+        {
+            // a new block, only inside the window.
+            if ((BULK_Next == BULK_Blocks) || ((u16)(BULK_Next - BULK_Base) >= BULK_WINDOW_SIZE)){ return; }
+            Local_Block = BULK_Next++;
+            Local_Slot  = Local_Block % BULK_WINDOW_SIZE;
+            BULK_Slot_Retries[Local_Slot] = 0;
+        }
+
+        Local_Size = (Local_Block == (u16)(BULK_Blocks - 1)) ? (u16)(BULK_Size - ((u32)Local_Block * BULK_BLOCK_SIZE))
+                                                             : BULK_BLOCK_SIZE;
+        BULK_Read((u32)Local_Block * BULK_BLOCK_SIZE, Local_Payload, Local_Size);
+        BULK_TX_Length[BULK_TX_Fill] = BULK_u16Build(BULK_TX_Frames[BULK_TX_Fill],
+                                                     (Local_Block == (u16)(BULK_Blocks - 1)) ? BULK_TYPE_LAST : BULK_TYPE_DATA,
+                                                     Local_Block, Local_Payload, Local_Size);
+        BULK_Slot_Flags[Local_Slot] = BULK_SLOT_SENT;
+        BULK_Slot_Cycle[Local_Slot] = Copy_Now;
+        BULK_Send_Report.Sent_Blocks++;
+
+        BULK_TX_State[BULK_TX_Fill] = BULK_TX_READY;
+        BULK_TX_Fill ^= 1;
+    }
+}
+
+
+/// @brief  BULK_voidSenderKick : it starts the Transmission of the next prepared frame if the port is free.
+/// @return Nothing.
+static void BULK_voidSenderKick(void)
+{
+    u32 Local_State;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    if (BULK_TX_State[BULK_TX_Send] == BULK_TX_READY)
+    {
+        BULK_TX_State[BULK_TX_Send] = BULK_TX_SENDING;
+        if (MCAL_UART_Transmit_INT(BULK_TX_Port, BULK_TX_Frames[BULK_TX_Send], BULK_TX_Length[BULK_TX_Send], COBS_DELIMITER) != Uart_OK)
+        {
+            // the port is busy, try again from the next run.
+            BULK_TX_State[BULK_TX_Send] = BULK_TX_READY;
+        }
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  BULK_voidSenderTXDone : it is executed by the USART Handler at the end of a frame Transmission, it starts
+///                                 the next prepared frame at once, so the line stays busy.
+/// @param  USARTx                : the Struct of the USART Peripheral.
+/// @return Nothing.
+static void BULK_voidSenderTXDone(USART_Struct *USARTx)
+{
+    if (BULK_TX_State[BULK_TX_Send] == BULK_TX_SENDING)
+    {
+        BULK_TX_State[BULK_TX_Send] = BULK_TX_FREE;
+        BULK_TX_Send ^= 1;
+    }
+    BULK_voidSenderKick();
+}
+
+
+/// @brief  BULK_voidSenderRXDone : it is executed by the USART Handler at the end of an ACK Reception.
+/// @param  USARTx                : the Struct of the USART Peripheral.
+/// @return Nothing.
+static void BULK_voidSenderRXDone(USART_Struct *USARTx)
+{
+    BULK_Ring_FrameEnd(&BULK_Ack_Ring);
+}
+
+
+/// @brief  BULK_voidReceiverBlock : it stores a Received block and slides the receiver window.
+/// @param  Copy_Raw               : the raw frame without its CRC.
+/// @param  Copy_Size              : the raw frame size.
+/// @return Nothing.
+static void BULK_voidReceiverBlock(u8 *Copy_Raw , u16 Copy_Size)
+{
+    u16 Local_Block  = (u16)(Copy_Raw[1] | (Copy_Raw[2] << 8));
+    u16 Local_Offset = (u16)(Local_Block - BULK_Expected);
+
+    if (Copy_Raw[0] == BULK_TYPE_LAST)
+    {
+        BULK_Last_Block = Local_Block;
+        BULK_Last_Known = 1;
+    }
+    // the sender never goes beyond its window, so an older block is a retransmission of an acknowledged one.
+    if (Local_Offset >= BULK_WINDOW_SIZE){ return; }
+    if ((Local_Offset != 0) && (GET_BIT(BULK_Received, Local_Offset - 1) == 1)){ return; }
+
+    BULK_Write((u32)Local_Block * BULK_BLOCK_SIZE, &Copy_Raw[BULK_HEADER_SIZE], Copy_Size - BULK_HEADER_SIZE);
+    if (Local_Offset != 0)
+    {
+        SET_BIT(BULK_Received, Local_Offset - 1);
+        return;
+    }
+    // the first missing block is Received, move to the next missing one.
+    BULK_Expected++;
+    while (GET_BIT(BULK_Received, 0) == 1)
+    {
+        BULK_Received >>= 1;
+        BULK_Expected++;
+    }
+    BULK_Received >>= 1;
+}
+
+
+/// @brief  BULK_voidReceiverAck : it sends the ACK of the current receiver window if the port is free.
+/// @return Nothing.
+static void BULK_voidReceiverAck(void)
+{
+    u16 Local_Length;
+    u8  Local_Bitmap[2];
+
+    if (BULK_Ack_Sending == 1){ return; }
+
+    Local_Bitmap[0] = (u8)(BULK_Received);
+    Local_Bitmap[1] = (u8)(BULK_Received >> 8);
+    Local_Length    = BULK_u16Build(BULK_Ack_TX, BULK_TYPE_ACK, BULK_Expected, Local_Bitmap, 2);
+    BULK_Ack_Sending = 1;
+    if (MCAL_UART_Transmit_INT(BULK_RX_Port, BULK_Ack_TX, Local_Length, COBS_DELIMITER) == Uart_OK)
+    {
+        BULK_Ack_Pending = 0;
+    }
+    else
+    {
+        BULK_Ack_Sending = 0;
+    }
+}
+
+
+/// @brief  BULK_voidReceiverTXDone : it is executed by the USART Handler at the end of an ACK Transmission.
+/// @param  USARTx                  : the Struct of the USART Peripheral.
+/// @return Nothing.
+static void BULK_voidReceiverTXDone(USART_Struct *USARTx)
+{
+    BULK_Ack_Sending = 0;
+}
+
+
+/// @brief  BULK_voidReceiverRXDone : it is executed by the USART Handler at the end of a data frame Reception.
+/// @param  USARTx                  : the Struct of the USART Peripheral.
+/// @return Nothing.
+static void BULK_voidReceiverRXDone(USART_Struct *USARTx)
+{
+    BULK_Ring_FrameEnd(&BULK_Data_Ring);
+}
@@ -0,0 +1,169 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test and goodput bench of the Windowed Bulk		*/
+/*					   Transfer, it runs on the host model of the USART driver (USART_POSIX)	*/
+/********************************************************************************************/
+/*	USART1 sends a data set to USART2 over a pseudo-terminal pair, on a clean line and on a	*/
+/*	noisy one (bit errors on the data of the receiver). the test checks that the data set	*/
+/*	arrives in one piece, and prints the goodput of every run as a CSV row :				*/
+/*	window,block,baud,bit_error_ppm,bytes,goodput,goodput_permille,limit_permille,			*/
+/*	sent_blocks,resent_blocks,bad_frames													*/
+/*	limit_permille is the goodput of a full line (the frame overhead only). the windowed	*/
+/*	transfer is compared with the stop-and-wait one by a second build with					*/
+/*	-DBULK_WINDOW_SIZE=1U.																	*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -O2 -DUSART_POSIX=Enable -DUSART_CRC=Enable -I. -IMCAL/USART				*/
+/*	    -ISERVICES/BULK MCAL/USART/USART_program.c MCAL/USART/USART_posix.c					*/
+/*	    SERVICES/COBS/COBS_program.c SERVICES/BULK/BULK_program.c SERVICES/BULK/BULK_test.c	*/
+/*	    -lpthread																			*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "SERVICES/COBS/COBS_interface.h"
+
+#include "BULK_config.h"
+#include "BULK_private.h"
+#include "BULK_interface.h"
+
+#if USART_POSIX == Enable
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_DATA_SIZE          8192U
+#define     TEST_BAUD               115200UL
+/*	the longest time of one run, in main loop periods (100 us)	*/
+#define     TEST_LOOPS              300000UL
+/********************************************************************************************/
+static USART_Struct     Test_Sender;
+static USART_Struct     Test_Receiver;
+static u8               Test_Source[TEST_DATA_SIZE];
+static u8               Test_Sink[TEST_DATA_SIZE];
+/********************************************************************************************/
+
+
+/// @brief  Test_Read    : it copies the elements of the data set for the sender.
+/// @return None.
+static void Test_Read(u32 Copy_Offset , u8 *Copy_Buffer , u16 Copy_Size)
+{
+    memcpy(Copy_Buffer, &Test_Source[Copy_Offset], Copy_Size);
+}
+
+
+/// @brief  Test_Write   : it stores the elements of the data set from the receiver.
+/// @return None.
+static void Test_Write(u32 Copy_Offset , const u8 *Copy_Data , u16 Copy_Size)
+{
+    if ((Copy_Offset + Copy_Size) <= TEST_DATA_SIZE)
+    {
+        memcpy(&Test_Sink[Copy_Offset], Copy_Data, Copy_Size);
+    }
+}
+
+
+/// @brief  Test_Open    : it opens and initializes a new line, so every run starts with idle ports.
+/// @return (1) if the line is ready, (0) if not.
+static u8 Test_Open(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    char Local_Name[64];
+
+    memset(&Test_Sender,   0, sizeof(Test_Sender));
+    memset(&Test_Receiver, 0, sizeof(Test_Receiver));
+    Test_Sender.USART_x      = USART1_R;
+    Test_Sender.Time_Limit   = 1000;
+    Test_Receiver.USART_x    = USART2_R;
+    Test_Receiver.Time_Limit = 1000;
+    if ((MCAL_UART_Posix_Pty(&Test_Sender, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_Receiver, Local_Name) != Uart_OK))
+    {
+        return 0;
+    }
+    (void)MCAL_UART_Init_(&Test_Sender,   &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_Receiver, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_Sender);
+    (void)MCAL_UART_Enable(&Test_Receiver);
+    return 1;
+}
+
+
+/// @brief  Test_Run     : it sends the data set once and prints its row.
+/// @param  Copy_ppm     : the bit error rate of the receiver line, in parts per million.
+/// @param  Copy_Report  : pointer to hold the report of the sender.
+/// @return (1) if the data set arrives in one piece, (0) if not.
+static u8 Test_Run(u32 Copy_ppm , BULK_Report *Copy_Report)
+{
+    USART_Noise_Model Local_Noise = { Copy_ppm, 0, 0, 0x1234U, 1 };
+    struct timespec Local_Pause = { 0, 100000L };
+    BULK_State Local_Send = BULK_BUSY, Local_Receive = BULK_BUSY;
+    u32 Local_Loop;
+    u8  Local_Intact;
+
+    if (Test_Open() == 0){ printf("FAIL : no pseudo-terminal\n"); return 0; }
+    if (Copy_ppm != 0){ (void)MCAL_UART_Posix_Noise(&Test_Receiver, &Local_Noise); }
+    memset(Test_Sink, 0, sizeof(Test_Sink));
+    if ((BULK_Receive_Start(&Test_Receiver, Test_Write) != Uart_OK) ||
+        (BULK_Send_Start(&Test_Sender, TEST_DATA_SIZE, Test_Read) != Uart_OK))
+    {
+        printf("FAIL : the transfer does not start\n");
+        return 0;
+    }
+    for (Local_Loop = 0; (Local_Loop < TEST_LOOPS) && ((Local_Send == BULK_BUSY) || (Local_Receive == BULK_BUSY)); Local_Loop++)
+    {
+        Local_Send    = BULK_Send_Run();
+        Local_Receive = BULK_Receive_Run();
+        nanosleep(&Local_Pause, NULL);
+    }
+    (void)BULK_Get_Report(Copy_Report);
+    Local_Intact = (Local_Send == BULK_DONE) && (Local_Receive == BULK_DONE) &&
+                   (memcmp(Test_Source, Test_Sink, TEST_DATA_SIZE) == 0);
+    // one block frame is its COBS encoding and its delimiter.
+    printf("%u,%u,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", BULK_WINDOW_SIZE, BULK_BLOCK_SIZE, (unsigned long)TEST_BAUD,
+           (unsigned long)Copy_ppm, (unsigned long)Copy_Report -> Payload_Bytes, (unsigned long)Copy_Report -> Goodput,
+           (unsigned long)Copy_Report -> Goodput_Permille, (unsigned long)((BULK_BLOCK_SIZE * 1000UL) / (BULK_FRAME_MAX + 1UL)),
+           (unsigned long)Copy_Report -> Sent_Blocks, (unsigned long)Copy_Report -> Resent_Blocks,
+           (unsigned long)Copy_Report -> Bad_Frames);
+    (void)MCAL_UART_Posix_Close(&Test_Receiver);
+    (void)MCAL_UART_Posix_Close(&Test_Sender);
+    if (Local_Intact == 0)
+    {
+        printf("FAIL : the data set is not received in one piece (sender %u, receiver %u)\n", Local_Send, Local_Receive);
+    }
+    return Local_Intact;
+}
+
+
+int main(void)
+{
+    BULK_Report Local_Clean, Local_Noisy;
+    u32 Local_Seed = 0x2545F491UL;
+    u16 Local_Index;
+    u8  Local_Pass = 1;
+
+    for (Local_Index = 0; Local_Index < TEST_DATA_SIZE; Local_Index++)
+    {
+        Local_Seed = (Local_Seed * 1664525UL) + 1013904223UL;
+        Test_Source[Local_Index] = (u8)(Local_Seed >> 24);
+    }
+    printf("window,block,baud,bit_error_ppm,bytes,goodput,goodput_permille,limit_permille,sent_blocks,resent_blocks,bad_frames\n");
+    Local_Pass &= Test_Run(0, &Local_Clean);
+    Local_Pass &= Test_Run(20, &Local_Noisy);
+    // a clean line has no retransmission, and the goodput is at least the half of the raw Baud rate.
+    if ((Local_Clean.Resent_Blocks != 0) || (Local_Clean.Bad_Frames != 0) || (Local_Clean.Goodput_Permille < 500U))
+    {
+        printf("FAIL : the clean line goodput\n");
+        Local_Pass = 0;
+    }
+    printf("%s : BULK loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
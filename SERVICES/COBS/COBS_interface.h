@@ -0,0 +1,41 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the COBS frame encoding Service,		*/
+/*					   it removes the (0x00) from a frame so it can be the frame delimiter	*/
+/*					   (the Last_element of the USART Transfers)							*/
+/********************************************************************************************/
+#ifndef		COBS_INTERFACE_H
+#define		COBS_INTERFACE_H
+
+/********************************************************************************************/
+/*	the frame delimiter, it is the only (0x00) on the wire									*/
+/********************************************************************************************/
+#define     COBS_DELIMITER              0x00U
+/********************************************************************************************/
+/*	the maximum size of an encoded frame with its delimiter for a given raw frame size		*/
+/********************************************************************************************/
+#define     COBS_ENCODED_MAX(__SIZE__)  ((__SIZE__) + ((__SIZE__) / 254U) + 2U)
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The COBS Functions Prototypes           		            		*/
+/********************************************************************************************/
+/// @brief  COBS_u16Encode : this function encodes a raw frame and adds the delimiter at its end.
+/// @param  Copy_Raw       : the raw frame.
+/// @param  Copy_Size      : the raw frame size.
+/// @param  Copy_Encoded   : the buffer of the encoded frame, COBS_ENCODED_MAX(Copy_Size) elements.
+/// @retval the encoded frame size with its delimiter.
+u16     COBS_u16Encode(const u8 *Copy_Raw , u16 Copy_Size , u8 *Copy_Encoded);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  COBS_u16Decode : this function decodes an encoded frame (without its delimiter), it can decode in place.
+/// @param  Copy_Encoded   : the encoded frame.
+/// @param  Copy_Size      : the encoded frame size.
+/// @param  Copy_Raw       : the buffer of the raw frame, Copy_Size elements.
+/// @retval the raw frame size, or (0) if the frame is not a valid COBS frame.
+u16     COBS_u16Decode(const u8 *Copy_Encoded , u16 Copy_Size , u8 *Copy_Raw);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,82 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the COBS frame encoding Service			*/
+/********************************************************************************************/
+#include "LIB/STD_Types.h"
+
+#include "COBS_interface.h"
+/********************************************************************************************/
+
+
+/// @brief  COBS_u16Encode : this function encodes a raw frame and adds the delimiter at its end.
+/// @param  Copy_Raw       : the raw frame.
+/// @param  Copy_Size      : the raw frame size.
+/// @param  Copy_Encoded   : the buffer of the encoded frame, COBS_ENCODED_MAX(Copy_Size) elements.
+/// @retval the encoded frame size with its delimiter.
+u16     COBS_u16Encode(const u8 *Copy_Raw , u16 Copy_Size , u8 *Copy_Encoded)
+{
+    u16 Local_Code_Index = 0;
+    u16 Local_Out = 1;
+    u8  Local_Code = 1;
+
+    while (Copy_Size-- > 0)
+    {
+        if (*Copy_Raw == COBS_DELIMITER)
+        {
+            // the code is the distance to the next zero.
+            Copy_Encoded[Local_Code_Index] = Local_Code;
+            Local_Code_Index = Local_Out++;
+            Local_Code = 1;
+        }
+        else
+        {
+            Copy_Encoded[Local_Out++] = *Copy_Raw;
+            // a full block of 254 non-zero elements has its own code without a zero.
+            if (++Local_Code == 0xFF)
+            {
+                Copy_Encoded[Local_Code_Index] = Local_Code;
+                Local_Code_Index = Local_Out++;
+                Local_Code = 1;
+            }
+        }
+        Copy_Raw++;
+    }
+    Copy_Encoded[Local_Code_Index] = Local_Code;
+    Copy_Encoded[Local_Out++] = COBS_DELIMITER;
+    return Local_Out;
+}
+
+
+/// @brief  COBS_u16Decode : this function decodes an encoded frame (without its delimiter), it can decode in place.
+/// @param  Copy_Encoded   : the encoded frame.
+/// @param  Copy_Size      : the encoded frame size.
+/// @param  Copy_Raw       : the buffer of the raw frame, Copy_Size elements.
+/// @retval the raw frame size, or (0) if the frame is not a valid COBS frame.
+u16     COBS_u16Decode(const u8 *Copy_Encoded , u16 Copy_Size , u8 *Copy_Raw)
+{
+    u16 Local_In  = 0;
+    u16 Local_Out = 0;
+
+    while (Local_In < Copy_Size)
+    {
+        u8 Local_Code = Copy_Encoded[Local_In++];
+        u8 Local_Index;
+
+        if ((Local_Code == 0) || ((Local_In + Local_Code - 1) > Copy_Size))
+        {
+            return 0;
+        }
+        for (Local_Index = 1; Local_Index < Local_Code; Local_Index++)
+        {
+            Copy_Raw[Local_Out++] = Copy_Encoded[Local_In++];
+        }
+        // every code except the last one and the full blocks stands for a zero.
+        if ((Local_Code != 0xFF) && (Local_In < Copy_Size))
+        {
+            Copy_Raw[Local_Out++] = COBS_DELIMITER;
+        }
+    }
+    return Local_Out;
+}
@@ -0,0 +1,27 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Line Reader Service 			*/
+/*											of the USART Reception							*/
+/********************************************************************************************/
+#ifndef		LINE_CONFIG_H
+#define		LINE_CONFIG_H
+
+/********************************************************************************************/
+/*	the number of the line buffers, one of them is always used by the Reception			*/
+/********************************************************************************************/
+#define LINE_SLOTS              4U
+/********************************************************************************************/
+/*	the maximum line length with its end elements (NMEA : 82), a longer line is dropped		*/
+/*	and the Reception continues from the next line											*/
+/********************************************************************************************/
+#define LINE_MAX                96U
+/********************************************************************************************/
+/*	the element that ends the Reception of a line : ('\n') for the "\r\n" and "\n" lines,	*/
+/*	or ('\r') for the "\r" and "\r\n" lines, the other one is removed from the line ends	*/
+/********************************************************************************************/
+#define LINE_END                '\n'
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,67 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Line Reader Service 				*/
+/*											of the USART Reception							*/
+/********************************************************************************************/
+#ifndef		LINE_INTERFACE_H
+#define		LINE_INTERFACE_H
+
+/********************************************************************************************/
+/*	The lines of a text protocol (AT commands, NMEA) are assembled by the USART Interrupt	*/
+/*	in a ring of line buffers. A completed line is given to the application in its buffer	*/
+/*	(without its CR / LF ends and with a NULL after it), so it is not copied, and the		*/
+/*	Reception goes on in the next buffer. The Resilient mode drops the lines that are		*/
+/*	longer than LINE_MAX or damaged, and the Reception continues from the next line end.	*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The Received line view.          	  		        				*/
+/********************************************************************************************/
+typedef struct{
+
+	const u8		*Text;						/*	 		The line elements followed by a NULL		  		  */
+	u16				 Length;					/*	 		Number of the line elements					  		  */
+
+}LINE_View;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The Line Reader statistics.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Lines;						/*	 		Number of the Received lines				  		  */
+	u32				 Empty;						/*	 		Number of the skipped empty lines			  		  */
+	u32				 Dropped;					/*	 Number of the lines dropped as all the buffers are waiting	  */
+	u32				 Damaged;					/*	 Number of the damaged or too long lines (the port counter)	  */
+
+}LINE_Stats;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Line Reader Functions Prototypes           		            	*/
+/********************************************************************************************/
+/// @brief  LINE_Start : this function starts the line Reception of a port, it uses the RX callback of the port.
+/// @param  USARTx     : the Struct of the initialized USART Peripheral.
+/// @retval Functions Status.
+Uart_Fun_Status	    LINE_Start(USART_Struct *USARTx);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LINE_Get : this function gives the oldest Received line, it stays in its buffer till LINE_Release.
+/// @param  Copy_View: pointer to hold the line view.
+/// @retval Functions Status, (Uart_BUSY) if there is no line.
+Uart_Fun_Status	    LINE_Get(LINE_View *Copy_View);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LINE_Release : this function gives the buffer of the oldest line back to the Reception.
+/// @retval Functions Status, (Uart_ERROR) if there is no line.
+Uart_Fun_Status	    LINE_Release(void);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LINE_Get_Stats : this function gets the Line Reader statistics.
+/// @param  Copy_Stats     : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    LINE_Get_Stats(LINE_Stats *Copy_Stats);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
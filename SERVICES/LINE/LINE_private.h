@@ -0,0 +1,23 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Line Reader Service 				*/
+/*											of the USART Reception							*/
+/********************************************************************************************/
+#ifndef		LINE_PRIVATE_H
+#define		LINE_PRIVATE_H
+
+/********************************************************************************************/
+/*	the ring has one more buffer than the waiting lines, it is the Reception buffer.		*/
+#define     LINE_RING_SIZE          (LINE_SLOTS + 1U)
+
+///@brief  Check the end elements (CR) and (LF) of a line.
+#define     __LINE_IS_END(__ELEMENT__)      (((__ELEMENT__) == '\r') || ((__ELEMENT__) == '\n'))
+/********************************************************************************************/
+
+#if (LINE_SLOTS == 0) || (LINE_MAX < 2)
+#error "the Line Reader needs one line buffer of two elements at least"
+#endif
+
+#endif
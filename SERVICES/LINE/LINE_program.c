@@ -0,0 +1,136 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Line Reader Service 				*/
+/*											of the USART Reception							*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "LINE_config.h"
+#include "LINE_private.h"
+#include "LINE_interface.h"
+/********************************************************************************************/
+static void LINE_voidLineEnd(USART_Struct *USARTx);
+/********************************************************************************************/
+static USART_Struct *LINE_Port = NULL;
+
+/*	the line buffers, (LINE_In) is the Reception buffer and the lines from (LINE_Out) to	*/
+/*	it are waiting, the Interrupt only writes (LINE_In) and the application (LINE_Out).		*/
+static u8           LINE_Ring[LINE_RING_SIZE][LINE_MAX];
+static u16          LINE_First[LINE_RING_SIZE];		/*	the index of the first line element	*/
+static u16          LINE_Length[LINE_RING_SIZE];
+static volatile u8  LINE_In  = 0;
+static volatile u8  LINE_Out = 0;
+static LINE_Stats   LINE_Statistics;
+/********************************************************************************************/
+
+
+/// @brief  LINE_Start : this function starts the line Reception of a port, it uses the RX callback of the port.
+/// @param  USARTx     : the Struct of the initialized USART Peripheral.
+/// @retval Functions Status.
+Uart_Fun_Status	    LINE_Start(USART_Struct *USARTx)
+{
+    if (USARTx == NULL){ return Uart_ERROR; }
+
+    LINE_Port = USARTx;
+    LINE_In   = 0;
+    LINE_Out  = 0;
+    LINE_Statistics.Lines   = 0;
+    LINE_Statistics.Empty   = 0;
+    LINE_Statistics.Dropped = 0;
+
+    // a too long or damaged line is dropped by the driver till the next line end, so the lines stay in sync.
+    MCAL_UART_Set_RX_Mode(USARTx, RX_Resilient_Mode);
+    MCAL_UART_RX_CALLBACK(USARTx, LINE_voidLineEnd);
+    return MCAL_UART_Receive_INT(USARTx, LINE_Ring[LINE_In], LINE_MAX, LINE_END);
+}
+
+
+/// @brief  LINE_Get : this function gives the oldest Received line, it stays in its buffer till LINE_Release.
+/// @param  Copy_View: pointer to hold the line view.
+/// @retval Functions Status, (Uart_BUSY) if there is no line.
+Uart_Fun_Status	    LINE_Get(LINE_View *Copy_View)
+{
+    u8 Local_Out = LINE_Out;
+
+    if (Copy_View == NULL){ return Uart_ERROR; }
+    if (Local_Out == LINE_In){ return Uart_BUSY; }
+
+    Copy_View -> Text   = &LINE_Ring[Local_Out][LINE_First[Local_Out]];
+    Copy_View -> Length = LINE_Length[Local_Out];
+    return Uart_OK;
+}
+
+
+/// @brief  LINE_Release : this function gives the buffer of the oldest line back to the Reception.
+/// @retval Functions Status, (Uart_ERROR) if there is no line.
+Uart_Fun_Status	    LINE_Release(void)
+{
+    u8 Local_Out = LINE_Out;
+
+    if (Local_Out == LINE_In){ return Uart_ERROR; }
+
+    LINE_Out = (Local_Out + 1) % LINE_RING_SIZE;
+    return Uart_OK;
+}
+
+
+/// @brief  LINE_Get_Stats : this function gets the Line Reader statistics.
+/// @param  Copy_Stats     : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    LINE_Get_Stats(LINE_Stats *Copy_Stats)
+{
+    if ((Copy_Stats == NULL) || (LINE_Port == NULL)){ return Uart_ERROR; }
+
+    LINE_Statistics.Damaged = LINE_Port -> RX_Errors.Damaged_Frames;
+    *Copy_Stats = LINE_Statistics;
+    return Uart_OK;
+}
+
+
+/// @brief  LINE_voidLineEnd : it is executed by the USART Handler at the end of a line, it removes the CR / LF ends of
+///                            the line, gives it to the application and Receives the next line into a free buffer.
+/// @param  USARTx           : the Struct of the USART Peripheral.
+/// @retval None.
+static void LINE_voidLineEnd(USART_Struct *USARTx)
+{
+    u8 *Local_Line  = LINE_Ring[LINE_In];
+    u8  Local_Next  = (LINE_In + 1) % LINE_RING_SIZE;
+    u16 Local_First = 0;
+    u16 Local_End   = LINE_Port -> RX_Buffer_Size;		/*	the index of the end element	*/
+
+    // the other end element ('\r' before '\n', or '\n' after '\r') stays in the line, so both ends are checked.
+    while ((Local_First < Local_End) && (__LINE_IS_END(Local_Line[Local_First])))
+    {
+        Local_First++;
+    }
+    while ((Local_End > Local_First) && (__LINE_IS_END(Local_Line[Local_End - 1])))
+    {
+        Local_End--;
+    }
+
+    if (Local_First == Local_End)
+    {
+        LINE_Statistics.Empty++;
+    }
+    else if (Local_Next == LINE_Out)
+    {
+        // the application is late, the line is dropped and its buffer is used again.
+        LINE_Statistics.Dropped++;
+    }
+    else
+    {
+        Local_Line[Local_End]  = 0;
+        LINE_First[LINE_In]    = Local_First;
+        LINE_Length[LINE_In]   = Local_End - Local_First;
+        LINE_In = Local_Next;
+        LINE_Statistics.Lines++;
+    }
+    (void)MCAL_UART_Receive_INT(LINE_Port, LINE_Ring[LINE_In], LINE_MAX, LINE_END);
+}
@@ -0,0 +1,30 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the LZSS Compression Service 		*/
+/*											of the USART Transmission						*/
+/********************************************************************************************/
+#ifndef		LZSS_CONFIG_H
+#define		LZSS_CONFIG_H
+
+/********************************************************************************************/
+/*	the history window is (2 ^ LZSS_WINDOW_BITS) elements (the matches' distance bits)		*/
+/********************************************************************************************/
+#define LZSS_WINDOW_BITS        8U
+/********************************************************************************************/
+/*	the matches' length bits, a match is 2 to (1 + 2 ^ LZSS_LENGTH_BITS) elements			*/
+/********************************************************************************************/
+#define LZSS_LENGTH_BITS        4U
+/********************************************************************************************/
+/*	the maximum size of one frame given to LZSS_Transmit_INT								*/
+/********************************************************************************************/
+#define LZSS_FRAME_MAX          128U
+/********************************************************************************************/
+/*	the history is cleared every LZSS_RESET_PERIOD frames, so the host decoder recovers		*/
+/*	after a lost frame (0 : never)															*/
+/********************************************************************************************/
+#define LZSS_RESET_PERIOD       32U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,63 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the LZSS Compression Service 			*/
+/*											of the USART Transmission						*/
+/********************************************************************************************/
+#ifndef		LZSS_INTERFACE_H
+#define		LZSS_INTERFACE_H
+
+/********************************************************************************************/
+/*	Every frame is compressed against a history of the last frames (a small fixed window,	*/
+/*	no heap), then it is COBS encoded and sent by MCAL_UART_Transmit_INT. The host tool		*/
+/*	(lzss_tool.py) decodes the frames and benchmarks recorded telemetry.					*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The Compression statistics.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Frames;					/*	 		Number of the sent frames					  		  */
+	u32				 Raw_Bytes;					/*	 		Number of the given elements				  		  */
+	u32				 Wire_Bytes;				/*	 		Number of the sent elements (with the framing)		  */
+	u32				 Throughput_Permille;		/*	 The effective throughput ratio to the raw Baud rate		  */
+
+}LZSS_Stats;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The LZSS Compression Functions Prototypes           		        */
+/********************************************************************************************/
+/// @brief  LZSS_voidInit : this function selects the USART port of the compressed frames and clears the history.
+/// @param  USARTx        : the Struct of the initialized USART Peripheral.
+/// @retval None.
+void	            LZSS_voidInit(USART_Struct *USARTx);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LZSS_voidReset : this function clears the history before the next frame (e.g. after the host connects).
+/// @retval None.
+void	            LZSS_voidReset(void);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LZSS_u16Compress : this function compresses one frame against the history, then adds it to the history.
+/// @param  Copy_Data        : the frame.
+/// @param  Copy_Size        : the frame size (up to LZSS_FRAME_MAX).
+/// @param  Copy_Packed      : the buffer of the packed frame (LZSS_FRAME_MAX + 1 elements).
+/// @retval the packed frame size, or (0) if the frame is too big.
+u16	                LZSS_u16Compress(const u8 *Copy_Data , u16 Copy_Size , u8 *Copy_Packed);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LZSS_Transmit_INT : this function compresses one frame and sends it by the Interrupt, the frame buffer can
+///                             be used again when the function returns.
+/// @param  Copy_Data         : the frame.
+/// @param  Copy_Size         : the frame size (up to LZSS_FRAME_MAX).
+/// @retval Functions Status, (Uart_BUSY) if the previous frame is still sent (the frame is not added to the history).
+Uart_Fun_Status	    LZSS_Transmit_INT(const u8 *Copy_Data , u16 Copy_Size);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  LZSS_Get_Stats : this function gets the compression statistics and the effective throughput.
+/// @param  Copy_Stats     : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    LZSS_Get_Stats(LZSS_Stats *Copy_Stats);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
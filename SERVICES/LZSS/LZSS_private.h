@@ -0,0 +1,38 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the LZSS Compression Service 			*/
+/*											of the USART Transmission						*/
+/********************************************************************************************/
+#ifndef		LZSS_PRIVATE_H
+#define		LZSS_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Packed Frame Format                      			    */
+/********************************************************************************************/
+/*	the packed frame is : [header][tokens], the tokens are a bit stream ({MSB} first) :		*/
+/*		literal : [1][8 bits element]														*/
+/*		match   : [0][distance - 1 : WINDOW_BITS][length - 2 : LENGTH_BITS]					*/
+/*	the last element is padded by zero bits, they are less than the smallest token.		*/
+/********************************************************************************************/
+/*	the header : [reset : bit 7][stored : bit 6][sequence : bits 0..5]		*/
+#define     LZSS_HEADER_RESET       7U
+#define     LZSS_HEADER_STORED      6U
+#define     LZSS_SEQUENCE_MASK      0x3FU
+
+#define     LZSS_WINDOW_SIZE        (1U << LZSS_WINDOW_BITS)
+#define     LZSS_MIN_MATCH          2U
+#define     LZSS_MAX_MATCH          (LZSS_MIN_MATCH + (1U << LZSS_LENGTH_BITS) - 1U)
+/*	the biggest token (a match) in bits.	*/
+#define     LZSS_TOKEN_BITS         (1U + LZSS_WINDOW_BITS + LZSS_LENGTH_BITS)
+/*	a stored frame is never bigger than the raw one plus its header.		*/
+#define     LZSS_PACKED_MAX         (1U + LZSS_FRAME_MAX)
+#define     LZSS_TX_MAX             COBS_ENCODED_MAX(LZSS_PACKED_MAX)
+/********************************************************************************************/
+
+#if ((LZSS_WINDOW_BITS + LZSS_LENGTH_BITS) > 24) || (LZSS_WINDOW_BITS < 4)
+#error "the match token should be 9 to 25 bits"
+#endif
+
+#endif
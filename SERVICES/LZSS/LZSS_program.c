@@ -0,0 +1,234 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the LZSS Compression Service 			*/
+/*											of the USART Transmission						*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "SERVICES/COBS/COBS_interface.h"
+
+#include "LZSS_config.h"
+#include "LZSS_private.h"
+#include "LZSS_interface.h"
+/********************************************************************************************/
+static void LZSS_voidPutBits(u8 *Copy_Packed , u16 *Copy_BitIndex , u32 Copy_Value , u8 Copy_Bits);
+/********************************************************************************************/
+static USART_Struct *LZSS_Port = NULL;
+
+/*	the history then the current frame, the matches are searched in the history and the	*/
+/*	already compressed part of the frame.													*/
+static u8           LZSS_Window[LZSS_WINDOW_SIZE + LZSS_FRAME_MAX];
+static u16          LZSS_History = 0;			/*	the number of the history elements	*/
+static u8           LZSS_Sequence = 0;
+static u16          LZSS_Frames_Since_Reset = 0;
+static u8           LZSS_Reset_Pending = 1;
+static u8           LZSS_TX_Frame[LZSS_TX_MAX];
+static LZSS_Stats   LZSS_Statistics;
+/********************************************************************************************/
+
+
+/// @brief  LZSS_voidInit : this function selects the USART port of the compressed frames and clears the history.
+/// @param  USARTx        : the Struct of the initialized USART Peripheral.
+/// @retval None.
+void	            LZSS_voidInit(USART_Struct *USARTx)
+{
+    LZSS_Port     = USARTx;
+    LZSS_Sequence = 0;
+    LZSS_Statistics.Frames              = 0;
+    LZSS_Statistics.Raw_Bytes           = 0;
+    LZSS_Statistics.Wire_Bytes          = 0;
+    LZSS_Statistics.Throughput_Permille = 0;
+    LZSS_voidReset();
+}
+
+
+/// @brief  LZSS_voidReset : this function clears the history before the next frame (e.g. after the host connects).
+/// @retval None.
+void	            LZSS_voidReset(void)
+{
+    LZSS_Reset_Pending = 1;
+}
+
+
+/// @brief  LZSS_u16Compress : this function compresses one frame against the history, then adds it to the history.
+/// @param  Copy_Data        : the frame.
+/// @param  Copy_Size        : the frame size (up to LZSS_FRAME_MAX).
+/// @param  Copy_Packed      : the buffer of the packed frame (LZSS_FRAME_MAX + 1 elements).
+/// @retval the packed frame size, or (0) if the frame is too big.
+u16	                LZSS_u16Compress(const u8 *Copy_Data , u16 Copy_Size , u8 *Copy_Packed)
+{
+    u8 *Local_Frame;
+    u16 Local_Index;
+    u16 Local_Pos;
+    u16 Local_Start;
+    u16 Local_Cand;
+    u16 Local_Length;
+    u16 Local_Best_Length;
+    u16 Local_Best_Dist;
+    u16 Local_BitIndex;
+    u16 Local_Packed_Size;
+
+    if ((Copy_Data == NULL) || (Copy_Packed == NULL) || (Copy_Size > LZSS_FRAME_MAX)){ return 0; }
+
+    // the periodic reset lets a decoder that lost a frame start again.
+    Copy_Packed[0] = LZSS_Sequence & LZSS_SEQUENCE_MASK;
+    LZSS_Sequence++;
+    if ((LZSS_RESET_PERIOD != 0) && (LZSS_Frames_Since_Reset >= LZSS_RESET_PERIOD))
+    {
+        LZSS_Reset_Pending = 1;
+    }
+    if (LZSS_Reset_Pending == 1)
+    {
+        LZSS_History            = 0;
+        LZSS_Frames_Since_Reset = 0;
+        LZSS_Reset_Pending      = 0;
+        SET_BIT(Copy_Packed[0], LZSS_HEADER_RESET);
+    }
+    LZSS_Frames_Since_Reset++;
+
+    Local_Frame = &LZSS_Window[LZSS_History];
+    for (Local_Index = 0; Local_Index < Copy_Size; Local_Index++)
+    {
+        Local_Frame[Local_Index] = Copy_Data[Local_Index];
+    }
+
+    // the bit stream starts after the header, it stops when the next token may not fit in a stored frame size.
+    Local_BitIndex = 8;
+    Local_Pos = LZSS_History;
+    while ((Local_Pos < (LZSS_History + Copy_Size)) && ((Local_BitIndex + LZSS_TOKEN_BITS) <= (8U * (1U + Copy_Size))))
+    {
+        // find the longest match inside the window, a match may run into the elements it copies.
+        Local_Best_Length = 0;
+        Local_Best_Dist   = 0;
+        Local_Start = (Local_Pos > LZSS_WINDOW_SIZE) ? (Local_Pos - LZSS_WINDOW_SIZE) : 0;
+        for (Local_Cand = Local_Start; Local_Cand < Local_Pos; Local_Cand++)
+        {
+            if (LZSS_Window[Local_Cand] != LZSS_Window[Local_Pos]){ continue; }
+            Local_Length = 1;
+            while ((Local_Length < LZSS_MAX_MATCH) && ((Local_Pos + Local_Length) < (LZSS_History + Copy_Size)) &&
+                   (LZSS_Window[Local_Cand + Local_Length] == LZSS_Window[Local_Pos + Local_Length]))
+            {
+                Local_Length++;
+            }
+            // the nearest of the equal matches is kept.
+            if (Local_Length >= Local_Best_Length)
+            {
+                Local_Best_Length = Local_Length;
+                Local_Best_Dist   = Local_Pos - Local_Cand;
+            }
+        }
+
+        if (Local_Best_Length >= LZSS_MIN_MATCH)
+        {
+            LZSS_voidPutBits(Copy_Packed, &Local_BitIndex, 0, 1);
+            LZSS_voidPutBits(Copy_Packed, &Local_BitIndex, Local_Best_Dist - 1, LZSS_WINDOW_BITS);
+            LZSS_voidPutBits(Copy_Packed, &Local_BitIndex, Local_Best_Length - LZSS_MIN_MATCH, LZSS_LENGTH_BITS);
+            Local_Pos += Local_Best_Length;
+        }
+        else
+        {
+            LZSS_voidPutBits(Copy_Packed, &Local_BitIndex, 0x100 | LZSS_Window[Local_Pos], 9);
+            Local_Pos++;
+        }
+    }
+    Local_Packed_Size = (Local_BitIndex + 7) / 8;
+
+    // a frame that does not get smaller is stored as it is.
+    if ((Local_Pos < (LZSS_History + Copy_Size)) || (Local_Packed_Size >= (1 + Copy_Size)))
+    {
+        SET_BIT(Copy_Packed[0], LZSS_HEADER_STORED);
+        for (Local_Index = 0; Local_Index < Copy_Size; Local_Index++)
+        {
+            Copy_Packed[1 + Local_Index] = Copy_Data[Local_Index];
+        }
+        Local_Packed_Size = 1 + Copy_Size;
+    }
+
+    // keep the last LZSS_WINDOW_SIZE elements as the history of the next frame.
+    LZSS_History += Copy_Size;
+    if (LZSS_History > LZSS_WINDOW_SIZE)
+    {
+        Local_Start = LZSS_History - LZSS_WINDOW_SIZE;
+        for (Local_Index = 0; Local_Index < LZSS_WINDOW_SIZE; Local_Index++)
+        {
+            LZSS_Window[Local_Index] = LZSS_Window[Local_Start + Local_Index];
+        }
+        LZSS_History = LZSS_WINDOW_SIZE;
+    }
+    return Local_Packed_Size;
+}
+
+
+/// @brief  LZSS_Transmit_INT : this function compresses one frame and sends it by the Interrupt, the frame buffer can
+///                             be used again when the function returns.
+/// @param  Copy_Data         : the frame.
+/// @param  Copy_Size         : the frame size (up to LZSS_FRAME_MAX).
+/// @retval Functions Status, (Uart_BUSY) if the previous frame is still sent (the frame is not added to the history).
+Uart_Fun_Status	    LZSS_Transmit_INT(const u8 *Copy_Data , u16 Copy_Size)
+{
+    u8  Local_Packed[LZSS_PACKED_MAX];
+    u16 Local_Size;
+    Uart_Fun_Status Local_Status;
+
+    if ((LZSS_Port == NULL) || (Copy_Data == NULL) || (Copy_Size == 0) || (Copy_Size > LZSS_FRAME_MAX)){ return Uart_ERROR; }
+    // the TX frame is still used by the Interrupt.
+    if (LZSS_Port -> TX_Lock_Flag == BUSY){ return Uart_BUSY; }
+
+    Local_Size = LZSS_u16Compress(Copy_Data, Copy_Size, Local_Packed);
+    Local_Size = COBS_u16Encode(Local_Packed, Local_Size, LZSS_TX_Frame);
+    Local_Status = MCAL_UART_Transmit_INT(LZSS_Port, LZSS_TX_Frame, Local_Size, COBS_DELIMITER);
+    if (Local_Status != Uart_OK)
+    {
+        // the host decoder can not follow a history with a missing frame.
+        LZSS_voidReset();
+        return Local_Status;
+    }
+    LZSS_Statistics.Frames++;
+    LZSS_Statistics.Raw_Bytes  += Copy_Size;
+    LZSS_Statistics.Wire_Bytes += Local_Size;
+    return Uart_OK;
+}
+
+
+/// @brief  LZSS_Get_Stats : this function gets the compression statistics and the effective throughput.
+/// @param  Copy_Stats     : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    LZSS_Get_Stats(LZSS_Stats *Copy_Stats)
+{
+    if (Copy_Stats == NULL){ return Uart_ERROR; }
+
+    // the link carries (Wire_Bytes) for (Raw_Bytes), so the effective throughput is scaled by their ratio.
+    if (LZSS_Statistics.Wire_Bytes != 0)
+    {
+        LZSS_Statistics.Throughput_Permille = (u32)(((f64)LZSS_Statistics.Raw_Bytes * 1000.0) / LZSS_Statistics.Wire_Bytes);
+    }
+    *Copy_Stats = LZSS_Statistics;
+    return Uart_OK;
+}
+
+
+/// @brief  LZSS_voidPutBits : it appends a value to the bit stream ({MSB} first).
+/// @param  Copy_Packed      : the packed frame.
+/// @param  Copy_BitIndex    : the index of the next bit, it is updated.
+/// @param  Copy_Value       : the value.
+/// @param  Copy_Bits        : the number of the value bits.
+/// @retval None.
+static void LZSS_voidPutBits(u8 *Copy_Packed , u16 *Copy_BitIndex , u32 Copy_Value , u8 Copy_Bits)
+{
+    while (Copy_Bits-- > 0)
+    {
+        u16 Local_Byte = *Copy_BitIndex / 8;
+        u8  Local_Bit  = 7 - (*Copy_BitIndex % 8);
+
+        if (Local_Bit == 7){ Copy_Packed[Local_Byte] = 0; }
+        if (GET_BIT(Copy_Value, Copy_Bits) == 1){ SET_BIT(Copy_Packed[Local_Byte], Local_Bit); }
+        (*Copy_BitIndex)++;
+    }
+}
@@ -0,0 +1,264 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the LZSS Compression Service, it runs	*/
+/*					   on the host model of the USART driver (USART_POSIX)					*/
+/********************************************************************************************/
+/*	USART1 sends telemetry lines by LZSS_Transmit_INT to USART2 over a pseudo-terminal		*/
+/*	pair, USART2 Receives the COBS frames and the test decodes them by the packed frame		*/
+/*	format of LZSS_private.h. the test checks that every line is decoded as it was sent,		*/
+/*	that a decoder that lost a frame waits for the next history reset and then follows		*/
+/*	again, and that the telemetry is compressed. the effective throughput is printed.		*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -I. -IMCAL/USART -ISERVICES/LZSS					*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c SERVICES/COBS/COBS_program.c		*/
+/*	    SERVICES/LZSS/LZSS_program.c SERVICES/LZSS/LZSS_test.c -lpthread					*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "SERVICES/COBS/COBS_interface.h"
+
+#include "LZSS_config.h"
+#include "LZSS_private.h"
+#include "LZSS_interface.h"
+
+#if USART_POSIX == Enable
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_FRAMES             (3U * LZSS_RESET_PERIOD)
+/*	the frame that the decoder does not get, it follows again at the next reset		*/
+#define     TEST_LOST_FRAME         (LZSS_RESET_PERIOD + 5U)
+#define     TEST_BAUD               115200UL
+/*	the longest wait of a frame, in pauses (100 us)	*/
+#define     TEST_WAITS              1000U
+/*	the decoder waits for a reset frame	*/
+#define     TEST_NOT_SYNCED         0xFFFFU
+/*	the decoder finds a wrong frame	*/
+#define     TEST_BAD_FRAME          0xFFFEU
+/*	the telemetry should be at least this compressed (raw / wire in permille)	*/
+#define     TEST_MIN_PERMILLE       1500U
+/********************************************************************************************/
+static USART_Struct     Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Test_Wire[LZSS_TX_MAX];
+static u8               Test_Packed[LZSS_TX_MAX];
+static u8               Test_History[LZSS_WINDOW_SIZE + LZSS_FRAME_MAX];
+static u16              Test_History_Size;
+static s16              Test_Sequence = -1;
+static u8               Test_Synced;
+static volatile u8      Test_RX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Test_RX_End      : the RX callback of USART2.
+/// @param  USARTx           : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_Get_Bits    : it reads a value from the bit stream ({MSB} first).
+/// @param  Copy_Stream      : the bit stream.
+/// @param  Copy_BitIndex    : the index of the first bit, it is updated.
+/// @param  Copy_Bits        : the number of the value bits.
+/// @return the value.
+static u32 Test_Get_Bits(const u8 *Copy_Stream , u16 *Copy_BitIndex , u8 Copy_Bits)
+{
+    u32 Local_Value = 0;
+
+    while (Copy_Bits-- > 0)
+    {
+        Local_Value = (Local_Value << 1) | GET_BIT(Copy_Stream[*Copy_BitIndex / 8U], 7U - (*Copy_BitIndex % 8U));
+        (*Copy_BitIndex)++;
+    }
+    return Local_Value;
+}
+
+
+/// @brief  Test_Decompress  : it decodes one packed frame against the history of the decoded frames.
+/// @param  Copy_Packed      : the packed frame.
+/// @param  Copy_Size        : the packed frame size.
+/// @param  Copy_Frame       : pointer to hold the decoded frame, it stays valid till the next call.
+/// @return the frame size, (TEST_NOT_SYNCED) after a lost frame till a reset frame, or (TEST_BAD_FRAME).
+static u16 Test_Decompress(const u8 *Copy_Packed , u16 Copy_Size , const u8 **Copy_Frame)
+{
+    u8  Local_Header = Copy_Packed[0];
+    u16 Local_Start, Local_Out, Local_BitIndex = 0, Local_Bits = (u16)((Copy_Size - 1U) * 8U);
+    u16 Local_Dist, Local_Length;
+    const u8 *Local_Stream = &Copy_Packed[1];
+
+    // a sequence gap is a lost frame, the history is not the one of the encoder till the next reset.
+    if ((Test_Sequence >= 0) && ((Local_Header & LZSS_SEQUENCE_MASK) != ((Test_Sequence + 1) & LZSS_SEQUENCE_MASK)))
+    {
+        Test_Synced = 0;
+    }
+    Test_Sequence = Local_Header & LZSS_SEQUENCE_MASK;
+    if (GET_BIT(Local_Header, LZSS_HEADER_RESET) == 1)
+    {
+        Test_History_Size = 0;
+        Test_Synced       = 1;
+    }
+    if (Test_Synced == 0){ return TEST_NOT_SYNCED; }
+
+    Local_Start = Test_History_Size;
+    Local_Out   = Test_History_Size;
+    if (GET_BIT(Local_Header, LZSS_HEADER_STORED) == 1)
+    {
+        if ((Copy_Size - 1U) > LZSS_FRAME_MAX){ return TEST_BAD_FRAME; }
+        memcpy(&Test_History[Local_Out], Local_Stream, Copy_Size - 1U);
+        Local_Out += Copy_Size - 1U;
+    }
+    else
+    {
+        // the padding bits are less than the smallest token.
+        while ((Local_Bits - Local_BitIndex) >= 9U)
+        {
+            if (Test_Get_Bits(Local_Stream, &Local_BitIndex, 1) == 1)
+            {
+                if (Local_Out >= sizeof(Test_History)){ return TEST_BAD_FRAME; }
+                Test_History[Local_Out++] = (u8)Test_Get_Bits(Local_Stream, &Local_BitIndex, 8);
+                continue;
+            }
+            if ((Local_Bits - Local_BitIndex) < (LZSS_TOKEN_BITS - 1U)){ break; }
+            Local_Dist   = (u16)(Test_Get_Bits(Local_Stream, &Local_BitIndex, LZSS_WINDOW_BITS) + 1U);
+            Local_Length = (u16)(Test_Get_Bits(Local_Stream, &Local_BitIndex, LZSS_LENGTH_BITS) + LZSS_MIN_MATCH);
+            if ((Local_Dist > Local_Out) || ((Local_Out + Local_Length) > sizeof(Test_History))){ return TEST_BAD_FRAME; }
+            // a match may run into the elements it copies.
+            while (Local_Length-- > 0)
+            {
+                Test_History[Local_Out] = Test_History[Local_Out - Local_Dist];
+                Local_Out++;
+            }
+        }
+    }
+    *Copy_Frame = &Test_History[Local_Start];
+    Test_History_Size = Local_Out;
+    return (u16)(Local_Out - Local_Start);
+}
+
+
+/// @brief  Test_Keep_History : it keeps the last (LZSS_WINDOW_SIZE) elements as the history of the next frame, it is
+///                             called when the decoded frame is not used any more.
+/// @return None.
+static void Test_Keep_History(void)
+{
+    if (Test_History_Size > LZSS_WINDOW_SIZE)
+    {
+        memmove(Test_History, &Test_History[Test_History_Size - LZSS_WINDOW_SIZE], LZSS_WINDOW_SIZE);
+        Test_History_Size = LZSS_WINDOW_SIZE;
+    }
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    struct timespec Local_Pause = { 0, 100000L };
+    const u8  *Local_Decoded;
+    LZSS_Stats Local_Stats;
+    char Local_Name[64];
+    char Local_Line[LZSS_FRAME_MAX];
+    u16  Local_Index, Local_Wait, Local_Line_Size, Local_Wire_Size, Local_Size;
+    u16  Local_Decoded_Frames = 0, Local_Waiting_Frames = 0;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, TEST_BAUD);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, Test_RX_End);
+    LZSS_voidInit(&Test_TX);
+
+    for (Local_Index = 0; (Local_Index < TEST_FRAMES) && (Local_Pass == 1); Local_Index++)
+    {
+        // a telemetry line of slow changing values.
+        Local_Line_Size = (u16)snprintf(Local_Line, sizeof(Local_Line), "T=%05u,VBAT=%4u,IOUT=%4u,TEMP=%3u,STATE=RUN\n",
+                                        Local_Index * 10U, 3300U + (Local_Index % 4U), 120U + (Local_Index % 8U),
+                                        25U + (Local_Index / 16U));
+        Test_RX_Done = 0;
+        if (MCAL_UART_Receive_INT(&Test_RX, Test_Wire, sizeof(Test_Wire), COBS_DELIMITER) != Uart_OK)
+        {
+            printf("FAIL : MCAL_UART_Receive_INT\n");
+            return 1;
+        }
+        for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (LZSS_Transmit_INT((const u8 *)Local_Line, Local_Line_Size) == Uart_BUSY); Local_Wait++)
+        {
+            nanosleep(&Local_Pause, NULL);
+        }
+        for (Local_Wait = 0; (Local_Wait < TEST_WAITS) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+        {
+            nanosleep(&Local_Pause, NULL);
+        }
+        // the Reception that ends by its last element holds the elements before it in RX_Buffer_Size.
+        Local_Wire_Size = Test_RX.RX_Buffer_Size;
+        if ((Test_RX_Done == 0) || (Local_Wire_Size == 0) || (Test_Wire[Local_Wire_Size] != COBS_DELIMITER))
+        {
+            printf("FAIL : the frame %u is not received\n", Local_Index);
+            Local_Pass = 0;
+            break;
+        }
+        // the lost frame is Received but not given to the decoder.
+        if (Local_Index == TEST_LOST_FRAME){ continue; }
+
+        Local_Size = COBS_u16Decode(Test_Wire, Local_Wire_Size, Test_Packed);
+        Local_Size = (Local_Size == 0) ? TEST_BAD_FRAME : Test_Decompress(Test_Packed, Local_Size, &Local_Decoded);
+        if (Local_Size == TEST_NOT_SYNCED)
+        {
+            // only the frames between the lost one and the next reset wait.
+            if ((Local_Index < TEST_LOST_FRAME) || (Local_Index >= (2U * LZSS_RESET_PERIOD)))
+            {
+                printf("FAIL : the decoder waits for a reset at the frame %u\n", Local_Index);
+                Local_Pass = 0;
+            }
+            Local_Waiting_Frames++;
+        }
+        else if ((Local_Size != Local_Line_Size) || (memcmp(Local_Decoded, Local_Line, Local_Line_Size) != 0))
+        {
+            printf("FAIL : the frame %u is not decoded as it was sent\n", Local_Index);
+            Local_Pass = 0;
+        }
+        else
+        {
+            Local_Decoded_Frames++;
+        }
+        Test_Keep_History();
+    }
+
+    (void)LZSS_Get_Stats(&Local_Stats);
+    // every element is 10 bits on the wire.
+    printf("%lu frames, %lu raw elements, %lu wire elements, throughput %lu permille, %lu B/s raw on a %lu B/s line\n",
+           (unsigned long)Local_Stats.Frames, (unsigned long)Local_Stats.Raw_Bytes, (unsigned long)Local_Stats.Wire_Bytes,
+           (unsigned long)Local_Stats.Throughput_Permille,
+           (unsigned long)(((TEST_BAUD / 10UL) * Local_Stats.Throughput_Permille) / 1000UL), (unsigned long)(TEST_BAUD / 10UL));
+    printf("%u frames decoded, %u frames wait for the reset after the lost one\n", Local_Decoded_Frames, Local_Waiting_Frames);
+    if ((Local_Stats.Frames != TEST_FRAMES) || (Local_Stats.Throughput_Permille < TEST_MIN_PERMILLE) ||
+        (Local_Waiting_Frames != ((2U * LZSS_RESET_PERIOD) - TEST_LOST_FRAME - 1U)) ||
+        (Local_Decoded_Frames != (TEST_FRAMES - 1U - Local_Waiting_Frames)))
+    {
+        printf("FAIL : the statistics or the recovery after the lost frame\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : LZSS loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+"""Host tool of the LZSS Compression Service.
+
+The target sends COBS encoded packed frames delimited by 0x00:
+    [header : reset bit 7, stored bit 6, sequence bits 0..5][tokens ...]
+    literal : [1][8 bits element]
+    match   : [0][distance - 1 : WINDOW_BITS][length - 2 : LENGTH_BITS]
+Every frame is compressed against the last WINDOW elements of the frames before
+it, the history is cleared by the frames that have the reset bit.
+
+usage: lzss_tool.py decode capture.bin [-o telemetry.bin]
+       lzss_tool.py decode /dev/ttyUSB0 --baud 115200        (needs pyserial)
+       lzss_tool.py bench telemetry.bin [--size N] [--baud 115200]
+
+The bench command compresses recorded telemetry by the same algorithm as the
+target, checks the round trip and prints the effective throughput of the link.
+The window and length bits must match LZSS_config.h.
+"""
+import argparse
+import sys
+
+MIN_MATCH = 2
+
+
+def cobs_encode(raw):
+    out = bytearray([0])
+    code_index, code = 0, 1
+    for byte in raw:
+        if byte == 0:
+            out[code_index] = code
+            code_index, code = len(out), 1
+            out.append(0)
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index, code = len(out), 1
+                out.append(0)
+    out[code_index] = code
+    out.append(0)
+    return bytes(out)
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            raise ValueError("bad COBS code")
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+class Encoder:
+    """The same compressor as LZSS_u16Compress."""
+
+    def __init__(self, window_bits, length_bits, reset_period):
+        self.window_bits, self.length_bits = window_bits, length_bits
+        self.window, self.max_match = 1 << window_bits, MIN_MATCH + (1 << length_bits) - 1
+        self.token_bits = 1 + window_bits + length_bits
+        self.reset_period = reset_period
+        self.history, self.sequence, self.since_reset, self.reset = b"", 0, 0, True
+
+    def compress(self, frame):
+        header = self.sequence & 0x3F
+        self.sequence += 1
+        if self.reset_period and self.since_reset >= self.reset_period:
+            self.reset = True
+        if self.reset:
+            self.history, self.since_reset, self.reset = b"", 0, False
+            header |= 0x80
+        self.since_reset += 1
+
+        data = self.history + frame
+        pos, end, bits = len(self.history), len(data), []
+        while pos < end and 8 + len(bits) + self.token_bits <= 8 * (1 + len(frame)):
+            best_length = best_dist = 0
+            for cand in range(max(0, pos - self.window), pos):
+                if data[cand] != data[pos]:
+                    continue
+                length = 1
+                while length < self.max_match and pos + length < end and data[cand + length] == data[pos + length]:
+                    length += 1
+                if length >= best_length:
+                    best_length, best_dist = length, pos - cand
+            if best_length >= MIN_MATCH:
+                bits += [0] + self._bits(best_dist - 1, self.window_bits) + self._bits(best_length - MIN_MATCH, self.length_bits)
+                pos += best_length
+            else:
+                bits += [1] + self._bits(data[pos], 8)
+                pos += 1
+
+        packed = bytes([header]) + bytes(int("".join(map(str, bits[i:i + 8])).ljust(8, "0"), 2) for i in range(0, len(bits), 8))
+        if pos < end or len(packed) >= 1 + len(frame):
+            packed = bytes([header | 0x40]) + frame
+        self.history = data[-self.window:]
+        return packed
+
+    @staticmethod
+    def _bits(value, count):
+        return [(value >> i) & 1 for i in range(count - 1, -1, -1)]
+
+
+class Decoder:
+    def __init__(self, window_bits, length_bits):
+        self.window_bits, self.length_bits = window_bits, length_bits
+        self.window = 1 << window_bits
+        self.history, self.sequence, self.synced = b"", None, False
+        self.lost = 0
+
+    def decompress(self, packed):
+        """Return the frame, or None while waiting for a reset frame after a loss."""
+        header = packed[0]
+        if self.sequence is not None and (header & 0x3F) != (self.sequence + 1) & 0x3F:
+            self.lost += ((header & 0x3F) - self.sequence - 1) & 0x3F
+            self.synced = False
+        self.sequence = header & 0x3F
+        if header & 0x80:
+            self.history, self.synced = b"", True
+        if not self.synced:
+            return None
+
+        if header & 0x40:
+            frame = bytes(packed[1:])
+        else:
+            out = bytearray(self.history)
+            start = len(out)
+            bits = "".join(format(byte, "08b") for byte in packed[1:])
+            i = 0
+            while len(bits) - i >= 9:
+                if bits[i] == "1":
+                    out.append(int(bits[i + 1:i + 9], 2))
+                    i += 9
+                else:
+                    if len(bits) - i < 1 + self.window_bits + self.length_bits:
+                        break
+                    dist = int(bits[i + 1:i + 1 + self.window_bits], 2) + 1
+                    length = int(bits[i + 1 + self.window_bits:i + 1 + self.window_bits + self.length_bits], 2) + MIN_MATCH
+                    i += 1 + self.window_bits + self.length_bits
+                    if dist > len(out):
+                        raise ValueError("match before the history start")
+                    for _ in range(length):
+                        out.append(out[-dist])
+            frame = bytes(out[start:])
+        self.history = (self.history + frame)[-self.window:]
+        return frame
+
+
+def frames(source, baud):
+    if source.startswith("/dev/") or source.upper().startswith("COM"):
+        import serial
+        port = serial.Serial(source, baud)
+        chunks = iter(lambda: port.read(1), b"")
+    else:
+        chunks = iter([open(source, "rb").read()])
+    pending = b""
+    for chunk in chunks:
+        pending += chunk
+        while b"\0" in pending:
+            frame, pending = pending.split(b"\0", 1)
+            if frame:
+                yield frame
+
+
+def split(data, size):
+    """Split the telemetry into frames of a fixed size, or into lines."""
+    if size:
+        return [data[i:i + size] for i in range(0, len(data), size)]
+    return [line + b"\n" for line in data.split(b"\n") if line]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("command", choices=["decode", "bench"])
+    parser.add_argument("input", help="a capture file or a serial port (decode), a telemetry file (bench)")
+    parser.add_argument("-o", "--output", help="the file of the decoded frames (decode)")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--window-bits", type=int, default=8)
+    parser.add_argument("--length-bits", type=int, default=4)
+    parser.add_argument("--reset-period", type=int, default=32)
+    parser.add_argument("--frame-max", type=int, default=128)
+    parser.add_argument("--size", type=int, default=0, help="split the telemetry into frames of this size (bench)")
+    args = parser.parse_args()
+
+    if args.command == "decode":
+        decoder = Decoder(args.window_bits, args.length_bits)
+        out = open(args.output, "wb") if args.output else sys.stdout.buffer
+        for frame in frames(args.input, args.baud):
+            try:
+                data = decoder.decompress(cobs_decode(frame))
+            except (ValueError, IndexError) as error:
+                print("bad frame: %s" % error, file=sys.stderr)
+                decoder.synced = False
+                continue
+            if data is not None:
+                out.write(data)
+                out.flush()
+        if decoder.lost:
+            print("%d frames lost" % decoder.lost, file=sys.stderr)
+        return
+
+    telemetry = split(open(args.input, "rb").read(), args.size)
+    if any(len(frame) > args.frame_max for frame in telemetry):
+        sys.exit("a frame is bigger than --frame-max, use --size")
+    encoder = Encoder(args.window_bits, args.length_bits, args.reset_period)
+    decoder = Decoder(args.window_bits, args.length_bits)
+    raw = wire_raw = wire_packed = 0
+    for frame in telemetry:
+        packed = encoder.compress(frame)
+        if decoder.decompress(packed) != frame:
+            sys.exit("round trip failed")
+        raw += len(frame)
+        wire_raw += len(cobs_encode(frame))
+        wire_packed += len(cobs_encode(packed))
+    line_rate = args.baud / 10.0
+    print("frames               : %d" % len(telemetry))
+    print("raw elements         : %d" % raw)
+    print("wire elements        : %d raw framed, %d compressed" % (wire_raw, wire_packed))
+    print("compression ratio    : %.3f" % (raw / float(wire_packed)))
+    print("effective throughput : %.0f B/s raw framed, %.0f B/s compressed (line %.0f B/s)"
+          % (line_rate * raw / wire_raw, line_rate * raw / wire_packed, line_rate))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,17 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Multi-Slave Polling			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		POLL_CONFIG_H
+#define		POLL_CONFIG_H
+
+/********************************************************************************************/
+/*	the maximum number of the polled slaves of all the ports								*/
+/********************************************************************************************/
+#define POLL_SLAVES_NUM         32U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,104 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Multi-Slave Polling				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		POLL_INTERFACE_H
+#define		POLL_INTERFACE_H
+
+/********************************************************************************************/
+/*	Every port polls its slaves one after the other by the Interrupts : the response		*/
+/*	Reception is started, then the request is sent, and the next slave is polled from the	*/
+/*	RX callback of the response end (or of its timeout), so the ports work in parallel		*/
+/*	and the application is not blocked. A slave that does not answer costs its timeout		*/
+/*	on its port only. The timeouts are ended by MCAL_UART_RX_Tick (POLL_Tick), so the		*/
+/*	service needs the USART_RX_TIMEOUT option of the driver.								*/
+/*	The ports are owned by the service : their TX and RX callbacks are claimed by POLL_Start	*/
+/*	(MCAL_UART_Claim_CALLBACKS), so a port of another service is not taken over.			*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The configuration of one slave.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	USART_Struct	*Port;						/*	 		The initialized port of the slave			  		  */
+	u8				*Request;					/*	 		The request elements, sent by their size	  		  */
+	u16				 Request_Size;				/*	 		Number of the request elements				  		  */
+	u8				*Response;					/*	 		The buffer of the response					  		  */
+	u16				 Response_Size;				/*	 The size of the response buffer (a full buffer is a response) */
+	u8				 Last_element;				/*	 		The last element of the response			  		  */
+	u32				 Timeout_us;				/*	 The longest time from the request start to the response end  */
+
+}POLL_Slave_Config;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The statistics of one slave.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Responses;					/*	 		Number of the Received responses			  		  */
+	u32				 Timeouts;					/*	 		Number of the requests with no response		  		  */
+	u32				 Errors;					/*	 	Number of the responses with a Receive error		  */
+	u32				 Last_Latency;				/*	 The DWT cycles from the request start to the last response end */
+	u32				 Max_Latency;				/*	 		The highest latency in DWT cycles			  		  */
+	u16				 Last_Size;					/*	 	Number of the elements of the last response		  */
+
+}POLL_Slave_Stats;
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The statistics of one port.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Cycles;					/*	 	Number of the poll cycles (all the port slaves)		  */
+	u32				 Last_Cycle;				/*	 		The DWT cycles of the last poll cycle		  		  */
+	u32				 Max_Cycle;					/*	 		The longest poll cycle in DWT cycles		  		  */
+	u32				 Transactions;				/*	 		Number of the ended requests				  		  */
+
+}POLL_Port_Stats;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Polling Functions Prototypes           		            		*/
+/********************************************************************************************/
+/// @brief  POLL_Add_Slave   : this function adds a slave to the poll cycle of its port, before POLL_Start.
+/// @param  Copy_Config      : pointer to the slave configuration, it is copied.
+/// @param  Copy_ID          : pointer to hold the slave ID (its index).
+/// @retval Functions Status, (Uart_BUSY) if the polling is running, (Uart_OVERSIZE) if the table is full.
+Uart_Fun_Status	    POLL_Add_Slave(const POLL_Slave_Config *Copy_Config , u8 *Copy_ID);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  POLL_Start       : this function starts the continuous poll cycles of all the ports.
+/// @param  Copy_Done        : NULL, or a function that is called by the Interrupt at the end of every request with the
+///                            slave ID and (Uart_OK), (Uart_TIMEOUT) or (Uart_ERROR), the response is in its buffer.
+/// @retval Functions Status, (Uart_BUSY) if the callbacks of a port are owned by another service.
+Uart_Fun_Status	    POLL_Start(void (*Copy_Done)(u8 ID , Uart_Fun_Status Status));
+/*------------------------------------------------------------------------------------------*/
+/// @brief  POLL_Stop        : this function stops the polling after the requests in progress.
+/// @retval Functions Status.
+Uart_Fun_Status	    POLL_Stop(void);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  POLL_Tick        : this function ends the requests that reach their timeout, it is called periodically by
+///                            the STK timer (its period is the resolution of the timeouts).
+/// @retval None.
+void                POLL_Tick(void);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  POLL_Get_Slave_Stats : this function gets the statistics of a slave.
+/// @param  Copy_ID          : the slave ID.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    POLL_Get_Slave_Stats(u8 Copy_ID , POLL_Slave_Stats *Copy_Stats);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  POLL_Get_Port_Stats : this function gets the poll cycle statistics of a port.
+/// @param  Copy_Port        : the Struct of the USART Peripheral.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    POLL_Get_Port_Stats(USART_Struct *Copy_Port , POLL_Port_Stats *Copy_Stats);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
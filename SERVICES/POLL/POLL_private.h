@@ -0,0 +1,26 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Multi-Slave Polling					*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		POLL_PRIVATE_H
+#define		POLL_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Polling Ports                      			        */
+/********************************************************************************************/
+/*	the USART1, USART2 and USART6 ports		*/
+#define     POLL_PORTS_NUM          3U
+/*	no port			*/
+#define     POLL_NO_PORT            0xFFU
+/*	no slave		*/
+#define     POLL_NO_SLAVE           0xFFU
+/********************************************************************************************/
+
+#if (POLL_SLAVES_NUM == 0) || (POLL_SLAVES_NUM >= POLL_NO_SLAVE)
+#error "POLL_SLAVES_NUM should be from 1 to 254"
+#endif
+
+#endif
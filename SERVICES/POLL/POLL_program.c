@@ -0,0 +1,425 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Multi-Slave Polling					*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "POLL_config.h"
+#include "POLL_private.h"
+#include "POLL_interface.h"
+
+#if USART_RX_TIMEOUT != Enable
+#error "the Polling Service needs the USART_RX_TIMEOUT option (MCAL_UART_Set_RX_Timeouts)"
+#endif
+/********************************************************************************************/
+/*	The port entry : the slave in progress and the chunks of its request.	*/
+typedef struct{
+
+	USART_Struct	*Port;
+	POLL_Port_Stats	 Stats;
+	u32				 Start_Cycle;							/*	the DWT cycle of the request start	*/
+	u32				 Cycle_Start;							/*	the DWT cycle of the poll cycle start	*/
+	u32				 Errors;								/*	the port Receive errors at the request start	*/
+	u16				 TX_Sent;								/*	the sent request elements		*/
+	u16				 TX_Chunk;								/*	the size of the chunk in progress	*/
+	u8				 Slave;
+	u8				 Active;								/*	a request waits for its response	*/
+	u8				 TX_Busy;								/*	a chunk is being sent			*/
+	u8				 TX_Stale;								/*	the chunk is of an ended request	*/
+	u8				 Ticking;								/*	the RX end is done by POLL_Tick	*/
+
+}POLL_Port_Entry;
+/********************************************************************************************/
+static u8   POLL_u8GetEntry(USART_Struct *USARTx , u8 Copy_Create);
+static u8   POLL_u8NextSlave(u8 Copy_Entry , u8 Copy_From);
+static u32  POLL_u32Errors(USART_Struct *USARTx);
+static void POLL_voidRequest(u8 Copy_Entry);
+static void POLL_voidSend(u8 Copy_Entry);
+static void POLL_voidTXDone(u8 Copy_Entry);
+static void POLL_voidResponse(u8 Copy_Entry);
+static void POLL_voidRXCallBack(USART_Struct *USARTx);
+static void POLL_voidTXCallBack(USART_Struct *USARTx);
+/********************************************************************************************/
+static POLL_Port_Entry   POLL_Ports[POLL_PORTS_NUM];
+static POLL_Slave_Config POLL_Slaves[POLL_SLAVES_NUM];
+static POLL_Slave_Stats  POLL_Slave_Statistics[POLL_SLAVES_NUM];
+static u8                POLL_Slaves_Count = 0;
+static volatile u8       POLL_Running = 0;
+static void            (*POLL_Done)(u8 ID , Uart_Fun_Status Status) = NULL;
+/********************************************************************************************/
+
+
+/// @brief  POLL_Add_Slave   : this function adds a slave to the poll cycle of its port, before POLL_Start.
+/// @param  Copy_Config      : pointer to the slave configuration, it is copied.
+/// @param  Copy_ID          : pointer to hold the slave ID (its index).
+/// @retval Functions Status, (Uart_BUSY) if the polling is running, (Uart_OVERSIZE) if the table is full.
+Uart_Fun_Status	    POLL_Add_Slave(const POLL_Slave_Config *Copy_Config , u8 *Copy_ID)
+{
+    if ((Copy_Config == NULL) || (Copy_ID == NULL) || (Copy_Config -> Port == NULL) || (Copy_Config -> Request == NULL) ||
+        (Copy_Config -> Request_Size == 0) || (Copy_Config -> Response == NULL) || (Copy_Config -> Response_Size == 0) ||
+        (Copy_Config -> Timeout_us == 0)){ return Uart_ERROR; }
+    if (POLL_Running == 1){ return Uart_BUSY; }
+    if (POLL_Slaves_Count >= POLL_SLAVES_NUM){ return Uart_OVERSIZE; }
+    if (POLL_u8GetEntry(Copy_Config -> Port, 1) == POLL_NO_PORT){ return Uart_ERROR; }
+
+    POLL_Slaves[POLL_Slaves_Count] = *Copy_Config;
+    POLL_Slave_Statistics[POLL_Slaves_Count].Responses    = 0;
+    POLL_Slave_Statistics[POLL_Slaves_Count].Timeouts     = 0;
+    POLL_Slave_Statistics[POLL_Slaves_Count].Errors       = 0;
+    POLL_Slave_Statistics[POLL_Slaves_Count].Last_Latency = 0;
+    POLL_Slave_Statistics[POLL_Slaves_Count].Max_Latency  = 0;
+    POLL_Slave_Statistics[POLL_Slaves_Count].Last_Size    = 0;
+    *Copy_ID = POLL_Slaves_Count;
+    POLL_Slaves_Count++;
+    return Uart_OK;
+}
+
+
+/// @brief  POLL_Start       : this function starts the continuous poll cycles of all the ports.
+/// @param  Copy_Done        : NULL, or a function that is called by the Interrupt at the end of every request with the
+///                            slave ID and (Uart_OK), (Uart_TIMEOUT) or (Uart_ERROR), the response is in its buffer.
+/// @retval Functions Status, (Uart_BUSY) if the callbacks of a port are owned by another service.
+Uart_Fun_Status	    POLL_Start(void (*Copy_Done)(u8 ID , Uart_Fun_Status Status))
+{
+    u8 Local_Entry;
+    u8 Local_Claimed;
+
+    if (POLL_Slaves_Count == 0){ return Uart_ERROR; }
+    if (POLL_Running == 1){ return Uart_BUSY; }
+
+    for (Local_Entry = 0; Local_Entry < POLL_PORTS_NUM; Local_Entry++)
+    {
+        if (POLL_Ports[Local_Entry].Port == NULL){ continue; }
+        if (MCAL_UART_Claim_CALLBACKS(POLL_Ports[Local_Entry].Port, POLL_voidTXCallBack, POLL_voidRXCallBack) != Uart_OK)
+        {
+            // the ports that are claimed already are given back.
+            for (Local_Claimed = 0; Local_Claimed < Local_Entry; Local_Claimed++)
+            {
+                if (POLL_Ports[Local_Claimed].Port == NULL){ continue; }
+                (void)MCAL_UART_TX_CALLBACK(POLL_Ports[Local_Claimed].Port, NULL);
+                (void)MCAL_UART_RX_CALLBACK(POLL_Ports[Local_Claimed].Port, NULL);
+            }
+            return Uart_BUSY;
+        }
+    }
+
+    // the latencies and the cycles are measured by the DWT cycle counter.
+    __UART_DWT_ENABLE();
+    POLL_Done    = Copy_Done;
+    POLL_Running = 1;
+    for (Local_Entry = 0; Local_Entry < POLL_PORTS_NUM; Local_Entry++)
+    {
+        POLL_Port_Entry *Local_Port = &POLL_Ports[Local_Entry];
+        if (Local_Port -> Port == NULL){ continue; }
+
+        Local_Port -> Stats.Cycles       = 0;
+        Local_Port -> Stats.Last_Cycle   = 0;
+        Local_Port -> Stats.Max_Cycle    = 0;
+        Local_Port -> Stats.Transactions = 0;
+        Local_Port -> Slave       = POLL_u8NextSlave(Local_Entry, POLL_NO_SLAVE);
+        Local_Port -> Cycle_Start = DWT_CYCCNT_R;
+        // a port that is busy now starts from POLL_Tick.
+        POLL_voidRequest(Local_Entry);
+    }
+    return Uart_OK;
+}
+
+
+/// @brief  POLL_Stop        : this function stops the polling after the requests in progress.
+/// @retval Functions Status.
+Uart_Fun_Status	    POLL_Stop(void)
+{
+    if (POLL_Running == 0){ return Uart_ERROR; }
+
+    POLL_Running = 0;
+    return Uart_OK;
+}
+
+
+/// @brief  POLL_Tick        : this function ends the requests that reach their timeout, it is called periodically by
+///                            the STK timer (its period is the resolution of the timeouts).
+/// @retval None.
+void                POLL_Tick(void)
+{
+    u8  Local_Entry;
+    u32 Local_State;
+
+    for (Local_Entry = 0; Local_Entry < POLL_PORTS_NUM; Local_Entry++)
+    {
+        POLL_Port_Entry *Local_Port = &POLL_Ports[Local_Entry];
+        if (Local_Port -> Port == NULL){ continue; }
+
+        // a response that ends at the same time is not taken as a timeout, as the Interrupts wait.
+        __UART_ENTER_CRITICAL(Local_State);
+        if (Local_Port -> Active == 1)
+        {
+            // the RX callback is called by MCAL_UART_RX_Tick if the request reached its timeout.
+            Local_Port -> Ticking = 1;
+            (void)MCAL_UART_RX_Tick(Local_Port -> Port);
+            Local_Port -> Ticking = 0;
+        }
+        else if (POLL_Running == 1)
+        {
+            // the port was busy at the request start.
+            POLL_voidRequest(Local_Entry);
+        }
+        __UART_EXIT_CRITICAL(Local_State);
+    }
+}
+
+
+/// @brief  POLL_Get_Slave_Stats : this function gets the statistics of a slave.
+/// @param  Copy_ID          : the slave ID.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    POLL_Get_Slave_Stats(u8 Copy_ID , POLL_Slave_Stats *Copy_Stats)
+{
+    u32 Local_State;
+
+    if ((Copy_Stats == NULL) || (Copy_ID >= POLL_Slaves_Count)){ return Uart_ERROR; }
+
+    __UART_ENTER_CRITICAL(Local_State);
+    *Copy_Stats = POLL_Slave_Statistics[Copy_ID];
+    __UART_EXIT_CRITICAL(Local_State);
+    return Uart_OK;
+}
+
+
+/// @brief  POLL_Get_Port_Stats : this function gets the poll cycle statistics of a port.
+/// @param  Copy_Port        : the Struct of the USART Peripheral.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    POLL_Get_Port_Stats(USART_Struct *Copy_Port , POLL_Port_Stats *Copy_Stats)
+{
+    u8  Local_Entry = POLL_u8GetEntry(Copy_Port, 0);
+    u32 Local_State;
+
+    if ((Copy_Stats == NULL) || (Local_Entry == POLL_NO_PORT)){ return Uart_ERROR; }
+
+    __UART_ENTER_CRITICAL(Local_State);
+    *Copy_Stats = POLL_Ports[Local_Entry].Stats;
+    __UART_EXIT_CRITICAL(Local_State);
+    return Uart_OK;
+}
+
+
+/// @brief  POLL_u8GetEntry  : it finds the entry of a port.
+/// @param  USARTx           : the Struct of the USART Peripheral.
+/// @param  Copy_Create      : (1) to use a free entry if the port has no entry.
+/// @retval the entry index, or POLL_NO_PORT.
+static u8 POLL_u8GetEntry(USART_Struct *USARTx , u8 Copy_Create)
+{
+    u8 Local_Index;
+
+    for (Local_Index = 0; Local_Index < POLL_PORTS_NUM; Local_Index++)
+    {
+        if (POLL_Ports[Local_Index].Port == USARTx){ return Local_Index; }
+    }
+    if ((Copy_Create == 0) || (USARTx == NULL)){ return POLL_NO_PORT; }
+    for (Local_Index = 0; Local_Index < POLL_PORTS_NUM; Local_Index++)
+    {
+        if (POLL_Ports[Local_Index].Port == NULL)
+        {
+            POLL_Ports[Local_Index].Port     = USARTx;
+            POLL_Ports[Local_Index].Active   = 0;
+            POLL_Ports[Local_Index].TX_Busy  = 0;
+            POLL_Ports[Local_Index].TX_Stale = 0;
+            POLL_Ports[Local_Index].Ticking  = 0;
+            return Local_Index;
+        }
+    }
+    return POLL_NO_PORT;
+}
+
+
+/// @brief  POLL_u8NextSlave : it finds the next slave of a port in the slaves table, the search goes back to the start.
+/// @param  Copy_Entry       : the port entry.
+/// @param  Copy_From        : the current slave, or POLL_NO_SLAVE to find the first one.
+/// @retval the slave index, it is not above (Copy_From) when a poll cycle ends.
+static u8 POLL_u8NextSlave(u8 Copy_Entry , u8 Copy_From)
+{
+    u8 Local_Index = (Copy_From == POLL_NO_SLAVE) ? 0 : (u8)(Copy_From + 1);
+    u8 Local_Count;
+
+    for (Local_Count = 0; Local_Count < POLL_Slaves_Count; Local_Count++)
+    {
+        if (Local_Index >= POLL_Slaves_Count){ Local_Index = 0; }
+        if (POLL_Slaves[Local_Index].Port == POLL_Ports[Copy_Entry].Port){ return Local_Index; }
+        Local_Index++;
+    }
+    return POLL_NO_SLAVE;
+}
+
+
+/// @brief  POLL_u32Errors   : it gets the sum of the Receive error counters of a port.
+/// @param  USARTx           : the Struct of the USART Peripheral.
+/// @retval the number of the errors.
+static u32 POLL_u32Errors(USART_Struct *USARTx)
+{
+    return USARTx -> RX_Errors.PE_Counter + USARTx -> RX_Errors.NE_Counter +
+           USARTx -> RX_Errors.FE_Counter + USARTx -> RX_Errors.ORE_Counter;
+}
+
+
+/// @brief  POLL_voidRequest : it starts the response Reception of the current slave, then sends its request.
+/// @param  Copy_Entry       : the port entry.
+/// @retval None.
+static void POLL_voidRequest(u8 Copy_Entry)
+{
+    POLL_Port_Entry   *Local_Port  = &POLL_Ports[Copy_Entry];
+    POLL_Slave_Config *Local_Slave;
+
+    if (Local_Port -> Slave == POLL_NO_SLAVE){ return; }
+    Local_Slave = &POLL_Slaves[Local_Port -> Slave];
+
+    // the timeout is the total time of the Reception, it starts before the request.
+    if ((MCAL_UART_Set_RX_Timeouts(Local_Port -> Port, 0, Local_Slave -> Timeout_us) != Uart_OK) ||
+        (MCAL_UART_Receive_INT(Local_Port -> Port, Local_Slave -> Response, Local_Slave -> Response_Size,
+                               Local_Slave -> Last_element) != Uart_OK))
+    {
+        return;
+    }
+    Local_Port -> Start_Cycle = DWT_CYCCNT_R;
+    Local_Port -> Errors      = POLL_u32Errors(Local_Port -> Port);
+    Local_Port -> TX_Sent     = 0;
+    // the chunk of the last request is still sent, it is not counted for this one.
+    Local_Port -> TX_Stale    = Local_Port -> TX_Busy;
+    Local_Port -> Active      = 1;
+    POLL_voidSend(Copy_Entry);
+}
+
+
+/// @brief  POLL_voidSend    : it sends the rest of the request of the current slave if the port is free.
+/// @param  Copy_Entry       : the port entry.
+/// @retval None.
+static void POLL_voidSend(u8 Copy_Entry)
+{
+    POLL_Port_Entry   *Local_Port  = &POLL_Ports[Copy_Entry];
+    POLL_Slave_Config *Local_Slave = &POLL_Slaves[Local_Port -> Slave];
+    Uart_Fun_Status    Local_Status;
+
+    if ((Local_Port -> Active == 1) && (Local_Port -> TX_Busy == 0) && (Local_Port -> TX_Sent < Local_Slave -> Request_Size))
+    {
+        Local_Port -> TX_Chunk = Local_Slave -> Request_Size - Local_Port -> TX_Sent;
+        Local_Port -> TX_Busy  = 1;
+        // the request is sent by its size only, so its elements can be equal to its last one.
+        Local_Status = MCAL_UART_Transmit_Size_INT(Local_Port -> Port, &Local_Slave -> Request[Local_Port -> TX_Sent], Local_Port -> TX_Chunk);
+        // POLL_voidTXDone is called at its end, a busy port sends the rest from its next TX callback, else the request
+        // ends by its timeout.
+        if (Local_Status != Uart_OK)
+        {
+            Local_Port -> TX_Busy = 0;
+        }
+    }
+}
+
+
+/// @brief  POLL_voidTXDone  : it counts the sent elements of the request chunk.
+/// @param  Copy_Entry       : the port entry.
+/// @retval None.
+static void POLL_voidTXDone(u8 Copy_Entry)
+{
+    POLL_Port_Entry *Local_Port = &POLL_Ports[Copy_Entry];
+
+    if (Local_Port -> TX_Busy == 0){ return; }
+    Local_Port -> TX_Busy = 0;
+    if (Local_Port -> TX_Stale == 1)
+    {
+        Local_Port -> TX_Stale = 0;
+        return;
+    }
+    // the chunk is sent by its size, so it ends after all its elements.
+    Local_Port -> TX_Sent += Local_Port -> TX_Chunk;
+}
+
+
+/// @brief  POLL_voidResponse : it is executed at the end of the response Reception (or of its timeout), it updates the
+///                             statistics and polls the next slave of the port.
+/// @param  Copy_Entry        : the port entry.
+/// @retval None.
+static void POLL_voidResponse(u8 Copy_Entry)
+{
+    POLL_Port_Entry  *Local_Port   = &POLL_Ports[Copy_Entry];
+    u8                Local_Slave  = Local_Port -> Slave;
+    POLL_Slave_Stats *Local_Stats  = &POLL_Slave_Statistics[Local_Slave];
+    u32               Local_Cycle  = DWT_CYCCNT_R;
+    u32               Local_Latency = Local_Cycle - Local_Port -> Start_Cycle;
+    Uart_Fun_Status   Local_Status = Uart_OK;
+
+    if (Local_Port -> Active == 0){ return; }
+    Local_Port -> Active = 0;
+    Local_Port -> Stats.Transactions++;
+    if (Local_Port -> Ticking == 1)
+    {
+        Local_Status = Uart_TIMEOUT;
+        Local_Stats -> Timeouts++;
+    }
+    else if (POLL_u32Errors(Local_Port -> Port) != Local_Port -> Errors)
+    {
+        Local_Status = Uart_ERROR;
+        Local_Stats -> Errors++;
+    }
+    else
+    {
+        Local_Stats -> Responses++;
+        Local_Stats -> Last_Size    = Local_Port -> Port -> RX_Buffer_Size;
+        Local_Stats -> Last_Latency = Local_Latency;
+        if (Local_Latency > Local_Stats -> Max_Latency)
+        {
+            Local_Stats -> Max_Latency = Local_Latency;
+        }
+    }
+    if (POLL_Done != NULL)
+    {
+        POLL_Done(Local_Slave, Local_Status);
+    }
+
+    // the poll cycle of the port ends when its slaves search goes back to the start.
+    Local_Port -> Slave = POLL_u8NextSlave(Copy_Entry, Local_Slave);
+    if (Local_Port -> Slave <= Local_Slave)
+    {
+        Local_Port -> Stats.Last_Cycle = Local_Cycle - Local_Port -> Cycle_Start;
+        if (Local_Port -> Stats.Last_Cycle > Local_Port -> Stats.Max_Cycle)
+        {
+            Local_Port -> Stats.Max_Cycle = Local_Port -> Stats.Last_Cycle;
+        }
+        Local_Port -> Stats.Cycles++;
+        Local_Port -> Cycle_Start = Local_Cycle;
+    }
+    if (POLL_Running == 1)
+    {
+        POLL_voidRequest(Copy_Entry);
+    }
+}
+
+
+/// @brief  POLL_voidRXCallBack : the USART RX callback of the ports, it ends the request of the port.
+/// @param  USARTx              : the Struct of the USART Peripheral.
+/// @retval None.
+static void POLL_voidRXCallBack(USART_Struct *USARTx)
+{
+    u8 Local_Entry = POLL_u8GetEntry(USARTx, 0);
+
+    if (Local_Entry != POLL_NO_PORT){ POLL_voidResponse(Local_Entry); }
+}
+
+
+/// @brief  POLL_voidTXCallBack : the USART TX callback of the ports, it sends the rest of the request.
+/// @param  USARTx              : the Struct of the USART Peripheral.
+/// @retval None.
+static void POLL_voidTXCallBack(USART_Struct *USARTx)
+{
+    u8 Local_Entry = POLL_u8GetEntry(USARTx, 0);
+
+    if (Local_Entry == POLL_NO_PORT){ return; }
+    POLL_voidTXDone(Local_Entry);
+    POLL_voidSend(Local_Entry);
+}
@@ -0,0 +1,190 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Multi-Slave Polling Service,		*/
+/*					   it runs on the host model of the USART driver (USART_POSIX)			*/
+/********************************************************************************************/
+/*	USART1 polls two slaves that are answered by USART2 over a pseudo-terminal pair : the	*/
+/*	first slave answers every request, the second one never answers. the requests have		*/
+/*	elements equal to their last element, so they should be sent by their size. the test	*/
+/*	checks that the callbacks of a port owned by another function are not taken over, the	*/
+/*	requests and the responses, the timeouts and the statistics.							*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -DUSART_RX_TIMEOUT=Enable -I. -IMCAL/USART			*/
+/*	    -ISERVICES/POLL MCAL/USART/USART_program.c MCAL/USART/USART_posix.c					*/
+/*	    SERVICES/POLL/POLL_program.c SERVICES/POLL/POLL_test.c -lpthread						*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "POLL_config.h"
+#include "POLL_private.h"
+#include "POLL_interface.h"
+
+#if USART_POSIX == Enable
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_REQUEST_SIZE       4U
+#define     TEST_RESPONSE_SIZE      8U
+#define     TEST_TIMEOUT_US         20000UL
+/*	the time of the polling, in POLL_Tick periods (1 ms)	*/
+#define     TEST_TICKS              300U
+/*	the Reception of the slaves ends by its size, no element is this one	*/
+#define     TEST_NO_ELEMENT         0xFFU
+/********************************************************************************************/
+static USART_Struct     Test_Master = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_Slaves = { .USART_x = USART2_R, .Time_Limit = 1000 };
+/*	the requests have their last element inside them.	*/
+static u8               Test_Request_A[TEST_REQUEST_SIZE] = { 0xA1U, 0x0DU, 0x55U, 0x0DU };
+static u8               Test_Request_B[TEST_REQUEST_SIZE] = { 0xB2U, 0x0DU, 0x66U, 0x0DU };
+static u8               Test_Answer[4] = { 0xA1U, 'O', 'K', '\n' };
+static u8               Test_Response_A[TEST_RESPONSE_SIZE];
+static u8               Test_Response_B[TEST_RESPONSE_SIZE];
+static u8               Test_Slave_Buffer[TEST_REQUEST_SIZE];
+static volatile u32     Test_Requests_A;
+static volatile u32     Test_Requests_B;
+static volatile u32     Test_Requests_Bad;
+static volatile u32     Test_Done_Count[2];
+/********************************************************************************************/
+
+
+/// @brief  Test_Foreign   : the RX callback of another service.
+/// @param  USARTx         : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_Foreign(USART_Struct *USARTx)
+{
+}
+
+
+/// @brief  Test_Slave_End : the RX callback of USART2, it answers the requests of the first slave.
+/// @param  USARTx         : the Struct of the USART Peripheral.
+/// @return None.
+static void Test_Slave_End(USART_Struct *USARTx)
+{
+    if (memcmp(Test_Slave_Buffer, Test_Request_A, TEST_REQUEST_SIZE) == 0)
+    {
+        Test_Requests_A++;
+        (void)MCAL_UART_Transmit_Size_INT(USARTx, Test_Answer, sizeof(Test_Answer));
+    }
+    else if (memcmp(Test_Slave_Buffer, Test_Request_B, TEST_REQUEST_SIZE) == 0)
+    {
+        Test_Requests_B++;
+    }
+    else
+    {
+        Test_Requests_Bad++;
+    }
+    (void)MCAL_UART_Receive_INT(USARTx, Test_Slave_Buffer, TEST_REQUEST_SIZE, TEST_NO_ELEMENT);
+}
+
+
+/// @brief  Test_Done      : the end of every request.
+/// @param  Copy_ID        : the slave ID.
+/// @param  Copy_Status    : the request status.
+/// @return None.
+static void Test_Done(u8 Copy_ID , Uart_Fun_Status Copy_Status)
+{
+    if (Copy_ID < 2U){ Test_Done_Count[Copy_ID]++; }
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    POLL_Slave_Config Local_Slave = { &Test_Master, Test_Request_A, TEST_REQUEST_SIZE, Test_Response_A, TEST_RESPONSE_SIZE,
+                                      '\n', TEST_TIMEOUT_US };
+    struct timespec Local_Pause = { 0, 1000000L };
+    POLL_Slave_Stats Local_Stats_A, Local_Stats_B;
+    POLL_Port_Stats  Local_Port;
+    char Local_Name[64];
+    u16  Local_Tick;
+    u8   Local_ID_A, Local_ID_B;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_Master, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_Slaves, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_Master, &Local_Frame, &Local_Receiving, 921600UL);
+    (void)MCAL_UART_Init_(&Test_Slaves, &Local_Frame, &Local_Receiving, 921600UL);
+    (void)MCAL_UART_Enable(&Test_Master);
+    (void)MCAL_UART_Enable(&Test_Slaves);
+    (void)MCAL_UART_RX_CALLBACK(&Test_Slaves, Test_Slave_End);
+    (void)MCAL_UART_Receive_INT(&Test_Slaves, Test_Slave_Buffer, TEST_REQUEST_SIZE, TEST_NO_ELEMENT);
+
+    if (POLL_Add_Slave(&Local_Slave, &Local_ID_A) != Uart_OK){ printf("FAIL : POLL_Add_Slave\n"); return 1; }
+    Local_Slave.Request  = Test_Request_B;
+    Local_Slave.Response = Test_Response_B;
+    if (POLL_Add_Slave(&Local_Slave, &Local_ID_B) != Uart_OK){ printf("FAIL : POLL_Add_Slave\n"); return 1; }
+
+    // the RX callback of the master is owned by another function, so the polling does not start.
+    (void)MCAL_UART_RX_CALLBACK(&Test_Master, Test_Foreign);
+    if ((POLL_Start(Test_Done) != Uart_BUSY) || (Test_Master.RX_CallBack != Test_Foreign) || (Test_Master.TX_CallBack != NULL))
+    {
+        printf("FAIL : the callbacks of another function are taken over\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_RX_CALLBACK(&Test_Master, NULL);
+    if (POLL_Start(Test_Done) != Uart_OK){ printf("FAIL : POLL_Start\n"); return 1; }
+    for (Local_Tick = 0; Local_Tick < TEST_TICKS; Local_Tick++)
+    {
+        nanosleep(&Local_Pause, NULL);
+        POLL_Tick();
+    }
+    (void)POLL_Stop();
+    // the request in progress ends by its response or its timeout.
+    for (Local_Tick = 0; Local_Tick < 50U; Local_Tick++)
+    {
+        nanosleep(&Local_Pause, NULL);
+        POLL_Tick();
+    }
+
+    (void)POLL_Get_Slave_Stats(Local_ID_A, &Local_Stats_A);
+    (void)POLL_Get_Slave_Stats(Local_ID_B, &Local_Stats_B);
+    (void)POLL_Get_Port_Stats(&Test_Master, &Local_Port);
+    if ((Local_Stats_A.Responses < 3U) || (Local_Stats_A.Timeouts != 0) || (Local_Stats_A.Errors != 0) ||
+        (Local_Stats_A.Last_Size != 3U) || (memcmp(Test_Response_A, Test_Answer, sizeof(Test_Answer)) != 0))
+    {
+        printf("FAIL : the first slave (%lu responses, %lu timeouts, %lu errors, last size %u)\n",
+               (unsigned long)Local_Stats_A.Responses, (unsigned long)Local_Stats_A.Timeouts,
+               (unsigned long)Local_Stats_A.Errors, Local_Stats_A.Last_Size);
+        Local_Pass = 0;
+    }
+    if ((Local_Stats_B.Responses != 0) || (Local_Stats_B.Timeouts < 3U))
+    {
+        printf("FAIL : the second slave (%lu responses, %lu timeouts)\n",
+               (unsigned long)Local_Stats_B.Responses, (unsigned long)Local_Stats_B.Timeouts);
+        Local_Pass = 0;
+    }
+    // every request arrives in one piece.
+    if ((Test_Requests_Bad != 0) || (Test_Requests_A != Local_Stats_A.Responses) || (Test_Requests_B != Local_Stats_B.Timeouts))
+    {
+        printf("FAIL : the slaves got %lu + %lu requests and %lu damaged ones\n", (unsigned long)Test_Requests_A,
+               (unsigned long)Test_Requests_B, (unsigned long)Test_Requests_Bad);
+        Local_Pass = 0;
+    }
+    if ((Local_Port.Transactions != (Local_Stats_A.Responses + Local_Stats_B.Timeouts)) ||
+        (Test_Done_Count[Local_ID_A] != Local_Stats_A.Responses) || (Test_Done_Count[Local_ID_B] != Local_Stats_B.Timeouts) ||
+        (Local_Port.Cycles < 3U) || (Local_Port.Max_Cycle < __UART_US_TO_CYCLES(TEST_TIMEOUT_US)))
+    {
+        printf("FAIL : the port statistics (%lu transactions, %lu cycles)\n", (unsigned long)Local_Port.Transactions,
+               (unsigned long)Local_Port.Cycles);
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_Slaves);
+    (void)MCAL_UART_Posix_Close(&Test_Master);
+    printf("%s : POLL loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif
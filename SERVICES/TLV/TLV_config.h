@@ -0,0 +1,22 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Streaming TLV Encoder			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		TLV_CONFIG_H
+#define		TLV_CONFIG_H
+
+/********************************************************************************************/
+/*	the longest time (in micro seconds) to wait for a place in the write ring, the			*/
+/*	message is cut after it																	*/
+/********************************************************************************************/
+#define TLV_WAIT_US             20000UL
+/********************************************************************************************/
+/*	the deepest nesting of the groups (the message is the first one)						*/
+/********************************************************************************************/
+#define TLV_MAX_DEPTH           8U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,85 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Streaming TLV Encoder				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		TLV_INTERFACE_H
+#define		TLV_INTERFACE_H
+
+/********************************************************************************************/
+/*	A message is encoded field by field straight into the write ring of the driver			*/
+/*	(MCAL_UART_Write), which is sent by the Interrupt while the next fields are encoded,	*/
+/*	so the message is never held whole : the RAM is the ring and one COBS block			*/
+/*	(TLV_BLOCK_SIZE elements) of the encoder, for any message size. When the ring is full	*/
+/*	the encoder waits for the Interrupt to send it (the backpressure), up to TLV_WAIT_US,	*/
+/*	then the message is cut and the next one starts by a delimiter, so the host drops		*/
+/*	only the cut one. The nested structs are groups that end by a key, so their size is	*/
+/*	not needed first. The service needs the USART_WRITE option of the driver, the port is	*/
+/*	started by MCAL_UART_Write_Start. The host decoder is (tlv_decode.py).					*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The state of one encoder.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	USART_Struct	*Port;						/*	 	The port, in the buffered write mode			 	  */
+	u32				 Messages;					/*	 		Number of the ended messages				  		  */
+	u32				 Bytes;						/*	 	Number of the elements given to the write ring		  */
+	u32				 Stalls;					/*	 Number of the waits for a place in the write ring	  */
+	u8				 Block[TLV_BLOCK_SIZE];		/*	 	The COBS block that waits for the ring, its code first */
+	u8				 Block_Count;				/*	 		Number of the elements of the block			  		  */
+	u8				 Depth;						/*	 		Number of the open groups					  		  */
+	u8				 Cut;						/*	 	A wait timed out, the message in progress is cut	  */
+	u8				 Resync;					/*	 	A message was cut, the next one starts by a delimiter  */
+
+}TLV_Encoder;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Streaming TLV Encoder Functions Prototypes           		        */
+/********************************************************************************************/
+/// @brief  TLV_Init     : this function prepares an encoder of a port.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @param  USARTx       : the Struct of the USART Peripheral, started by MCAL_UART_Write_Start.
+/// @retval Functions Status.
+Uart_Fun_Status	    TLV_Init(TLV_Encoder *Copy_Encoder , USART_Struct *USARTx);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TLV_Begin    : this function starts a message (at the first level) or a nested group.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @param  Copy_Tag     : the tag of the message or the group (1 to 0x1FFFFFFF).
+/// @retval Functions Status, (Uart_OVERSIZE) if TLV_MAX_DEPTH groups are open.
+Uart_Fun_Status	    TLV_Begin(TLV_Encoder *Copy_Encoder , u32 Copy_Tag);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TLV_End      : this function ends the last open group, the end of a message starts its Transmission.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @retval Functions Status, (Uart_ERROR) if no group is open or the message was cut.
+Uart_Fun_Status	    TLV_End(TLV_Encoder *Copy_Encoder);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TLV_Put_Unsigned : this function adds an unsigned field.
+/// @param  Copy_Encoder     : pointer to the encoder.
+/// @param  Copy_Tag         : the tag of the field (1 to 0x1FFFFFFF).
+/// @param  Copy_Value       : the value.
+/// @retval Functions Status, (Uart_TIMEOUT) if the ring had no place in TLV_WAIT_US (the message is cut).
+Uart_Fun_Status	    TLV_Put_Unsigned(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , u32 Copy_Value);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TLV_Put_Signed : this function adds a signed field (a zigzag varint, so small negative values are short).
+/// @param  Copy_Encoder   : pointer to the encoder.
+/// @param  Copy_Tag       : the tag of the field (1 to 0x1FFFFFFF).
+/// @param  Copy_Value     : the value.
+/// @retval Functions Status, (Uart_TIMEOUT) if the ring had no place in TLV_WAIT_US (the message is cut).
+Uart_Fun_Status	    TLV_Put_Signed(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , s32 Copy_Value);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TLV_Put_Bytes : this function adds a field of elements.
+/// @param  Copy_Encoder  : pointer to the encoder.
+/// @param  Copy_Tag      : the tag of the field (1 to 0x1FFFFFFF).
+/// @param  Copy_Data     : pointer of the elements.
+/// @param  Copy_Size     : the number of the elements.
+/// @retval Functions Status, (Uart_TIMEOUT) if the ring had no place in TLV_WAIT_US (the message is cut).
+Uart_Fun_Status	    TLV_Put_Bytes(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , const u8 *Copy_Data , u16 Copy_Size);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,36 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Streaming TLV Encoder				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		TLV_PRIVATE_H
+#define		TLV_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Wire Format                      			        */
+/********************************************************************************************/
+/*	every field starts by its key, the varint of ((tag << 3) | type), then :				*/
+/*		TLV_TYPE_UNSIGNED	: the varint of the value										*/
+/*		TLV_TYPE_SIGNED		: the varint of the zigzag value								*/
+/*		TLV_TYPE_BYTES		: the varint of the size, then the elements						*/
+/*		TLV_TYPE_GROUP		: the fields of the group, till the key of TLV_TYPE_END (tag 0)	*/
+/*	a message is a group at the first level, so no size is sent before its fields.			*/
+/*	a varint holds 7 bits per element, the {LSB} first, the 8th bit is set if more follow.	*/
+/*	every message is a COBS frame ended by the delimiter (0x00), it is encoded block by		*/
+/*	block while the fields are added. A cut message has no delimiter, so the next message	*/
+/*	starts by one : the host drops the broken frame and decodes the next one.				*/
+/********************************************************************************************/
+#define     TLV_TYPE_UNSIGNED       0U
+#define     TLV_TYPE_SIGNED         1U
+#define     TLV_TYPE_BYTES          2U
+#define     TLV_TYPE_GROUP          3U
+#define     TLV_TYPE_END            4U
+
+/*	the COBS block : its code and the 254 elements before the next (0x00)	*/
+#define     TLV_BLOCK_SIZE          255U
+#define     TLV_BLOCK_FULL          0xFFU
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,291 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Streaming TLV Encoder				*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "SERVICES/COBS/COBS_interface.h"
+
+#include "TLV_config.h"
+#include "TLV_private.h"
+#include "TLV_interface.h"
+
+#if USART_WRITE != Enable
+#error "the Streaming TLV Encoder needs the USART_WRITE option (MCAL_UART_Write)"
+#endif
+/********************************************************************************************/
+static Uart_Fun_Status TLV_Put_Key(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , u8 Copy_Type);
+static Uart_Fun_Status TLV_Put_Varint(TLV_Encoder *Copy_Encoder , u32 Copy_Value);
+static Uart_Fun_Status TLV_Put_Element(TLV_Encoder *Copy_Encoder , u8 Copy_Element);
+static Uart_Fun_Status TLV_Write(TLV_Encoder *Copy_Encoder , const u8 *Copy_Data , u16 Copy_Size);
+/********************************************************************************************/
+
+
+/// @brief  TLV_Init     : this function prepares an encoder of a port.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @param  USARTx       : the Struct of the USART Peripheral, started by MCAL_UART_Write_Start.
+/// @retval Functions Status.
+Uart_Fun_Status	    TLV_Init(TLV_Encoder *Copy_Encoder , USART_Struct *USARTx)
+{
+    if ((Copy_Encoder == NULL) || (USARTx == NULL) || (USARTx -> Write_Buffer == NULL)){ return Uart_ERROR; }
+
+    // the waits are measured by the DWT cycle counter.
+    __UART_DWT_ENABLE();
+    Copy_Encoder -> Port        = USARTx;
+    Copy_Encoder -> Messages    = 0;
+    Copy_Encoder -> Bytes       = 0;
+    Copy_Encoder -> Stalls      = 0;
+    Copy_Encoder -> Block_Count = 0;
+    Copy_Encoder -> Depth       = 0;
+    Copy_Encoder -> Cut         = 0;
+    // the host may have seen a part of an older frame on the line.
+    Copy_Encoder -> Resync      = 1;
+    return Uart_OK;
+}
+
+
+/// @brief  TLV_Begin    : this function starts a message (at the first level) or a nested group.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @param  Copy_Tag     : the tag of the message or the group (1 to 0x1FFFFFFF).
+/// @retval Functions Status, (Uart_OVERSIZE) if TLV_MAX_DEPTH groups are open.
+Uart_Fun_Status	    TLV_Begin(TLV_Encoder *Copy_Encoder , u32 Copy_Tag)
+{
+    Uart_Fun_Status Local_Status = Uart_OK;
+    const u8 Local_Delimiter = COBS_DELIMITER;
+
+    if ((Copy_Encoder == NULL) || (Copy_Encoder -> Port == NULL)){ return Uart_ERROR; }
+    if (Copy_Encoder -> Depth >= TLV_MAX_DEPTH){ return Uart_OVERSIZE; }
+
+    if (Copy_Encoder -> Depth == 0)
+    {
+        Copy_Encoder -> Cut         = 0;
+        Copy_Encoder -> Block_Count = 0;
+        // the delimiter ends the frame of the cut message, so the host drops it.
+        if (Copy_Encoder -> Resync == 1)
+        {
+            Local_Status = TLV_Write(Copy_Encoder, &Local_Delimiter, 1);
+            if (Local_Status == Uart_OK){ Copy_Encoder -> Resync = 0; }
+        }
+    }
+    if (Local_Status == Uart_OK)
+    {
+        Local_Status = TLV_Put_Key(Copy_Encoder, Copy_Tag, TLV_TYPE_GROUP);
+    }
+    // the group is open even if the message is cut, so TLV_End stays paired with it.
+    Copy_Encoder -> Depth++;
+    return Local_Status;
+}
+
+
+/// @brief  TLV_End      : this function ends the last open group, the end of a message starts its Transmission.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @retval Functions Status, (Uart_ERROR) if no group is open or the message was cut.
+Uart_Fun_Status	    TLV_End(TLV_Encoder *Copy_Encoder)
+{
+    Uart_Fun_Status Local_Status;
+
+    if ((Copy_Encoder == NULL) || (Copy_Encoder -> Port == NULL) || (Copy_Encoder -> Depth == 0)){ return Uart_ERROR; }
+
+    Copy_Encoder -> Depth--;
+    if (Copy_Encoder -> Cut == 1){ return Uart_ERROR; }
+
+    Local_Status = TLV_Put_Key(Copy_Encoder, 0, TLV_TYPE_END);
+    if ((Local_Status == Uart_OK) && (Copy_Encoder -> Depth == 0))
+    {
+        // the last block and the delimiter, the block has a place for it (a full block is already sent).
+        Copy_Encoder -> Block[0] = (u8)(Copy_Encoder -> Block_Count + 1U);
+        Copy_Encoder -> Block[Copy_Encoder -> Block_Count + 1U] = COBS_DELIMITER;
+        Local_Status = TLV_Write(Copy_Encoder, Copy_Encoder -> Block, (u16)(Copy_Encoder -> Block_Count + 2U));
+        Copy_Encoder -> Block_Count = 0;
+        if (Local_Status == Uart_OK)
+        {
+            // the message does not wait for the threshold nor the deadline of the ring.
+            (void)MCAL_UART_Write_Flush(Copy_Encoder -> Port);
+            Copy_Encoder -> Messages++;
+        }
+    }
+    return Local_Status;
+}
+
+
+/// @brief  TLV_Put_Unsigned : this function adds an unsigned field.
+/// @param  Copy_Encoder     : pointer to the encoder.
+/// @param  Copy_Tag         : the tag of the field (1 to 0x1FFFFFFF).
+/// @param  Copy_Value       : the value.
+/// @retval Functions Status, (Uart_TIMEOUT) if the ring had no place in TLV_WAIT_US (the message is cut).
+Uart_Fun_Status	    TLV_Put_Unsigned(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , u32 Copy_Value)
+{
+    Uart_Fun_Status Local_Status = TLV_Put_Key(Copy_Encoder, Copy_Tag, TLV_TYPE_UNSIGNED);
+
+    if (Local_Status != Uart_OK){ return Local_Status; }
+    return TLV_Put_Varint(Copy_Encoder, Copy_Value);
+}
+
+
+/// @brief  TLV_Put_Signed : this function adds a signed field (a zigzag varint, so small negative values are short).
+/// @param  Copy_Encoder   : pointer to the encoder.
+/// @param  Copy_Tag       : the tag of the field (1 to 0x1FFFFFFF).
+/// @param  Copy_Value     : the value.
+/// @retval Functions Status, (Uart_TIMEOUT) if the ring had no place in TLV_WAIT_US (the message is cut).
+Uart_Fun_Status	    TLV_Put_Signed(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , s32 Copy_Value)
+{
+    Uart_Fun_Status Local_Status = TLV_Put_Key(Copy_Encoder, Copy_Tag, TLV_TYPE_SIGNED);
+
+    if (Local_Status != Uart_OK){ return Local_Status; }
+    return TLV_Put_Varint(Copy_Encoder, ((u32)Copy_Value << 1) ^ (u32)(Copy_Value >> 31));
+}
+
+
+/// @brief  TLV_Put_Bytes : this function adds a field of elements.
+/// @param  Copy_Encoder  : pointer to the encoder.
+/// @param  Copy_Tag      : the tag of the field (1 to 0x1FFFFFFF).
+/// @param  Copy_Data     : pointer of the elements.
+/// @param  Copy_Size     : the number of the elements.
+/// @retval Functions Status, (Uart_TIMEOUT) if the ring had no place in TLV_WAIT_US (the message is cut).
+Uart_Fun_Status	    TLV_Put_Bytes(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , const u8 *Copy_Data , u16 Copy_Size)
+{
+    Uart_Fun_Status Local_Status;
+
+    if ((Copy_Data == NULL) && (Copy_Size != 0)){ return Uart_ERROR; }
+    Local_Status = TLV_Put_Key(Copy_Encoder, Copy_Tag, TLV_TYPE_BYTES);
+    if (Local_Status == Uart_OK)
+    {
+        Local_Status = TLV_Put_Varint(Copy_Encoder, Copy_Size);
+    }
+    while ((Local_Status == Uart_OK) && (Copy_Size-- > 0))
+    {
+        Local_Status = TLV_Put_Element(Copy_Encoder, *Copy_Data++);
+    }
+    return Local_Status;
+}
+
+
+/// @brief  TLV_Put_Key  : it adds the key of a field.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @param  Copy_Tag     : the tag of the field.
+/// @param  Copy_Type    : the type of the field.
+/// @retval Functions Status.
+static Uart_Fun_Status TLV_Put_Key(TLV_Encoder *Copy_Encoder , u32 Copy_Tag , u8 Copy_Type)
+{
+    if ((Copy_Encoder == NULL) || (Copy_Encoder -> Port == NULL) || (Copy_Tag > 0x1FFFFFFFUL) ||
+        ((Copy_Tag == 0) && (Copy_Type != TLV_TYPE_END))){ return Uart_ERROR; }
+    // the fields of a cut message are not sent.
+    if (Copy_Encoder -> Cut == 1){ return Uart_ERROR; }
+
+    return TLV_Put_Varint(Copy_Encoder, (Copy_Tag << 3) | Copy_Type);
+}
+
+
+/// @brief  TLV_Put_Varint : it adds a varint (7 bits per element, {LSB} first).
+/// @param  Copy_Encoder   : pointer to the encoder.
+/// @param  Copy_Value     : the value.
+/// @retval Functions Status.
+static Uart_Fun_Status TLV_Put_Varint(TLV_Encoder *Copy_Encoder , u32 Copy_Value)
+{
+    Uart_Fun_Status Local_Status = Uart_OK;
+
+    while ((Local_Status == Uart_OK) && (Copy_Value >= 0x80))
+    {
+        Local_Status = TLV_Put_Element(Copy_Encoder, (u8)(Copy_Value | 0x80));
+        Copy_Value >>= 7;
+    }
+    if (Local_Status == Uart_OK)
+    {
+        Local_Status = TLV_Put_Element(Copy_Encoder, (u8)Copy_Value);
+    }
+    return Local_Status;
+}
+
+
+/// @brief  TLV_Put_Element : it adds one element to the COBS block, the block is given to the write ring at a (0x00)
+///                           element (its code holds the place of the zero) or when it is full.
+/// @param  Copy_Encoder    : pointer to the encoder.
+/// @param  Copy_Element    : the element.
+/// @retval Functions Status.
+static Uart_Fun_Status TLV_Put_Element(TLV_Encoder *Copy_Encoder , u8 Copy_Element)
+{
+    Uart_Fun_Status Local_Status = Uart_OK;
+
+    if (Copy_Encoder -> Cut == 1){ return Uart_TIMEOUT; }
+
+    if (Copy_Element == COBS_DELIMITER)
+    {
+        Copy_Encoder -> Block[0] = (u8)(Copy_Encoder -> Block_Count + 1U);
+        Local_Status = TLV_Write(Copy_Encoder, Copy_Encoder -> Block, (u16)(Copy_Encoder -> Block_Count + 1U));
+        Copy_Encoder -> Block_Count = 0;
+    }
+    else
+    {
+        Copy_Encoder -> Block[++Copy_Encoder -> Block_Count] = Copy_Element;
+        if (Copy_Encoder -> Block_Count == (TLV_BLOCK_SIZE - 1U))
+        {
+            // a full block has no zero after it.
+            Copy_Encoder -> Block[0] = TLV_BLOCK_FULL;
+            Local_Status = TLV_Write(Copy_Encoder, Copy_Encoder -> Block, TLV_BLOCK_SIZE);
+            Copy_Encoder -> Block_Count = 0;
+        }
+    }
+    return Local_Status;
+}
+
+
+/// @brief  TLV_Write    : it copies elements into the write ring, it waits while the ring is full (the backpressure)
+///                        and cuts the message if the time ends.
+/// @param  Copy_Encoder : pointer to the encoder.
+/// @param  Copy_Data    : pointer of the elements.
+/// @param  Copy_Size    : the number of the elements.
+/// @retval Functions Status.
+static Uart_Fun_Status TLV_Write(TLV_Encoder *Copy_Encoder , const u8 *Copy_Data , u16 Copy_Size)
+{
+    USART_Struct *USARTx = Copy_Encoder -> Port;
+    u32 Local_Start   = 0;
+    u16 Local_In;
+    u16 Local_Piece;
+    u8  Local_Stalled = 0;
+    Uart_Fun_Status Local_Status;
+
+    // half of the ring at most, so a piece is copied while the other half is sent.
+    Local_Piece = (u16)((USARTx -> Write_Size - 1U) / 2U);
+    if (Local_Piece == 0){ Local_Piece = 1; }
+    while (Copy_Size > 0)
+    {
+        if (Local_Piece > Copy_Size){ Local_Piece = Copy_Size; }
+        Local_In     = USARTx -> Write_In;
+        Local_Status = MCAL_UART_Write(USARTx, Copy_Data, Local_Piece);
+        // the elements are taken if the ring index moved, a Transmission that could not start keeps them in the ring.
+        if (USARTx -> Write_In != Local_In)
+        {
+            Copy_Encoder -> Bytes += Local_Piece;
+            Copy_Data     += Local_Piece;
+            Copy_Size     -= Local_Piece;
+            Local_Stalled  = 0;
+            continue;
+        }
+        if (Local_Status != Uart_BUSY){ return Uart_ERROR; }
+
+        if (Local_Stalled == 0)
+        {
+            Local_Stalled = 1;
+            Local_Start   = DWT_CYCCNT_R;
+            Copy_Encoder -> Stalls++;
+        }
+        else if ((DWT_CYCCNT_R - Local_Start) >= __UART_US_TO_CYCLES(TLV_WAIT_US))
+        {
+            // the frame has no delimiter now, the next message sends it first.
+            Copy_Encoder -> Cut    = 1;
+            Copy_Encoder -> Resync = 1;
+            return Uart_TIMEOUT;
+        }
+        // the ring is sent without its threshold, so it has a place again.
+        (void)MCAL_UART_Write_Flush(USARTx);
+    }
+    return Uart_OK;
+}
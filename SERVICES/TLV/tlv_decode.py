@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Host decoder of the Streaming TLV Encoder (TLV).
+
+Every message is a COBS frame delimited by 0x00. In the frame, every field
+starts by its key, the varint of ((tag << 3) | type):
+    0 unsigned : varint value
+    1 signed   : zigzag varint value
+    2 bytes    : varint size, then the elements
+    3 group    : the fields of the group, till an end key (tag 0, type 4)
+A message is a group at the first level, it is printed as an indented tree.
+A message cut by the target is a broken frame, it is reported and dropped.
+
+usage: tlv_decode.py capture.bin
+       tlv_decode.py /dev/ttyUSB0 --baud 115200   (needs pyserial)
+"""
+import argparse
+import sys
+
+UNSIGNED, SIGNED, BYTES, GROUP, END = range(5)
+
+
+def cobs_decode(frame):
+    out = bytearray()
+    i = 0
+    while i < len(frame):
+        code = frame[i]
+        if code == 0 or i + code > len(frame) + 1:
+            raise ValueError("bad COBS code")
+        out += frame[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def frames(source):
+    buffer = bytearray()
+    while True:
+        chunk = source.read(256)
+        if not chunk:
+            if buffer:
+                yield None
+            return
+        buffer += chunk
+        while b"\0" in buffer:
+            end = buffer.index(b"\0")
+            if end:
+                yield bytes(buffer[:end])
+            del buffer[:end + 1]
+
+
+class Reader(object):
+    def __init__(self, data):
+        self.data = data
+        self.at = 0
+
+    def element(self):
+        if self.at >= len(self.data):
+            raise ValueError("truncated field")
+        self.at += 1
+        return self.data[self.at - 1]
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            byte = self.element()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+            if shift > 35:
+                raise ValueError("varint longer than 5 elements")
+
+    def elements(self, size):
+        if self.at + size > len(self.data):
+            raise ValueError("truncated field")
+        self.at += size
+        return self.data[self.at - size:self.at]
+
+
+def show(data):
+    if data and all(32 <= byte < 127 for byte in data):
+        return '"%s"' % data.decode()
+    return data.hex(" ") or "<empty>"
+
+
+def message(raw):
+    """Return the lines of one message, or raise ValueError if it is not whole."""
+    reader = Reader(raw)
+    lines = []
+    depth = 0
+    while True:
+        key = reader.varint()
+        tag, kind = key >> 3, key & 7
+        indent = "  " * depth
+        if kind == GROUP and tag != 0:
+            lines.append("%s%d {" % (indent, tag))
+            depth += 1
+        elif depth == 0:
+            raise ValueError("the message is not a group (key 0x%X)" % key)
+        elif kind == END and tag == 0:
+            depth -= 1
+            lines.append("  " * depth + "}")
+            if depth == 0:
+                break
+        elif kind == UNSIGNED and tag != 0:
+            lines.append("%s%d: %d" % (indent, tag, reader.varint()))
+        elif kind == SIGNED and tag != 0:
+            raw_value = reader.varint()
+            lines.append("%s%d: %d" % (indent, tag, (raw_value >> 1) ^ -(raw_value & 1)))
+        elif kind == BYTES and tag != 0:
+            lines.append("%s%d: %s" % (indent, tag, show(reader.elements(reader.varint()))))
+        else:
+            raise ValueError("bad key 0x%X" % key)
+    if reader.at != len(raw):
+        raise ValueError("%d element(s) after the message" % (len(raw) - reader.at))
+    return lines
+
+
+def decode(stream, out=sys.stdout):
+    """Print the messages, return (messages, dropped)."""
+    messages = dropped = 0
+    for frame in stream:
+        try:
+            if frame is None:
+                raise ValueError("no delimiter at the end of the capture")
+            lines = message(cobs_decode(frame))
+        except ValueError as error:
+            out.write("<message dropped: %s>\n" % error)
+            dropped += 1
+            continue
+        out.write("\n".join(lines) + "\n")
+        messages += 1
+    return messages, dropped
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="a capture file or a serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    options = parser.parse_args()
+
+    if options.input.startswith("/dev/"):
+        import serial
+        source = serial.Serial(options.input, options.baud)
+    else:
+        source = open(options.input, "rb")
+    messages, dropped = decode(frames(source))
+    sys.stderr.write("%d message(s), %d dropped\n" % (messages, dropped))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Configuration file For the Priority Transmit Queues		*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		TXQ_CONFIG_H
+#define		TXQ_CONFIG_H
+
+/********************************************************************************************/
+/*	the number of the priority queues of every port, the queue (0) is the highest			*/
+/********************************************************************************************/
+#define TXQ_QUEUES_NUM          3U
+/********************************************************************************************/
+/*	the maximum number of the frames waiting in one queue									*/
+/********************************************************************************************/
+#define TXQ_QUEUE_DEPTH         4U
+/********************************************************************************************/
+/*	the preemption of the lowest priority queue (the bulk frames) :							*/
+/*		(Enable) : a bulk frame is sent in chunks of TXQ_PREEMPT_CHUNK elements, and the	*/
+/*				   higher queues are sent between its chunks. Use it only when the receiver	*/
+/*				   reads the bulk frames as a stream (they have no delimiters or the higher */
+/*				   frames can be separated from them), as a frame is cut by other frames.	*/
+/*		(Disable): a frame is always sent to its end.										*/
+/*	it can also be given to the compiler, like (-DTXQ_PREEMPT=Enable).						*/
+/********************************************************************************************/
+#ifndef TXQ_PREEMPT
+#define TXQ_PREEMPT             Disable
+#endif
+#define TXQ_PREEMPT_CHUNK       16U
+/********************************************************************************************/
+/*	the latency histogram : bucket (i) counts the latencies below 2^(i+1+TXQ_HIST_FIRST)	*/
+/*	DWT cycles, the last bucket counts the rest (16 buckets from 2^11 cycles = 128us at 16	*/
+/*	MHz to 4 seconds).																		*/
+/********************************************************************************************/
+#define TXQ_HIST_BUCKETS        16U
+#define TXQ_HIST_FIRST          10U
+/********************************************************************************************/
+
+#endif
@@ -0,0 +1,73 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Interface file For the Priority Transmit Queues			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		TXQ_INTERFACE_H
+#define		TXQ_INTERFACE_H
+
+/********************************************************************************************/
+/*	Every port has TXQ_QUEUES_NUM queues of frames, the queue (0) has the highest priority.	*/
+/*	A frame is sent from its place (it is not copied), and the TX callback of the port		*/
+/*	starts the oldest frame of the highest queue that has frames at the end of every frame,	*/
+/*	so a command waits for one frame at most instead of a full queue of telemetry. With		*/
+/*	TXQ_PREEMPT, it waits for one chunk of a bulk frame at most.							*/
+/*	The port is owned by the service : its TX callback is claimed by the first TXQ_Send		*/
+/*	(MCAL_UART_Claim_CALLBACKS), and MCAL_UART_Transmit_INT should not be called on it by	*/
+/*	the application. Its RX callback is free for another service.							*/
+/********************************************************************************************/
+
+/********************************************************************************************/
+/*          		   	The statistics of one queue.          	  		        			*/
+/********************************************************************************************/
+typedef struct{
+
+	u32				 Frames;					/*	 		Number of the sent frames					  		  */
+	u32				 Dropped;					/*	 Number of the frames dropped as the queue was full or the TX */
+												/*	 		failed										  		  */
+	u32				 Preempted;					/*	 Number of the times a frame was cut by a higher queue		  */
+	u32				 Max_Cycles;				/*	 The highest latency (from TXQ_Send to the frame end) in DWT  */
+												/*	 		cycles										  		  */
+	u32				 Histogram[TXQ_HIST_BUCKETS];	/*	 	The latencies histogram (see TXQ_HIST_FIRST)	  	  */
+
+}TXQ_Stats;
+/********************************************************************************************/
+
+
+/********************************************************************************************/
+/*             		The Priority Queues Functions Prototypes      		            		*/
+/********************************************************************************************/
+/// @brief  TXQ_Send         : this function adds a frame to a queue of the port, and starts it if the port is free.
+/// @param  Copy_Port        : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Priority    : the queue of the frame, (0) is the highest priority.
+/// @param  Copy_Frame       : pointer to the frame, it should not be changed until the frame is sent (TXQ_Get_Pending).
+/// @param  Copy_Size        : the size of the frame.
+/// @retval Functions Status, (Uart_BUSY) if the queue is full, (Uart_ERROR) if the TX callback of the port is owned by
+///         another service.
+Uart_Fun_Status	    TXQ_Send(USART_Struct *Copy_Port , u8 Copy_Priority , u8 *Copy_Frame , u16 Copy_Size);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TXQ_Get_Pending  : this function gets the number of the frames of a queue that are not sent yet.
+/// @param  Copy_Port        : the Struct of the USART Peripheral.
+/// @param  Copy_Priority    : the queue.
+/// @param  Copy_Count       : pointer to hold the number of the frames.
+/// @retval Functions Status.
+Uart_Fun_Status	    TXQ_Get_Pending(USART_Struct *Copy_Port , u8 Copy_Priority , u8 *Copy_Count);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TXQ_Get_Stats    : this function gets the statistics of a queue of the port.
+/// @param  Copy_Port        : the Struct of the USART Peripheral.
+/// @param  Copy_Priority    : the queue.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    TXQ_Get_Stats(USART_Struct *Copy_Port , u8 Copy_Priority , TXQ_Stats *Copy_Stats);
+/*------------------------------------------------------------------------------------------*/
+/// @brief  TXQ_Get_Percentile : this function gets a latency percentile from the histogram of the statistics, it is
+///                              the upper limit of the bucket of the percentile, so it is never below the real value.
+/// @param  Copy_Stats       : pointer to the statistics of a queue (TXQ_Get_Stats).
+/// @param  Copy_Percent     : the percentile, from 1 to 100 (50 for the median).
+/// @retval the latency in DWT cycles, or (0) if the queue has no sent frames.
+u32                 TXQ_Get_Percentile(const TXQ_Stats *Copy_Stats , u8 Copy_Percent);
+/*------------------------------------------------------------------------------------------*/
+
+#endif
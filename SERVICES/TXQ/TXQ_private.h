@@ -0,0 +1,32 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Private file For the Priority Transmit Queues			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#ifndef		TXQ_PRIVATE_H
+#define		TXQ_PRIVATE_H
+
+/********************************************************************************************/
+/*                   			    The Queues Ports                      			        */
+/********************************************************************************************/
+/*	the USART1, USART2 and USART6 ports		*/
+#define     TXQ_PORTS_NUM           3U
+/*	no port			*/
+#define     TXQ_NO_PORT             0xFFU
+/*	no queue has a frame	*/
+#define     TXQ_NO_QUEUE            0xFFU
+/********************************************************************************************/
+
+#if (TXQ_QUEUES_NUM == 0) || (TXQ_QUEUES_NUM >= TXQ_NO_QUEUE)
+#error "TXQ_QUEUES_NUM should be from 1 to 254"
+#endif
+#if (TXQ_QUEUE_DEPTH == 0) || (TXQ_QUEUE_DEPTH > 255)
+#error "TXQ_QUEUE_DEPTH should be from 1 to 255"
+#endif
+#if (TXQ_HIST_BUCKETS == 0) || ((TXQ_HIST_BUCKETS + TXQ_HIST_FIRST) > 32)
+#error "TXQ_HIST_BUCKETS + TXQ_HIST_FIRST should not be more than 32"
+#endif
+
+#endif
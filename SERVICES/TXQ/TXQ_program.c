@@ -0,0 +1,345 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the Program file For the Priority Transmit Queues			*/
+/*											Service of the USART Peripherals				*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "TXQ_config.h"
+#include "TXQ_private.h"
+#include "TXQ_interface.h"
+/********************************************************************************************/
+/*	A queued frame.	*/
+typedef struct{
+
+	u8				*Frame;
+	u16				 Size;
+	u16				 Sent;									/*	the sent elements (the chunks)	*/
+	u32				 Cycle;									/*	the DWT cycle of TXQ_Send		*/
+
+}TXQ_Frame;
+
+/*	The port entry : its queues and the chunk in progress.	*/
+typedef struct{
+
+	USART_Struct	*Port;
+	TXQ_Frame		 Queue[TXQ_QUEUES_NUM][TXQ_QUEUE_DEPTH];
+	u8				 Queue_Head[TXQ_QUEUES_NUM];
+	u8				 Queue_Count[TXQ_QUEUES_NUM];
+	TXQ_Stats		 Stats[TXQ_QUEUES_NUM];
+	u8				 TX_Busy;
+	u8				 Active;								/*	the queue of the chunk in progress	*/
+	u16				 Chunk;									/*	the size of the chunk in progress	*/
+
+}TXQ_Port_Entry;
+/********************************************************************************************/
+static u8   TXQ_u8GetEntry(USART_Struct *USARTx , u8 Copy_Create);
+static u8   TXQ_u8Highest(TXQ_Port_Entry *Copy_Entry);
+static void TXQ_voidKick(u8 Copy_Entry);
+static void TXQ_voidChunkDone(u8 Copy_Entry);
+static void TXQ_voidFrameDone(TXQ_Port_Entry *Copy_Entry , u8 Copy_Queue , u8 Copy_Sent);
+static void TXQ_voidTXCallBack(USART_Struct *USARTx);
+/********************************************************************************************/
+static TXQ_Port_Entry TXQ_Ports[TXQ_PORTS_NUM];
+/********************************************************************************************/
+
+
+/// @brief  TXQ_Send         : this function adds a frame to a queue of the port, and starts it if the port is free.
+/// @param  Copy_Port        : the Struct of the initialized USART Peripheral.
+/// @param  Copy_Priority    : the queue of the frame, (0) is the highest priority.
+/// @param  Copy_Frame       : pointer to the frame, it should not be changed until the frame is sent (TXQ_Get_Pending).
+/// @param  Copy_Size        : the size of the frame.
+/// @retval Functions Status, (Uart_BUSY) if the queue is full, (Uart_ERROR) if the TX callback of the port is owned by
+///         another service.
+Uart_Fun_Status	    TXQ_Send(USART_Struct *Copy_Port , u8 Copy_Priority , u8 *Copy_Frame , u16 Copy_Size)
+{
+    u8  Local_Index;
+    u32 Local_State;
+    TXQ_Port_Entry *Local_Entry;
+    TXQ_Frame      *Local_Frame;
+
+    if ((Copy_Port == NULL) || (Copy_Frame == NULL) || (Copy_Size == 0) || (Copy_Priority >= TXQ_QUEUES_NUM)){ return Uart_ERROR; }
+
+    Local_Index = TXQ_u8GetEntry(Copy_Port, 1);
+    if (Local_Index == TXQ_NO_PORT){ return Uart_ERROR; }
+    Local_Entry = &TXQ_Ports[Local_Index];
+
+    __UART_ENTER_CRITICAL(Local_State);
+    if (Local_Entry -> Queue_Count[Copy_Priority] >= TXQ_QUEUE_DEPTH)
+    {
+        Local_Entry -> Stats[Copy_Priority].Dropped++;
+        __UART_EXIT_CRITICAL(Local_State);
+        return Uart_BUSY;
+    }
+    Local_Frame = &Local_Entry -> Queue[Copy_Priority][(Local_Entry -> Queue_Head[Copy_Priority] + Local_Entry -> Queue_Count[Copy_Priority]) % TXQ_QUEUE_DEPTH];
+    Local_Frame -> Frame = Copy_Frame;
+    Local_Frame -> Size  = Copy_Size;
+    Local_Frame -> Sent  = 0;
+    Local_Frame -> Cycle = DWT_CYCCNT_R;
+    Local_Entry -> Queue_Count[Copy_Priority]++;
+    __UART_EXIT_CRITICAL(Local_State);
+
+    TXQ_voidKick(Local_Index);
+    return Uart_OK;
+}
+
+
+/// @brief  TXQ_Get_Pending  : this function gets the number of the frames of a queue that are not sent yet.
+/// @param  Copy_Port        : the Struct of the USART Peripheral.
+/// @param  Copy_Priority    : the queue.
+/// @param  Copy_Count       : pointer to hold the number of the frames.
+/// @retval Functions Status.
+Uart_Fun_Status	    TXQ_Get_Pending(USART_Struct *Copy_Port , u8 Copy_Priority , u8 *Copy_Count)
+{
+    u8 Local_Index = TXQ_u8GetEntry(Copy_Port, 0);
+
+    if ((Copy_Count == NULL) || (Copy_Priority >= TXQ_QUEUES_NUM)){ return Uart_ERROR; }
+
+    // a port that has never sent has no frames.
+    *Copy_Count = (Local_Index == TXQ_NO_PORT) ? 0 : TXQ_Ports[Local_Index].Queue_Count[Copy_Priority];
+    return Uart_OK;
+}
+
+
+/// @brief  TXQ_Get_Stats    : this function gets the statistics of a queue of the port.
+/// @param  Copy_Port        : the Struct of the USART Peripheral.
+/// @param  Copy_Priority    : the queue.
+/// @param  Copy_Stats       : pointer to hold the statistics.
+/// @retval Functions Status.
+Uart_Fun_Status	    TXQ_Get_Stats(USART_Struct *Copy_Port , u8 Copy_Priority , TXQ_Stats *Copy_Stats)
+{
+    u8  Local_Index = TXQ_u8GetEntry(Copy_Port, 0);
+    u32 Local_State;
+
+    if ((Copy_Stats == NULL) || (Copy_Priority >= TXQ_QUEUES_NUM) || (Local_Index == TXQ_NO_PORT)){ return Uart_ERROR; }
+
+    __UART_ENTER_CRITICAL(Local_State);
+    *Copy_Stats = TXQ_Ports[Local_Index].Stats[Copy_Priority];
+    __UART_EXIT_CRITICAL(Local_State);
+    return Uart_OK;
+}
+
+
+/// @brief  TXQ_Get_Percentile : this function gets a latency percentile from the histogram of the statistics, it is
+///                              the upper limit of the bucket of the percentile, so it is never below the real value.
+/// @param  Copy_Stats       : pointer to the statistics of a queue (TXQ_Get_Stats).
+/// @param  Copy_Percent     : the percentile, from 1 to 100 (50 for the median).
+/// @retval the latency in DWT cycles, or (0) if the queue has no sent frames.
+u32                 TXQ_Get_Percentile(const TXQ_Stats *Copy_Stats , u8 Copy_Percent)
+{
+    u8  Local_Bucket;
+    u32 Local_Count = 0;
+    u32 Local_Limit;
+    u32 Local_Total = 0;
+
+    if ((Copy_Stats == NULL) || (Copy_Percent == 0) || (Copy_Percent > 100)){ return 0; }
+
+    for (Local_Bucket = 0; Local_Bucket < TXQ_HIST_BUCKETS; Local_Bucket++)
+    {
+        Local_Total += Copy_Stats -> Histogram[Local_Bucket];
+    }
+    if (Local_Total == 0){ return 0; }
+
+    // the rank of the percentile, rounded up (the frames of the histogram are counted in 32 bits).
+    Local_Limit = (Local_Total / 100U) * Copy_Percent + ((Local_Total % 100U) * Copy_Percent + 99U) / 100U;
+    for (Local_Bucket = 0; Local_Bucket < (TXQ_HIST_BUCKETS - 1); Local_Bucket++)
+    {
+        Local_Count += Copy_Stats -> Histogram[Local_Bucket];
+        if (Local_Count >= Local_Limit)
+        {
+            // the upper limit of the bucket, the highest latency is a closer limit for the last frames.
+            Local_Limit = (u32)1 << (Local_Bucket + 1 + TXQ_HIST_FIRST);
+            return (Copy_Stats -> Max_Cycles < Local_Limit) ? Copy_Stats -> Max_Cycles : Local_Limit;
+        }
+    }
+    // the last bucket has no upper limit.
+    return Copy_Stats -> Max_Cycles;
+}
+
+
+/// @brief  TXQ_u8GetEntry   : it finds the entry of a port.
+/// @param  USARTx           : the Struct of the USART Peripheral.
+/// @param  Copy_Create      : (1) to use a free entry if the port has no entry, its TX callback is claimed.
+/// @retval the entry index, or TXQ_NO_PORT.
+static u8 TXQ_u8GetEntry(USART_Struct *USARTx , u8 Copy_Create)
+{
+    u8  Local_Index;
+    u8  Local_Queue;
+    u32 Local_State;
+
+    for (Local_Index = 0; Local_Index < TXQ_PORTS_NUM; Local_Index++)
+    {
+        if (TXQ_Ports[Local_Index].Port == USARTx){ return Local_Index; }
+    }
+    if ((Copy_Create == 0) || (USARTx == NULL)){ return TXQ_NO_PORT; }
+
+    __UART_ENTER_CRITICAL(Local_State);
+    for (Local_Index = 0; Local_Index < TXQ_PORTS_NUM; Local_Index++)
+    {
+        if (TXQ_Ports[Local_Index].Port == NULL)
+        {
+            for (Local_Queue = 0; Local_Queue < TXQ_QUEUES_NUM; Local_Queue++)
+            {
+                TXQ_Ports[Local_Index].Queue_Head[Local_Queue]  = 0;
+                TXQ_Ports[Local_Index].Queue_Count[Local_Queue] = 0;
+            }
+            TXQ_Ports[Local_Index].TX_Busy = 0;
+            TXQ_Ports[Local_Index].Port    = USARTx;
+            break;
+        }
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+    if (Local_Index == TXQ_PORTS_NUM){ return TXQ_NO_PORT; }
+
+    if (MCAL_UART_Claim_CALLBACKS(USARTx, TXQ_voidTXCallBack, NULL) != Uart_OK)
+    {
+        // the port is owned by another service.
+        TXQ_Ports[Local_Index].Port = NULL;
+        return TXQ_NO_PORT;
+    }
+    // the latencies are measured by the DWT cycle counter.
+    __UART_DWT_ENABLE();
+    return Local_Index;
+}
+
+
+/// @brief  TXQ_u8Highest    : it finds the highest queue that has frames.
+/// @param  Copy_Entry       : the port entry.
+/// @retval the queue, or TXQ_NO_QUEUE.
+static u8 TXQ_u8Highest(TXQ_Port_Entry *Copy_Entry)
+{
+    u8 Local_Queue;
+
+    for (Local_Queue = 0; Local_Queue < TXQ_QUEUES_NUM; Local_Queue++)
+    {
+        if (Copy_Entry -> Queue_Count[Local_Queue] > 0){ return Local_Queue; }
+    }
+    return TXQ_NO_QUEUE;
+}
+
+
+/// @brief  TXQ_voidKick     : it starts the next chunk of the highest queue if the port is free.
+/// @param  Copy_Entry       : the port entry.
+/// @retval None.
+static void TXQ_voidKick(u8 Copy_Entry)
+{
+    TXQ_Port_Entry *Local_Entry = &TXQ_Ports[Copy_Entry];
+    TXQ_Frame      *Local_Frame;
+    u8  Local_Queue;
+    u16 Local_Chunk;
+    u32 Local_State;
+    Uart_Fun_Status Local_Status;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    while (Local_Entry -> TX_Busy == 0)
+    {
+        Local_Queue = TXQ_u8Highest(Local_Entry);
+        if (Local_Queue == TXQ_NO_QUEUE){ break; }
+        Local_Frame = &Local_Entry -> Queue[Local_Queue][Local_Entry -> Queue_Head[Local_Queue]];
+        Local_Chunk = Local_Frame -> Size - Local_Frame -> Sent;
+#if TXQ_PREEMPT == Enable
+        // the bulk frames are cut into chunks, so the higher queues are checked between them.
+        if ((Local_Queue == (TXQ_QUEUES_NUM - 1)) && (Local_Chunk > TXQ_PREEMPT_CHUNK))
+        {
+            Local_Chunk = TXQ_PREEMPT_CHUNK;
+        }
+#endif
+        Local_Entry -> Active  = Local_Queue;
+        Local_Entry -> Chunk   = Local_Chunk;
+        Local_Entry -> TX_Busy = 1;
+        // the chunk ends by its size only, so a queue is changed only at a frame end or at a bulk chunk end.
+        Local_Status = MCAL_UART_Transmit_Size_INT(Local_Entry -> Port, &Local_Frame -> Frame[Local_Frame -> Sent], Local_Chunk);
+        if (Local_Status == Uart_OK)
+        {
+            // TXQ_voidChunkDone is called at its end.
+            break;
+        }
+        Local_Entry -> TX_Busy = 0;
+        if (Local_Status == Uart_BUSY)
+        {
+            // the port is used by another Transfer, the queues are sent from the next TXQ_Send.
+            break;
+        }
+        // the frame can not be sent.
+        Local_Entry -> Stats[Local_Queue].Dropped++;
+        TXQ_voidFrameDone(Local_Entry, Local_Queue, 0);
+    }
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  TXQ_voidChunkDone : it adds the sent chunk to the active frame, and ends the frame at its size.
+/// @param  Copy_Entry        : the port entry.
+/// @retval None.
+static void TXQ_voidChunkDone(u8 Copy_Entry)
+{
+    TXQ_Port_Entry *Local_Entry = &TXQ_Ports[Copy_Entry];
+    TXQ_Frame      *Local_Frame = &Local_Entry -> Queue[Local_Entry -> Active][Local_Entry -> Queue_Head[Local_Entry -> Active]];
+    u32 Local_State;
+
+    __UART_ENTER_CRITICAL(Local_State);
+    // a chunk is sent by its size, so it ends after all its elements.
+    Local_Frame -> Sent += Local_Entry -> Chunk;
+    if (Local_Frame -> Sent >= Local_Frame -> Size)
+    {
+        TXQ_voidFrameDone(Local_Entry, Local_Entry -> Active, 1);
+    }
+    else if (TXQ_u8Highest(Local_Entry) < Local_Entry -> Active)
+    {
+        // a higher frame is sent before the rest of this one.
+        Local_Entry -> Stats[Local_Entry -> Active].Preempted++;
+    }
+    Local_Entry -> TX_Busy = 0;
+    __UART_EXIT_CRITICAL(Local_State);
+}
+
+
+/// @brief  TXQ_voidFrameDone : it removes the oldest frame of a queue and adds its latency to the statistics.
+/// @param  Copy_Entry        : the port entry.
+/// @param  Copy_Queue        : the queue.
+/// @param  Copy_Sent         : (1) if the frame is sent, (0) if it is dropped.
+/// @retval None.
+static void TXQ_voidFrameDone(TXQ_Port_Entry *Copy_Entry , u8 Copy_Queue , u8 Copy_Sent)
+{
+    TXQ_Stats *Local_Stats = &Copy_Entry -> Stats[Copy_Queue];
+    u32 Local_Cycles;
+    u8  Local_Bucket = 0;
+
+    if (Copy_Sent == 1)
+    {
+        Local_Cycles = DWT_CYCCNT_R - Copy_Entry -> Queue[Copy_Queue][Copy_Entry -> Queue_Head[Copy_Queue]].Cycle;
+        // the bucket is the highest set bit above TXQ_HIST_FIRST.
+        while (((Local_Cycles >> (Local_Bucket + 1 + TXQ_HIST_FIRST)) != 0) && (Local_Bucket < (TXQ_HIST_BUCKETS - 1)))
+        {
+            Local_Bucket++;
+        }
+        Local_Stats -> Histogram[Local_Bucket]++;
+        if (Local_Cycles > Local_Stats -> Max_Cycles)
+        {
+            Local_Stats -> Max_Cycles = Local_Cycles;
+        }
+        Local_Stats -> Frames++;
+    }
+    Copy_Entry -> Queue_Head[Copy_Queue] = (Copy_Entry -> Queue_Head[Copy_Queue] + 1) % TXQ_QUEUE_DEPTH;
+    Copy_Entry -> Queue_Count[Copy_Queue]--;
+}
+
+
+/// @brief  TXQ_voidTXCallBack : the USART TX callback of the ports, it sends the next chunk.
+/// @param  USARTx             : the Struct of the USART Peripheral.
+/// @retval None.
+static void TXQ_voidTXCallBack(USART_Struct *USARTx)
+{
+    u8 Local_Index = TXQ_u8GetEntry(USARTx, 0);
+
+    if (Local_Index == TXQ_NO_PORT){ return; }
+    TXQ_voidChunkDone(Local_Index);
+    TXQ_voidKick(Local_Index);
+}
@@ -0,0 +1,178 @@
+/********************************************************************************************/
+/* 	AUTHOR  		: islam atef Mohamed 													*/
+/* 	VERSION 		:	  V1.0 																*/
+/* 	DATE    		:  1/2023 																*/
+/*	Description  	:  This is the loopback test of the Priority Transmit Queues Service,	*/
+/*					   it runs on the host model of the USART driver (USART_POSIX)			*/
+/********************************************************************************************/
+/*	USART1 sends a bulk frame, a telemetry frame and two command frames by the queues to		*/
+/*	USART2 over a pseudo-terminal pair. every frame has elements equal to its last element,	*/
+/*	the test checks that every frame arrives in one piece (no frame is cut by another one),	*/
+/*	that the commands are sent before the telemetry, and the statistics of the queues.		*/
+/*	build (the LIB and STK headers of the firmware tree are on the include path) :			*/
+/*	gcc -std=gnu99 -DUSART_POSIX=Enable -I. -IMCAL/USART -ISERVICES/TXQ						*/
+/*	    MCAL/USART/USART_program.c MCAL/USART/USART_posix.c SERVICES/TXQ/TXQ_program.c			*/
+/*	    SERVICES/TXQ/TXQ_test.c -lpthread													*/
+/*	run : ./a.out, it returns (0) if the test passes.										*/
+/********************************************************************************************/
+#include "LIB/BIT_MATH.h"
+#include "LIB/STD_Types.h"
+
+#include "MCAL/USART/USART_private.h"
+#include "MCAL/USART/USART_config.h"
+#include "MCAL/USART/USART_interface.h"
+
+#include "TXQ_config.h"
+#include "TXQ_private.h"
+#include "TXQ_interface.h"
+
+#if USART_POSIX == Enable
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+/********************************************************************************************/
+#define     TEST_BULK_SIZE          100U
+#define     TEST_TELEMETRY_SIZE     20U
+#define     TEST_COMMAND_SIZE       8U
+#define     TEST_TOTAL_SIZE         (TEST_BULK_SIZE + TEST_TELEMETRY_SIZE + (2U * TEST_COMMAND_SIZE))
+/*	the Reception ends by its size, no element is this one	*/
+#define     TEST_NO_ELEMENT         0xFFU
+/********************************************************************************************/
+static USART_Struct     Test_TX = { .USART_x = USART1_R, .Time_Limit = 1000 };
+static USART_Struct     Test_RX = { .USART_x = USART2_R, .Time_Limit = 1000 };
+static u8               Test_Bulk[TEST_BULK_SIZE];
+static u8               Test_Telemetry[TEST_TELEMETRY_SIZE];
+static u8               Test_Command_A[TEST_COMMAND_SIZE];
+static u8               Test_Command_B[TEST_COMMAND_SIZE];
+static u8               Test_Stream[TEST_TOTAL_SIZE];
+static volatile u8      Test_RX_Done;
+/********************************************************************************************/
+
+
+/// @brief  Test_RX_End : the RX callback of USART2.
+/// @return None.
+static void Test_RX_End(USART_Struct *USARTx)
+{
+    __atomic_store_n(&Test_RX_Done, 1, __ATOMIC_RELEASE);
+}
+
+
+/// @brief  Test_Fill    : it fills a frame by its tag, then (Copy_Last) elements, the last one is equal to them.
+/// @param  Copy_Frame   : the frame.
+/// @param  Copy_Size    : the frame size.
+/// @param  Copy_Tag     : the first element.
+/// @param  Copy_Last    : the repeated element.
+/// @return None.
+static void Test_Fill(u8 *Copy_Frame , u16 Copy_Size , u8 Copy_Tag , u8 Copy_Last)
+{
+    u16 Local_Index;
+
+    Copy_Frame[0] = Copy_Tag;
+    for (Local_Index = 1; Local_Index < Copy_Size; Local_Index++)
+    {
+        Copy_Frame[Local_Index] = ((Local_Index % 3U) == 0) ? Copy_Last : (u8)(Copy_Tag + Local_Index);
+    }
+    Copy_Frame[Copy_Size - 1U] = Copy_Last;
+}
+
+
+/// @brief  Test_Check   : it checks that a frame is the next piece of the stream.
+/// @param  Copy_Offset  : pointer of the stream offset, it is moved after the frame.
+/// @param  Copy_Frame   : the frame.
+/// @param  Copy_Size    : the frame size.
+/// @param  Copy_Name    : the frame name.
+/// @return (1) if the frame is found, (0) if not.
+static u8 Test_Check(u16 *Copy_Offset , const u8 *Copy_Frame , u16 Copy_Size , const char *Copy_Name)
+{
+    if (((*Copy_Offset + Copy_Size) > TEST_TOTAL_SIZE) || (memcmp(&Test_Stream[*Copy_Offset], Copy_Frame, Copy_Size) != 0))
+    {
+        printf("FAIL : the %s frame is not at %u in one piece\n", Copy_Name, *Copy_Offset);
+        return 0;
+    }
+    *Copy_Offset += Copy_Size;
+    return 1;
+}
+
+
+int main(void)
+{
+    MUSART_Frame_Config     Local_Frame     = { _8_Bit, _1_0_Bit, Parity_Disable };
+    MUSART_Receiving_Config Local_Receiving = { Sampling_By_16, Three_Sample };
+    struct timespec Local_Pause = { 0, 1000000L };
+    TXQ_Stats Local_Stats;
+    char Local_Name[64];
+    u16  Local_Offset = 0;
+    u16  Local_Wait;
+    u8   Local_Pending = 0;
+    u8   Local_Pass = 1;
+
+    if ((MCAL_UART_Posix_Pty(&Test_TX, Local_Name, sizeof(Local_Name)) != Uart_OK) ||
+        (MCAL_UART_Posix_Open(&Test_RX, Local_Name) != Uart_OK))
+    {
+        printf("FAIL : no pseudo-terminal\n");
+        return 1;
+    }
+    (void)MCAL_UART_Init_(&Test_TX, &Local_Frame, &Local_Receiving, 921600UL);
+    (void)MCAL_UART_Init_(&Test_RX, &Local_Frame, &Local_Receiving, 921600UL);
+    (void)MCAL_UART_Enable(&Test_TX);
+    (void)MCAL_UART_Enable(&Test_RX);
+    (void)MCAL_UART_RX_CALLBACK(&Test_RX, Test_RX_End);
+    (void)MCAL_UART_Receive_INT(&Test_RX, Test_Stream, TEST_TOTAL_SIZE, TEST_NO_ELEMENT);
+
+    Test_Fill(Test_Bulk,      TEST_BULK_SIZE,      0x10U, 0x0AU);
+    Test_Fill(Test_Telemetry, TEST_TELEMETRY_SIZE, 0x40U, 0x0DU);
+    Test_Fill(Test_Command_A, TEST_COMMAND_SIZE,   0x70U, 0x0AU);
+    Test_Fill(Test_Command_B, TEST_COMMAND_SIZE,   0x80U, 0x0AU);
+    // the bulk frame starts at once, the other frames wait for its end (TXQ_PREEMPT is Disable).
+    if ((TXQ_Send(&Test_TX, TXQ_QUEUES_NUM - 1U, Test_Bulk,      TEST_BULK_SIZE)      != Uart_OK) ||
+        (TXQ_Send(&Test_TX, 1U,                  Test_Telemetry, TEST_TELEMETRY_SIZE) != Uart_OK) ||
+        (TXQ_Send(&Test_TX, 0U,                  Test_Command_A, TEST_COMMAND_SIZE)   != Uart_OK) ||
+        (TXQ_Send(&Test_TX, 0U,                  Test_Command_B, TEST_COMMAND_SIZE)   != Uart_OK))
+    {
+        printf("FAIL : TXQ_Send\n");
+        return 1;
+    }
+    for (Local_Wait = 0; (Local_Wait < 2000U) && (__atomic_load_n(&Test_RX_Done, __ATOMIC_ACQUIRE) == 0); Local_Wait++)
+    {
+        nanosleep(&Local_Pause, NULL);
+    }
+    if (Test_RX_Done == 0)
+    {
+        printf("FAIL : %u elements of %u are Received\n", (u16)(TEST_TOTAL_SIZE - Test_RX.RX_Process_Count), TEST_TOTAL_SIZE);
+        return 1;
+    }
+#if TXQ_PREEMPT == Disable
+    Local_Pass &= Test_Check(&Local_Offset, Test_Bulk,      TEST_BULK_SIZE,      "bulk");
+    Local_Pass &= Test_Check(&Local_Offset, Test_Command_A, TEST_COMMAND_SIZE,   "first command");
+    Local_Pass &= Test_Check(&Local_Offset, Test_Command_B, TEST_COMMAND_SIZE,   "second command");
+    Local_Pass &= Test_Check(&Local_Offset, Test_Telemetry, TEST_TELEMETRY_SIZE, "telemetry");
+#else
+    // the commands and the telemetry are sent after the first chunk of the bulk frame, then its rest.
+    Local_Offset = TXQ_PREEMPT_CHUNK;
+    Local_Pass &= Test_Check(&Local_Offset, Test_Command_A, TEST_COMMAND_SIZE,   "first command");
+    Local_Pass &= Test_Check(&Local_Offset, Test_Command_B, TEST_COMMAND_SIZE,   "second command");
+    Local_Pass &= Test_Check(&Local_Offset, Test_Telemetry, TEST_TELEMETRY_SIZE, "telemetry");
+    if ((memcmp(Test_Stream, Test_Bulk, TXQ_PREEMPT_CHUNK) != 0) ||
+        (memcmp(&Test_Stream[Local_Offset], &Test_Bulk[TXQ_PREEMPT_CHUNK], TEST_BULK_SIZE - TXQ_PREEMPT_CHUNK) != 0))
+    {
+        printf("FAIL : the bulk frame is not cut at its first chunk\n");
+        Local_Pass = 0;
+    }
+#endif
+    if ((TXQ_Get_Stats(&Test_TX, TXQ_QUEUES_NUM - 1U, &Local_Stats) != Uart_OK) || (Local_Stats.Frames != 1U) ||
+        (Local_Stats.Preempted != ((TXQ_PREEMPT == Enable) ? 1U : 0U)))
+    {
+        printf("FAIL : the bulk queue statistics\n");
+        Local_Pass = 0;
+    }
+    if ((TXQ_Get_Pending(&Test_TX, 0U, &Local_Pending) != Uart_OK) || (Local_Pending != 0U))
+    {
+        printf("FAIL : the commands are still pending\n");
+        Local_Pass = 0;
+    }
+    (void)MCAL_UART_Posix_Close(&Test_RX);
+    (void)MCAL_UART_Posix_Close(&Test_TX);
+    printf("%s : TXQ loopback\n", (Local_Pass == 1) ? "PASS" : "FAIL");
+    return (Local_Pass == 1) ? 0 : 1;
+}
+#endif